@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "common/lang/bitmap.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+using FindNextBitFunc = int (*)(const char *, int, int, bool);
+
+/**
+ * @brief 遍历位图中所有为1的位，模拟扫描页面上的记录
+ * @details 参数分别是位图的大小和每一位为1的概率(百分比)
+ */
+static void scan_setted_bits(State &state, FindNextBitFunc func)
+{
+  const int    size    = static_cast<int>(state.range(0));
+  const int    density = static_cast<int>(state.range(1));
+  vector<char> buf((size + 7) / 8);
+  Bitmap       bitmap(buf.data(), size);
+  mt19937      random(1);
+  for (int i = 0; i < size; i++) {
+    if (static_cast<int>(random() % 100) < density) {
+      bitmap.set_bit(i);
+    }
+  }
+
+  for (auto _ : state) {
+    int count = 0;
+    for (int index = func(buf.data(), size, 0, true); index >= 0; index = func(buf.data(), size, index + 1, true)) {
+      count++;
+    }
+    DoNotOptimize(count);
+  }
+}
+
+static void BM_ScanIterator(State &state)
+{
+  const int    size    = static_cast<int>(state.range(0));
+  const int    density = static_cast<int>(state.range(1));
+  vector<char> buf((size + 7) / 8);
+  Bitmap       bitmap(buf.data(), size);
+  mt19937      random(1);
+  for (int i = 0; i < size; i++) {
+    if (static_cast<int>(random() % 100) < density) {
+      bitmap.set_bit(i);
+    }
+  }
+
+  for (auto _ : state) {
+    int               count = 0;
+    SettedBitIterator iterator(buf.data(), size);
+    while (iterator.next() >= 0) {
+      count++;
+    }
+    DoNotOptimize(count);
+  }
+}
+
+/**
+ * @brief 在几乎满了的位图中查找空闲的位，模拟插入记录时查找空闲的槽位
+ */
+static void find_unsetted_bit(State &state, FindNextBitFunc func)
+{
+  const int    size = static_cast<int>(state.range(0));
+  vector<char> buf((size + 7) / 8, -1);
+  Bitmap       bitmap(buf.data(), size);
+  bitmap.clear_bit(size - 1);
+
+  for (auto _ : state) {
+    DoNotOptimize(func(buf.data(), size, 0, false));
+  }
+}
+
+static void BM_ScanBytewise(State &state) { scan_setted_bits(state, find_next_bit_bytewise); }
+static void BM_ScanWordwise(State &state) { scan_setted_bits(state, find_next_bit_wordwise); }
+static void BM_ScanAvx2(State &state) { scan_setted_bits(state, find_next_bit_avx2); }
+
+static void BM_FindUnsettedBytewise(State &state) { find_unsetted_bit(state, find_next_bit_bytewise); }
+static void BM_FindUnsettedWordwise(State &state) { find_unsetted_bit(state, find_next_bit_wordwise); }
+static void BM_FindUnsettedAvx2(State &state) { find_unsetted_bit(state, find_next_bit_avx2); }
+
+// 页面上的记录位图只有几百位，缓冲池页面分组的位图有几万位
+#define SCAN_ARGS ArgsProduct({{400, 65536}, {1, 50, 100}})
+#define FIND_ARGS Arg(400)->Arg(65536)
+
+BENCHMARK(BM_ScanBytewise)->SCAN_ARGS;
+BENCHMARK(BM_ScanWordwise)->SCAN_ARGS;
+BENCHMARK(BM_ScanAvx2)->SCAN_ARGS;
+BENCHMARK(BM_ScanIterator)->SCAN_ARGS;
+BENCHMARK(BM_FindUnsettedBytewise)->FIND_ARGS;
+BENCHMARK(BM_FindUnsettedWordwise)->FIND_ARGS;
+BENCHMARK(BM_FindUnsettedAvx2)->FIND_ARGS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+#include <benchmark/benchmark.h>
+#include <random>
+#include <stdexcept>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 测试页帧全部命中时，BPFrameManager::get 的吞吐随线程数的变化
+ * @details 参数是分片的个数。分片个数为1时，相当于所有的页面都在一把锁下面
+ */
+class FrameManagerBenchmark : public Fixture
+{
+public:
+  static constexpr int FILE_DESC = 0;
+  static constexpr int POOL_NUM  = 8;
+
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("frame_manager.log", LOG_LEVEL_INFO);
+
+    frame_manager_ = new BPFrameManager("Benchmark", static_cast<int>(state.range(0)));
+    if (frame_manager_->init(POOL_NUM) != RC::SUCCESS) {
+      throw runtime_error("failed to init frame manager");
+    }
+
+    page_num_ = static_cast<int>(frame_manager_->total_frame_num());
+    for (PageNum page_num = 0; page_num < page_num_; page_num++) {
+      Frame *frame = frame_manager_->alloc(FILE_DESC, page_num);
+      if (frame == nullptr) {
+        throw runtime_error("failed to alloc frame");
+      }
+      frame->set_file_desc(FILE_DESC);
+      frame->unpin();
+    }
+    LOG_INFO("frame manager benchmark setup done. threads=%d, shards=%d, pages=%d",
+             state.threads(), frame_manager_->shard_num(), page_num_);
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    for (PageNum page_num = 0; page_num < page_num_; page_num++) {
+      Frame *frame = frame_manager_->get(FILE_DESC, page_num);
+      frame_manager_->free(FILE_DESC, page_num, frame);
+    }
+    frame_manager_->cleanup();
+    delete frame_manager_;
+    frame_manager_ = nullptr;
+  }
+
+protected:
+  BPFrameManager *frame_manager_ = nullptr;
+  int             page_num_      = 0;
+};
+
+BENCHMARK_DEFINE_F(FrameManagerBenchmark, Get)(State &state)
+{
+  // IntegerGenerator 每次都会读取 random_device，开销比 get 本身还大，这里使用一个简单的伪随机数
+  minstd_rand                   random_engine(state.thread_index() + 1);
+  uniform_int_distribution<int> distribution(0, page_num_ - 1);
+
+  for (auto _ : state) {
+    Frame *frame = frame_manager_->get(FILE_DESC, distribution(random_engine));
+    frame->unpin();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(FrameManagerBenchmark, Get)
+    ->Arg(1)
+    ->Arg(BPFrameManager::DEFAULT_SHARD_NUM)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_MAIN();
@@ -12,6 +12,14 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2021/5/7.
 //
 
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITMAP_X86 1
+#endif
+
 #include "common/lang/bitmap.h"
 
 namespace common {
@@ -38,6 +46,182 @@ int find_first_setted(char byte, int start)
 
 int bytes(int size) { return size % 8 == 0 ? size / 8 : size / 8 + 1; }
 
+int find_next_bit_bytewise(const char *bitmap, int size, int start, bool setted)
+{
+  int ret           = -1;
+  int start_in_byte = start % 8;
+  for (int iter = start / 8, end = bytes(size); iter < end; iter++) {
+    char byte = bitmap[iter];
+    if (byte != (setted ? 0x00 : -1)) {
+      int index_in_byte = setted ? find_first_setted(byte, start_in_byte) : find_first_zero(byte, start_in_byte);
+      if (index_in_byte >= 0) {
+        ret = iter * 8 + index_in_byte;
+        break;
+      }
+    }
+    start_in_byte = 0;
+  }
+
+  if (ret >= size) {
+    ret = -1;
+  }
+  return ret;
+}
+
+/**
+ * @brief 读取位图最后不足8个字节的部分，多出来的部分是0
+ */
+__attribute__((noinline, cold)) static uint64_t load_tail_word(
+    const char *bitmap, int byte_num, int byte_index, uint64_t invert)
+{
+  uint64_t word = 0;
+  for (int i = 0; byte_index + i < byte_num; i++) {
+    word |= static_cast<uint64_t>(static_cast<uint8_t>(bitmap[byte_index + i] ^ invert)) << (i * 8);
+  }
+  return word;
+}
+
+/**
+ * @brief 从 byte_index 开始读取一个字(最多8个字节)，并且按照 invert 取反，这样要找的位都是1
+ */
+static inline uint64_t load_word(const char *bitmap, int byte_num, int byte_index, uint64_t invert)
+{
+  if (__builtin_expect(byte_index + 8 <= byte_num, 1)) {
+    uint64_t word;
+    memcpy(&word, bitmap + byte_index, sizeof(word));
+    return word ^ invert;
+  }
+  return load_tail_word(bitmap, byte_num, byte_index, invert);
+}
+
+/**
+ * @brief 从 byte_index 开始按字查找，word 是 byte_index 处已经读取的字
+ */
+static inline int scan_words(const char *bitmap, int size, int byte_num, int byte_index, uint64_t word, uint64_t invert)
+{
+  while (word == 0) {
+    byte_index += 8;
+    if (byte_index >= byte_num) {
+      return -1;
+    }
+    word = load_word(bitmap, byte_num, byte_index, invert);
+  }
+
+  const int index = byte_index * 8 + __builtin_ctzll(word);
+  return index < size ? index : -1;
+}
+
+int find_next_bit_wordwise(const char *bitmap, int size, int start, bool setted)
+{
+  if (start < 0 || start >= size) {
+    return -1;
+  }
+
+  const uint64_t invert     = setted ? 0 : ~0ULL;
+  const int      byte_num   = (size + 7) / 8;
+  const int      byte_index = start / 8;
+
+  // 起始位置所在的字需要去掉 start 前面的位
+  const uint64_t word = load_word(bitmap, byte_num, byte_index, invert) & (~0ULL << (start % 8));
+  return scan_words(bitmap, size, byte_num, byte_index, word, invert);
+}
+
+#ifdef BITMAP_X86
+__attribute__((target("avx2"))) static int find_next_bit_avx2_impl(
+    const char *bitmap, int size, int start, bool setted)
+{
+  if (start < 0 || start >= size) {
+    return -1;
+  }
+
+  const uint64_t invert     = setted ? 0 : ~0ULL;
+  const int      byte_num   = (size + 7) / 8;
+  int            byte_index = start / 8;
+
+  const uint64_t word = load_word(bitmap, byte_num, byte_index, invert) & (~0ULL << (start % 8));
+  if (word != 0) {
+    return scan_words(bitmap, size, byte_num, byte_index, word, invert);
+  }
+
+  // 一次比较32个字节，整块都不满足条件就跳过，找到之后在这一块中按字查找
+  const __m256i invert_vec = _mm256_set1_epi64x(static_cast<long long>(invert));
+  for (byte_index += 8; byte_index + 32 <= byte_num; byte_index += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitmap + byte_index));
+    block         = _mm256_xor_si256(block, invert_vec);
+    if (!_mm256_testz_si256(block, block)) {
+      break;
+    }
+  }
+  if (byte_index >= byte_num) {
+    return -1;
+  }
+  return scan_words(bitmap, size, byte_num, byte_index, load_word(bitmap, byte_num, byte_index, invert), invert);
+}
+#endif
+
+int find_next_bit_avx2(const char *bitmap, int size, int start, bool setted)
+{
+#ifdef BITMAP_X86
+  if (avx2_supported()) {
+    return find_next_bit_avx2_impl(bitmap, size, start, setted);
+  }
+#endif
+  return find_next_bit_wordwise(bitmap, size, start, setted);
+}
+
+bool avx2_supported()
+{
+#ifdef BITMAP_X86
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
+
+using FindNextBitFunc = int (*)(const char *, int, int, bool);
+
+static FindNextBitFunc choose_find_next_bit()
+{
+#ifdef BITMAP_X86
+  if (avx2_supported()) {
+    return find_next_bit_avx2_impl;
+  }
+#endif
+  return find_next_bit_wordwise;
+}
+
+int find_next_bit(const char *bitmap, int size, int start, bool setted)
+{
+  static const FindNextBitFunc func = choose_find_next_bit();
+  return func(bitmap, size, start, setted);
+}
+
+void SettedBitIterator::init(const char *bitmap, int size, int start /*=0*/)
+{
+  bitmap_     = bitmap;
+  size_       = size;
+  next_start_ = start < 0 ? 0 : start;
+  base_       = 0;
+  word_       = 0;
+}
+
+bool SettedBitIterator::load_next_word()
+{
+  const int index = find_next_bit(bitmap_, size_, next_start_, true);
+  if (index < 0) {
+    next_start_ = size_;
+    return false;
+  }
+
+  // 从找到的位所在的字节开始读取一个字，前面已经返回过的位去掉
+  const int byte_index = index / 8;
+  base_                = byte_index * 8;
+  word_                = load_word(bitmap_, (size_ + 7) / 8, byte_index, 0) & (~0ULL << (index % 8));
+  next_start_          = base_ + 64;
+  return true;
+}
+
 Bitmap::Bitmap() : bitmap_(nullptr), size_(0) {}
 Bitmap::Bitmap(char *bitmap, int size) : bitmap_(bitmap), size_(size) {}
 
@@ -47,7 +231,7 @@ void Bitmap::init(char *bitmap, int size)
   size_   = size;
 }
 
-bool Bitmap::get_bit(int index)
+bool Bitmap::get_bit(int index) const
 {
   char bits = bitmap_[index / 8];
   return (bits & (1 << (index % 8))) != 0;
@@ -65,48 +249,8 @@ void Bitmap::clear_bit(int index)
   bits &= ~(1 << (index % 8));
 }
 
-int Bitmap::next_unsetted_bit(int start)
-{
-  int ret           = -1;
-  int start_in_byte = start % 8;
-  for (int iter = start / 8, end = bytes(size_); iter < end; iter++) {
-    char byte = bitmap_[iter];
-    if (byte != -1) {
-      int index_in_byte = find_first_zero(byte, start_in_byte);
-      if (index_in_byte >= 0) {
-        ret = iter * 8 + index_in_byte;
-        break;
-      }
-    }
-    start_in_byte = 0;
-  }
+int Bitmap::next_unsetted_bit(int start) const { return find_next_bit(bitmap_, size_, start, false); }
 
-  if (ret >= size_) {
-    ret = -1;
-  }
-  return ret;
-}
-
-int Bitmap::next_setted_bit(int start)
-{
-  int ret           = -1;
-  int start_in_byte = start % 8;
-  for (int iter = start / 8, end = bytes(size_); iter < end; iter++) {
-    char byte = bitmap_[iter];
-    if (byte != 0x00) {
-      int index_in_byte = find_first_setted(byte, start_in_byte);
-      if (index_in_byte >= 0) {
-        ret = iter * 8 + index_in_byte;
-        break;
-      }
-    }
-    start_in_byte = 0;
-  }
-
-  if (ret >= size_) {
-    ret = -1;
-  }
-  return ret;
-}
+int Bitmap::next_setted_bit(int start) const { return find_next_bit(bitmap_, size_, start, true); }
 
 }  // namespace common
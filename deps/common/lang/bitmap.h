@@ -14,8 +14,72 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
+
 namespace common {
 
+/**
+ * @brief 在位图中查找从 start 开始(包含 start)第一个值为 setted 的位，找不到返回-1
+ * @details 位图中第 i 位是第 i/8 个字节的第 i%8 位。这里有几种实现：
+ * - bytewise：逐个字节逐位查找，只用于对比；
+ * - wordwise：一次读取8个字节，使用 ctz 找到第一个满足条件的位；
+ * - avx2：一次比较32个字节，跳过整块都不满足条件的数据，剩下的按字查找。CPU 不支持时退化成 wordwise。
+ * find_next_bit 在启动时根据 CPU 选择最快的实现，Bitmap 使用的就是这个函数。
+ *
+ * @param bitmap 位图的内存，不需要对齐
+ * @param size   位图中有多少位
+ * @param start  从哪个位开始查找
+ * @param setted 查找值为1的位还是值为0的位
+ */
+int find_next_bit(const char *bitmap, int size, int start, bool setted);
+int find_next_bit_bytewise(const char *bitmap, int size, int start, bool setted);
+int find_next_bit_wordwise(const char *bitmap, int size, int start, bool setted);
+int find_next_bit_avx2(const char *bitmap, int size, int start, bool setted);
+
+/**
+ * @brief 当前的 CPU 是否支持 AVX2 指令
+ */
+bool avx2_supported();
+
+/**
+ * @brief 按顺序遍历位图中所有为1的位
+ * @details 反复调用 find_next_bit(index + 1) 时，每次查找都要重新读取位图，后一次查找依赖前一次的结果。
+ * 这里一次读取一个字，依次取出字中为1的位，一个字取完之后再使用 find_next_bit 跳到下一个为1的位。
+ * 遍历过程中修改位图，已经读取的字不会感知到。
+ */
+class SettedBitIterator
+{
+public:
+  SettedBitIterator() = default;
+  SettedBitIterator(const char *bitmap, int size, int start = 0) { init(bitmap, size, start); }
+
+  void init(const char *bitmap, int size, int start = 0);
+
+  /**
+   * @brief 返回下一个为1的位，没有了返回-1
+   */
+  int next()
+  {
+    if (word_ == 0 && !load_next_word()) {
+      return -1;
+    }
+
+    const int index = base_ + __builtin_ctzll(word_);
+    word_ &= word_ - 1;
+    return index < size_ ? index : -1;
+  }
+
+private:
+  bool load_next_word();
+
+private:
+  const char *bitmap_     = nullptr;
+  int         size_       = 0;
+  int         next_start_ = 0;  ///< 当前的字取完之后，从哪一位开始查找
+  int         base_       = 0;  ///< 当前的字中第0位在位图中的位置
+  uint64_t    word_       = 0;  ///< 当前的字中还没有返回的位
+};
+
 class Bitmap
 {
 public:
@@ -23,15 +87,15 @@ public:
   Bitmap(char *bitmap, int size);
 
   void init(char *bitmap, int size);
-  bool get_bit(int index);
+  bool get_bit(int index) const;
   void set_bit(int index);
   void clear_bit(int index);
 
   /**
    * @param start 从哪个位开始查找，start是包含在内的
    */
-  int next_unsetted_bit(int start);
-  int next_setted_bit(int start);
+  int next_unsetted_bit(int start) const;
+  int next_setted_bit(int start) const;
 
 private:
   char *bitmap_;
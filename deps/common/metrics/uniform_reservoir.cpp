@@ -47,7 +47,7 @@ UniformReservoir::UniformReservoir(RandomGenerator &random, size_t size) : Reser
 
 UniformReservoir::~UniformReservoir()
 {
-  if (snapshot_value_ == NULL) {
+  if (snapshot_value_ != NULL) {
     delete snapshot_value_;
     snapshot_value_ = NULL;
   }
@@ -80,13 +80,16 @@ size_t UniformReservoir::get_count()
 void UniformReservoir::update(double value)
 {
   MUTEX_LOCK(&mutex);
-  size_t count = ++counter;
+  size_t count = counter++;
 
   if (count < data.size()) {
     data[count] = (value);
   } else {
-    size_t rcount = next(data.size());
-    data[rcount]  = (value);
+    // Algorithm R: the count-th value replaces a sample with probability size/(count+1)
+    size_t rcount = next(count + 1);
+    if (rcount < data.size()) {
+      data[rcount] = (value);
+    }
   }
 
   MUTEX_UNLOCK(&mutex);
@@ -95,7 +98,9 @@ void UniformReservoir::update(double value)
 void UniformReservoir::snapshot()
 {
   MUTEX_LOCK(&mutex);
-  std::vector<double> output = data;
+  // only the recorded part before the reservoir is full
+  size_t              size = (counter < data.size()) ? counter : data.size();
+  std::vector<double> output(data.begin(), data.begin() + size);
   MUTEX_UNLOCK(&mutex);
 
   if (snapshot_value_ == NULL) {
@@ -24,4 +24,30 @@ See the Mulan PSL v2 for more details. */
 
 #define SOCKET_BUFFER_SIZE 8192
 
+#define BUFFER_POOL "BUFFER_POOL"
+#define FRAME_CACHE "FRAME_CACHE"
+#define PAGE_CLEANER_THREAD_NUM "PAGE_CLEANER_THREAD_NUM"
+#define PAGE_CLEANER_INTERVAL_MS "PAGE_CLEANER_INTERVAL_MS"
+#define PAGE_CLEANER_FREE_FRAME_PERCENT "PAGE_CLEANER_FREE_FRAME_PERCENT"
+#define PAGE_CLEANER_DIRTY_HIGH_WATERMARK "PAGE_CLEANER_DIRTY_HIGH_WATERMARK"
+#define PAGE_CLEANER_DIRTY_LOW_WATERMARK "PAGE_CLEANER_DIRTY_LOW_WATERMARK"
+#define READ_AHEAD_THREAD_NUM "READ_AHEAD_THREAD_NUM"
+#define READ_AHEAD_MAX_PAGES "READ_AHEAD_MAX_PAGES"
+#define PAGE_IO "PAGE_IO"
+#define DIRECT_IO "DIRECT_IO"
+#define FLUSH_RATE_LIMIT_MB "FLUSH_RATE_LIMIT_MB"
+#define PARTITIONS "PARTITIONS"
+#define PARTITION_TABLES "PARTITION_TABLES"
+#define READONLY_TABLES "READONLY_TABLES"
+#define WARM_UP_FILE "WARM_UP_FILE"
+
+#define EXECUTOR "EXECUTOR"
+#define PARALLEL_SCAN_THREAD_NUM "PARALLEL_SCAN_THREAD_NUM"
+#define PARALLEL_SCAN_MIN_PAGES "PARALLEL_SCAN_MIN_PAGES"
+#define PARALLEL_SCAN_MORSEL_PAGES "PARALLEL_SCAN_MORSEL_PAGES"
+
+#define INDEX "INDEX"
+#define INDEX_FILL_PERCENT "INDEX_FILL_PERCENT"
+#define INDEX_SORT_MEMORY_MB "INDEX_SORT_MEMORY_MB"
+
 #define SESSION_STAGE_NAME "SessionStage"
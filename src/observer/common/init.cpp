@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/init.h"
 
 #include "common/conf/ini.h"
+#include "common/ini_setting.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
@@ -24,9 +25,11 @@ See the Mulan PSL v2 for more details. */
 #include "global_context.h"
 #include "session/session.h"
 #include "session/session_stage.h"
+#include "sql/operator/parallel_table_scan_physical_operator.h"
 #include "sql/plan_cache/plan_cache_stage.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/default/default_handler.h"
+#include "storage/index/bplus_tree.h"
 #include "storage/trx/trx.h"
 
 using namespace std;
@@ -134,11 +137,204 @@ int prepare_init_seda()
   return 0;
 }
 
-int init_global_objects(ProcessParam *process_param, Ini &properties)
+/**
+ * @brief 创建缓冲池分区，并把表分配到分区中
+ * @details PARTITIONS=name:MB,name:MB
+ * PARTITION_TABLES=name:table|table,name:table
+ */
+static int init_buffer_pool_partitions(map<string, string> &bp_section)
+{
+  vector<string> items;
+  auto           it = bp_section.find(PARTITIONS);
+  if (it != bp_section.end()) {
+    split_string(it->second, ",", items);
+  }
+  for (string &item : items) {
+    vector<string> name_size;
+    split_string(item, ":", name_size);
+    int64_t memory_mb = 0;
+    if (name_size.size() != 2 || !str_to_val(name_size[1], memory_mb)) {
+      LOG_ERROR("invalid buffer pool partition: %s", item.c_str());
+      return -1;
+    }
+
+    strip(name_size[0]);
+    RC rc = GCTX.buffer_pool_manager_->create_partition(name_size[0].c_str(), memory_mb * 1024 * 1024);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to create buffer pool partition. partition=%s, rc=%s", item.c_str(), strrc(rc));
+      return -1;
+    }
+  }
+
+  items.clear();
+  it = bp_section.find(PARTITION_TABLES);
+  if (it != bp_section.end()) {
+    split_string(it->second, ",", items);
+  }
+  for (string &item : items) {
+    vector<string> name_tables;
+    split_string(item, ":", name_tables);
+    if (name_tables.size() != 2) {
+      LOG_ERROR("invalid buffer pool partition tables: %s", item.c_str());
+      return -1;
+    }
+
+    strip(name_tables[0]);
+    vector<string> tables;
+    split_string(name_tables[1], "|", tables);
+    for (string &table : tables) {
+      strip(table);
+      RC rc = GCTX.buffer_pool_manager_->assign_table(table.c_str(), name_tables[0].c_str());
+      if (OB_FAIL(rc)) {
+        LOG_ERROR("failed to assign table to buffer pool partition. table=%s, partition=%s, rc=%s",
+                  table.c_str(), name_tables[0].c_str(), strrc(rc));
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+int init_buffer_pool(ProcessParam *process_param, Ini &properties)
 {
-  GCTX.buffer_pool_manager_ = new BufferPoolManager();
+  map<string, string> bp_section = properties.get(BUFFER_POOL);
+
+  string frame_cache_name;
+  auto   it = bp_section.find(FRAME_CACHE);
+  if (it != bp_section.end()) {
+    frame_cache_name = it->second;
+  }
+
+  GCTX.buffer_pool_manager_ = new BufferPoolManager(process_param->buffer_pool_memory_size(), frame_cache_name.c_str());
   BufferPoolManager::set_instance(GCTX.buffer_pool_manager_);
 
+  it = bp_section.find(PAGE_IO);
+  if (it != bp_section.end()) {
+    RC rc = GCTX.buffer_pool_manager_->set_page_io(it->second.c_str());
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to set page io. name=%s, rc=%s", it->second.c_str(), strrc(rc));
+      return -1;
+    }
+  }
+
+  it = bp_section.find(DIRECT_IO);
+  if (it != bp_section.end()) {
+    const string &value = it->second;
+    GCTX.buffer_pool_manager_->set_direct_io(0 == strcasecmp(value.c_str(), "true") || value == "1");
+  }
+
+  it = bp_section.find(FLUSH_RATE_LIMIT_MB);
+  if (it != bp_section.end()) {
+    int64_t rate_limit = 0;
+    str_to_val(it->second, rate_limit);
+    GCTX.buffer_pool_manager_->set_flush_rate_limit(rate_limit);
+  }
+
+  if (init_buffer_pool_partitions(bp_section) != 0) {
+    return -1;
+  }
+
+  it = bp_section.find(READONLY_TABLES);
+  if (it != bp_section.end()) {
+    vector<string> tables;
+    split_string(it->second, "|", tables);
+    for (string &table : tables) {
+      strip(table);
+      GCTX.buffer_pool_manager_->set_table_readonly(table.c_str());
+    }
+  }
+
+  PageCleanerParam cleaner_param;
+  auto             get_int = [&bp_section](const char *key, int &value) {
+    auto it = bp_section.find(key);
+    if (it != bp_section.end()) {
+      str_to_val(it->second, value);
+    }
+  };
+  get_int(PAGE_CLEANER_THREAD_NUM, cleaner_param.thread_num);
+  get_int(PAGE_CLEANER_INTERVAL_MS, cleaner_param.interval_ms);
+  get_int(PAGE_CLEANER_FREE_FRAME_PERCENT, cleaner_param.free_frame_percent);
+  get_int(PAGE_CLEANER_DIRTY_HIGH_WATERMARK, cleaner_param.dirty_high_watermark);
+  get_int(PAGE_CLEANER_DIRTY_LOW_WATERMARK, cleaner_param.dirty_low_watermark);
+
+  RC rc = GCTX.buffer_pool_manager_->start_page_cleaner(cleaner_param);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to start page cleaner. rc=%s", strrc(rc));
+    return -1;
+  }
+
+  ReadAheadParam read_ahead_param;
+  get_int(READ_AHEAD_THREAD_NUM, read_ahead_param.thread_num);
+  get_int(READ_AHEAD_MAX_PAGES, read_ahead_param.max_pages);
+
+  rc = GCTX.buffer_pool_manager_->start_read_ahead(read_ahead_param);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to start read ahead. rc=%s", strrc(rc));
+    return -1;
+  }
+  return 0;
+}
+
+int init_executor(Ini &properties)
+{
+  map<string, string> executor_section = properties.get(EXECUTOR);
+
+  ParallelScanParam parallel_scan_param;
+  auto              get_int = [&executor_section](const char *key, int &value) {
+    auto it = executor_section.find(key);
+    if (it != executor_section.end()) {
+      str_to_val(it->second, value);
+    }
+  };
+  get_int(PARALLEL_SCAN_THREAD_NUM, parallel_scan_param.thread_num);
+  get_int(PARALLEL_SCAN_MIN_PAGES, parallel_scan_param.min_pages);
+  get_int(PARALLEL_SCAN_MORSEL_PAGES, parallel_scan_param.morsel_pages);
+
+  RC rc = ParallelTableScanPhysicalOperator::start_workers(parallel_scan_param);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to start parallel scan workers. rc=%s", strrc(rc));
+    return -1;
+  }
+  return 0;
+}
+
+int init_index(Ini &properties)
+{
+  map<string, string> index_section = properties.get(INDEX);
+
+  BplusTreeBuildParam build_param;
+  auto                it = index_section.find(INDEX_FILL_PERCENT);
+  if (it != index_section.end()) {
+    str_to_val(it->second, build_param.fill_percent);
+  }
+
+  it = index_section.find(INDEX_SORT_MEMORY_MB);
+  if (it != index_section.end()) {
+    int sort_memory_mb = 0;
+    str_to_val(it->second, sort_memory_mb);
+    if (sort_memory_mb > 0) {
+      build_param.sort_memory = static_cast<int64_t>(sort_memory_mb) * 1024 * 1024;
+    }
+  }
+
+  BplusTreeBulkLoader::set_build_param(build_param);
+  return 0;
+}
+
+int init_global_objects(ProcessParam *process_param, Ini &properties)
+{
+  if (init_buffer_pool(process_param, properties) != 0) {
+    return -1;
+  }
+
+  if (init_executor(properties) != 0) {
+    return -1;
+  }
+
+  if (init_index(properties) != 0) {
+    return -1;
+  }
+
   GCTX.handler_ = new DefaultHandler();
 
   DefaultHandler::set_default(GCTX.handler_);
@@ -156,11 +352,26 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
     LOG_ERROR("failed to init handler. rc=%s", strrc(rc));
     return -1;
   }
+
+  // 数据库打开之后才能预热，在接受连接之前把上次关闭时内存中的页面加载进来
+  string warm_up_file = properties.get(WARM_UP_FILE, "", BUFFER_POOL);
+  if (!warm_up_file.empty()) {
+    (void)GCTX.buffer_pool_manager_->warm_up(warm_up_file.c_str());
+  }
   return ret;
 }
 
 int uninit_global_objects()
 {
+  // 关闭数据库之前，记录下内存中的页面，下次启动时预热
+  string warm_up_file = get_properties()->get(WARM_UP_FILE, "", BUFFER_POOL);
+  if (!warm_up_file.empty() && GCTX.buffer_pool_manager_ != nullptr) {
+    (void)GCTX.buffer_pool_manager_->dump_hot_pages(warm_up_file.c_str());
+  }
+
+  // 关闭数据库之前停止并行扫描的线程，这时已经没有查询在执行了
+  ParallelTableScanPhysicalOperator::stop_workers();
+
   // TODO use global context
   DefaultHandler *default_handler = &DefaultHandler::get_default();
   if (default_handler != nullptr) {
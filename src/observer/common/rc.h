@@ -31,6 +31,7 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(BUFFERPOOL_OPEN)             \
   DEFINE_RC(BUFFERPOOL_NOBUF)            \
   DEFINE_RC(BUFFERPOOL_INVALID_PAGE_NUM) \
+  DEFINE_RC(BUFFERPOOL_READONLY)         \
   DEFINE_RC(RECORD_OPENNED)              \
   DEFINE_RC(RECORD_INVALID_RID)          \
   DEFINE_RC(RECORD_INVALID_KEY)          \
@@ -44,6 +45,7 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(SCHEMA_DB_NOT_OPENED)        \
   DEFINE_RC(SCHEMA_TABLE_NOT_EXIST)      \
   DEFINE_RC(SCHEMA_TABLE_EXIST)          \
+  DEFINE_RC(SCHEMA_TABLE_READONLY)       \
   DEFINE_RC(SCHEMA_FIELD_NOT_EXIST)      \
   DEFINE_RC(SCHEMA_FIELD_MISSING)        \
   DEFINE_RC(SCHEMA_FIELD_TYPE_MISMATCH)  \
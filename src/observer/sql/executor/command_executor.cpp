@@ -21,9 +21,11 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/help_executor.h"
 #include "sql/executor/load_data_executor.h"
 #include "sql/executor/set_variable_executor.h"
+#include "sql/executor/show_buffer_pool_executor.h"
 #include "sql/executor/show_tables_executor.h"
 #include "sql/executor/trx_begin_executor.h"
 #include "sql/executor/trx_end_executor.h"
+#include "sql/executor/vacuum_table_executor.h"
 #include "sql/stmt/stmt.h"
 
 RC CommandExecutor::execute(SQLStageEvent *sql_event)
@@ -46,6 +48,11 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
       return executor.execute(sql_event);
     }
 
+    case StmtType::VACUUM_TABLE: {
+      VacuumTableExecutor executor;
+      return executor.execute(sql_event);
+    }
+
     case StmtType::HELP: {
       HelpExecutor executor;
       return executor.execute(sql_event);
@@ -56,6 +63,11 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
       return executor.execute(sql_event);
     }
 
+    case StmtType::SHOW_BUFFER_POOL_STATUS: {
+      ShowBufferPoolExecutor executor;
+      return executor.execute(sql_event);
+    }
+
     case StmtType::BEGIN: {
       TrxBeginExecutor executor;
       return executor.execute(sql_event);
@@ -33,7 +33,9 @@ public:
   RC execute(SQLStageEvent *sql_event)
   {
     const char *strings[] = {"show tables;",
+        "show buffer_pool status;",
         "desc `table name`;",
+        "vacuum table `table name`;",
         "create table `table name` (`column name` `column type`, ...);",
         "create index `index name` on `table` (`column`);",
         "insert into `table` values(`value1`,`value2`);",
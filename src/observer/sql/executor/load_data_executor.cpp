@@ -33,15 +33,21 @@ RC LoadDataExecutor::execute(SQLStageEvent *sql_event)
 }
 
 /**
- * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
+ * @brief 一次批量导入多少行数据，参考 Table::insert_records
+ */
+static constexpr int LOAD_BATCH_ROWS = 4096;
+
+/**
+ * 从文件中导入数据时使用。把解析后的一行数据转换成一条记录。
  * @param table  要导入的表
  * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
- * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
+ * @param record_values Table::make_record使用的参数，为了防止频繁的申请内存
+ * @param record 返回生成的记录
  * @param errmsg 如果出现错误，通过这个参数返回错误信息
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(
-    Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values, std::stringstream &errmsg)
+RC make_record_from_file(Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values,
+    Record &record, std::stringstream &errmsg)
 {
 
   const int field_num     = record_values.size();
@@ -58,7 +64,7 @@ RC insert_record_from_file(
     const FieldMeta *field = table->table_meta().field(i + sys_field_num);
 
     std::string &file_value = file_values[i];
-    if (field->type() != CHARS) {
+    if (field->type() != CHARS && field->type() != VARCHARS) {
       common::strip(file_value);
     }
 
@@ -92,7 +98,8 @@ RC insert_record_from_file(
           record_values[i].set_float(float_value);
         }
       } break;
-      case CHARS: {
+      case CHARS:
+      case VARCHARS: {
         record_values[i].set_string(file_value.c_str());
       } break;
       default: {
@@ -103,17 +110,34 @@ RC insert_record_from_file(
   }
 
   if (RC::SUCCESS == rc) {
-    Record record;
     rc = table->make_record(field_num, record_values.data(), record);
     if (rc != RC::SUCCESS) {
       errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
-      errmsg << "insert failed.";
     }
   }
   return rc;
 }
 
+/**
+ * 批量插入攒下来的记录，插入失败时记录出错的行
+ * @param records   要插入的记录，插入之后清空
+ * @param line_nums 每条记录在文件中的行号
+ */
+RC insert_records_from_file(Table *table, std::vector<Record> &records, std::vector<int> &line_nums,
+    int &insertion_count, std::stringstream &result_string)
+{
+  int inserted = 0;
+  RC  rc       = table->insert_records(records, inserted);
+  insertion_count += inserted;
+  if (rc != RC::SUCCESS) {
+    result_string << "Line:" << line_nums[inserted] << " insert record failed:insert failed.. error:" << strrc(rc)
+                  << std::endl;
+  }
+  records.clear();
+  line_nums.clear();
+  return rc;
+}
+
 void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult *sql_result)
 {
   std::stringstream result_string;
@@ -133,12 +157,16 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
   const int field_num     = table->table_meta().field_num() - sys_field_num;
 
   std::vector<Value>       record_values(field_num);
+  std::vector<Record>      records;
+  std::vector<int>         line_nums;
   std::string              line;
   std::vector<std::string> file_values;
   const std::string        delim("|");
   int                      line_num        = 0;
   int                      insertion_count = 0;
   RC                       rc              = RC::SUCCESS;
+  records.reserve(LOAD_BATCH_ROWS);
+  line_nums.reserve(LOAD_BATCH_ROWS);
   while (!fs.eof() && RC::SUCCESS == rc) {
     std::getline(fs, line);
     line_num++;
@@ -149,14 +177,25 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
     file_values.clear();
     common::split_string(line, delim, file_values);
     std::stringstream errmsg;
-    rc = insert_record_from_file(table, file_values, record_values, errmsg);
+    rc = make_record_from_file(table, file_values, record_values, records.emplace_back(), errmsg);
     if (rc != RC::SUCCESS) {
-      result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
-                    << std::endl;
-    } else {
-      insertion_count++;
+      records.pop_back();
+      // 出错的行之前的数据还是要导入，前面的数据导入失败时就不会再处理到这一行
+      if (RC::SUCCESS == insert_records_from_file(table, records, line_nums, insertion_count, result_string)) {
+        result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
+                      << std::endl;
+      }
+      break;
+    }
+
+    line_nums.push_back(line_num);
+    if (static_cast<int>(records.size()) >= LOAD_BATCH_ROWS) {
+      rc = insert_records_from_file(table, records, line_nums, insertion_count, result_string);
     }
   }
+  if (RC::SUCCESS == rc && !records.empty()) {
+    rc = insert_records_from_file(table, records, line_nums, insertion_count, result_string);
+  }
   fs.close();
 
   struct timespec end_time;
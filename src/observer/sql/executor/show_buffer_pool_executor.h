@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include "common/rc.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "sql/executor/sql_result.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+/**
+ * @brief 显示缓冲池统计信息的执行器
+ * @ingroup Executor
+ * @details 每行是一项统计信息，Scope 为 global 或者文件名。可以根据命中率、淘汰次数等调整缓冲池的大小
+ */
+class ShowBufferPoolExecutor
+{
+public:
+  ShowBufferPoolExecutor()          = default;
+  virtual ~ShowBufferPoolExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event)
+  {
+    SqlResult *sql_result = sql_event->session_event()->sql_result();
+
+    std::vector<BufferPoolStatItem> items;
+    BufferPoolManager::instance().collect_stats(items);
+
+    TupleSchema tuple_schema;
+    tuple_schema.append_cell(TupleCellSpec("", "Scope", "Scope"));
+    tuple_schema.append_cell(TupleCellSpec("", "Name", "Name"));
+    tuple_schema.append_cell(TupleCellSpec("", "Value", "Value"));
+    sql_result->set_tuple_schema(tuple_schema);
+
+    auto oper = new StringListPhysicalOperator;
+    for (const BufferPoolStatItem &item : items) {
+      oper->append({item.scope, item.name, item.value});
+    }
+
+    sql_result->set_operator(std::unique_ptr<PhysicalOperator>(oper));
+    return RC::SUCCESS;
+  }
+};
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+
+#include "sql/executor/vacuum_table_executor.h"
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "sql/stmt/vacuum_table_stmt.h"
+#include "storage/table/table.h"
+
+RC VacuumTableExecutor::execute(SQLStageEvent *sql_event)
+{
+  Stmt          *stmt          = sql_event->stmt();
+  SessionEvent  *session_event = sql_event->session_event();
+  Session       *session       = session_event->session();
+  ASSERT(stmt->type() == StmtType::VACUUM_TABLE,
+      "vacuum table executor can not run this command: %d",
+      static_cast<int>(stmt->type()));
+
+  VacuumTableStmt *vacuum_table_stmt = static_cast<VacuumTableStmt *>(stmt);
+
+  Trx       *trx   = session->current_trx();
+  Table     *table = vacuum_table_stmt->table();
+  VacuumStat stat;
+  RC         rc = table->vacuum(trx, stat);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to vacuum table. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  TupleSchema tuple_schema;
+  tuple_schema.append_cell(TupleCellSpec("", "Purged records", "Purged records"));
+  tuple_schema.append_cell(TupleCellSpec("", "Moved records", "Moved records"));
+  tuple_schema.append_cell(TupleCellSpec("", "Released pages", "Released pages"));
+
+  SqlResult *sql_result = session_event->sql_result();
+  sql_result->set_tuple_schema(tuple_schema);
+
+  auto oper = new StringListPhysicalOperator;
+  oper->append({std::to_string(stat.purged_records), std::to_string(stat.moved_records),
+      std::to_string(stat.released_pages)});
+  sql_result->set_operator(std::unique_ptr<PhysicalOperator>(oper));
+  return RC::SUCCESS;
+}
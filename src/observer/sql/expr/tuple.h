@@ -157,11 +157,8 @@ public:
       return RC::INVALID_ARGUMENT;
     }
 
-    FieldExpr       *field_expr = speces_[index];
-    const FieldMeta *field_meta = field_expr->field().meta();
-    cell.set_type(field_meta->type());
-    cell.set_data(this->record_->data() + field_meta->offset(), field_meta->len());
-    return RC::SUCCESS;
+    FieldExpr *field_expr = speces_[index];
+    return field_expr->field().get_value(*record_, cell);
   }
 
   RC find_cell(const TupleCellSpec &spec, Value &cell) const override
@@ -38,6 +38,8 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
+  // 与全表扫描一样，扫描期间不能整理表，close 时释放
+  table_->latch().lock_shared();
   IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
       left_value_.length(),
       left_inclusive_,
@@ -46,6 +48,7 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
       right_inclusive_);
   if (nullptr == index_scanner) {
     LOG_WARN("failed to create index scanner");
+    table_->latch().unlock_shared();
     return RC::INTERNAL;
   }
 
@@ -53,9 +56,11 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
   if (nullptr == record_handler_) {
     LOG_WARN("invalid record handler");
     index_scanner->destroy();
+    table_->latch().unlock_shared();
     return RC::INTERNAL;
   }
   index_scanner_ = index_scanner;
+  latched_       = true;
 
   tuple_.set_schema(table_, table_->table_meta().field_metas());
 
@@ -100,8 +105,15 @@ RC IndexScanPhysicalOperator::next()
 
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();
-  index_scanner_ = nullptr;
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
+  record_page_handler_.cleanup();
+  if (latched_) {
+    latched_ = false;
+    table_->latch().unlock_shared();
+  }
   return RC::SUCCESS;
 }
 
@@ -51,6 +51,7 @@ private:
   Table             *table_          = nullptr;
   Index             *index_          = nullptr;
   bool               readonly_       = false;
+  bool               latched_        = false;  ///< open 成功时持有表的读锁，close 只释放自己持有的锁
   IndexScanner      *index_scanner_  = nullptr;
   RecordFileHandler *record_handler_ = nullptr;
 
@@ -0,0 +1,351 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+#include "common/log/log.h"
+#include "common/thread/thread_pool_executor.h"
+#include "event/sql_debug.h"
+#include "sql/operator/parallel_table_scan_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+
+using namespace std;
+
+static ParallelScanParam                      parallel_scan_param;
+static unique_ptr<common::ThreadPoolExecutor> parallel_scan_executor;
+
+RC ParallelTableScanPhysicalOperator::start_workers(const ParallelScanParam &param)
+{
+  parallel_scan_param              = param;
+  parallel_scan_param.morsel_pages = std::max(param.morsel_pages, 1);
+  if (param.thread_num <= 1) {
+    LOG_INFO("parallel scan is disabled. thread num=%d", param.thread_num);
+    return RC::SUCCESS;
+  }
+
+#ifdef CONCURRENCY
+  // 执行查询的线程也会参与扫描，所以只需要 thread_num - 1 个工作线程
+  auto executor = make_unique<common::ThreadPoolExecutor>();
+  int  ret      = executor->init("ParallelScan", param.thread_num - 1, param.thread_num - 1, 60 * 1000);
+  if (ret != 0) {
+    LOG_WARN("failed to init parallel scan thread pool. ret=%d", ret);
+    return RC::INTERNAL;
+  }
+  parallel_scan_executor = std::move(executor);
+  LOG_INFO("parallel scan started. thread num=%d, min pages=%d, morsel pages=%d",
+           param.thread_num, param.min_pages, parallel_scan_param.morsel_pages);
+#else
+  LOG_INFO("parallel scan runs in the query thread without CONCURRENCY. min pages=%d, morsel pages=%d",
+           param.min_pages, parallel_scan_param.morsel_pages);
+#endif
+  return RC::SUCCESS;
+}
+
+void ParallelTableScanPhysicalOperator::stop_workers()
+{
+  if (parallel_scan_executor) {
+    parallel_scan_executor->shutdown();
+    parallel_scan_executor->await_termination();
+    parallel_scan_executor.reset();
+    LOG_INFO("parallel scan stopped");
+  }
+}
+
+const ParallelScanParam &ParallelTableScanPhysicalOperator::scan_param() { return parallel_scan_param; }
+
+bool ParallelTableScanPhysicalOperator::support_aggregation(AggrOp aggregation, AttrType attr_type)
+{
+  switch (aggregation) {
+    case AggrOp::AGGR_COUNT:
+    case AggrOp::AGGR_COUNT_ALL: return true;
+    case AggrOp::AGGR_SUM:
+    case AggrOp::AGGR_AVG: return attr_type == INTS || attr_type == FLOATS;
+    case AggrOp::AGGR_MAX:
+    case AggrOp::AGGR_MIN: return attr_type == INTS || attr_type == FLOATS || attr_type == DATES || attr_type == CHARS;
+    default: return false;
+  }
+}
+
+ParallelTableScanPhysicalOperator::ParallelTableScanPhysicalOperator(Table *table, const vector<Field> &fields)
+    : table_(table), fields_(fields)
+{}
+
+void ParallelTableScanPhysicalOperator::set_aggregations(const vector<Field> &aggregate_fields)
+{
+  const vector<FieldMeta> &field_metas = *table_->table_meta().field_metas();
+  aggregations_.clear();
+  columns_.clear();
+  for (const Field &field : aggregate_fields) {
+    aggregations_.push_back(field.aggregation());
+    columns_.push_back(static_cast<int>(field.meta() - field_metas.data()));
+  }
+}
+
+string ParallelTableScanPhysicalOperator::param() const { return table_->name(); }
+
+RC ParallelTableScanPhysicalOperator::open(Trx *trx)
+{
+  trx_ = trx;
+  column_spec_ = ColumnScanSpec();
+  TableScanPhysicalOperator::make_column_scan_spec(table_, fields_, predicates_, true /*readonly*/, column_spec_);
+
+  // 扫描线程都在 next 中结束，读锁由打开算子的线程持有，close 时释放
+  table_->latch().lock_shared();
+  latched_    = true;
+  page_count_ = table_->data_buffer_pool()->page_count();
+  next_page_  = BP_HEADER_PAGE + 1;
+  failed_     = false;
+  emitted_    = false;
+  return RC::SUCCESS;
+}
+
+RC ParallelTableScanPhysicalOperator::next()
+{
+  if (emitted_) {
+    return RC::RECORD_EOF;
+  }
+  emitted_ = true;
+
+  const int             thread_num = std::max(parallel_scan_param.thread_num, 1);
+  vector<PartialResult> results(thread_num);
+
+  mutex              lock;
+  condition_variable done;
+  int                running = 0;
+  RC                 rc      = RC::SUCCESS;
+  auto               finish  = [&](RC task_rc) {
+    lock_guard<mutex> guard(lock);
+    if (OB_FAIL(task_rc) && OB_SUCC(rc)) {
+      rc = task_rc;
+    }
+  };
+
+  for (int i = 1; parallel_scan_executor && i < thread_num; i++) {
+    {
+      lock_guard<mutex> guard(lock);
+      running++;
+    }
+    int ret = parallel_scan_executor->execute([this, i, &results, &finish, &lock, &done, &running]() {
+      finish(scan_morsels(results[i]));
+      lock_guard<mutex> guard(lock);
+      if (--running == 0) {
+        done.notify_all();
+      }
+    });
+    if (ret != 0) {
+      LOG_WARN("failed to submit parallel scan task. ret=%d", ret);
+      lock_guard<mutex> guard(lock);
+      running--;
+      break;
+    }
+  }
+
+  // 执行查询的线程也领取块来扫描，没有工作线程时所有的块都在这里扫描
+  finish(scan_morsels(results[0]));
+  {
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [&running]() { return running == 0; });
+  }
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to scan table in parallel. table=%s, rc=%s", table_->name(), strrc(rc));
+    return rc;
+  }
+
+  merge(results);
+
+  // 工作线程中没有会话，调试信息只能在这里输出
+  int     morsels       = 0;
+  int64_t skipped_pages = 0;
+  for (const PartialResult &result : results) {
+    morsels += result.morsels;
+    skipped_pages += result.skipped_pages;
+  }
+  sql_debug("parallel scan table %s: %d threads, %d morsels, %ld pages skipped by zone map",
+      table_->name(), thread_num, morsels, skipped_pages);
+  return RC::SUCCESS;
+}
+
+RC ParallelTableScanPhysicalOperator::close()
+{
+  if (latched_) {
+    latched_ = false;
+    table_->latch().unlock_shared();
+  }
+  trx_ = nullptr;
+  return RC::SUCCESS;
+}
+
+RC ParallelTableScanPhysicalOperator::scan_morsels(PartialResult &result)
+{
+  result.sums.assign(aggregations_.size(), 0);
+  result.values.assign(aggregations_.size(), Value());
+
+  RowTuple tuple;
+  tuple.set_schema(table_, table_->table_meta().field_metas());
+
+  const int morsel_pages = parallel_scan_param.morsel_pages;
+  while (!failed_.load()) {
+    const PageNum start_page = next_page_.fetch_add(morsel_pages);
+    if (start_page >= page_count_) {
+      break;
+    }
+
+    const PageNum end_page = std::min(start_page + morsel_pages, page_count_);
+    RC            rc       = scan_morsel(start_page, end_page, tuple, result);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan pages [%d, %d) of table %s. rc=%s", start_page, end_page, table_->name(), strrc(rc));
+      failed_ = true;
+      return rc;
+    }
+    result.morsels++;
+  }
+  return RC::SUCCESS;
+}
+
+RC ParallelTableScanPhysicalOperator::scan_morsel(
+    PageNum start_page, PageNum end_page, RowTuple &tuple, PartialResult &result)
+{
+  RecordFileScanner scanner;
+  RC rc = table_->get_record_scanner(scanner, trx_, true /*readonly*/, &column_spec_, start_page, end_page);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  vector<Record> records;
+  Value          value;
+  while (OB_SUCC(rc = scanner.next_batch(records))) {
+    for (Record &record : records) {
+      tuple.set_record(&record);
+
+      bool matched = true;
+      for (const unique_ptr<Expression> &expr : predicates_) {
+        rc = expr->get_value(tuple, value);
+        if (OB_FAIL(rc)) {
+          return rc;
+        }
+        if (!value.get_boolean()) {
+          matched = false;
+          break;
+        }
+      }
+
+      if (matched) {
+        rc = accumulate(tuple, result);
+        if (OB_FAIL(rc)) {
+          return rc;
+        }
+      }
+    }
+  }
+
+  result.skipped_pages += scanner.skipped_pages();
+  scanner.close_scan();
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+RC ParallelTableScanPhysicalOperator::accumulate(const RowTuple &tuple, PartialResult &result)
+{
+  result.count++;
+
+  Value cell;
+  for (size_t i = 0; i < aggregations_.size(); i++) {
+    const AggrOp aggregation = aggregations_[i];
+    if (aggregation == AggrOp::AGGR_COUNT || aggregation == AggrOp::AGGR_COUNT_ALL) {
+      continue;
+    }
+
+    RC rc = tuple.cell_at(columns_[i], cell);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    switch (aggregation) {
+      case AggrOp::AGGR_SUM:
+      case AggrOp::AGGR_AVG: {
+        result.sums[i] += cell.attr_type() == INTS ? cell.get_int() : cell.get_float();
+      } break;
+      case AggrOp::AGGR_MAX:
+      case AggrOp::AGGR_MIN: {
+        Value &current = result.values[i];
+        if (current.attr_type() == UNDEFINED) {
+          current = cell;
+        } else {
+          const int cmp = cell.compare(current);
+          if ((aggregation == AggrOp::AGGR_MAX && cmp > 0) || (aggregation == AggrOp::AGGR_MIN && cmp < 0)) {
+            current = cell;
+          }
+        }
+      } break;
+      default: return RC::UNIMPLENMENT;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void ParallelTableScanPhysicalOperator::merge(const vector<PartialResult> &results)
+{
+  int64_t count = 0;
+  for (const PartialResult &result : results) {
+    count += result.count;
+  }
+
+  // 没有满足条件的记录时，除了 COUNT 之外的聚合结果都是空的
+  vector<Value> cells(aggregations_.size());
+  for (size_t i = 0; i < aggregations_.size(); i++) {
+    const AggrOp aggregation = aggregations_[i];
+    switch (aggregation) {
+      case AggrOp::AGGR_COUNT:
+      case AggrOp::AGGR_COUNT_ALL: {
+        cells[i].set_int(static_cast<int>(count));
+      } break;
+      case AggrOp::AGGR_SUM:
+      case AggrOp::AGGR_AVG: {
+        if (count == 0) {
+          break;
+        }
+        double sum = 0;
+        for (const PartialResult &result : results) {
+          if (!result.sums.empty()) {
+            sum += result.sums[i];
+          }
+        }
+        cells[i].set_float(static_cast<float>(aggregation == AggrOp::AGGR_SUM ? sum : sum / count));
+      } break;
+      case AggrOp::AGGR_MAX:
+      case AggrOp::AGGR_MIN: {
+        for (const PartialResult &result : results) {
+          if (result.values.empty() || result.values[i].attr_type() == UNDEFINED) {
+            continue;
+          }
+          const Value &value = result.values[i];
+          if (cells[i].attr_type() == UNDEFINED) {
+            cells[i] = value;
+            continue;
+          }
+          const int cmp = value.compare(cells[i]);
+          if ((aggregation == AggrOp::AGGR_MAX && cmp > 0) || (aggregation == AggrOp::AGGR_MIN && cmp < 0)) {
+            cells[i] = value;
+          }
+        }
+      } break;
+      default: break;
+    }
+  }
+  result_tuple_.set_cells(cells);
+}
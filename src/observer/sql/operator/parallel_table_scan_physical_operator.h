@@ -0,0 +1,134 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/rc.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/tuple.h"
+#include "sql/operator/physical_operator.h"
+#include "storage/record/record_manager.h"
+
+class Table;
+
+/**
+ * @brief 并行扫描的参数
+ * @ingroup PhysicalOperator
+ */
+struct ParallelScanParam
+{
+  int thread_num   = 4;   ///< 扫描一张表使用的线程个数，包括执行查询的线程。小于等于1时不使用并行扫描
+  int min_pages    = 64;  ///< 表至少有这么多个页面时才使用并行扫描，小表启动线程的代价比扫描还要大
+  int morsel_pages = 16;  ///< 每次分配给一个线程多少个连续的页面
+};
+
+/**
+ * @brief 并行表扫描物理算子
+ * @ingroup PhysicalOperator
+ * @details 把数据文件按照页号切分成若干个小块(morsel)，每块 ParallelScanParam::morsel_pages 个页面，
+ * 执行查询的线程和工作线程通过一个原子的游标领取下一块，各自使用独立的扫描器(参考 RecordFileScanner::open_scan
+ * 的页面范围)遍历块中的记录。过滤条件和聚合都在各个线程中完成，每个线程只维护自己的部分聚合结果，
+ * 所有的块都扫描完之后再合并成最终的结果。快的线程会多领几块，不会因为某个线程分到的数据多而拖慢整个查询。
+ *
+ * 当前只用于单表上的聚合查询(参考 PhysicalPlanGenerator)，输出一行聚合结果，
+ * 结果的类型与 AggregatePhysicalOperator 相同。
+ * 工作线程是所有查询共享的，只在CONCURRENCY编译模式下启动，否则所有的块都由执行查询的线程依次扫描。
+ */
+class ParallelTableScanPhysicalOperator : public PhysicalOperator
+{
+public:
+  ParallelTableScanPhysicalOperator(Table *table, const std::vector<Field> &fields);
+
+  virtual ~ParallelTableScanPhysicalOperator() = default;
+
+  /**
+   * @brief 设置参数并启动工作线程
+   */
+  static RC start_workers(const ParallelScanParam &param);
+
+  /**
+   * @brief 停止工作线程，需要在关闭数据库之前调用
+   */
+  static void stop_workers();
+
+  static const ParallelScanParam &scan_param();
+
+  /**
+   * @brief 是否支持这种聚合
+   * @details SUM 和 AVG 只支持数字类型，MIN 和 MAX 不支持变长字符串
+   */
+  static bool support_aggregation(AggrOp aggregation, AttrType attr_type);
+
+  std::string param() const override;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::PARALLEL_TABLE_SCAN; }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override { return &result_tuple_; }
+
+  void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs) { predicates_ = std::move(exprs); }
+
+  /**
+   * @brief 输出的每一列的聚合，参考 AggregateLogicalOperator::fields
+   */
+  void set_aggregations(const std::vector<Field> &aggregate_fields);
+
+private:
+  /**
+   * @brief 一个线程的部分聚合结果
+   */
+  struct PartialResult
+  {
+    int64_t             count         = 0;  ///< 满足条件的记录数
+    int                 morsels       = 0;  ///< 扫描了多少块
+    int64_t             skipped_pages = 0;  ///< 根据区域映射跳过的页面数
+    std::vector<double> sums;               ///< SUM 和 AVG 的累加值
+    std::vector<Value>  values;             ///< MIN 和 MAX 的当前值，没有记录时是 UNDEFINED
+  };
+
+  /**
+   * @brief 一个线程不停地领取下一块并扫描，直到所有的块都领完了或者有线程出错
+   */
+  RC scan_morsels(PartialResult &result);
+  RC scan_morsel(PageNum start_page, PageNum end_page, RowTuple &tuple, PartialResult &result);
+  RC accumulate(const RowTuple &tuple, PartialResult &result);
+
+  /**
+   * @brief 合并所有线程的部分聚合结果，生成输出的一行
+   */
+  void merge(const std::vector<PartialResult> &results);
+
+private:
+  Table                                   *table_ = nullptr;
+  Trx                                     *trx_   = nullptr;
+  std::vector<Field>                       fields_;        ///< 需要从表中读取的字段
+  std::vector<AggrOp>                      aggregations_;  ///< 每个输出列的聚合
+  std::vector<int>                         columns_;       ///< 每个输出列聚合的是表中的第几个字段
+  std::vector<std::unique_ptr<Expression>> predicates_;
+  ColumnScanSpec                           column_spec_;
+
+  PageNum              page_count_ = 0;  ///< 开始扫描时文件中的页面个数，之后新分配的页面不会扫描
+  std::atomic<PageNum> next_page_{0};    ///< 下一块的起始页号
+  std::atomic<bool>    failed_{false};   ///< 有线程出错时，其它线程不再领取新的块
+  bool                 emitted_ = false;
+  bool                 latched_ = false;  ///< open 时持有表的读锁，close 只释放自己持有的锁
+  ValueListTuple       result_tuple_;
+};
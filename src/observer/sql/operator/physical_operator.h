@@ -38,6 +38,7 @@ class Trx;
 enum class PhysicalOperatorType
 {
   TABLE_SCAN,
+  PARALLEL_TABLE_SCAN,
   INDEX_SCAN,
   NESTED_LOOP_JOIN,
   EXPLAIN,
@@ -20,50 +20,76 @@ using namespace std;
 
 RC TableScanPhysicalOperator::open(Trx *trx)
 {
-  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_);
+  ColumnScanSpec column_spec;
+  make_column_scan_spec(table_, fields_, predicates_, readonly_, column_spec);
+
+  // 扫描期间整理表不能搬动记录，close 时释放
+  table_->latch().lock_shared();
+  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_, &column_spec);
   if (rc == RC::SUCCESS) {
+    latched_ = true;
     tuple_.set_schema(table_, table_->table_meta().field_metas());
+  } else {
+    table_->latch().unlock_shared();
   }
-  trx_ = trx;
+  records_.clear();
+  record_index_   = 0;
+  current_record_ = nullptr;
+  trx_            = trx;
   return rc;
 }
 
 RC TableScanPhysicalOperator::next()
 {
-  if (!record_scanner_.has_next()) {
-    return RC::RECORD_EOF;
-  }
-
   RC   rc            = RC::SUCCESS;
   bool filter_result = false;
-  while (record_scanner_.has_next()) {
-    rc = record_scanner_.next(current_record_);
-    if (rc != RC::SUCCESS) {
-      return rc;
+  while (true) {
+    if (record_index_ >= records_.size()) {
+      // 只读扫描每次取一个页面上的所有记录。修改数据时插入记录可能会整理页面，挪动同一个页面上其它记录的位置，
+      // 所以每次只取一条
+      record_index_ = 0;
+      rc            = record_scanner_.next_batch(records_, readonly_ ? 0 : 1);
+      if (rc != RC::SUCCESS) {
+        current_record_ = nullptr;
+        return rc;
+      }
     }
 
-    tuple_.set_record(&current_record_);
-    rc = filter(tuple_, filter_result);
-    if (rc != RC::SUCCESS) {
-      return rc;
-    }
+    // 在当前这一批记录中查找满足条件的记录
+    for (; record_index_ < records_.size(); record_index_++) {
+      tuple_.set_record(&records_[record_index_]);
+      rc = filter(tuple_, filter_result);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
 
-    if (filter_result) {
-      sql_debug("get a tuple: %s", tuple_.to_string().c_str());
-      break;
-    } else {
+      if (filter_result) {
+        sql_debug("get a tuple: %s", tuple_.to_string().c_str());
+        current_record_ = &records_[record_index_++];
+        return rc;
+      }
       sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());
-      rc = RC::RECORD_EOF;
     }
   }
   return rc;
 }
 
-RC TableScanPhysicalOperator::close() { return record_scanner_.close_scan(); }
+RC TableScanPhysicalOperator::close()
+{
+  if (record_scanner_.skipped_pages() > 0) {
+    sql_debug("table %s skipped %ld pages by zone map", table_->name(), record_scanner_.skipped_pages());
+  }
+  RC rc = record_scanner_.close_scan();
+  if (latched_) {
+    latched_ = false;
+    table_->latch().unlock_shared();
+  }
+  return rc;
+}
 
 Tuple *TableScanPhysicalOperator::current_tuple()
 {
-  tuple_.set_record(&current_record_);
+  tuple_.set_record(current_record_);
   return &tuple_;
 }
 
@@ -74,6 +100,64 @@ void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&
   predicates_ = std::move(exprs);
 }
 
+void TableScanPhysicalOperator::make_column_scan_spec(const Table *table, const vector<Field> &fields,
+    const vector<unique_ptr<Expression>> &predicates, bool readonly, ColumnScanSpec &spec)
+{
+  const std::vector<FieldMeta> &field_metas = *table->table_meta().field_metas();
+  auto column_of = [&field_metas](const FieldMeta *field_meta) {
+    return static_cast<int>(field_meta - field_metas.data());
+  };
+
+  if (readonly) {
+    for (const Field &field : fields) {
+      spec.columns.push_back(column_of(field.meta()));
+    }
+  }
+
+  for (const unique_ptr<Expression> &expr : predicates) {
+    if (expr->type() != ExprType::COMPARISON) {
+      continue;
+    }
+
+    auto       *comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+    Expression *left            = comparison_expr->left().get();
+    Expression *right           = comparison_expr->right().get();
+    CompOp      comp            = comparison_expr->comp();
+    if (left->type() == ExprType::VALUE && right->type() == ExprType::FIELD) {
+      // 常量 op 字段 转换成 字段 op' 常量
+      std::swap(left, right);
+      switch (comp) {
+        case LESS_THAN: comp = GREAT_THAN; break;
+        case LESS_EQUAL: comp = GREAT_EQUAL; break;
+        case GREAT_THAN: comp = LESS_THAN; break;
+        case GREAT_EQUAL: comp = LESS_EQUAL; break;
+        default: break;
+      }
+    }
+    if (left->type() != ExprType::FIELD || right->type() != ExprType::VALUE) {
+      continue;
+    }
+
+    const FieldMeta *field_meta = static_cast<FieldExpr *>(left)->field().meta();
+    const Value     &value      = static_cast<ValueExpr *>(right)->get_value();
+    if (field_meta->type() != value.attr_type() ||
+        (value.attr_type() != INTS && value.attr_type() != DATES && value.attr_type() != CHARS)) {
+      continue;
+    }
+
+    ColumnFilter filter;
+    filter.column = column_of(field_meta);
+    filter.type   = value.attr_type();
+    filter.comp   = comp;
+    if (value.attr_type() == CHARS) {
+      filter.chars_value = value.get_string();
+    } else {
+      filter.value = value.attr_type() == INTS ? value.get_int() : value.get_date();
+    }
+    spec.filters.push_back(filter);
+  }
+}
+
 RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
 {
   RC    rc = RC::SUCCESS;
@@ -43,6 +43,20 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 上层算子需要的字段，按列存放的表扫描时只读取这些字段
+   */
+  void set_fields(const std::vector<Field> &fields) { fields_ = fields; }
+
+  /**
+   * @brief 根据需要的字段和过滤条件生成按列扫描的参数
+   * @details 只读扫描时只读取需要的字段，修改数据时需要完整的记录。
+   * 字段与常量之间的整数比较可以在页面上按列提前过滤，字符串比较在字典编码的页面上提前过滤，
+   * 其它条件仍然在 filter 中处理
+   */
+  static void make_column_scan_spec(const Table *table, const std::vector<Field> &fields,
+      const std::vector<std::unique_ptr<Expression>> &predicates, bool readonly, ColumnScanSpec &spec);
+
 private:
   RC filter(RowTuple &tuple, bool &result);
 
@@ -50,8 +64,12 @@ private:
   Table                                   *table_    = nullptr;
   Trx                                     *trx_      = nullptr;
   bool                                     readonly_ = false;
+  bool                                     latched_  = false;  ///< open 成功时持有表的读锁，close 只释放自己持有的锁
   RecordFileScanner                        record_scanner_;
-  Record                                   current_record_;
+  std::vector<Record>                      records_;           ///< 从扫描器中批量获取的记录
+  size_t                                   record_index_ = 0;  ///< 下一条要处理的记录在 records_ 中的位置
+  Record                                  *current_record_ = nullptr;
   RowTuple                                 tuple_;
   std::vector<std::unique_ptr<Expression>> predicates_;  // TODO chang predicate to table tuple filter
+  std::vector<Field>                       fields_;
 };
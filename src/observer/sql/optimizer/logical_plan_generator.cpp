@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/optimizer/logical_plan_generator.h"
 
 #include <common/log/log.h>
+#include <algorithm>
 
 #include "sql/operator/calc_logical_operator.h"
 #include "sql/operator/delete_logical_operator.h"
@@ -107,6 +108,23 @@ RC LogicalPlanGenerator::create_plan(SelectStmt *select_stmt, unique_ptr<Logical
       }
     }
 
+    // 过滤条件用到的字段也需要从表中读取出来，按列存放的表只会读取这些字段
+    if (select_stmt->filter_stmt() != nullptr) {
+      for (const FilterUnit *filter_unit : select_stmt->filter_stmt()->filter_units()) {
+        for (const FilterObj *filter_obj : {&filter_unit->left(), &filter_unit->right()}) {
+          if (!filter_obj->is_attr || 0 != strcmp(filter_obj->field.table_name(), table->name())) {
+            continue;
+          }
+          auto same_field = [filter_obj](const Field &field) {
+            return 0 == strcmp(field.field_name(), filter_obj->field.field_name());
+          };
+          if (std::none_of(fields.begin(), fields.end(), same_field)) {
+            fields.push_back(filter_obj->field);
+          }
+        }
+      }
+    }
+
     unique_ptr<LogicalOperator> table_get_oper(new TableGetLogicalOperator(table, fields, true /*readonly*/));
     if (table_oper == nullptr) {
       table_oper = std::move(table_get_oper);
@@ -29,6 +29,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/insert_physical_operator.h"
 #include "sql/operator/join_logical_operator.h"
 #include "sql/operator/join_physical_operator.h"
+#include "sql/operator/parallel_table_scan_physical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/predicate_physical_operator.h"
 #include "sql/operator/project_logical_operator.h"
@@ -38,6 +39,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/update_logical_operator.h"
 #include "sql/operator/update_physical_operator.h"
 #include "sql/optimizer/physical_plan_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
 #include "physical_plan_generator.h"
 
 using namespace std;
@@ -94,14 +97,19 @@ RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<P
   return rc;
 }
 
-RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper)
+/**
+ * @brief 看看是否有可以用于索引查找的表达式
+ *
+ * @param value_expr 返回索引查找使用的值
+ * @return Index* 没有可以使用的索引时返回nullptr
+ */
+static Index *find_index_for_predicates(TableGetLogicalOperator &table_get_oper, ValueExpr *&value_expr)
 {
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
-  // 看看是否有可以用于索引查找的表达式
-  Table *table = table_get_oper.table();
+  Table                          *table      = table_get_oper.table();
 
-  Index     *index      = nullptr;
-  ValueExpr *value_expr = nullptr;
+  Index *index = nullptr;
+  value_expr   = nullptr;
   for (auto &expr : predicates) {
     if (expr->type() == ExprType::COMPARISON) {
       auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
@@ -139,7 +147,16 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
       }
     }
   }
+  return index;
+}
 
+RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
+  Table                          *table      = table_get_oper.table();
+
+  ValueExpr *value_expr = nullptr;
+  Index     *index      = find_index_for_predicates(table_get_oper, value_expr);
   if (index != nullptr) {
     ASSERT(value_expr != nullptr, "got an index but value expr is null ?");
 
@@ -152,6 +169,7 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
     LOG_TRACE("use index scan");
   } else {
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.readonly());
+    table_scan_oper->set_fields(table_get_oper.fields());
     table_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(table_scan_oper);
     LOG_TRACE("use table scan");
@@ -335,6 +353,11 @@ RC PhysicalPlanGenerator::create_plan(AggregateLogicalOperator &logical_oper, st
   vector<unique_ptr<LogicalOperator>> &children_opers = logical_oper.children();
   ASSERT(children_opers.size() == 1,"aggregate logical operator's sub oper number should be 1");
 
+  if (create_parallel_scan_plan(logical_oper, oper)) {
+    LOG_TRACE("create a parallel table scan physical operator");
+    return RC::SUCCESS;
+  }
+
   LogicalOperator &child_oper = *children_opers.front();
 
   unique_ptr<PhysicalOperator> child_phy_oper;
@@ -359,4 +382,69 @@ RC PhysicalPlanGenerator::create_plan(AggregateLogicalOperator &logical_oper, st
 
   LOG_TRACE("create an aggregate physical operator");
   return rc;
-}
\ No newline at end of file
+}
+
+bool PhysicalPlanGenerator::create_parallel_scan_plan(
+    AggregateLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper)
+{
+  const ParallelScanParam &param = ParallelTableScanPhysicalOperator::scan_param();
+  if (param.thread_num <= 1) {
+    return false;
+  }
+
+  // 只处理单表上的聚合：aggregate -> project -> [predicate] -> table get
+  LogicalOperator &project_oper = *logical_oper.children().front();
+  if (project_oper.type() != LogicalOperatorType::PROJECTION || project_oper.children().size() != 1) {
+    return false;
+  }
+
+  LogicalOperator *child_oper = project_oper.children().front().get();
+  LogicalOperator *pred_oper  = nullptr;
+  if (child_oper->type() == LogicalOperatorType::PREDICATE) {
+    pred_oper = child_oper;
+    if (pred_oper->children().size() != 1) {
+      return false;
+    }
+    child_oper = pred_oper->children().front().get();
+  }
+  if (child_oper->type() != LogicalOperatorType::TABLE_GET) {
+    return false;
+  }
+
+  auto  &table_get_oper = static_cast<TableGetLogicalOperator &>(*child_oper);
+  Table *table          = table_get_oper.table();
+  if (!table_get_oper.readonly()) {
+    return false;
+  }
+
+  // 可以使用索引的等值查询只会访问很少的记录
+  ValueExpr *value_expr = nullptr;
+  if (find_index_for_predicates(table_get_oper, value_expr) != nullptr) {
+    return false;
+  }
+
+  if (table->data_buffer_pool()->allocated_pages() < param.min_pages) {
+    return false;
+  }
+
+  const vector<Field> &aggregate_fields = logical_oper.fields();
+  for (const Field &field : aggregate_fields) {
+    if (!ParallelTableScanPhysicalOperator::support_aggregation(field.aggregation(), field.attr_type())) {
+      return false;
+    }
+  }
+
+  // 没有下推到表上的过滤条件也在扫描的线程中处理
+  vector<unique_ptr<Expression>> predicates = std::move(table_get_oper.predicates());
+  if (pred_oper != nullptr) {
+    for (unique_ptr<Expression> &expr : pred_oper->expressions()) {
+      predicates.push_back(std::move(expr));
+    }
+  }
+
+  auto scan_oper = new ParallelTableScanPhysicalOperator(table, table_get_oper.fields());
+  scan_oper->set_aggregations(aggregate_fields);
+  scan_oper->set_predicates(std::move(predicates));
+  oper.reset(scan_oper);
+  return true;
+}
@@ -54,4 +54,10 @@ private:
   RC create_plan(JoinLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(CalcLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(AggregateLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+
+  /**
+   * @brief 单表上的聚合查询在表比较大时使用并行扫描，参考 ParallelTableScanPhysicalOperator
+   * @return bool 不满足并行扫描的条件时返回false，由调用者生成普通的执行计划
+   */
+  bool create_parallel_scan_plan(AggregateLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
 };
@@ -174,6 +174,16 @@ struct AttrInfoSqlNode
   size_t      length;  ///< Length of attribute
 };
 
+/**
+ * @brief 创建表时的一个选项，name=value
+ * @ingroup SQLParser
+ */
+struct TableOptionSqlNode
+{
+  std::string name;
+  std::string value;
+};
+
 /**
  * @brief 描述一个create table语句
  * @ingroup SQLParser
@@ -181,8 +191,9 @@ struct AttrInfoSqlNode
  */
 struct CreateTableSqlNode
 {
-  std::string                  relation_name;  ///< Relation name
-  std::vector<AttrInfoSqlNode> attr_infos;     ///< attributes
+  std::string                     relation_name;  ///< Relation name
+  std::vector<AttrInfoSqlNode>    attr_infos;     ///< attributes
+  std::vector<TableOptionSqlNode> options;        ///< 表的选项，WITH (format=pax, zone_map=true)
 };
 
 /**
@@ -227,6 +238,16 @@ struct DescTableSqlNode
   std::string relation_name;
 };
 
+/**
+ * @brief 描述一个vacuum table语句
+ * @ingroup SQLParser
+ * @details 整理表，回收删除的记录占用的空间，参考 Table::vacuum
+ */
+struct VacuumTableSqlNode
+{
+  std::string relation_name;
+};
+
 /**
  * @brief 描述一个load data语句
  * @ingroup SQLParser
@@ -293,7 +314,9 @@ enum SqlCommandFlag
   SCF_DROP_INDEX,
   SCF_SYNC,
   SCF_SHOW_TABLES,
+  SCF_SHOW_BUFFER_POOL_STATUS,  ///< 显示缓冲池的统计信息
   SCF_DESC_TABLE,
+  SCF_VACUUM_TABLE,  ///< 整理表
   SCF_BEGIN,  ///< 事务开始语句，可以在这里扩展只读事务
   SCF_COMMIT,
   SCF_CLOG_SYNC,
@@ -324,6 +347,7 @@ public:
   CreateIndexSqlNode  create_index;
   DropIndexSqlNode    drop_index;
   DescTableSqlNode    desc_table;
+  VacuumTableSqlNode  vacuum_table;
   LoadDataSqlNode     load_data;
   ExplainSqlNode      explain;
   SetVariableSqlNode  set_variable;
@@ -26,11 +26,12 @@ const char *ATTR_TYPE_NAME[] = {
     "dates",
     "floats",
     "booleans",
+    "varchars",
 };
 
 const char *attr_type_to_string(AttrType type)
 {
-  if (type >= UNDEFINED && type <= FLOATS) {
+  if (type >= UNDEFINED && type <= VARCHARS) {
     return ATTR_TYPE_NAME[type];
   }
   return "unknown";
@@ -210,6 +211,7 @@ void Value::set_value(const Value &value)
     case DATES: {
       set_date(value.get_date());
     }
+    case VARCHARS:
     case UNDEFINED: {
       ASSERT(false, "got an invalid value type");
     } break;
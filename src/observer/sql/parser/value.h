@@ -28,8 +28,12 @@ enum AttrType
   DATES,     ///< 新添加的类型
   FLOATS,    ///< 浮点数类型(4字节)
   BOOLEANS,  ///< boolean类型，当前不是由parser解析出来的，是程序内部使用的
+  VARCHARS,  ///< 变长字符串类型(varchar/text)，只用于字段定义，读出来的值是CHARS类型
 };
 
+static constexpr int VARCHAR_MAX_LENGTH = 65535;  ///< varchar 最多可以定义的长度
+static constexpr int TEXT_LENGTH        = 4096;   ///< text 类型以及不指定长度的 varchar 的长度
+
 const char *attr_type_to_string(AttrType type);
 AttrType    attr_type_from_string(const char *s);
 
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -110,7 +111,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 }
 
 
-#line 114 "yacc_sql.cpp"
+#line 115 "yacc_sql.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -133,146 +134,128 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_YACC_SQL_HPP_INCLUDED
-# define YY_YY_YACC_SQL_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SEMICOLON = 258,
-    COUNT_F = 259,
-    SUM_F = 260,
-    AVG_F = 261,
-    MAX_F = 262,
-    MIN_F = 263,
-    CREATE = 264,
-    DROP = 265,
-    TABLE = 266,
-    TABLES = 267,
-    INDEX = 268,
-    CALC = 269,
-    SELECT = 270,
-    DESC = 271,
-    SHOW = 272,
-    SYNC = 273,
-    INSERT = 274,
-    DELETE = 275,
-    UPDATE = 276,
-    LBRACE = 277,
-    RBRACE = 278,
-    COMMA = 279,
-    INNER = 280,
-    JOIN = 281,
-    TRX_BEGIN = 282,
-    TRX_COMMIT = 283,
-    TRX_ROLLBACK = 284,
-    INT_T = 285,
-    DATE_T = 286,
-    STRING_T = 287,
-    FLOAT_T = 288,
-    HELP = 289,
-    EXIT = 290,
-    DOT = 291,
-    INTO = 292,
-    VALUES = 293,
-    FROM = 294,
-    WHERE = 295,
-    AND = 296,
-    SET = 297,
-    ON = 298,
-    LOAD = 299,
-    DATA = 300,
-    INFILE = 301,
-    EXPLAIN = 302,
-    EQ = 303,
-    LT = 304,
-    GT = 305,
-    LE = 306,
-    GE = 307,
-    NE = 308,
-    NUMBER = 309,
-    FLOAT = 310,
-    ID = 311,
-    DATE_STR = 312,
-    SSS = 313,
-    UMINUS = 314
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-union YYSTYPE
+#include "yacc_sql.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 110 "yacc_sql.y"
-
-  ParsedSqlNode *                   sql_node;
-  ConditionSqlNode *                condition;
-  Value *                           value;
-  enum AggrOp                       aggr_op;
-  enum CompOp                       comp;
-  RelAttrSqlNode *                  rel_attr;
-  RelAttrSqlNode *                  rel_attr_aggr;
-  JoinSqlNode *                     join_attr;
-  std::vector<JoinSqlNode> *        join_list;
-  std::vector<AttrInfoSqlNode> *    attr_infos;
-  AttrInfoSqlNode *                 attr_info;
-  Expression *                      expression;
-  std::vector<Expression *> *       expression_list;
-  std::vector<Value> *              value_list;
-  std::vector<ConditionSqlNode> *   condition_list;
-  std::vector<RelAttrSqlNode> *     rel_attr_list;
-  std::vector<RelAttrSqlNode> *     rel_attr_aggr_list;
-  std::vector<std::string> *        relation_list;
-  char *                            string;
-  int                               number;
-  float                             floats;
-
-#line 250 "yacc_sql.cpp"
-
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SEMICOLON = 3,                  /* SEMICOLON  */
+  YYSYMBOL_COUNT_F = 4,                    /* COUNT_F  */
+  YYSYMBOL_SUM_F = 5,                      /* SUM_F  */
+  YYSYMBOL_AVG_F = 6,                      /* AVG_F  */
+  YYSYMBOL_MAX_F = 7,                      /* MAX_F  */
+  YYSYMBOL_MIN_F = 8,                      /* MIN_F  */
+  YYSYMBOL_CREATE = 9,                     /* CREATE  */
+  YYSYMBOL_DROP = 10,                      /* DROP  */
+  YYSYMBOL_TABLE = 11,                     /* TABLE  */
+  YYSYMBOL_TABLES = 12,                    /* TABLES  */
+  YYSYMBOL_INDEX = 13,                     /* INDEX  */
+  YYSYMBOL_CALC = 14,                      /* CALC  */
+  YYSYMBOL_SELECT = 15,                    /* SELECT  */
+  YYSYMBOL_DESC = 16,                      /* DESC  */
+  YYSYMBOL_SHOW = 17,                      /* SHOW  */
+  YYSYMBOL_SYNC = 18,                      /* SYNC  */
+  YYSYMBOL_INSERT = 19,                    /* INSERT  */
+  YYSYMBOL_DELETE = 20,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 21,                    /* UPDATE  */
+  YYSYMBOL_LBRACE = 22,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 23,                    /* RBRACE  */
+  YYSYMBOL_COMMA = 24,                     /* COMMA  */
+  YYSYMBOL_INNER = 25,                     /* INNER  */
+  YYSYMBOL_JOIN = 26,                      /* JOIN  */
+  YYSYMBOL_TRX_BEGIN = 27,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 28,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 29,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 30,                     /* INT_T  */
+  YYSYMBOL_DATE_T = 31,                    /* DATE_T  */
+  YYSYMBOL_STRING_T = 32,                  /* STRING_T  */
+  YYSYMBOL_FLOAT_T = 33,                   /* FLOAT_T  */
+  YYSYMBOL_HELP = 34,                      /* HELP  */
+  YYSYMBOL_EXIT = 35,                      /* EXIT  */
+  YYSYMBOL_DOT = 36,                       /* DOT  */
+  YYSYMBOL_INTO = 37,                      /* INTO  */
+  YYSYMBOL_VALUES = 38,                    /* VALUES  */
+  YYSYMBOL_FROM = 39,                      /* FROM  */
+  YYSYMBOL_WHERE = 40,                     /* WHERE  */
+  YYSYMBOL_AND = 41,                       /* AND  */
+  YYSYMBOL_SET = 42,                       /* SET  */
+  YYSYMBOL_ON = 43,                        /* ON  */
+  YYSYMBOL_LOAD = 44,                      /* LOAD  */
+  YYSYMBOL_DATA = 45,                      /* DATA  */
+  YYSYMBOL_INFILE = 46,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 47,                   /* EXPLAIN  */
+  YYSYMBOL_EQ = 48,                        /* EQ  */
+  YYSYMBOL_LT = 49,                        /* LT  */
+  YYSYMBOL_GT = 50,                        /* GT  */
+  YYSYMBOL_LE = 51,                        /* LE  */
+  YYSYMBOL_GE = 52,                        /* GE  */
+  YYSYMBOL_NE = 53,                        /* NE  */
+  YYSYMBOL_NUMBER = 54,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 55,                     /* FLOAT  */
+  YYSYMBOL_ID = 56,                        /* ID  */
+  YYSYMBOL_DATE_STR = 57,                  /* DATE_STR  */
+  YYSYMBOL_SSS = 58,                       /* SSS  */
+  YYSYMBOL_59_ = 59,                       /* '+'  */
+  YYSYMBOL_60_ = 60,                       /* '-'  */
+  YYSYMBOL_61_ = 61,                       /* '*'  */
+  YYSYMBOL_62_ = 62,                       /* '/'  */
+  YYSYMBOL_UMINUS = 63,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 64,                  /* $accept  */
+  YYSYMBOL_commands = 65,                  /* commands  */
+  YYSYMBOL_command_wrapper = 66,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 67,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 68,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 69,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 70,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 71,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 72,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 73,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 74,          /* show_tables_stmt  */
+  YYSYMBOL_show_buffer_pool_stmt = 75,     /* show_buffer_pool_stmt  */
+  YYSYMBOL_desc_table_stmt = 76,           /* desc_table_stmt  */
+  YYSYMBOL_vacuum_table_stmt = 77,         /* vacuum_table_stmt  */
+  YYSYMBOL_create_index_stmt = 78,         /* create_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 79,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 80,         /* create_table_stmt  */
+  YYSYMBOL_table_options = 81,             /* table_options  */
+  YYSYMBOL_table_option_list = 82,         /* table_option_list  */
+  YYSYMBOL_table_option = 83,              /* table_option  */
+  YYSYMBOL_attr_def_list = 84,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 85,                  /* attr_def  */
+  YYSYMBOL_number = 86,                    /* number  */
+  YYSYMBOL_type = 87,                      /* type  */
+  YYSYMBOL_insert_stmt = 88,               /* insert_stmt  */
+  YYSYMBOL_join_list = 89,                 /* join_list  */
+  YYSYMBOL_join_attr = 90,                 /* join_attr  */
+  YYSYMBOL_value_list = 91,                /* value_list  */
+  YYSYMBOL_value = 92,                     /* value  */
+  YYSYMBOL_delete_stmt = 93,               /* delete_stmt  */
+  YYSYMBOL_update_stmt = 94,               /* update_stmt  */
+  YYSYMBOL_select_stmt = 95,               /* select_stmt  */
+  YYSYMBOL_calc_stmt = 96,                 /* calc_stmt  */
+  YYSYMBOL_expression_list = 97,           /* expression_list  */
+  YYSYMBOL_expression = 98,                /* expression  */
+  YYSYMBOL_select_attr = 99,               /* select_attr  */
+  YYSYMBOL_aggr_op = 100,                  /* aggr_op  */
+  YYSYMBOL_rel_attr_aggr = 101,            /* rel_attr_aggr  */
+  YYSYMBOL_rel_attr_aggr_list = 102,       /* rel_attr_aggr_list  */
+  YYSYMBOL_rel_attr = 103,                 /* rel_attr  */
+  YYSYMBOL_attr_list = 104,                /* attr_list  */
+  YYSYMBOL_rel_list = 105,                 /* rel_list  */
+  YYSYMBOL_where = 106,                    /* where  */
+  YYSYMBOL_condition_list = 107,           /* condition_list  */
+  YYSYMBOL_condition = 108,                /* condition  */
+  YYSYMBOL_comp_op = 109,                  /* comp_op  */
+  YYSYMBOL_load_data_stmt = 110,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 111,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 112,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 113             /* opt_semicolon  */
 };
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
-
-
-
-int yyparse (const char * sql_string, ParsedSqlResult * sql_result, void * scanner);
-
-#endif /* !YY_YY_YACC_SQL_HPP_INCLUDED  */
 
 
 
@@ -313,6 +296,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -372,6 +367,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -390,6 +386,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -408,17 +405,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -447,7 +450,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -512,8 +515,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -579,27 +581,29 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  72
+#define YYFINAL  77
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   188
+#define YYLAST   203
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  64
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  45
+#define YYNNTS  50
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  109
+#define YYNRULES  119
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  200
+#define YYNSTATES  220
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   314
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -640,66 +644,66 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   192,   192,   200,   201,   202,   203,   204,   205,   206,
-     207,   208,   209,   210,   211,   212,   213,   214,   215,   216,
-     217,   218,   219,   223,   229,   234,   240,   246,   252,   258,
-     265,   271,   279,   293,   303,   323,   326,   339,   347,   357,
-     360,   361,   362,   363,   366,   383,   386,   391,   398,   406,
-     419,   422,   433,   437,   441,   447,   462,   474,   489,   517,
-     540,   550,   555,   566,   569,   572,   575,   578,   582,   585,
-     593,   600,   612,   615,   618,   621,   624,   630,   635,   640,
-     651,   654,   667,   672,   679,   687,   698,   701,   715,   718,
-     731,   734,   740,   743,   748,   755,   767,   779,   791,   806,
-     807,   808,   809,   810,   811,   815,   828,   836,   846,   847
+       0,   199,   199,   207,   208,   209,   210,   211,   212,   213,
+     214,   215,   216,   217,   218,   219,   220,   221,   222,   223,
+     224,   225,   226,   227,   228,   232,   238,   243,   249,   255,
+     261,   267,   274,   280,   294,   302,   318,   332,   342,   367,
+     370,   390,   393,   401,   412,   415,   428,   436,   446,   449,
+     450,   451,   452,   453,   466,   483,   486,   491,   498,   506,
+     519,   522,   533,   537,   541,   547,   562,   574,   589,   617,
+     640,   650,   655,   666,   669,   672,   675,   678,   682,   685,
+     693,   700,   712,   715,   718,   721,   724,   730,   735,   740,
+     751,   754,   767,   772,   779,   787,   798,   801,   815,   818,
+     831,   834,   840,   843,   848,   855,   867,   879,   891,   906,
+     907,   908,   909,   910,   911,   915,   928,   936,   946,   947
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SEMICOLON", "COUNT_F", "SUM_F", "AVG_F",
-  "MAX_F", "MIN_F", "CREATE", "DROP", "TABLE", "TABLES", "INDEX", "CALC",
-  "SELECT", "DESC", "SHOW", "SYNC", "INSERT", "DELETE", "UPDATE", "LBRACE",
-  "RBRACE", "COMMA", "INNER", "JOIN", "TRX_BEGIN", "TRX_COMMIT",
-  "TRX_ROLLBACK", "INT_T", "DATE_T", "STRING_T", "FLOAT_T", "HELP", "EXIT",
-  "DOT", "INTO", "VALUES", "FROM", "WHERE", "AND", "SET", "ON", "LOAD",
-  "DATA", "INFILE", "EXPLAIN", "EQ", "LT", "GT", "LE", "GE", "NE",
-  "NUMBER", "FLOAT", "ID", "DATE_STR", "SSS", "'+'", "'-'", "'*'", "'/'",
-  "UMINUS", "$accept", "commands", "command_wrapper", "exit_stmt",
+  "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "COUNT_F",
+  "SUM_F", "AVG_F", "MAX_F", "MIN_F", "CREATE", "DROP", "TABLE", "TABLES",
+  "INDEX", "CALC", "SELECT", "DESC", "SHOW", "SYNC", "INSERT", "DELETE",
+  "UPDATE", "LBRACE", "RBRACE", "COMMA", "INNER", "JOIN", "TRX_BEGIN",
+  "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "DATE_T", "STRING_T", "FLOAT_T",
+  "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM", "WHERE", "AND", "SET",
+  "ON", "LOAD", "DATA", "INFILE", "EXPLAIN", "EQ", "LT", "GT", "LE", "GE",
+  "NE", "NUMBER", "FLOAT", "ID", "DATE_STR", "SSS", "'+'", "'-'", "'*'",
+  "'/'", "UMINUS", "$accept", "commands", "command_wrapper", "exit_stmt",
   "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
-  "drop_table_stmt", "show_tables_stmt", "desc_table_stmt",
-  "create_index_stmt", "drop_index_stmt", "create_table_stmt",
-  "attr_def_list", "attr_def", "number", "type", "insert_stmt",
-  "join_list", "join_attr", "value_list", "value", "delete_stmt",
-  "update_stmt", "select_stmt", "calc_stmt", "expression_list",
-  "expression", "select_attr", "aggr_op", "rel_attr_aggr",
-  "rel_attr_aggr_list", "rel_attr", "attr_list", "rel_list", "where",
-  "condition_list", "condition", "comp_op", "load_data_stmt",
-  "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+  "drop_table_stmt", "show_tables_stmt", "show_buffer_pool_stmt",
+  "desc_table_stmt", "vacuum_table_stmt", "create_index_stmt",
+  "drop_index_stmt", "create_table_stmt", "table_options",
+  "table_option_list", "table_option", "attr_def_list", "attr_def",
+  "number", "type", "insert_stmt", "join_list", "join_attr", "value_list",
+  "value", "delete_stmt", "update_stmt", "select_stmt", "calc_stmt",
+  "expression_list", "expression", "select_attr", "aggr_op",
+  "rel_attr_aggr", "rel_attr_aggr_list", "rel_attr", "attr_list",
+  "rel_list", "where", "condition_list", "condition", "comp_op",
+  "load_data_stmt", "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,    43,
-      45,    42,    47,   314
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-160)
+#define YYPACT_NINF (-152)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -709,177 +713,189 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      74,    24,    27,    57,    -1,   -33,    20,  -160,    14,    15,
-       6,  -160,  -160,  -160,  -160,  -160,    25,    35,    74,    96,
-      94,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,    42,    54,    68,    69,    57,  -160,  -160,  -160,  -160,
-      57,  -160,  -160,    45,  -160,  -160,  -160,  -160,  -160,    77,
-    -160,    87,   105,   104,  -160,  -160,    73,    75,    88,    84,
-      89,  -160,  -160,  -160,  -160,   111,    91,  -160,    93,    16,
-    -160,    57,    57,    57,    57,    57,    81,    82,    26,     5,
-    -160,   101,   100,    85,    65,    86,    90,    92,    95,  -160,
-    -160,   -41,   -41,  -160,  -160,  -160,    28,   100,    46,  -160,
-     106,  -160,   119,   104,   123,    10,  -160,    99,  -160,   112,
-      12,   126,   130,  -160,    97,   128,   102,  -160,   102,   129,
-     103,   -25,   133,  -160,    65,   -23,   -23,  -160,   116,    65,
-     149,  -160,  -160,  -160,  -160,   141,    90,   142,   108,   143,
-     110,   144,   100,  -160,   114,  -160,   119,  -160,   147,  -160,
-    -160,  -160,  -160,  -160,  -160,    10,    10,    10,   100,   117,
-     118,   126,  -160,   145,  -160,   131,  -160,   132,  -160,    65,
-     153,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,   154,
-    -160,  -160,    10,    10,   147,  -160,  -160,  -160,  -160,  -160
+      91,    86,   102,    27,    -1,   -34,     2,  -152,   -11,    23,
+      -6,  -152,  -152,  -152,  -152,  -152,     7,    38,    91,    75,
+      89,    95,  -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,
+    -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,
+    -152,  -152,  -152,  -152,    46,    61,    65,    66,    27,  -152,
+    -152,  -152,  -152,    27,  -152,  -152,   -16,  -152,  -152,  -152,
+    -152,  -152,    87,  -152,    85,   105,   104,  -152,  -152,    73,
+      74,    76,    92,    83,    90,  -152,    81,  -152,  -152,  -152,
+     117,    97,  -152,    98,    18,  -152,    27,    27,    27,    27,
+      27,    88,    93,    -2,     5,  -152,  -152,   107,   103,    94,
+     -20,    84,  -152,    96,    99,   100,  -152,  -152,   -29,   -29,
+    -152,  -152,  -152,    15,   103,    32,  -152,   110,  -152,   124,
+     104,   129,    11,  -152,   106,  -152,   116,    -3,   133,   136,
+    -152,   108,   134,   109,  -152,   109,   135,   111,   -36,   139,
+    -152,   -20,    43,    43,  -152,   118,   -20,   152,  -152,  -152,
+    -152,  -152,  -152,   144,    96,   145,   115,   148,   119,   149,
+     103,  -152,   120,  -152,   124,  -152,   153,  -152,  -152,  -152,
+    -152,  -152,  -152,    11,    11,    11,   103,   122,   125,   133,
+     126,   150,  -152,   137,  -152,   138,  -152,   -20,   160,  -152,
+    -152,  -152,  -152,  -152,  -152,  -152,  -152,   161,  -152,   163,
+    -152,  -152,    11,    11,   153,  -152,  -152,   130,  -152,  -152,
+    -152,   140,   165,   131,   130,   167,  -152,   165,  -152,  -152
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    25,     0,     0,
-       0,    26,    27,    28,    24,    23,     0,     0,     0,     0,
-     108,    22,    21,    14,    15,    16,    17,     9,    10,    11,
-      12,    13,     8,     5,     7,     6,     4,     3,    18,    19,
-      20,     0,     0,     0,     0,     0,    52,    53,    55,    54,
-       0,    69,    60,    61,    72,    73,    74,    75,    76,    82,
-      70,     0,     0,    86,    31,    30,     0,     0,     0,     0,
-       0,   106,     1,   109,     2,     0,     0,    29,     0,     0,
-      68,     0,     0,     0,     0,     0,     0,    45,     0,     0,
-      71,     0,    90,     0,     0,     0,     0,     0,     0,    67,
-      62,    63,    64,    65,    66,    83,    88,    90,    46,    85,
-      78,    77,    80,    86,     0,    92,    56,     0,   107,     0,
-       0,    35,     0,    33,     0,     0,    45,    59,    45,     0,
-       0,     0,     0,    87,     0,     0,     0,    91,    93,     0,
-       0,    40,    43,    41,    42,    38,     0,     0,     0,    88,
-       0,     0,    90,    47,     0,    79,    80,    84,    50,    99,
-     100,   101,   102,   103,   104,     0,     0,    92,    90,     0,
-       0,    35,    34,     0,    89,     0,    58,     0,    81,     0,
-       0,    96,    98,    95,    97,    94,    57,   105,    39,     0,
-      36,    32,    92,    92,    50,    44,    37,    48,    49,    51
+       0,     0,     0,     0,     0,     0,     0,    27,     0,     0,
+       0,    28,    29,    30,    26,    25,     0,     0,     0,     0,
+       0,   118,    24,    23,    16,    17,    18,    19,     9,    10,
+      11,    12,    13,    14,    15,     8,     5,     7,     6,     4,
+       3,    20,    21,    22,     0,     0,     0,     0,     0,    62,
+      63,    65,    64,     0,    79,    70,    71,    82,    83,    84,
+      85,    86,    92,    80,     0,     0,    96,    34,    32,     0,
+       0,     0,     0,     0,     0,   116,     0,     1,   119,     2,
+       0,     0,    31,     0,     0,    78,     0,     0,     0,     0,
+       0,     0,    55,     0,     0,    81,    33,     0,   100,     0,
+       0,     0,    35,     0,     0,     0,    77,    72,    73,    74,
+      75,    76,    93,    98,   100,    56,    95,    88,    87,    90,
+      96,     0,   102,    66,     0,   117,     0,     0,    44,     0,
+      37,     0,     0,    55,    69,    55,     0,     0,     0,     0,
+      97,     0,     0,     0,   101,   103,     0,     0,    49,    52,
+      50,    51,    53,    47,     0,     0,     0,    98,     0,     0,
+     100,    57,     0,    89,    90,    94,    60,   109,   110,   111,
+     112,   113,   114,     0,     0,   102,   100,     0,     0,    44,
+      39,     0,    99,     0,    68,     0,    91,     0,     0,   106,
+     108,   105,   107,   104,    67,   115,    48,     0,    45,     0,
+      38,    36,   102,   102,    60,    54,    46,     0,    58,    59,
+      61,     0,    41,     0,     0,     0,    43,    41,    40,    42
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -160,  -160,   160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,     8,    34,  -160,  -160,  -160,
-     -78,  -160,   -13,   -93,  -160,  -160,  -160,  -160,   107,   -26,
-    -160,  -160,    51,    29,    -4,    70,    37,  -105,  -159,  -160,
-      48,  -160,  -160,  -160,  -160
+    -152,  -152,   173,  -152,  -152,  -152,  -152,  -152,  -152,  -152,
+    -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,   -25,   -21,
+      16,    40,  -152,  -152,  -152,   -19,  -152,    -8,   -99,  -152,
+    -152,  -152,  -152,   112,   -17,  -152,  -152,    59,    35,    -4,
+      80,    44,  -112,  -151,  -152,    60,  -152,  -152,  -152,  -152
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,   147,   121,   189,   145,    33,
-     107,   108,   180,    51,    34,    35,    36,    37,    52,    53,
-      61,    62,   112,   132,   136,    90,   126,   116,   137,   138,
-     165,    38,    39,    40,    74
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,   200,   215,   212,
+     155,   128,   197,   153,    36,   114,   115,   188,    54,    37,
+      38,    39,    40,    55,    56,    64,    65,   119,   139,   143,
+      95,   133,   123,   144,   145,   173,    41,    42,    43,    79
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      63,   118,   127,    54,    55,    56,    57,    58,   185,    54,
-      55,    56,    57,    58,    54,    55,    56,    57,    58,    79,
-      84,    85,   135,    64,    80,   159,   160,   161,   162,   163,
-     164,   110,    65,   197,   198,    41,   111,    42,    43,    99,
-      44,   158,   141,   142,   143,   144,   168,   176,   152,   109,
-     153,    66,   124,   125,    67,    59,   101,   102,   103,   104,
-      60,    59,    68,   186,    46,    47,    59,    48,    49,    81,
-     128,   129,   181,   183,   135,    82,    83,    84,    85,    45,
-      70,    69,   110,     1,     2,   113,   194,   111,     3,     4,
-       5,     6,     7,     8,     9,    10,    72,    73,    75,   135,
-     135,    11,    12,    13,    82,    83,    84,    85,    14,    15,
-      76,    46,    47,    86,    48,    49,    16,    50,    17,    46,
-      47,    18,    48,    49,    77,    78,    87,    88,    89,    91,
-      93,    92,    94,    96,    97,    95,    98,   105,   106,   114,
-     115,   117,   130,   131,   119,   134,   120,   139,   122,   140,
-     146,   123,   148,   149,   150,   154,   157,   167,   151,   155,
-     169,   182,   184,   170,   173,   172,   175,   124,   191,   125,
-     177,   179,   188,   187,   192,   193,   195,   196,    71,   190,
-     171,   199,   156,   133,   166,   178,   174,     0,   100
+      66,   125,   134,    57,    58,    59,    60,    61,    86,    57,
+      58,    59,    60,    61,    68,    57,    58,    59,    60,    61,
+     117,   116,    67,   142,   193,   118,    70,   148,   149,   150,
+     151,    84,    89,    90,    49,    50,    85,    51,    52,   131,
+     132,   106,   166,    87,    88,    89,    90,   176,   184,    48,
+      72,   208,   209,   152,   117,    62,   135,   136,    69,   118,
+      63,    62,    71,    73,   194,    49,    50,    62,    51,    52,
+     108,   109,   110,   111,   189,   191,   142,    87,    88,    89,
+      90,    49,    50,    74,    51,    52,    76,    53,   204,    77,
+     120,   167,   168,   169,   170,   171,   172,    44,    78,    45,
+       1,     2,    80,   142,   142,     3,     4,     5,     6,     7,
+       8,     9,    10,    46,   160,    47,   161,    81,    11,    12,
+      13,    82,    83,    91,    92,    14,    15,    93,    94,    96,
+      97,   100,    98,    16,    99,    17,   101,   102,    18,   103,
+     104,   105,   126,   122,   112,   121,   137,    19,   138,   113,
+     124,   141,   127,   147,   146,   129,   130,   154,   156,   175,
+     158,   162,   165,   177,   157,   159,   178,   163,   180,   190,
+     192,   181,   131,   201,   132,   183,   185,   187,   195,   196,
+     202,   203,   199,   205,   206,   207,   211,   216,   213,   214,
+     218,    75,   219,   217,   179,   198,   210,   164,   107,   186,
+     140,   182,     0,   174
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    94,   107,     4,     5,     6,     7,     8,   167,     4,
-       5,     6,     7,     8,     4,     5,     6,     7,     8,    45,
-      61,    62,   115,    56,    50,    48,    49,    50,    51,    52,
-      53,    56,    12,   192,   193,    11,    61,    13,    11,    23,
-      13,   134,    30,    31,    32,    33,   139,   152,   126,    23,
-     128,    37,    24,    25,    39,    56,    82,    83,    84,    85,
-      61,    56,    56,   168,    54,    55,    56,    57,    58,    24,
-      24,    25,   165,   166,   167,    59,    60,    61,    62,    22,
-      45,    56,    56,     9,    10,    89,   179,    61,    14,    15,
-      16,    17,    18,    19,    20,    21,     0,     3,    56,   192,
-     193,    27,    28,    29,    59,    60,    61,    62,    34,    35,
-      56,    54,    55,    36,    57,    58,    42,    60,    44,    54,
-      55,    47,    57,    58,    56,    56,    39,    22,    24,    56,
-      42,    56,    48,    22,    43,    46,    43,    56,    56,    38,
-      40,    56,    36,    24,    58,    22,    56,    48,    56,    37,
-      24,    56,    22,    56,    26,    26,    23,    41,    56,    56,
-      11,   165,   166,    22,    56,    23,    56,    24,    23,    25,
-      56,    24,    54,    56,    43,    43,    23,    23,    18,   171,
-     146,   194,   131,   113,   136,   156,   149,    -1,    81
+       4,   100,   114,     4,     5,     6,     7,     8,    24,     4,
+       5,     6,     7,     8,    12,     4,     5,     6,     7,     8,
+      56,    23,    56,   122,   175,    61,    37,    30,    31,    32,
+      33,    48,    61,    62,    54,    55,    53,    57,    58,    24,
+      25,    23,   141,    59,    60,    61,    62,   146,   160,    22,
+      56,   202,   203,    56,    56,    56,    24,    25,    56,    61,
+      61,    56,    39,    56,   176,    54,    55,    56,    57,    58,
+      87,    88,    89,    90,   173,   174,   175,    59,    60,    61,
+      62,    54,    55,    45,    57,    58,    11,    60,   187,     0,
+      94,    48,    49,    50,    51,    52,    53,    11,     3,    13,
+       9,    10,    56,   202,   203,    14,    15,    16,    17,    18,
+      19,    20,    21,    11,   133,    13,   135,    56,    27,    28,
+      29,    56,    56,    36,    39,    34,    35,    22,    24,    56,
+      56,    48,    56,    42,    42,    44,    46,    56,    47,    22,
+      43,    43,    58,    40,    56,    38,    36,    56,    24,    56,
+      56,    22,    56,    37,    48,    56,    56,    24,    22,    41,
+      26,    26,    23,    11,    56,    56,    22,    56,    23,   173,
+     174,    56,    24,    23,    25,    56,    56,    24,    56,    54,
+      43,    43,    56,    23,    23,    22,    56,    56,    48,    24,
+      23,    18,   217,   214,   154,   179,   204,   138,    86,   164,
+     120,   157,    -1,   143
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     9,    10,    14,    15,    16,    17,    18,    19,    20,
-      21,    27,    28,    29,    34,    35,    42,    44,    47,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,    83,    88,    89,    90,    91,   105,   106,
-     107,    11,    13,    11,    13,    22,    54,    55,    57,    58,
-      60,    87,    92,    93,     4,     5,     6,     7,     8,    56,
-      61,    94,    95,    98,    56,    12,    37,    39,    56,    56,
-      45,    66,     0,     3,   108,    56,    56,    56,    56,    93,
-      93,    24,    59,    60,    61,    62,    36,    39,    22,    24,
-      99,    56,    56,    42,    48,    46,    22,    43,    43,    23,
-      92,    93,    93,    93,    93,    56,    56,    84,    85,    23,
-      56,    61,    96,    98,    38,    40,   101,    56,    87,    58,
-      56,    80,    56,    56,    24,    25,   100,   101,    24,    25,
-      36,    24,    97,    99,    22,    87,    98,   102,   103,    48,
-      37,    30,    31,    32,    33,    82,    24,    79,    22,    56,
-      26,    56,    84,    84,    26,    56,    96,    23,    87,    48,
-      49,    50,    51,    52,    53,   104,   104,    41,    87,    11,
-      22,    80,    23,    56,   100,    56,   101,    56,    97,    24,
-      86,    87,    98,    87,    98,   102,   101,    56,    54,    81,
-      79,    23,    43,    43,    87,    23,    23,   102,   102,    86
+      21,    27,    28,    29,    34,    35,    42,    44,    47,    56,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    88,    93,    94,    95,
+      96,   110,   111,   112,    11,    13,    11,    13,    22,    54,
+      55,    57,    58,    60,    92,    97,    98,     4,     5,     6,
+       7,     8,    56,    61,    99,   100,   103,    56,    12,    56,
+      37,    39,    56,    56,    45,    66,    11,     0,     3,   113,
+      56,    56,    56,    56,    98,    98,    24,    59,    60,    61,
+      62,    36,    39,    22,    24,   104,    56,    56,    56,    42,
+      48,    46,    56,    22,    43,    43,    23,    97,    98,    98,
+      98,    98,    56,    56,    89,    90,    23,    56,    61,   101,
+     103,    38,    40,   106,    56,    92,    58,    56,    85,    56,
+      56,    24,    25,   105,   106,    24,    25,    36,    24,   102,
+     104,    22,    92,   103,   107,   108,    48,    37,    30,    31,
+      32,    33,    56,    87,    24,    84,    22,    56,    26,    56,
+      89,    89,    26,    56,   101,    23,    92,    48,    49,    50,
+      51,    52,    53,   109,   109,    41,    92,    11,    22,    85,
+      23,    56,   105,    56,   106,    56,   102,    24,    91,    92,
+     103,    92,   103,   107,   106,    56,    54,    86,    84,    56,
+      81,    23,    43,    43,    92,    23,    23,    22,   107,   107,
+      91,    56,    83,    48,    24,    82,    56,    83,    23,    82
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    64,    65,    66,    66,    66,    66,    66,    66,    66,
       66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    67,    68,    69,    70,    71,    72,    73,
-      74,    75,    76,    77,    78,    79,    79,    80,    80,    81,
-      82,    82,    82,    82,    83,    84,    84,    84,    85,    85,
-      86,    86,    87,    87,    87,    87,    88,    89,    90,    90,
-      91,    92,    92,    93,    93,    93,    93,    93,    93,    93,
-      94,    94,    95,    95,    95,    95,    95,    96,    96,    96,
-      97,    97,    98,    98,    98,    98,    99,    99,   100,   100,
-     101,   101,   102,   102,   102,   103,   103,   103,   103,   104,
-     104,   104,   104,   104,   104,   105,   106,   107,   108,   108
+      66,    66,    66,    66,    66,    67,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
+      81,    82,    82,    83,    84,    84,    85,    85,    86,    87,
+      87,    87,    87,    87,    88,    89,    89,    89,    90,    90,
+      91,    91,    92,    92,    92,    92,    93,    94,    95,    95,
+      96,    97,    97,    98,    98,    98,    98,    98,    98,    98,
+      99,    99,   100,   100,   100,   100,   100,   101,   101,   101,
+     102,   102,   103,   103,   103,   103,   104,   104,   105,   105,
+     106,   106,   107,   107,   107,   108,   108,   108,   108,   109,
+     109,   109,   109,   109,   109,   110,   111,   112,   113,   113
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       2,     2,     8,     5,     7,     0,     3,     5,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     2,     3,     2,     3,     8,     5,     8,     0,
+       5,     0,     3,     3,     0,     3,     5,     2,     1,     1,
        1,     1,     1,     1,     8,     0,     1,     3,     6,     6,
        0,     3,     1,     1,     1,     1,     4,     7,     7,     5,
        2,     1,     3,     3,     3,     3,     3,     3,     2,     1,
@@ -890,14 +906,15 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -919,10 +936,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -966,12 +982,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -999,24 +1022,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, sql_string, sql_result, scanner); \
+                  Kind, Value, Location, sql_string, sql_result, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -1027,22 +1058,19 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
-  YYUSE (sql_string);
-  YYUSE (sql_result);
-  YYUSE (scanner);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -1052,14 +1080,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp, sql_string, sql_result, scanner);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, sql_string, sql_result, scanner);
   YYFPRINTF (yyo, ")");
 }
 
@@ -1092,7 +1121,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -1104,9 +1134,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule,
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , sql_string, sql_result, scanner);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), sql_string, sql_result, scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1121,8 +1151,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1145,12 +1175,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1160,13 +1239,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1180,10 +1259,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1198,7 +1277,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1232,31 +1310,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1280,52 +1342,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1333,17 +1397,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1352,7 +1422,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1364,7 +1434,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1375,32 +1445,35 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (sql_string);
-  YYUSE (sql_result);
-  YYUSE (scanner);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1408,7 +1481,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1427,55 +1500,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1483,17 +1551,10 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1516,10 +1577,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1550,7 +1612,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1561,11 +1623,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1585,6 +1647,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1605,18 +1668,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1688,94 +1763,128 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 193 "yacc_sql.y"
+  case 2: /* commands: command_wrapper opt_semicolon  */
+#line 200 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1698 "yacc_sql.cpp"
+#line 1773 "yacc_sql.cpp"
     break;
 
-  case 23:
-#line 223 "yacc_sql.y"
+  case 25: /* exit_stmt: EXIT  */
+#line 232 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1707 "yacc_sql.cpp"
+#line 1782 "yacc_sql.cpp"
     break;
 
-  case 24:
-#line 229 "yacc_sql.y"
+  case 26: /* help_stmt: HELP  */
+#line 238 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1715 "yacc_sql.cpp"
+#line 1790 "yacc_sql.cpp"
     break;
 
-  case 25:
-#line 234 "yacc_sql.y"
+  case 27: /* sync_stmt: SYNC  */
+#line 243 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1723 "yacc_sql.cpp"
+#line 1798 "yacc_sql.cpp"
     break;
 
-  case 26:
-#line 240 "yacc_sql.y"
+  case 28: /* begin_stmt: TRX_BEGIN  */
+#line 249 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1731 "yacc_sql.cpp"
+#line 1806 "yacc_sql.cpp"
     break;
 
-  case 27:
-#line 246 "yacc_sql.y"
+  case 29: /* commit_stmt: TRX_COMMIT  */
+#line 255 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1739 "yacc_sql.cpp"
+#line 1814 "yacc_sql.cpp"
     break;
 
-  case 28:
-#line 252 "yacc_sql.y"
+  case 30: /* rollback_stmt: TRX_ROLLBACK  */
+#line 261 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1747 "yacc_sql.cpp"
+#line 1822 "yacc_sql.cpp"
     break;
 
-  case 29:
-#line 258 "yacc_sql.y"
+  case 31: /* drop_table_stmt: DROP TABLE ID  */
+#line 267 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1757 "yacc_sql.cpp"
+#line 1832 "yacc_sql.cpp"
     break;
 
-  case 30:
-#line 265 "yacc_sql.y"
+  case 32: /* show_tables_stmt: SHOW TABLES  */
+#line 274 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1765 "yacc_sql.cpp"
+#line 1840 "yacc_sql.cpp"
     break;
 
-  case 31:
-#line 271 "yacc_sql.y"
+  case 33: /* show_buffer_pool_stmt: SHOW ID ID  */
+#line 280 "yacc_sql.y"
+               {
+      // buffer_pool 和 status 不是关键字，避免影响使用这些名字的表和字段
+      bool valid = 0 == strcasecmp((yyvsp[-1].string), "buffer_pool") && 0 == strcasecmp((yyvsp[0].string), "status");
+      free((yyvsp[-1].string));
+      free((yyvsp[0].string));
+      if (!valid) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "unknown show command");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_BUFFER_POOL_STATUS);
+    }
+#line 1856 "yacc_sql.cpp"
+    break;
+
+  case 34: /* desc_table_stmt: DESC ID  */
+#line 294 "yacc_sql.y"
              {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1775 "yacc_sql.cpp"
+#line 1866 "yacc_sql.cpp"
     break;
 
-  case 32:
-#line 280 "yacc_sql.y"
+  case 35: /* vacuum_table_stmt: ID TABLE ID  */
+#line 302 "yacc_sql.y"
+                {
+      // vacuum 不是关键字，避免影响使用这个名字的表和字段
+      bool valid = 0 == strcasecmp((yyvsp[-2].string), "vacuum");
+      free((yyvsp[-2].string));
+      if (!valid) {
+        free((yyvsp[0].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "unknown command");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_VACUUM_TABLE);
+      (yyval.sql_node)->vacuum_table.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 1884 "yacc_sql.cpp"
+    break;
+
+  case 36: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE  */
+#line 319 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1786,11 +1895,11 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 1790 "yacc_sql.cpp"
+#line 1899 "yacc_sql.cpp"
     break;
 
-  case 33:
-#line 294 "yacc_sql.y"
+  case 37: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 333 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -1798,40 +1907,104 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 1802 "yacc_sql.cpp"
+#line 1911 "yacc_sql.cpp"
     break;
 
-  case 34:
-#line 304 "yacc_sql.y"
+  case 38: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE table_options  */
+#line 343 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
-      create_table.relation_name = (yyvsp[-4].string);
-      free((yyvsp[-4].string));
+      create_table.relation_name = (yyvsp[-5].string);
+      free((yyvsp[-5].string));
 
-      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-1].attr_infos);
+      if ((yyvsp[0].table_option_list) != nullptr) {
+        create_table.options.swap(*(yyvsp[0].table_option_list));
+        delete (yyvsp[0].table_option_list);
+      }
+
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-2].attr_infos);
 
       if (src_attrs != nullptr) {
         create_table.attr_infos.swap(*src_attrs);
         delete src_attrs;
       }
-      create_table.attr_infos.emplace_back(*(yyvsp[-2].attr_info));
+      create_table.attr_infos.emplace_back(*(yyvsp[-3].attr_info));
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
-      delete (yyvsp[-2].attr_info);
+      delete (yyvsp[-3].attr_info);
+    }
+#line 1937 "yacc_sql.cpp"
+    break;
+
+  case 39: /* table_options: %empty  */
+#line 367 "yacc_sql.y"
+    {
+      (yyval.table_option_list) = nullptr;
+    }
+#line 1945 "yacc_sql.cpp"
+    break;
+
+  case 40: /* table_options: ID LBRACE table_option table_option_list RBRACE  */
+#line 371 "yacc_sql.y"
+    {
+      // with 和选项的名字都不是关键字，避免影响使用这些名字的表和字段。选项的名字和取值由 CreateTableStmt 检查
+      bool valid = 0 == strcasecmp((yyvsp[-4].string), "with");
+      free((yyvsp[-4].string));
+      if (!valid) {
+        delete (yyvsp[-2].table_option);
+        delete (yyvsp[-1].table_option_list);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "unknown table option");
+        YYERROR;
+      }
+
+      (yyval.table_option_list) = (yyvsp[-1].table_option_list) != nullptr ? (yyvsp[-1].table_option_list) : new std::vector<TableOptionSqlNode>;
+      (yyval.table_option_list)->emplace_back(std::move(*(yyvsp[-2].table_option)));
+      std::reverse((yyval.table_option_list)->begin(), (yyval.table_option_list)->end());
+      delete (yyvsp[-2].table_option);
+    }
+#line 1966 "yacc_sql.cpp"
+    break;
+
+  case 41: /* table_option_list: %empty  */
+#line 390 "yacc_sql.y"
+    {
+      (yyval.table_option_list) = nullptr;
+    }
+#line 1974 "yacc_sql.cpp"
+    break;
+
+  case 42: /* table_option_list: COMMA table_option table_option_list  */
+#line 394 "yacc_sql.y"
+    {
+      (yyval.table_option_list) = (yyvsp[0].table_option_list) != nullptr ? (yyvsp[0].table_option_list) : new std::vector<TableOptionSqlNode>;
+      (yyval.table_option_list)->emplace_back(std::move(*(yyvsp[-1].table_option)));
+      delete (yyvsp[-1].table_option);
+    }
+#line 1984 "yacc_sql.cpp"
+    break;
+
+  case 43: /* table_option: ID EQ ID  */
+#line 402 "yacc_sql.y"
+    {
+      (yyval.table_option) = new TableOptionSqlNode;
+      (yyval.table_option)->name = (yyvsp[-2].string);
+      (yyval.table_option)->value = (yyvsp[0].string);
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
     }
-#line 1823 "yacc_sql.cpp"
+#line 1996 "yacc_sql.cpp"
     break;
 
-  case 35:
-#line 323 "yacc_sql.y"
+  case 44: /* attr_def_list: %empty  */
+#line 412 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 1831 "yacc_sql.cpp"
+#line 2004 "yacc_sql.cpp"
     break;
 
-  case 36:
-#line 327 "yacc_sql.y"
+  case 45: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 416 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -1841,11 +2014,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 1845 "yacc_sql.cpp"
+#line 2018 "yacc_sql.cpp"
     break;
 
-  case 37:
-#line 340 "yacc_sql.y"
+  case 46: /* attr_def: ID type LBRACE number RBRACE  */
+#line 429 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
@@ -1853,53 +2026,68 @@ yyreduce:
       (yyval.attr_info)->length = (yyvsp[-1].number);
       free((yyvsp[-4].string));
     }
-#line 1857 "yacc_sql.cpp"
+#line 2030 "yacc_sql.cpp"
     break;
 
-  case 38:
-#line 348 "yacc_sql.y"
+  case 47: /* attr_def: ID type  */
+#line 437 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
       (yyval.attr_info)->name = (yyvsp[-1].string);
-      (yyval.attr_info)->length = 4;
+      (yyval.attr_info)->length = ((yyval.attr_info)->type == VARCHARS) ? TEXT_LENGTH : 4;
       free((yyvsp[-1].string));
     }
-#line 1869 "yacc_sql.cpp"
+#line 2042 "yacc_sql.cpp"
     break;
 
-  case 39:
-#line 357 "yacc_sql.y"
+  case 48: /* number: NUMBER  */
+#line 446 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 1875 "yacc_sql.cpp"
+#line 2048 "yacc_sql.cpp"
     break;
 
-  case 40:
-#line 360 "yacc_sql.y"
+  case 49: /* type: INT_T  */
+#line 449 "yacc_sql.y"
                { (yyval.number)=INTS; }
-#line 1881 "yacc_sql.cpp"
+#line 2054 "yacc_sql.cpp"
     break;
 
-  case 41:
-#line 361 "yacc_sql.y"
+  case 50: /* type: STRING_T  */
+#line 450 "yacc_sql.y"
                { (yyval.number)=CHARS; }
-#line 1887 "yacc_sql.cpp"
+#line 2060 "yacc_sql.cpp"
     break;
 
-  case 42:
-#line 362 "yacc_sql.y"
+  case 51: /* type: FLOAT_T  */
+#line 451 "yacc_sql.y"
                { (yyval.number)=FLOATS; }
-#line 1893 "yacc_sql.cpp"
+#line 2066 "yacc_sql.cpp"
     break;
 
-  case 43:
-#line 363 "yacc_sql.y"
+  case 52: /* type: DATE_T  */
+#line 452 "yacc_sql.y"
                { (yyval.number)=DATES; }
-#line 1899 "yacc_sql.cpp"
+#line 2072 "yacc_sql.cpp"
     break;
 
-  case 44:
-#line 367 "yacc_sql.y"
+  case 53: /* type: ID  */
+#line 454 "yacc_sql.y"
+    {
+      // varchar 和 text 不是关键字，避免影响使用这些名字的表和字段
+      bool valid = 0 == strcasecmp((yyvsp[0].string), "varchar") || 0 == strcasecmp((yyvsp[0].string), "text");
+      free((yyvsp[0].string));
+      if (!valid) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "unknown type");
+        YYERROR;
+      }
+      (yyval.number)=VARCHARS;
+    }
+#line 2087 "yacc_sql.cpp"
+    break;
+
+  case 54: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
+#line 467 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
@@ -1912,39 +2100,39 @@ yyreduce:
       delete (yyvsp[-2].value);
       free((yyvsp[-5].string));
     }
-#line 1916 "yacc_sql.cpp"
+#line 2104 "yacc_sql.cpp"
     break;
 
-  case 45:
-#line 383 "yacc_sql.y"
+  case 55: /* join_list: %empty  */
+#line 483 "yacc_sql.y"
     {
       (yyval.join_list) = nullptr;
     }
-#line 1924 "yacc_sql.cpp"
+#line 2112 "yacc_sql.cpp"
     break;
 
-  case 46:
-#line 386 "yacc_sql.y"
+  case 56: /* join_list: join_attr  */
+#line 486 "yacc_sql.y"
                 {
       (yyval.join_list) = new std::vector<JoinSqlNode>;
       (yyval.join_list)->emplace_back(*(yyvsp[0].join_attr));
       delete (yyvsp[0].join_attr);
     }
-#line 1934 "yacc_sql.cpp"
+#line 2122 "yacc_sql.cpp"
     break;
 
-  case 47:
-#line 391 "yacc_sql.y"
+  case 57: /* join_list: join_attr COMMA join_list  */
+#line 491 "yacc_sql.y"
                                 {
       (yyval.join_list) = (yyvsp[0].join_list);
       (yyval.join_list)->emplace_back(*(yyvsp[-2].join_attr));
       delete (yyvsp[-2].join_attr);
     }
-#line 1944 "yacc_sql.cpp"
+#line 2132 "yacc_sql.cpp"
     break;
 
-  case 48:
-#line 398 "yacc_sql.y"
+  case 58: /* join_attr: ID INNER JOIN ID ON condition_list  */
+#line 498 "yacc_sql.y"
                                       {
       (yyval.join_attr) = new JoinSqlNode;
       (yyval.join_attr)->relations.emplace_back((yyvsp[-5].string));
@@ -1953,11 +2141,11 @@ yyreduce:
       free((yyvsp[-2].string));
       (yyval.join_attr)->conditions=(*(yyvsp[0].condition_list));
     }
-#line 1957 "yacc_sql.cpp"
+#line 2145 "yacc_sql.cpp"
     break;
 
-  case 49:
-#line 406 "yacc_sql.y"
+  case 59: /* join_attr: join_attr INNER JOIN ID ON condition_list  */
+#line 506 "yacc_sql.y"
                                                {
       if((yyvsp[-5].join_attr) != nullptr){
         (yyval.join_attr)=(yyvsp[-5].join_attr);
@@ -1968,19 +2156,19 @@ yyreduce:
       free((yyvsp[-2].string));
       (yyval.join_attr)->conditions.insert((yyval.join_attr)->conditions.end(),(yyvsp[0].condition_list)->begin(),(yyvsp[0].condition_list)->end());
     }
-#line 1972 "yacc_sql.cpp"
+#line 2160 "yacc_sql.cpp"
     break;
 
-  case 50:
-#line 419 "yacc_sql.y"
+  case 60: /* value_list: %empty  */
+#line 519 "yacc_sql.y"
     {
       (yyval.value_list) = nullptr;
     }
-#line 1980 "yacc_sql.cpp"
+#line 2168 "yacc_sql.cpp"
     break;
 
-  case 51:
-#line 422 "yacc_sql.y"
+  case 61: /* value_list: COMMA value value_list  */
+#line 522 "yacc_sql.y"
                               { 
       if ((yyvsp[0].value_list) != nullptr) {
         (yyval.value_list) = (yyvsp[0].value_list);
@@ -1990,40 +2178,40 @@ yyreduce:
       (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 1994 "yacc_sql.cpp"
+#line 2182 "yacc_sql.cpp"
     break;
 
-  case 52:
-#line 433 "yacc_sql.y"
+  case 62: /* value: NUMBER  */
+#line 533 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2003 "yacc_sql.cpp"
+#line 2191 "yacc_sql.cpp"
     break;
 
-  case 53:
-#line 437 "yacc_sql.y"
+  case 63: /* value: FLOAT  */
+#line 537 "yacc_sql.y"
            {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2012 "yacc_sql.cpp"
+#line 2200 "yacc_sql.cpp"
     break;
 
-  case 54:
-#line 441 "yacc_sql.y"
+  case 64: /* value: SSS  */
+#line 541 "yacc_sql.y"
          {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
       free((yyvsp[0].string));
     }
-#line 2023 "yacc_sql.cpp"
+#line 2211 "yacc_sql.cpp"
     break;
 
-  case 55:
-#line 447 "yacc_sql.y"
+  case 65: /* value: DATE_STR  */
+#line 547 "yacc_sql.y"
               {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       Value* v=new Value(tmp,strlen(tmp),1);
@@ -2036,11 +2224,11 @@ yyreduce:
       free(tmp);
       free((yyvsp[0].string));
     }
-#line 2040 "yacc_sql.cpp"
+#line 2228 "yacc_sql.cpp"
     break;
 
-  case 56:
-#line 463 "yacc_sql.y"
+  case 66: /* delete_stmt: DELETE FROM ID where  */
+#line 563 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2050,11 +2238,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2054 "yacc_sql.cpp"
+#line 2242 "yacc_sql.cpp"
     break;
 
-  case 57:
-#line 475 "yacc_sql.y"
+  case 67: /* update_stmt: UPDATE ID SET ID EQ value where  */
+#line 575 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-5].string);
@@ -2067,11 +2255,11 @@ yyreduce:
       free((yyvsp[-5].string));
       free((yyvsp[-3].string));
     }
-#line 2071 "yacc_sql.cpp"
+#line 2259 "yacc_sql.cpp"
     break;
 
-  case 58:
-#line 490 "yacc_sql.y"
+  case 68: /* select_stmt: SELECT select_attr FROM ID rel_list join_list where  */
+#line 590 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
       if ((yyvsp[-5].rel_attr_list) != nullptr) {
@@ -2099,11 +2287,11 @@ yyreduce:
         delete (yyvsp[-1].join_list);
       }
     }
-#line 2103 "yacc_sql.cpp"
+#line 2291 "yacc_sql.cpp"
     break;
 
-  case 59:
-#line 518 "yacc_sql.y"
+  case 69: /* select_stmt: SELECT select_attr FROM join_list where  */
+#line 618 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
       if ((yyvsp[-3].rel_attr_list) != nullptr) {
@@ -2124,31 +2312,31 @@ yyreduce:
         delete (yyvsp[-1].join_list);
       }
     }
-#line 2128 "yacc_sql.cpp"
+#line 2316 "yacc_sql.cpp"
     break;
 
-  case 60:
-#line 541 "yacc_sql.y"
+  case 70: /* calc_stmt: CALC expression_list  */
+#line 641 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       std::reverse((yyvsp[0].expression_list)->begin(), (yyvsp[0].expression_list)->end());
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2139 "yacc_sql.cpp"
+#line 2327 "yacc_sql.cpp"
     break;
 
-  case 61:
-#line 551 "yacc_sql.y"
+  case 71: /* expression_list: expression  */
+#line 651 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<Expression*>;
       (yyval.expression_list)->emplace_back((yyvsp[0].expression));
     }
-#line 2148 "yacc_sql.cpp"
+#line 2336 "yacc_sql.cpp"
     break;
 
-  case 62:
-#line 556 "yacc_sql.y"
+  case 72: /* expression_list: expression COMMA expression_list  */
+#line 656 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2157,70 +2345,70 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-2].expression));
     }
-#line 2161 "yacc_sql.cpp"
+#line 2349 "yacc_sql.cpp"
     break;
 
-  case 63:
-#line 566 "yacc_sql.y"
+  case 73: /* expression: expression '+' expression  */
+#line 666 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2169 "yacc_sql.cpp"
+#line 2357 "yacc_sql.cpp"
     break;
 
-  case 64:
-#line 569 "yacc_sql.y"
+  case 74: /* expression: expression '-' expression  */
+#line 669 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2177 "yacc_sql.cpp"
+#line 2365 "yacc_sql.cpp"
     break;
 
-  case 65:
-#line 572 "yacc_sql.y"
+  case 75: /* expression: expression '*' expression  */
+#line 672 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2185 "yacc_sql.cpp"
+#line 2373 "yacc_sql.cpp"
     break;
 
-  case 66:
-#line 575 "yacc_sql.y"
+  case 76: /* expression: expression '/' expression  */
+#line 675 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2193 "yacc_sql.cpp"
+#line 2381 "yacc_sql.cpp"
     break;
 
-  case 67:
-#line 578 "yacc_sql.y"
+  case 77: /* expression: LBRACE expression RBRACE  */
+#line 678 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2202 "yacc_sql.cpp"
+#line 2390 "yacc_sql.cpp"
     break;
 
-  case 68:
-#line 582 "yacc_sql.y"
+  case 78: /* expression: '-' expression  */
+#line 682 "yacc_sql.y"
                                   {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2210 "yacc_sql.cpp"
+#line 2398 "yacc_sql.cpp"
     break;
 
-  case 69:
-#line 585 "yacc_sql.y"
+  case 79: /* expression: value  */
+#line 685 "yacc_sql.y"
             {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2220 "yacc_sql.cpp"
+#line 2408 "yacc_sql.cpp"
     break;
 
-  case 70:
-#line 593 "yacc_sql.y"
+  case 80: /* select_attr: '*'  */
+#line 693 "yacc_sql.y"
         {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       RelAttrSqlNode attr;
@@ -2228,11 +2416,11 @@ yyreduce:
       attr.attribute_name = "*";
       (yyval.rel_attr_list)->emplace_back(attr);
     }
-#line 2232 "yacc_sql.cpp"
+#line 2420 "yacc_sql.cpp"
     break;
 
-  case 71:
-#line 600 "yacc_sql.y"
+  case 81: /* select_attr: rel_attr attr_list  */
+#line 700 "yacc_sql.y"
                          {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2242,71 +2430,71 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2246 "yacc_sql.cpp"
+#line 2434 "yacc_sql.cpp"
     break;
 
-  case 72:
-#line 612 "yacc_sql.y"
+  case 82: /* aggr_op: COUNT_F  */
+#line 712 "yacc_sql.y"
             {
       (yyval.aggr_op) = AGGR_COUNT;
     }
-#line 2254 "yacc_sql.cpp"
+#line 2442 "yacc_sql.cpp"
     break;
 
-  case 73:
-#line 615 "yacc_sql.y"
+  case 83: /* aggr_op: SUM_F  */
+#line 715 "yacc_sql.y"
            { 
       (yyval.aggr_op) = AGGR_SUM;
     }
-#line 2262 "yacc_sql.cpp"
+#line 2450 "yacc_sql.cpp"
     break;
 
-  case 74:
-#line 618 "yacc_sql.y"
+  case 84: /* aggr_op: AVG_F  */
+#line 718 "yacc_sql.y"
             {
       (yyval.aggr_op) = AGGR_AVG;
     }
-#line 2270 "yacc_sql.cpp"
+#line 2458 "yacc_sql.cpp"
     break;
 
-  case 75:
-#line 621 "yacc_sql.y"
+  case 85: /* aggr_op: MAX_F  */
+#line 721 "yacc_sql.y"
             {
       (yyval.aggr_op) = AGGR_MAX;
     }
-#line 2278 "yacc_sql.cpp"
+#line 2466 "yacc_sql.cpp"
     break;
 
-  case 76:
-#line 624 "yacc_sql.y"
+  case 86: /* aggr_op: MIN_F  */
+#line 724 "yacc_sql.y"
             {
       (yyval.aggr_op) = AGGR_MIN;
     }
-#line 2286 "yacc_sql.cpp"
+#line 2474 "yacc_sql.cpp"
     break;
 
-  case 77:
-#line 630 "yacc_sql.y"
+  case 87: /* rel_attr_aggr: '*'  */
+#line 730 "yacc_sql.y"
      {
     (yyval.rel_attr_aggr) = new RelAttrSqlNode;
     (yyval.rel_attr_aggr) -> relation_name = "";
     (yyval.rel_attr_aggr) -> attribute_name = "*";
   }
-#line 2296 "yacc_sql.cpp"
+#line 2484 "yacc_sql.cpp"
     break;
 
-  case 78:
-#line 635 "yacc_sql.y"
+  case 88: /* rel_attr_aggr: ID  */
+#line 735 "yacc_sql.y"
        {
     (yyval.rel_attr_aggr) = new RelAttrSqlNode;
     (yyval.rel_attr_aggr)->attribute_name = (yyvsp[0].string);
     free((yyvsp[0].string));
   }
-#line 2306 "yacc_sql.cpp"
+#line 2494 "yacc_sql.cpp"
     break;
 
-  case 79:
-#line 640 "yacc_sql.y"
+  case 89: /* rel_attr_aggr: ID DOT ID  */
+#line 740 "yacc_sql.y"
               {
     (yyval.rel_attr_aggr) = new RelAttrSqlNode;
     (yyval.rel_attr_aggr)->relation_name  = (yyvsp[-2].string);
@@ -2314,19 +2502,19 @@ yyreduce:
     free((yyvsp[-2].string));
     free((yyvsp[0].string));
   }
-#line 2318 "yacc_sql.cpp"
+#line 2506 "yacc_sql.cpp"
     break;
 
-  case 80:
-#line 651 "yacc_sql.y"
+  case 90: /* rel_attr_aggr_list: %empty  */
+#line 751 "yacc_sql.y"
     {
       (yyval.rel_attr_aggr_list) = nullptr;
     }
-#line 2326 "yacc_sql.cpp"
+#line 2514 "yacc_sql.cpp"
     break;
 
-  case 81:
-#line 654 "yacc_sql.y"
+  case 91: /* rel_attr_aggr_list: COMMA rel_attr_aggr rel_attr_aggr_list  */
+#line 754 "yacc_sql.y"
                                              {
       if ((yyvsp[0].rel_attr_aggr_list) != nullptr) {
         (yyval.rel_attr_aggr_list) = (yyvsp[0].rel_attr_aggr_list);
@@ -2337,21 +2525,21 @@ yyreduce:
       (yyval.rel_attr_aggr_list)->emplace_back(*(yyvsp[-1].rel_attr_aggr));
       delete (yyvsp[-1].rel_attr_aggr);
     }
-#line 2341 "yacc_sql.cpp"
+#line 2529 "yacc_sql.cpp"
     break;
 
-  case 82:
-#line 667 "yacc_sql.y"
+  case 92: /* rel_attr: ID  */
+#line 767 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2351 "yacc_sql.cpp"
+#line 2539 "yacc_sql.cpp"
     break;
 
-  case 83:
-#line 672 "yacc_sql.y"
+  case 93: /* rel_attr: ID DOT ID  */
+#line 772 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2359,11 +2547,11 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2363 "yacc_sql.cpp"
+#line 2551 "yacc_sql.cpp"
     break;
 
-  case 84:
-#line 679 "yacc_sql.y"
+  case 94: /* rel_attr: aggr_op LBRACE rel_attr_aggr rel_attr_aggr_list RBRACE  */
+#line 779 "yacc_sql.y"
                                                             {
       (yyval.rel_attr) = (yyvsp[-2].rel_attr_aggr);
       (yyval.rel_attr) -> aggregation = (yyvsp[-4].aggr_op);
@@ -2372,11 +2560,11 @@ yyreduce:
         delete (yyvsp[-1].rel_attr_aggr_list);
       }
     }
-#line 2376 "yacc_sql.cpp"
+#line 2564 "yacc_sql.cpp"
     break;
 
-  case 85:
-#line 687 "yacc_sql.y"
+  case 95: /* rel_attr: aggr_op LBRACE RBRACE  */
+#line 787 "yacc_sql.y"
                            {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr) -> relation_name = "";
@@ -2384,19 +2572,19 @@ yyreduce:
       (yyval.rel_attr) -> aggregation = (yyvsp[-2].aggr_op);
       (yyval.rel_attr) -> valid = false;
     }
-#line 2388 "yacc_sql.cpp"
+#line 2576 "yacc_sql.cpp"
     break;
 
-  case 86:
-#line 698 "yacc_sql.y"
+  case 96: /* attr_list: %empty  */
+#line 798 "yacc_sql.y"
     {
       (yyval.rel_attr_list) = nullptr;
     }
-#line 2396 "yacc_sql.cpp"
+#line 2584 "yacc_sql.cpp"
     break;
 
-  case 87:
-#line 701 "yacc_sql.y"
+  case 97: /* attr_list: COMMA rel_attr attr_list  */
+#line 801 "yacc_sql.y"
                                {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2407,19 +2595,19 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2411 "yacc_sql.cpp"
+#line 2599 "yacc_sql.cpp"
     break;
 
-  case 88:
-#line 715 "yacc_sql.y"
+  case 98: /* rel_list: %empty  */
+#line 815 "yacc_sql.y"
     {
       (yyval.relation_list) = nullptr;
     }
-#line 2419 "yacc_sql.cpp"
+#line 2607 "yacc_sql.cpp"
     break;
 
-  case 89:
-#line 718 "yacc_sql.y"
+  case 99: /* rel_list: COMMA ID rel_list  */
+#line 818 "yacc_sql.y"
                         {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2430,55 +2618,55 @@ yyreduce:
       (yyval.relation_list)->push_back((yyvsp[-1].string));
       free((yyvsp[-1].string));
     }
-#line 2434 "yacc_sql.cpp"
+#line 2622 "yacc_sql.cpp"
     break;
 
-  case 90:
-#line 731 "yacc_sql.y"
+  case 100: /* where: %empty  */
+#line 831 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2442 "yacc_sql.cpp"
+#line 2630 "yacc_sql.cpp"
     break;
 
-  case 91:
-#line 734 "yacc_sql.y"
+  case 101: /* where: WHERE condition_list  */
+#line 834 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 2450 "yacc_sql.cpp"
+#line 2638 "yacc_sql.cpp"
     break;
 
-  case 92:
-#line 740 "yacc_sql.y"
+  case 102: /* condition_list: %empty  */
+#line 840 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2458 "yacc_sql.cpp"
+#line 2646 "yacc_sql.cpp"
     break;
 
-  case 93:
-#line 743 "yacc_sql.y"
+  case 103: /* condition_list: condition  */
+#line 843 "yacc_sql.y"
                 {
       (yyval.condition_list) = new std::vector<ConditionSqlNode>;
       (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 2468 "yacc_sql.cpp"
+#line 2656 "yacc_sql.cpp"
     break;
 
-  case 94:
-#line 748 "yacc_sql.y"
+  case 104: /* condition_list: condition AND condition_list  */
+#line 848 "yacc_sql.y"
                                    {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 2478 "yacc_sql.cpp"
+#line 2666 "yacc_sql.cpp"
     break;
 
-  case 95:
-#line 756 "yacc_sql.y"
+  case 105: /* condition: rel_attr comp_op value  */
+#line 856 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2490,11 +2678,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].value);
     }
-#line 2494 "yacc_sql.cpp"
+#line 2682 "yacc_sql.cpp"
     break;
 
-  case 96:
-#line 768 "yacc_sql.y"
+  case 106: /* condition: value comp_op value  */
+#line 868 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2506,11 +2694,11 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].value);
     }
-#line 2510 "yacc_sql.cpp"
+#line 2698 "yacc_sql.cpp"
     break;
 
-  case 97:
-#line 780 "yacc_sql.y"
+  case 107: /* condition: rel_attr comp_op rel_attr  */
+#line 880 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2522,11 +2710,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].rel_attr);
     }
-#line 2526 "yacc_sql.cpp"
+#line 2714 "yacc_sql.cpp"
     break;
 
-  case 98:
-#line 792 "yacc_sql.y"
+  case 108: /* condition: value comp_op rel_attr  */
+#line 892 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2538,47 +2726,47 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].rel_attr);
     }
-#line 2542 "yacc_sql.cpp"
+#line 2730 "yacc_sql.cpp"
     break;
 
-  case 99:
-#line 806 "yacc_sql.y"
+  case 109: /* comp_op: EQ  */
+#line 906 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 2548 "yacc_sql.cpp"
+#line 2736 "yacc_sql.cpp"
     break;
 
-  case 100:
-#line 807 "yacc_sql.y"
+  case 110: /* comp_op: LT  */
+#line 907 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 2554 "yacc_sql.cpp"
+#line 2742 "yacc_sql.cpp"
     break;
 
-  case 101:
-#line 808 "yacc_sql.y"
+  case 111: /* comp_op: GT  */
+#line 908 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 2560 "yacc_sql.cpp"
+#line 2748 "yacc_sql.cpp"
     break;
 
-  case 102:
-#line 809 "yacc_sql.y"
+  case 112: /* comp_op: LE  */
+#line 909 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 2566 "yacc_sql.cpp"
+#line 2754 "yacc_sql.cpp"
     break;
 
-  case 103:
-#line 810 "yacc_sql.y"
+  case 113: /* comp_op: GE  */
+#line 910 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 2572 "yacc_sql.cpp"
+#line 2760 "yacc_sql.cpp"
     break;
 
-  case 104:
-#line 811 "yacc_sql.y"
+  case 114: /* comp_op: NE  */
+#line 911 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 2578 "yacc_sql.cpp"
+#line 2766 "yacc_sql.cpp"
     break;
 
-  case 105:
-#line 816 "yacc_sql.y"
+  case 115: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 916 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -2588,20 +2776,20 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 2592 "yacc_sql.cpp"
+#line 2780 "yacc_sql.cpp"
     break;
 
-  case 106:
-#line 829 "yacc_sql.y"
+  case 116: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 929 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 2601 "yacc_sql.cpp"
+#line 2789 "yacc_sql.cpp"
     break;
 
-  case 107:
-#line 837 "yacc_sql.y"
+  case 117: /* set_variable_stmt: SET ID EQ value  */
+#line 937 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -2609,11 +2797,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 2613 "yacc_sql.cpp"
+#line 2801 "yacc_sql.cpp"
     break;
 
 
-#line 2617 "yacc_sql.cpp"
+#line 2805 "yacc_sql.cpp"
 
       default: break;
     }
@@ -2628,11 +2816,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2657,50 +2844,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, sql_string, sql_result, scanner, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, sql_string, sql_result, scanner, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2733,6 +2915,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2749,13 +2932,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2769,7 +2953,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, sql_string, sql_result, scanner);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, sql_string, sql_result, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2780,13 +2964,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2797,7 +2979,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2805,24 +2987,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, sql_string, sql_result, scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2838,20 +3018,19 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp, sql_string, sql_result, scanner);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, sql_string, sql_result, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 849 "yacc_sql.y"
+
+#line 949 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
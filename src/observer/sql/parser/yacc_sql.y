@@ -119,6 +119,8 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   std::vector<JoinSqlNode> *        join_list;
   std::vector<AttrInfoSqlNode> *    attr_infos;
   AttrInfoSqlNode *                 attr_info;
+  TableOptionSqlNode *              table_option;
+  std::vector<TableOptionSqlNode> * table_option_list;
   Expression *                      expression;
   std::vector<Expression *> *       expression_list;
   std::vector<Value> *              value_list;
@@ -151,6 +153,9 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <join_list>           join_list
 %type <attr_infos>          attr_def_list
 %type <attr_info>           attr_def
+%type <table_option_list>   table_options
+%type <table_option_list>   table_option_list
+%type <table_option>        table_option
 %type <value_list>          value_list
 %type <condition_list>      where
 %type <condition_list>      condition_list
@@ -168,7 +173,9 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            create_table_stmt
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
+%type <sql_node>            show_buffer_pool_stmt
 %type <sql_node>            desc_table_stmt
+%type <sql_node>            vacuum_table_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            drop_index_stmt
 %type <sql_node>            sync_stmt
@@ -205,7 +212,9 @@ command_wrapper:
   | create_table_stmt
   | drop_table_stmt
   | show_tables_stmt
+  | show_buffer_pool_stmt
   | desc_table_stmt
+  | vacuum_table_stmt
   | create_index_stmt
   | drop_index_stmt
   | sync_stmt
@@ -267,6 +276,20 @@ show_tables_stmt:
     }
     ;
 
+show_buffer_pool_stmt:
+    SHOW ID ID {
+      // buffer_pool 和 status 不是关键字，避免影响使用这些名字的表和字段
+      bool valid = 0 == strcasecmp($2, "buffer_pool") && 0 == strcasecmp($3, "status");
+      free($2);
+      free($3);
+      if (!valid) {
+        yyerror(&@$, sql_string, sql_result, scanner, "unknown show command");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_SHOW_BUFFER_POOL_STATUS);
+    }
+    ;
+
 desc_table_stmt:
     DESC ID  {
       $$ = new ParsedSqlNode(SCF_DESC_TABLE);
@@ -275,6 +298,22 @@ desc_table_stmt:
     }
     ;
 
+vacuum_table_stmt:
+    ID TABLE ID {
+      // vacuum 不是关键字，避免影响使用这个名字的表和字段
+      bool valid = 0 == strcasecmp($1, "vacuum");
+      free($1);
+      if (!valid) {
+        free($3);
+        yyerror(&@$, sql_string, sql_result, scanner, "unknown command");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_VACUUM_TABLE);
+      $$->vacuum_table.relation_name = $3;
+      free($3);
+    }
+    ;
+
 create_index_stmt:    /*create index 语句的语法解析树*/
     CREATE INDEX ID ON ID LBRACE ID RBRACE
     {
@@ -300,13 +339,18 @@ drop_index_stmt:      /*drop index 语句的语法解析树*/
     }
     ;
 create_table_stmt:    /*create table 语句的语法解析树*/
-    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE
+    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE table_options
     {
       $$ = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = $$->create_table;
       create_table.relation_name = $3;
       free($3);
 
+      if ($8 != nullptr) {
+        create_table.options.swap(*$8);
+        delete $8;
+      }
+
       std::vector<AttrInfoSqlNode> *src_attrs = $6;
 
       if (src_attrs != nullptr) {
@@ -318,6 +362,51 @@ create_table_stmt:    /*create table 语句的语法解析树*/
       delete $5;
     }
     ;
+table_options:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | ID LBRACE table_option table_option_list RBRACE
+    {
+      // with 和选项的名字都不是关键字，避免影响使用这些名字的表和字段。选项的名字和取值由 CreateTableStmt 检查
+      bool valid = 0 == strcasecmp($1, "with");
+      free($1);
+      if (!valid) {
+        delete $3;
+        delete $4;
+        yyerror(&@$, sql_string, sql_result, scanner, "unknown table option");
+        YYERROR;
+      }
+
+      $$ = $4 != nullptr ? $4 : new std::vector<TableOptionSqlNode>;
+      $$->emplace_back(std::move(*$3));
+      std::reverse($$->begin(), $$->end());
+      delete $3;
+    }
+    ;
+table_option_list:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | COMMA table_option table_option_list
+    {
+      $$ = $3 != nullptr ? $3 : new std::vector<TableOptionSqlNode>;
+      $$->emplace_back(std::move(*$2));
+      delete $2;
+    }
+    ;
+table_option:
+    ID EQ ID
+    {
+      $$ = new TableOptionSqlNode;
+      $$->name = $1;
+      $$->value = $3;
+      free($1);
+      free($3);
+    }
+    ;
 attr_def_list:
     /* empty */
     {
@@ -349,7 +438,7 @@ attr_def:
       $$ = new AttrInfoSqlNode;
       $$->type = (AttrType)$2;
       $$->name = $1;
-      $$->length = 4;
+      $$->length = ($$->type == VARCHARS) ? TEXT_LENGTH : 4;
       free($1);
     }
     ;
@@ -361,6 +450,17 @@ type:
     | STRING_T { $$=CHARS; }
     | FLOAT_T  { $$=FLOATS; }
     | DATE_T   { $$=DATES; }
+    | ID
+    {
+      // varchar 和 text 不是关键字，避免影响使用这些名字的表和字段
+      bool valid = 0 == strcasecmp($1, "varchar") || 0 == strcasecmp($1, "text");
+      free($1);
+      if (!valid) {
+        yyerror(&@$, sql_string, sql_result, scanner, "unknown type");
+        YYERROR;
+      }
+      $$=VARCHARS;
+    }
     ;
 insert_stmt:        /*insert   语句的语法解析树*/
     INSERT INTO ID VALUES LBRACE value value_list RBRACE 
@@ -40,6 +40,11 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  if (table->readonly()) {
+    LOG_WARN("table is readonly. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_READONLY;
+  }
+
   const FieldMeta *field_meta = table->table_meta().field(create_index.attribute_name.c_str());
   if (nullptr == field_meta) {
     LOG_WARN("no such field in table. db=%s, table=%s, field name=%s", 
@@ -47,6 +52,13 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_FIELD_NOT_EXIST;
   }
 
+  // 索引中的键是定长的，变长字段在记录中只有一个引用，不能作为索引键
+  if (field_meta->type() == VARCHARS) {
+    LOG_WARN("cannot create index on varchar field. db=%s, table=%s, field name=%s",
+             db->name(), table_name, field_meta->name());
+    return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+  }
+
   Index *index = table->find_index(create_index.index_name.c_str());
   if (nullptr != index) {
     LOG_WARN("index with name(%s) already exists. table name=%s", create_index.index_name.c_str(), table_name);
@@ -12,12 +12,67 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2023/6/13.
 //
 
+#include <strings.h>
+
 #include "sql/stmt/create_table_stmt.h"
+#include "common/log/log.h"
 #include "event/sql_debug.h"
 
+/**
+ * @brief 开关类型的选项，取值是 true 或者 false，不区分大小写
+ */
+static RC bool_option_from_string(const char *value, bool &result)
+{
+  if (0 == strcasecmp(value, "true")) {
+    result = true;
+  } else if (0 == strcasecmp(value, "false")) {
+    result = false;
+  } else {
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
 RC CreateTableStmt::create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt)
 {
-  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos);
+  TableOptions options;
+  for (const TableOptionSqlNode &option : create_table.options) {
+    RC rc = RC::SUCCESS;
+    if (0 == strcasecmp(option.name.c_str(), "format")) {
+      rc = storage_format_from_string(option.value.c_str(), options.storage_format);
+    } else if (0 == strcasecmp(option.name.c_str(), "zone_map")) {
+      rc = bool_option_from_string(option.value.c_str(), options.zone_map);
+    } else if (0 == strcasecmp(option.name.c_str(), "compression")) {
+      rc = bool_option_from_string(option.value.c_str(), options.compression);
+    } else {
+      rc = RC::INVALID_ARGUMENT;
+    }
+
+    if (OB_FAIL(rc)) {
+      LOG_WARN("invalid table option. table=%s, option=%s, value=%s",
+               create_table.relation_name.c_str(), option.name.c_str(), option.value.c_str());
+      return rc;
+    }
+  }
+
+  // 压缩是按列编码的，只有 PAX 页面才能压缩
+  if (options.compression && options.storage_format != StorageFormat::PAX) {
+    LOG_WARN("compression requires pax storage format. table=%s", create_table.relation_name.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // PAX 页面按照字段的长度划分每一列的空间，只支持定长的字段
+  if (options.storage_format == StorageFormat::PAX) {
+    for (const AttrInfoSqlNode &attr_info : create_table.attr_infos) {
+      if (attr_info.type == VARCHARS) {
+        LOG_WARN("pax storage format does not support varchar fields. table=%s, field=%s",
+                 create_table.relation_name.c_str(), attr_info.name.c_str());
+        return RC::INVALID_ARGUMENT;
+      }
+    }
+  }
+
+  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos, options);
   sql_debug("create table statement: table name %s", create_table.relation_name.c_str());
   return RC::SUCCESS;
 }
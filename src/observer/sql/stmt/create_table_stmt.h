@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 
 #include "sql/stmt/stmt.h"
+#include "storage/table/table_meta.h"
 
 class Db;
 
@@ -29,8 +30,9 @@ class Db;
 class CreateTableStmt : public Stmt
 {
 public:
-  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos)
-      : table_name_(table_name), attr_infos_(attr_infos)
+  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos,
+      const TableOptions &options = {})
+      : table_name_(table_name), attr_infos_(attr_infos), options_(options)
   {}
   virtual ~CreateTableStmt() = default;
 
@@ -38,10 +40,12 @@ public:
 
   const std::string                  &table_name() const { return table_name_; }
   const std::vector<AttrInfoSqlNode> &attr_infos() const { return attr_infos_; }
+  const TableOptions                 &options() const { return options_; }
 
   static RC create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt);
 
 private:
   std::string                  table_name_;
   std::vector<AttrInfoSqlNode> attr_infos_;
+  TableOptions                 options_;
 };
\ No newline at end of file
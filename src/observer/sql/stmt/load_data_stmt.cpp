@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "storage/db/db.h"
+#include "storage/table/table.h"
 #include <unistd.h>
 
 using namespace common;
@@ -38,6 +39,11 @@ RC LoadDataStmt::create(Db *db, const LoadDataSqlNode &load_data, Stmt *&stmt)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  if (table->readonly()) {
+    LOG_WARN("table is readonly. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_READONLY;
+  }
+
   if (0 != access(load_data.file_name.c_str(), R_OK)) {
     LOG_WARN("no such file to load. file name=%s, error=%s", load_data.file_name.c_str(), strerror(errno));
     return RC::FILE_NOT_EXIST;
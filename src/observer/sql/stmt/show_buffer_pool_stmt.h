@@ -0,0 +1,36 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include "sql/stmt/stmt.h"
+
+/**
+ * @brief 显示缓冲池统计信息的语句
+ * @ingroup Statement
+ */
+class ShowBufferPoolStmt : public Stmt
+{
+public:
+  ShowBufferPoolStmt()          = default;
+  virtual ~ShowBufferPoolStmt() = default;
+
+  StmtType type() const override { return StmtType::SHOW_BUFFER_POOL_STATUS; }
+
+  static RC create(Stmt *&stmt)
+  {
+    stmt = new ShowBufferPoolStmt();
+    return RC::SUCCESS;
+  }
+};
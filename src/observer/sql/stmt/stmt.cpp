@@ -26,10 +26,12 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/load_data_stmt.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/set_variable_stmt.h"
+#include "sql/stmt/show_buffer_pool_stmt.h"
 #include "sql/stmt/show_tables_stmt.h"
 #include "sql/stmt/trx_begin_stmt.h"
 #include "sql/stmt/trx_end_stmt.h"
 #include "sql/stmt/update_stmt.h"
+#include "sql/stmt/vacuum_table_stmt.h"
 
 RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
 {
@@ -64,6 +66,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return DescTableStmt::create(db, sql_node.desc_table, stmt);
     }
 
+    case SCF_VACUUM_TABLE: {
+      return VacuumTableStmt::create(db, sql_node.vacuum_table, stmt);
+    }
+
     case SCF_HELP: {
       return HelpStmt::create(stmt);
     }
@@ -72,6 +78,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return ShowTablesStmt::create(db, stmt);
     }
 
+    case SCF_SHOW_BUFFER_POOL_STATUS: {
+      return ShowBufferPoolStmt::create(stmt);
+    }
+
     case SCF_BEGIN: {
       return TrxBeginStmt::create(stmt);
     }
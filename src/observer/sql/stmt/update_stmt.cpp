@@ -37,6 +37,11 @@ RC UpdateStmt::create(Db *db, const UpdateSqlNode &update_sql, Stmt *&stmt)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  if (table->readonly()) {
+    LOG_WARN("table is readonly. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_READONLY;
+  }
+
   const FieldMeta *field_meta = table->table_meta().field(update_sql.attribute_name.c_str());
 
   if (nullptr == field_meta) {
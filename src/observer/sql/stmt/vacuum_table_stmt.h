@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+
+#pragma once
+
+#include "sql/stmt/stmt.h"
+
+class Db;
+class Table;
+
+/**
+ * @brief 整理表的语句
+ * @ingroup Statement
+ */
+class VacuumTableStmt : public Stmt
+{
+public:
+  VacuumTableStmt(Table *table) : table_(table) {}
+  virtual ~VacuumTableStmt() = default;
+
+  StmtType type() const override { return StmtType::VACUUM_TABLE; }
+
+  Table *table() const { return table_; }
+
+  static RC create(Db *db, const VacuumTableSqlNode &vacuum_table, Stmt *&stmt);
+
+private:
+  Table *table_ = nullptr;
+};
@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <stdio.h>
+
+#include "common/math/random_generator.h"
+#include "common/metrics/histogram_snapshot.h"
+#include "common/metrics/metrics.h"
+#include "storage/buffer/buffer_pool_stats.h"
+
+using namespace std;
+
+LatencyHistogram::LatencyHistogram()
+    : random_(new common::RandomGenerator()), histogram_(new common::Histogram(*random_))
+{}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+void LatencyHistogram::record(int64_t latency_us) { histogram_->update(static_cast<double>(latency_us)); }
+
+string LatencyHistogram::to_string()
+{
+  lock_guard<mutex> guard(lock_);
+
+  histogram_->snapshot();
+  auto *snapshot = static_cast<common::HistogramSnapShot *>(histogram_->get_snapshot());
+  if (snapshot == nullptr || snapshot->size() == 0) {
+    return "-";
+  }
+
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.0f/%.0f/%.0f", snapshot->get_median(), snapshot->get_99th(), snapshot->get_max());
+  return buf;
+}
+
+void BufferPoolStats::add_hit()
+{
+  hits_++;
+  if (global_ != nullptr) {
+    global_->add_hit();
+  }
+}
+
+void BufferPoolStats::add_miss()
+{
+  misses_++;
+  if (global_ != nullptr) {
+    global_->add_miss();
+  }
+}
+
+void BufferPoolStats::add_read(int ios, int pages, Clock::time_point start)
+{
+  auto latency = chrono::duration_cast<chrono::microseconds>(Clock::now() - start).count();
+  record_read(ios, pages, latency);
+}
+
+void BufferPoolStats::add_write(int ios, int pages, Clock::time_point start)
+{
+  auto latency = chrono::duration_cast<chrono::microseconds>(Clock::now() - start).count();
+  record_write(ios, pages, latency);
+}
+
+void BufferPoolStats::record_read(int ios, int pages, int64_t latency_us)
+{
+  read_ios_ += ios;
+  read_pages_ += pages;
+  read_latency_.record(latency_us);
+  if (global_ != nullptr) {
+    global_->record_read(ios, pages, latency_us);
+  }
+}
+
+void BufferPoolStats::record_write(int ios, int pages, int64_t latency_us)
+{
+  write_ios_ += ios;
+  write_pages_ += pages;
+  write_latency_.record(latency_us);
+  if (global_ != nullptr) {
+    global_->record_write(ios, pages, latency_us);
+  }
+}
+
+void BufferPoolStats::add_prefetch(int pages)
+{
+  prefetch_pages_ += pages;
+  if (global_ != nullptr) {
+    global_->add_prefetch(pages);
+  }
+}
+
+void BufferPoolStats::to_items(const string &scope, vector<BufferPoolStatItem> &items)
+{
+  const int64_t hits   = hits_.load();
+  const int64_t misses = misses_.load();
+
+  char hit_ratio[32] = "-";
+  if (hits + misses > 0) {
+    snprintf(hit_ratio, sizeof(hit_ratio), "%.2f%%", 100.0 * hits / (hits + misses));
+  }
+
+  items.push_back({scope, "hits", std::to_string(hits)});
+  items.push_back({scope, "misses", std::to_string(misses)});
+  items.push_back({scope, "hit_ratio", hit_ratio});
+  items.push_back({scope, "read_ios", std::to_string(read_ios_.load())});
+  items.push_back({scope, "read_pages", std::to_string(read_pages_.load())});
+  items.push_back({scope, "write_ios", std::to_string(write_ios_.load())});
+  items.push_back({scope, "write_pages", std::to_string(write_pages_.load())});
+  items.push_back({scope, "prefetch_pages", std::to_string(prefetch_pages_.load())});
+  items.push_back({scope, "read_latency_us(p50/p99/max)", read_latency_.to_string()});
+  items.push_back({scope, "write_latency_us(p50/p99/max)", write_latency_.to_string()});
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace common {
+class Histogram;
+class RandomGenerator;
+}  // namespace common
+
+/**
+ * @brief 一项统计信息
+ * @ingroup BufferPool
+ */
+struct BufferPoolStatItem
+{
+  std::string scope;  ///< global 或者文件名
+  std::string name;
+  std::string value;
+};
+
+/**
+ * @brief 延迟的分布，单位是微秒
+ * @ingroup BufferPool
+ * @details 使用采样的方式记录，只保留固定个数的样本
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+  ~LatencyHistogram();
+
+  void record(int64_t latency_us);
+
+  /**
+   * @brief 返回 p50/p99/max 格式的字符串，没有样本时返回 "-"
+   */
+  std::string to_string();
+
+private:
+  std::mutex                               lock_;    ///< 保护直方图的快照
+  std::unique_ptr<common::RandomGenerator> random_;  ///< 每个直方图使用自己的随机数生成器，更新时受直方图的锁保护
+  std::unique_ptr<common::Histogram>       histogram_;
+};
+
+/**
+ * @brief 缓冲池的统计信息
+ * @ingroup BufferPool
+ * @details 每个文件(DiskBufferPool)有一份，BufferPoolManager中有一份全局的。
+ * 文件的统计信息更新时，会同时更新全局的统计信息，所以关闭文件之后全局的统计信息不会丢失。
+ */
+class BufferPoolStats
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param global 全局的统计信息，为空表示当前就是全局的
+   */
+  explicit BufferPoolStats(BufferPoolStats *global = nullptr) : global_(global) {}
+
+  void add_hit();
+  void add_miss();
+
+  /**
+   * @brief 记录一次读IO的提交，延迟是整批IO请求完成的时间
+   * @param ios 一起提交的IO请求个数，连续的页面合并成一个请求
+   * @param pages 读了多少个页面
+   * @param start 提交IO的时间
+   */
+  void add_read(int ios, int pages, Clock::time_point start);
+  void add_write(int ios, int pages, Clock::time_point start);
+
+  /**
+   * @brief 预读或预热加载的页面
+   */
+  void add_prefetch(int pages);
+
+  /**
+   * @brief 把统计信息追加到items中
+   */
+  void to_items(const std::string &scope, std::vector<BufferPoolStatItem> &items);
+
+private:
+  void record_read(int ios, int pages, int64_t latency_us);
+  void record_write(int ios, int pages, int64_t latency_us);
+
+private:
+  BufferPoolStats *global_ = nullptr;
+
+  std::atomic<int64_t> hits_{0};            ///< 在缓冲池中找到了页面
+  std::atomic<int64_t> misses_{0};          ///< 需要从磁盘加载页面
+  std::atomic<int64_t> read_ios_{0};        ///< 读IO请求的个数，连续的页面合并成一个请求
+  std::atomic<int64_t> read_pages_{0};      ///< 从磁盘读取的页面数
+  std::atomic<int64_t> write_ios_{0};       ///< 写IO请求的个数
+  std::atomic<int64_t> write_pages_{0};     ///< 写到磁盘的页面数
+  std::atomic<int64_t> prefetch_pages_{0};  ///< 预读和预热加载的页面数
+
+  LatencyHistogram read_latency_;
+  LatencyHistogram write_latency_;
+};
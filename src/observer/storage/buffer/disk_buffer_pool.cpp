@@ -11,59 +11,163 @@ See the Mulan PSL v2 for more details. */
 //
 // Created by Meiyi & Longda on 2021/4/13.
 //
+#include <algorithm>
 #include <errno.h>
+#include <fstream>
+#include <map>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <thread>
 
-#include "common/io/io.h"
 #include "common/lang/mutex.h"
 #include "common/log/log.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/common/meta_util.h"
 
 using namespace common;
 using namespace std;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+/// 前台找不到干净的页帧时，最多等待后台刷脏页线程多久
+static const int WAIT_PAGE_CLEANER_MS = 10;
+
+/// 关闭文件时，页帧可能正在被后台线程刷盘，需要等它处理完
+static const int PURGE_PAGES_RETRY_TIMES = 1000;
+
+/// 识别出顺序访问后，第一个预读窗口的大小
+static const int READ_AHEAD_INIT_PAGES = 4;
+
+/// 每个文件最多同时有几个异步预读任务
+static const int MAX_PENDING_READ_AHEAD = 4;
+
+/// 预热时每次最多加载多少个页面
+static const size_t WARM_UP_BATCH_PAGES = 256;
+
+/// flush_all_pages 时每批下刷多少个页面，每批之间会按照限速等待
+static const size_t FLUSH_BATCH_PAGES = 256;
+
+/// flush_all_pages 时一个IO请求最多合并多少个连续的页面
+static const int FLUSH_MAX_PAGES_PER_IO = 64;
+
+/// 一个位图页中有多少个64位的字
+static const int GROUP_WORD_NUM = BP_GROUP_PAGE_NUM / 64;
+
+/// 位图页的数据不是按照8字节对齐的，使用memcpy读写
+static uint64_t load_bitmap_word(const char *bitmap, int word_index)
+{
+  uint64_t word;
+  memcpy(&word, bitmap + word_index * sizeof(uint64_t), sizeof(word));
+  return word;
+}
+
+/// 返回第一个为1的位，没有时返回-1
+static int find_first_bit(const std::vector<uint64_t> &words)
+{
+  for (size_t i = 0; i < words.size(); i++) {
+    if (words[i] != 0) {
+      return static_cast<int>(i * 64 + __builtin_ctzll(words[i]));
+    }
+  }
+  return -1;
+}
+
+static void assign_bit(std::vector<uint64_t> &words, int index, bool value)
+{
+  if (value) {
+    words[index / 64] |= (1ULL << (index % 64));
+  } else {
+    words[index / 64] &= ~(1ULL << (index % 64));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 string BPFileHeader::to_string() const
 {
   stringstream ss;
-  ss << "pageCount:" << page_count << ", allocatedCount:" << allocated_pages;
+  ss << "pageCount:" << page_count << ", allocatedCount:" << allocated_pages << ", groupCount:" << group_count;
   return ss.str();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-BPFrameManager::BPFrameManager(const char *name) : allocator_(name) {}
+BPFrameManager::BPFrameManager(const char *name, int shard_num /* = DEFAULT_SHARD_NUM */)
+    : tag_(name), shards_(std::max(shard_num, 1))
+{}
 
-RC BPFrameManager::init(int pool_num)
+RC BPFrameManager::init(int pool_num, const char *cache_name /* = nullptr */)
 {
-  int ret = allocator_.init(false, pool_num);
-  if (ret == 0) {
-    return RC::SUCCESS;
+  RC rc = arena_.init(pool_num * DEFAULT_ITEM_NUM_PER_POOL);
+  if (OB_FAIL(rc)) {
+    return rc;
   }
-  return RC::NOMEM;
+
+  const size_t shard_capacity = arena_.size() / shards_.size();
+  for (FrameShard &shard : shards_) {
+    shard.frames_.reset(FrameCache::create(cache_name, shard_capacity));
+    if (shard.frames_ == nullptr) {
+      LOG_WARN("failed to create frame cache, use lru instead. name=%s", cache_name);
+      shard.frames_.reset(FrameCache::create(nullptr, shard_capacity));
+    }
+  }
+
+  // 把所有的页帧分散到各个分片的空闲列表中，分配页帧时就不需要再访问全局的内存池
+  const int frame_num = arena_.size();
+  for (int i = 0; i < frame_num; i++) {
+    shards_[i % shards_.size()].free_frames_.push_back(arena_.frame(i));
+  }
+  LOG_INFO("frame manager init done. tag=%s, frame num=%d, shard num=%d, frame cache=%s, page mode=%s",
+           tag_.c_str(), frame_num, shard_num(), shards_[0].frames_->name(),
+           FrameArena::page_mode_name(arena_.page_mode()));
+  return RC::SUCCESS;
 }
 
 RC BPFrameManager::cleanup()
 {
-  if (frames_.count() > 0) {
+  if (frame_num() > 0) {
     return RC::INTERNAL;
   }
 
-  frames_.destroy();
+  // 页帧的内存由 arena_ 管理，在析构时统一释放
+  for (FrameShard &shard : shards_) {
+    shard.free_frames_.clear();
+    shard.frames_.reset();
+  }
   return RC::SUCCESS;
 }
 
-int BPFrameManager::purge_frames(int count, std::function<RC(Frame *frame)> purger)
+BPFrameManager::FrameShard &BPFrameManager::shard_of(const FrameId &frame_id)
 {
-  std::lock_guard<std::mutex> lock_guard(lock_);
+  size_t hash = frame_id.hash();
+  hash ^= hash >> 32;
+  return shards_[hash % shards_.size()];
+}
 
-  std::vector<Frame *> frames_can_purge;
+int BPFrameManager::purge_frames(int count, std::function<RC(Frame *frame)> purger)
+{
   if (count <= 0) {
     count = 1;
   }
+
+  // 每次从不同的分片开始淘汰，避免总是从同一个分片中淘汰页面
+  const size_t start       = purge_cursor_.fetch_add(1) % shards_.size();
+  int          freed_count = 0;
+  for (size_t i = 0; i < shards_.size() && freed_count < count; i++) {
+    FrameShard &shard = shards_[(start + i) % shards_.size()];
+    freed_count += purge_shard_frames(shard, count - freed_count, purger);
+  }
+  LOG_INFO("purge frame done. number=%d", freed_count);
+  return freed_count;
+}
+
+int BPFrameManager::purge_shard_frames(FrameShard &shard, int count, std::function<RC(Frame *frame)> &purger)
+{
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+
+  std::vector<Frame *> frames_can_purge;
   frames_can_purge.reserve(count);
 
   auto purge_finder = [&frames_can_purge, count](const FrameId &frame_id, Frame *const frame) {
@@ -77,91 +181,237 @@ int BPFrameManager::purge_frames(int count, std::function<RC(Frame *frame)> purg
     return true;  // true continue to look up
   };
 
-  frames_.foreach_reverse(purge_finder);
-  LOG_INFO("purge frames find %ld pages total", frames_can_purge.size());
+  shard.frames_->foreach_reverse(purge_finder);
+  LOG_DEBUG("purge frames find %ld pages in shard", frames_can_purge.size());
 
-  /// 当前还在frameManager的锁内，而 purger 是一个非常耗时的操作
-  /// 他需要把脏页数据刷新到磁盘上去，所以这里会极大地降低并发度
+  /// 当前还在分片的锁内，而 purger 是一个非常耗时的操作
+  /// 他需要把脏页数据刷新到磁盘上去，所以这里会降低这个分片上的并发度
   int freed_count = 0;
   for (Frame *frame : frames_can_purge) {
     RC rc = purger(frame);
     if (RC::SUCCESS == rc) {
-      free_internal(frame->frame_id(), frame);
+      free_internal(shard, frame->frame_id(), frame, true /*evict*/);
       freed_count++;
+      evict_count_++;
     } else {
       frame->unpin();
       LOG_WARN("failed to purge frame. frame_id=%s, rc=%s", 
                to_string(frame->frame_id()).c_str(), strrc(rc));
     }
   }
-  LOG_INFO("purge frame done. number=%d", freed_count);
   return freed_count;
 }
 
+int BPFrameManager::evict_clean_frames(int count)
+{
+  const size_t start       = purge_cursor_.fetch_add(1) % shards_.size();
+  int          freed_count = 0;
+  for (size_t i = 0; i < shards_.size() && freed_count < count; i++) {
+    FrameShard &shard = shards_[(start + i) % shards_.size()];
+    freed_count += evict_shard_clean_frames(shard, count - freed_count);
+  }
+  return freed_count;
+}
+
+int BPFrameManager::evict_clean_frames(int shard_index, int count)
+{
+  return evict_shard_clean_frames(shards_[shard_index], count);
+}
+
+int BPFrameManager::evict_shard_clean_frames(FrameShard &shard, int count)
+{
+  if (count <= 0) {
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+
+  // pin count 为0的页帧，只有拿到分片的锁才能再pin住，所以这里检查的脏页标识是可靠的
+  std::vector<Frame *> frames;
+  shard.frames_->foreach_reverse([&frames, count](const FrameId &, Frame *const frame) {
+    if (frame->can_purge() && !frame->dirty()) {
+      frames.push_back(frame);
+    }
+    return frames.size() < static_cast<size_t>(count);
+  });
+
+  for (Frame *frame : frames) {
+    frame->pin();
+    free_internal(shard, frame->frame_id(), frame, true /*evict*/);
+  }
+  evict_count_ += frames.size();
+  return static_cast<int>(frames.size());
+}
+
+void BPFrameManager::foreach_frame_reverse(int shard_index, std::function<bool(Frame *frame)> func)
+{
+  FrameShard                 &shard = shards_[shard_index];
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  shard.frames_->foreach_reverse([&func](const FrameId &, Frame *const frame) { return func(frame); });
+}
+
+void BPFrameManager::forget_file(int file_desc)
+{
+  for (FrameShard &shard : shards_) {
+    std::lock_guard<std::mutex> lock_guard(shard.lock_);
+    shard.frames_->forget_file(file_desc);
+  }
+}
+
 Frame *BPFrameManager::get(int file_desc, PageNum page_num)
 {
   FrameId                     frame_id(file_desc, page_num);
-  std::lock_guard<std::mutex> lock_guard(lock_);
-  return get_internal(frame_id);
+  FrameShard                 &shard = shard_of(frame_id);
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  return get_internal(shard, frame_id);
 }
 
-Frame *BPFrameManager::get_internal(const FrameId &frame_id)
+Frame *BPFrameManager::get_internal(FrameShard &shard, const FrameId &frame_id)
 {
   Frame *frame = nullptr;
-  (void)frames_.get(frame_id, frame);
+  (void)shard.frames_->get(frame_id, frame);
   if (frame != nullptr) {
     frame->pin();
   }
   return frame;
 }
 
+Frame *BPFrameManager::steal_free_frame(const FrameShard &except)
+{
+  for (FrameShard &shard : shards_) {
+    if (&shard == &except) {
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock_guard(shard.lock_);
+    if (!shard.free_frames_.empty()) {
+      Frame *frame = shard.free_frames_.back();
+      shard.free_frames_.pop_back();
+      return frame;
+    }
+  }
+  return nullptr;
+}
+
 Frame *BPFrameManager::alloc(int file_desc, PageNum page_num)
 {
-  FrameId frame_id(file_desc, page_num);
+  FrameId     frame_id(file_desc, page_num);
+  FrameShard &shard = shard_of(frame_id);
 
-  std::lock_guard<std::mutex> lock_guard(lock_);
-  Frame                      *frame = get_internal(frame_id);
-  if (frame != nullptr) {
-    return frame;
+  Frame *frame = nullptr;
+  {
+    std::lock_guard<std::mutex> lock_guard(shard.lock_);
+    frame = get_internal(shard, frame_id);
+    if (frame != nullptr) {
+      return frame;
+    }
+
+    if (!shard.free_frames_.empty()) {
+      frame = shard.free_frames_.back();
+      shard.free_frames_.pop_back();
+    }
   }
 
-  frame = allocator_.alloc();
-  if (frame != nullptr) {
-    ASSERT(
-        frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", to_string(*frame).c_str());
-    frame->set_page_num(page_num);
-    frame->pin();
-    frames_.put(frame_id, frame);
+  // 当前分片没有空闲页帧了，去其它分片找一个。为了防止死锁，这时不能拿着当前分片的锁
+  if (frame == nullptr) {
+    frame = steal_free_frame(shard);
+    if (frame == nullptr) {
+      return nullptr;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  Frame                      *exists_frame = get_internal(shard, frame_id);
+  if (exists_frame != nullptr) {
+    // 释放锁的间隙里，其它线程已经分配了这个页面
+    shard.free_frames_.push_back(frame);
+    return exists_frame;
   }
+
+  ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", to_string(*frame).c_str());
+  frame->set_page_num(page_num);
+  frame->pin();
+  shard.frames_->put(frame_id, frame);
   return frame;
 }
 
+Frame *BPFrameManager::alloc_detached()
+{
+  for (int retry = 0; retry < 2; retry++) {
+    const size_t start = purge_cursor_.fetch_add(1) % shards_.size();
+    for (size_t i = 0; i < shards_.size(); i++) {
+      FrameShard                 &shard = shards_[(start + i) % shards_.size()];
+      std::lock_guard<std::mutex> lock_guard(shard.lock_);
+      if (!shard.free_frames_.empty()) {
+        Frame *frame = shard.free_frames_.back();
+        shard.free_frames_.pop_back();
+        return frame;
+      }
+    }
+
+    if (evict_clean_frames(1) <= 0) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+bool BPFrameManager::attach(int file_desc, PageNum page_num, Frame *frame, bool pin)
+{
+  FrameId     frame_id(file_desc, page_num);
+  FrameShard &shard = shard_of(frame_id);
+
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  Frame                      *exists_frame = nullptr;
+  if (shard.frames_->get(frame_id, exists_frame)) {
+    shard.free_frames_.push_back(frame);
+    return false;
+  }
+
+  ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", to_string(*frame).c_str());
+  shard.frames_->put(frame_id, frame);
+  if (pin) {
+    frame->pin();
+  }
+  return true;
+}
+
+void BPFrameManager::free_detached(Frame *frame)
+{
+  FrameShard                 &shard = shards_[purge_cursor_.fetch_add(1) % shards_.size()];
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  shard.free_frames_.push_back(frame);
+}
+
 RC BPFrameManager::free(int file_desc, PageNum page_num, Frame *frame)
 {
-  FrameId frame_id(file_desc, page_num);
+  FrameId     frame_id(file_desc, page_num);
+  FrameShard &shard = shard_of(frame_id);
 
-  std::lock_guard<std::mutex> lock_guard(lock_);
-  return free_internal(frame_id, frame);
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  return free_internal(shard, frame_id, frame);
 }
 
-RC BPFrameManager::free_internal(const FrameId &frame_id, Frame *frame)
+RC BPFrameManager::free_internal(FrameShard &shard, const FrameId &frame_id, Frame *frame, bool evict /*= false*/)
 {
   Frame                *frame_source = nullptr;
-  [[maybe_unused]] bool found        = frames_.get(frame_id, frame_source);
+  [[maybe_unused]] bool found        = shard.frames_->get(frame_id, frame_source);
   ASSERT(found && frame == frame_source && frame->pin_count() == 1,
       "failed to free frame. found=%d, frameId=%s, frame_source=%p, frame=%p, pinCount=%d, lbt=%s",
       found, to_string(frame_id).c_str(), frame_source, frame, frame->pin_count(), lbt());
 
   frame->unpin();
-  frames_.remove(frame_id);
-  allocator_.free(frame);
+  if (evict) {
+    shard.frames_->evict(frame_id);
+  } else {
+    shard.frames_->remove(frame_id);
+  }
+  shard.free_frames_.push_back(frame);
   return RC::SUCCESS;
 }
 
 std::list<Frame *> BPFrameManager::find_list(int file_desc)
 {
-  std::lock_guard<std::mutex> lock_guard(lock_);
-
   std::list<Frame *> frames;
   auto               fetcher = [&frames, file_desc](const FrameId &frame_id, Frame *const frame) -> bool {
     if (file_desc == frame_id.file_desc()) {
@@ -170,16 +420,46 @@ std::list<Frame *> BPFrameManager::find_list(int file_desc)
     }
     return true;
   };
-  frames_.foreach (fetcher);
+
+  for (FrameShard &shard : shards_) {
+    std::lock_guard<std::mutex> lock_guard(shard.lock_);
+    shard.frames_->foreach (fetcher);
+  }
   return frames;
 }
 
+size_t BPFrameManager::frame_num() const
+{
+  size_t num = 0;
+  for (const FrameShard &shard : shards_) {
+    std::lock_guard<std::mutex> lock_guard(shard.lock_);
+    if (shard.frames_ != nullptr) {
+      num += shard.frames_->count();
+    }
+  }
+  return num;
+}
+
+size_t BPFrameManager::frame_num(int shard_index) const
+{
+  const FrameShard           &shard = shards_[shard_index];
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  return shard.frames_->count();
+}
+
+size_t BPFrameManager::free_frame_num(int shard_index) const
+{
+  const FrameShard           &shard = shards_[shard_index];
+  std::lock_guard<std::mutex> lock_guard(shard.lock_);
+  return shard.free_frames_.size();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 BufferPoolIterator::BufferPoolIterator() {}
 BufferPoolIterator::~BufferPoolIterator() {}
 RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
 {
-  bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
+  bp_ = &bp;
   if (start_page <= 0) {
     current_page_num_ = 0;
   } else {
@@ -188,12 +468,12 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
   return RC::SUCCESS;
 }
 
-bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
+bool BufferPoolIterator::has_next() { return bp_->next_allocated_page(current_page_num_ + 1) != BP_INVALID_PAGE_NUM; }
 
 PageNum BufferPoolIterator::next()
 {
-  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
-  if (next_page != -1) {
+  PageNum next_page = bp_->next_allocated_page(current_page_num_ + 1);
+  if (next_page != BP_INVALID_PAGE_NUM) {
     current_page_num_ = next_page;
   }
   return next_page;
@@ -206,8 +486,11 @@ RC BufferPoolIterator::reset()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-DiskBufferPool::DiskBufferPool(BufferPoolManager &bp_manager, BPFrameManager &frame_manager)
-    : bp_manager_(bp_manager), frame_manager_(frame_manager)
+DiskBufferPool::DiskBufferPool(BufferPoolManager &bp_manager, BufferPoolPartition &partition)
+    : bp_manager_(bp_manager),
+      partition_(partition),
+      frame_manager_(partition.frame_manager()),
+      stats_(&bp_manager.stats())
 {}
 
 DiskBufferPool::~DiskBufferPool()
@@ -216,14 +499,31 @@ DiskBufferPool::~DiskBufferPool()
   LOG_INFO("disk buffer pool exit");
 }
 
-RC DiskBufferPool::open_file(const char *file_name)
+RC DiskBufferPool::open_file(const char *file_name, bool readonly /* = false */)
 {
-  int fd = open(file_name, O_RDWR);
+  if (readonly) {
+    return open_mapped_file(file_name);
+  }
+
+  int fd = -1;
+#ifdef O_DIRECT
+  if (bp_manager_.direct_io()) {
+    fd = open(file_name, O_RDWR | O_DIRECT);
+    if (fd >= 0) {
+      direct_io_ = true;
+    } else if (errno == EINVAL) {
+      LOG_WARN("file system does not support O_DIRECT, use buffered io. file=%s", file_name);
+    }
+  }
+#endif
+  if (fd < 0) {
+    fd = open(file_name, O_RDWR);
+  }
   if (fd < 0) {
     LOG_ERROR("Failed to open file %s, because %s.", file_name, strerror(errno));
     return RC::IOERR_ACCESS;
   }
-  LOG_INFO("Successfully open buffer pool file %s.", file_name);
+  LOG_INFO("Successfully open buffer pool file %s. direct io=%d", file_name, direct_io_);
 
   file_name_ = file_name;
   file_desc_ = fd;
@@ -250,6 +550,25 @@ RC DiskBufferPool::open_file(const char *file_name)
 
   file_header_ = (BPFileHeader *)hdr_frame_->data();
 
+  if (file_header_->magic != BP_FILE_MAGIC) {
+    rc = upgrade_file_header();
+  }
+  if (OB_SUCC(rc)) {
+    rc = load_page_groups();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load page groups of %s. rc=%s", file_name, strrc(rc));
+    for (PageGroup &group : page_groups_) {
+      group.bitmap_frame->unpin();
+    }
+    page_groups_.clear();
+    hdr_frame_->unpin();
+    (void)purge_all_pages();
+    close(fd);
+    file_desc_ = -1;
+    return rc;
+  }
+
   LOG_INFO("Successfully open %s. file_desc=%d, hdr_frame=%p, file header=%s",
            file_name, file_desc_, hdr_frame_, file_header_->to_string().c_str());
   return RC::SUCCESS;
@@ -262,16 +581,29 @@ RC DiskBufferPool::close_file()
     return rc;
   }
 
+  // 等待还没有执行完的预读任务，它们会访问当前对象
+  {
+    std::unique_lock<std::mutex> read_ahead_guard(read_ahead_lock_);
+    closing_ = true;
+    read_ahead_cv_.wait(read_ahead_guard, [this]() { return pending_read_ahead_ == 0; });
+  }
+
   hdr_frame_->unpin();
+  for (PageGroup &group : page_groups_) {
+    group.bitmap_frame->unpin();
+  }
+  page_groups_.clear();
+  free_groups_.clear();
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
-  rc = purge_all_pages();
+  rc = (mmap_base_ != nullptr) ? unmap_file() : purge_all_pages();
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to close %s, due to failed to purge pages. rc=%s", file_name_.c_str(), strrc(rc));
     return rc;
   }
 
   disposed_pages_.clear();
+  frame_manager_.forget_file(file_desc_);
 
   if (close(file_desc_) < 0) {
     LOG_ERROR("Failed to close fileId:%d, fileName:%s, error:%s", file_desc_, file_name_.c_str(), strerror(errno));
@@ -286,103 +618,149 @@ RC DiskBufferPool::close_file()
 
 RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
 {
-  RC rc  = RC::SUCCESS;
   *frame = nullptr;
-
-  Frame *used_match_frame = frame_manager_.get(file_desc_, page_num);
-  if (used_match_frame != nullptr) {
-    used_match_frame->access();
-    *frame = used_match_frame;
-    return RC::SUCCESS;
+  if (mmap_base_ != nullptr) {
+    return get_mapped_page(page_num, frame);
   }
 
-  std::scoped_lock lock_guard(lock_);  // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
+  while (true) {
+    Frame *used_match_frame = frame_manager_.get(file_desc_, page_num);
+    if (used_match_frame != nullptr) {
+      used_match_frame->access();
+      *frame = used_match_frame;
+      stats_.add_hit();
+      check_read_ahead(page_num, true /*hit*/);
+      return RC::SUCCESS;
+    }
 
-  // Allocate one page and load the data into this page
-  Frame *allocated_frame = nullptr;
-  rc                     = allocate_frame(page_num, &allocated_frame);
-  if (rc != RC::SUCCESS) {
-    LOG_ERROR("Failed to alloc frame %s:%d, due to failed to alloc page.", file_name_.c_str(), page_num);
-    return rc;
-  }
+    // 缺页时不加整个缓冲池的锁，只有访问同一个页面的线程需要等待
+    bool                      owner = false;
+    std::shared_ptr<PageLoad> load  = begin_load(page_num, owner);
+    if (!owner) {
+      RC rc = wait_load(load);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      // 加载完成后，页面可能又被淘汰了，所以要重新查找
+      continue;
+    }
 
-  allocated_frame->set_file_desc(file_desc_);
-  // allocated_frame->pin(); // pined in manager::get
-  allocated_frame->access();
+    // 登记之前，其它线程可能刚好把这个页面加载完成(比如预读)
+    used_match_frame = frame_manager_.get(file_desc_, page_num);
+    if (used_match_frame != nullptr) {
+      end_load(page_num, RC::SUCCESS);
+      used_match_frame->access();
+      *frame = used_match_frame;
+      stats_.add_hit();
+      return RC::SUCCESS;
+    }
 
-  if ((rc = load_page(page_num, allocated_frame)) != RC::SUCCESS) {
-    LOG_ERROR("Failed to load page %s:%d", file_name_.c_str(), page_num);
-    purge_frame(page_num, allocated_frame);
-    return rc;
+    stats_.add_miss();
+    RC rc = load_frame(page_num, frame);
+    end_load(page_num, rc);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    break;
   }
 
-  *frame = allocated_frame;
+  // 预读时需要加锁，所以放在锁外面
+  check_read_ahead(page_num, false /*hit*/);
   return RC::SUCCESS;
 }
 
 RC DiskBufferPool::allocate_page(Frame **frame)
 {
+  if (mmap_base_ != nullptr) {
+    LOG_WARN("cannot allocate page in a readonly file. file=%s", file_name_.c_str());
+    return RC::BUFFERPOOL_READONLY;
+  }
+
+  std::scoped_lock lock_guard(lock_);
+  return allocate_page_locked(frame);
+}
+
+RC DiskBufferPool::allocate_pages(int count, std::vector<Frame *> &frames)
+{
+  if (mmap_base_ != nullptr) {
+    LOG_WARN("cannot allocate page in a readonly file. file=%s", file_name_.c_str());
+    return RC::BUFFERPOOL_READONLY;
+  }
+
+  frames.clear();
+  frames.reserve(count);
+
   RC rc = RC::SUCCESS;
+  {
+    std::scoped_lock lock_guard(lock_);
 
-  lock_.lock();
+    // 空闲页面不够时一次扩展出剩下的所有页面，之后的分配都不需要再扩展文件
+    int free_pages = 0;
+    for (const PageGroup &page_group : page_groups_) {
+      free_pages += page_group.free_pages;
+    }
+    if (free_pages < count) {
+      rc = extend_file(file_header_->page_count + count - free_pages);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to extend file. file=%s, page count=%d, count=%d, rc=%s",
+                 file_name_.c_str(), file_header_->page_count, count, strrc(rc));
+      }
+    }
 
-  int byte = 0, bit = 0;
-  if ((file_header_->allocated_pages) < (file_header_->page_count)) {
-    // There is one free page
-    for (int i = 0; i < file_header_->page_count; i++) {
-      byte = i / 8;
-      bit  = i % 8;
-      if (((file_header_->bitmap[byte]) & (1 << bit)) == 0) {
-        (file_header_->allocated_pages)++;
-        file_header_->bitmap[byte] |= (1 << bit);
-        // TODO,  do we need clean the loaded page's data?
-        hdr_frame_->mark_dirty();
-
-        lock_.unlock();
-        return get_this_page(i, frame);
+    for (int i = 0; OB_SUCC(rc) && i < count; i++) {
+      Frame *frame = nullptr;
+      rc           = allocate_page_locked(&frame);
+      if (OB_SUCC(rc)) {
+        frames.push_back(frame);
       }
     }
   }
 
-  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM) {
-    LOG_WARN("file buffer pool is full. page count %d, max page count %d",
-        file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
-    lock_.unlock();
-    return RC::BUFFERPOOL_NOBUF;
+  if (OB_FAIL(rc)) {
+    for (Frame *frame : frames) {
+      const PageNum page_num = frame->page_num();
+      frame->unpin();
+      dispose_page(page_num);
+    }
+    frames.clear();
+  }
+  return rc;
+}
+
+RC DiskBufferPool::allocate_page_locked(Frame **frame)
+{
+  PageNum page_num = find_free_page();
+  if (page_num == BP_INVALID_PAGE_NUM) {
+    RC rc = extend_file(file_header_->page_count + 1);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to extend file. file=%s, page count=%d, rc=%s",
+               file_name_.c_str(), file_header_->page_count, strrc(rc));
+      return rc;
+    }
+
+    page_num = find_free_page();
+    ASSERT(page_num != BP_INVALID_PAGE_NUM, "cannot find free page after extend file. file=%s", file_name_.c_str());
   }
 
-  PageNum page_num        = file_header_->page_count;
-  Frame  *allocated_frame = nullptr;
-  if ((rc = allocate_frame(page_num, &allocated_frame)) != RC::SUCCESS) {
+  Frame *allocated_frame = nullptr;
+  RC     rc              = allocate_frame(page_num, &allocated_frame);
+  if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to allocate frame %s, due to no free page.", file_name_.c_str());
-    lock_.unlock();
     return rc;
   }
 
-  LOG_INFO("allocate new page. file=%s, pageNum=%d, pin=%d",
-           file_name_.c_str(), page_num, allocated_frame->pin_count());
-
+  set_page_allocated(page_num, true);
   file_header_->allocated_pages++;
-  file_header_->page_count++;
-
-  byte = page_num / 8;
-  bit  = page_num % 8;
-  file_header_->bitmap[byte] |= (1 << bit);
   hdr_frame_->mark_dirty();
 
+  LOG_DEBUG("allocate page. file=%s, pageNum=%d, pin=%d", file_name_.c_str(), page_num, allocated_frame->pin_count());
+
+  // 新分配的页面不需要从磁盘读取，磁盘上可能是已经释放的页面的数据，或者还没有写过
   allocated_frame->set_file_desc(file_desc_);
   allocated_frame->access();
   allocated_frame->clear_page();
-  allocated_frame->set_page_num(file_header_->page_count - 1);
-
-  // Use flush operation to extension file
-  if ((rc = flush_page_internal(*allocated_frame)) != RC::SUCCESS) {
-    LOG_WARN("Failed to alloc page %s , due to failed to extend one page.", file_name_.c_str());
-    // skip return false, delay flush the extended page
-    // return tmp;
-  }
-
-  lock_.unlock();
+  allocated_frame->set_page_num(page_num);
+  allocated_frame->mark_dirty();
 
   *frame = allocated_frame;
   return RC::SUCCESS;
@@ -390,6 +768,11 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 
 RC DiskBufferPool::dispose_page(PageNum page_num)
 {
+  if (mmap_base_ != nullptr) {
+    LOG_WARN("cannot dispose page in a readonly file. file=%s, page=%d", file_name_.c_str(), page_num);
+    return RC::BUFFERPOOL_READONLY;
+  }
+
   std::scoped_lock lock_guard(lock_);
   Frame           *used_frame = frame_manager_.get(file_desc_, page_num);
   if (used_frame != nullptr) {
@@ -402,8 +785,7 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
 
   hdr_frame_->mark_dirty();
   file_header_->allocated_pages--;
-  char tmp = 1 << (page_num % 8);
-  file_header_->bitmap[page_num / 8] &= ~tmp;
+  set_page_allocated(page_num, false);
   return RC::SUCCESS;
 }
 
@@ -447,15 +829,36 @@ RC DiskBufferPool::purge_page(PageNum page_num)
 
 RC DiskBufferPool::purge_all_pages()
 {
-  std::list<Frame *> used = frame_manager_.find_list(file_desc_);
+  // 后台刷脏页的线程会短暂地pin住页帧，这些页帧需要等它处理完再释放。
+  // 等待时不能持有当前buffer pool的锁，因为后台线程刷盘时也需要这把锁
+  for (int retry = 0; retry < PURGE_PAGES_RETRY_TIMES; retry++) {
+    std::list<Frame *> used = frame_manager_.find_list(file_desc_);
+    if (used.empty()) {
+      return RC::SUCCESS;
+    }
 
-  std::scoped_lock lock_guard(lock_);
-  for (std::list<Frame *>::iterator it = used.begin(); it != used.end(); ++it) {
-    Frame *frame = *it;
+    bool wait_cleaner = false;
+    {
+      std::scoped_lock lock_guard(lock_);
+      for (Frame *frame : used) {
+        if (purge_frame(frame->page_num(), frame) != RC::SUCCESS) {
+          // 后台线程还pin着这个页帧，或者在 purge_frame 之后刚刚放开(只剩下当前线程的pin)，都需要再试一次。
+          // 其它情况是页帧被前台pin住了，与原来一样不等待
+          wait_cleaner = wait_cleaner || partition_.page_cleaner().holding(frame) || frame->pin_count() == 1;
+          frame->unpin();
+        }
+      }
+    }
 
-    purge_frame(frame->page_num(), frame);
+    if (!wait_cleaner) {
+      return RC::SUCCESS;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
-  return RC::SUCCESS;
+
+  // 页帧还在页帧表中，不能关闭文件，否则后台线程可能会写到一个已经关闭或者被复用的文件描述符
+  LOG_ERROR("some pages are still held by page cleaner after purge all pages. file=%s", file_name_.c_str());
+  return RC::LOCKED_UNLOCK;
 }
 
 RC DiskBufferPool::check_all_pages_unpinned()
@@ -479,25 +882,26 @@ RC DiskBufferPool::check_all_pages_unpinned()
 
 RC DiskBufferPool::flush_page(Frame &frame)
 {
-  std::scoped_lock lock_guard(lock_);
+  // 写页面时带上了文件偏移，不需要加锁保护文件的读写位置
   return flush_page_internal(frame);
 }
 
 RC DiskBufferPool::flush_page_internal(Frame &frame)
 {
-  // The better way is use mmap the block into memory,
-  // so it is easier to flush data to file.
+  // 只读文件的页帧就是映射的内存，由操作系统写回文件
+  if (mmap_base_ != nullptr) {
+    frame.clear_dirty();
+    return RC::SUCCESS;
+  }
 
   Page   &page   = frame.page();
   int64_t offset = ((int64_t)page.page_num) * sizeof(Page);
-  if (lseek(file_desc_, offset, SEEK_SET) == offset - 1) {
-    LOG_ERROR("Failed to flush page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_SEEK;
-  }
-
-  if (writen(file_desc_, &page, sizeof(Page)) != 0) {
-    LOG_ERROR("Failed to flush page %lld of %d due to %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_WRITE;
+  auto    start  = BufferPoolStats::Clock::now();
+  RC      rc     = bp_manager_.page_io().write(file_desc_, offset, &page, sizeof(Page));
+  stats_.add_write(1, 1, start);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to flush page %lld of %d. rc=%s", offset, file_desc_, strrc(rc));
+    return rc;
   }
   frame.clear_dirty();
   LOG_DEBUG("Flush block. file desc=%d, pageNum=%d, pin count=%d", file_desc_, page.page_num, frame.pin_count());
@@ -507,28 +911,116 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
 
 RC DiskBufferPool::flush_all_pages()
 {
-  std::list<Frame *> used = frame_manager_.find_list(file_desc_);
+  if (mmap_base_ != nullptr) {
+    if (msync(mmap_base_, (size_t)mmap_page_count_ * BP_PAGE_SIZE, MS_SYNC) != 0) {
+      LOG_WARN("failed to sync mapped file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+      return RC::IOERR_SYNC;
+    }
+    return RC::SUCCESS;
+  }
+
+  std::list<Frame *>   used = frame_manager_.find_list(file_desc_);
+  std::vector<Frame *> dirty_frames;
   for (Frame *frame : used) {
-    RC rc = flush_page(*frame);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to flush all pages");
-      return rc;
+    if (frame->dirty()) {
+      dirty_frames.push_back(frame);
+    }
+  }
+
+  // 按照页面编号排序，让写入是顺序的，并且可以把连续的页面合并成一个请求
+  std::sort(dirty_frames.begin(), dirty_frames.end(), [](const Frame *left, const Frame *right) {
+    return left->page_num() < right->page_num();
+  });
+
+  std::vector<iovec> iovs(dirty_frames.size());
+  for (size_t i = 0; i < dirty_frames.size(); i++) {
+    iovs[i] = iovec{&dirty_frames[i]->page(), sizeof(Page)};
+  }
+
+  RC  rc       = RC::SUCCESS;
+  int io_count = 0;
+  for (size_t batch_start = 0; batch_start < dirty_frames.size(); batch_start += FLUSH_BATCH_PAGES) {
+    const size_t batch_end = std::min(dirty_frames.size(), batch_start + FLUSH_BATCH_PAGES);
+
+    std::vector<PageIORequest> requests;
+    std::vector<size_t>        request_starts;  // 每个请求的第一个页面在dirty_frames中的位置
+    for (size_t i = batch_start; i < batch_end; i++) {
+      if (!requests.empty() && dirty_frames[i]->page_num() == dirty_frames[i - 1]->page_num() + 1 &&
+          requests.back().iovcnt < FLUSH_MAX_PAGES_PER_IO) {
+        requests.back().iovcnt++;
+        continue;
+      }
+
+      PageIORequest request;
+      request.type   = PageIORequest::Type::WRITE;
+      request.fd     = file_desc_;
+      request.offset = ((int64_t)dirty_frames[i]->page_num()) * sizeof(Page);
+      request.iov    = &iovs[i];
+      request.iovcnt = 1;
+      requests.push_back(request);
+      request_starts.push_back(i);
+    }
+
+    bp_manager_.throttle_flush(static_cast<int>(batch_end - batch_start));
+
+    auto start    = BufferPoolStats::Clock::now();
+    RC   batch_rc = bp_manager_.page_io().submit(requests.data(), static_cast<int>(requests.size()));
+    stats_.add_write(static_cast<int>(requests.size()), static_cast<int>(batch_end - batch_start), start);
+    io_count += static_cast<int>(requests.size());
+
+    for (size_t r = 0; r < requests.size(); r++) {
+      if (OB_FAIL(requests[r].rc)) {
+        continue;
+      }
+      for (int i = 0; i < requests[r].iovcnt; i++) {
+        dirty_frames[request_starts[r] + i]->clear_dirty();
+      }
+    }
+
+    if (OB_FAIL(batch_rc)) {
+      rc = batch_rc;
+      break;
     }
   }
+
+  for (Frame *frame : used) {
+    frame->unpin();
+  }
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush all pages. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+  LOG_DEBUG("flush all pages. file=%s, dirty pages=%d, ios=%d", file_name_.c_str(), (int)dirty_frames.size(), io_count);
   return RC::SUCCESS;
 }
 
 RC DiskBufferPool::recover_page(PageNum page_num)
 {
-  int byte = 0, bit = 0;
-  byte = page_num / 8;
-  bit  = page_num % 8;
+  if (mmap_base_ != nullptr && !page_allocated(page_num)) {
+    LOG_WARN("cannot allocate page in a readonly file while recover page. file=%s, page=%d",
+             file_name_.c_str(), page_num);
+    return RC::BUFFERPOOL_READONLY;
+  }
+  if (!writable()) {
+    LOG_WARN("cannot modify page in a file mapped without write permission. file=%s, page=%d",
+             file_name_.c_str(), page_num);
+    return RC::BUFFERPOOL_READONLY;
+  }
 
   std::scoped_lock lock_guard(lock_);
-  if (!(file_header_->bitmap[byte] & (1 << bit))) {
-    file_header_->bitmap[byte] |= (1 << bit);
+  if (page_num >= file_header_->page_count) {
+    RC rc = extend_file(page_num + 1);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to extend file while recover page. file=%s, page=%d, rc=%s",
+               file_name_.c_str(), page_num, strrc(rc));
+      return rc;
+    }
+  }
+
+  if (!page_allocated(page_num)) {
+    set_page_allocated(page_num, true);
     file_header_->allocated_pages++;
-    file_header_->page_count++;
     hdr_frame_->mark_dirty();
   }
   return RC::SUCCESS;
@@ -536,9 +1028,48 @@ RC DiskBufferPool::recover_page(PageNum page_num)
 
 RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 {
-  auto purger = [this](Frame *frame) {
-    if (!frame->dirty()) {
-      return RC::SUCCESS;
+  while (true) {
+    Frame *frame = frame_manager_.alloc(file_desc_, page_num);
+    if (frame != nullptr) {
+      *buffer = frame;
+      return RC::SUCCESS;
+    }
+
+    make_free_frame();
+  }
+  return RC::BUFFERPOOL_NOBUF;
+}
+
+RC DiskBufferPool::allocate_detached_frame(Frame **buffer)
+{
+  while (true) {
+    Frame *frame = frame_manager_.alloc_detached();
+    if (frame != nullptr) {
+      *buffer = frame;
+      return RC::SUCCESS;
+    }
+
+    make_free_frame();
+  }
+  return RC::BUFFERPOOL_NOBUF;
+}
+
+void DiskBufferPool::make_free_frame()
+{
+  // 优先淘汰干净的页帧，前台线程不需要为其它页面做磁盘写
+  if (frame_manager_.evict_clean_frames(1 /*count*/) > 0) {
+    return;
+  }
+
+  // 没有干净的页帧，让后台线程刷一些脏页出来。
+  // 当前线程可能持有buffer pool的锁，不能让其它访问这个文件的线程等太久，所以只等待一小段时间
+  if (partition_.page_cleaner().wait_free_frames(WAIT_PAGE_CLEANER_MS)) {
+    return;
+  }
+
+  auto purger = [this](Frame *frame) {
+    if (!frame->dirty()) {
+      return RC::SUCCESS;
     }
 
     RC rc = RC::SUCCESS;
@@ -554,17 +1085,78 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
     return rc;
   };
 
-  while (true) {
-    Frame *frame = frame_manager_.alloc(file_desc_, page_num);
-    if (frame != nullptr) {
-      *buffer = frame;
-      return RC::SUCCESS;
-    }
+  LOG_TRACE("frames are all allocated, so we should purge some frames to get one free frame");
+  (void)frame_manager_.purge_frames(1 /*count*/, purger);
+}
 
-    LOG_TRACE("frames are all allocated, so we should purge some frames to get one free frame");
-    (void)frame_manager_.purge_frames(1 /*count*/, purger);
+std::shared_ptr<DiskBufferPool::PageLoad> DiskBufferPool::begin_load(PageNum page_num, bool &owner)
+{
+  std::lock_guard<std::mutex> lock_guard(load_lock_);
+
+  auto iter = loading_pages_.find(page_num);
+  if (iter != loading_pages_.end()) {
+    owner = false;
+    return iter->second;
   }
-  return RC::BUFFERPOOL_NOBUF;
+
+  auto load = std::make_shared<PageLoad>();
+  loading_pages_.emplace(page_num, load);
+  owner = true;
+  return load;
+}
+
+void DiskBufferPool::end_load(PageNum page_num, RC rc)
+{
+  std::lock_guard<std::mutex> lock_guard(load_lock_);
+
+  auto iter = loading_pages_.find(page_num);
+  ASSERT(iter != loading_pages_.end(), "page is not loading. file=%s, page=%d", file_name_.c_str(), page_num);
+
+  std::shared_ptr<PageLoad> load = iter->second;
+  loading_pages_.erase(iter);
+  load->done = true;
+  load->rc   = rc;
+  load->cv.notify_all();
+}
+
+RC DiskBufferPool::wait_load(const std::shared_ptr<PageLoad> &load)
+{
+  std::unique_lock<std::mutex> lock_guard(load_lock_);
+  load->cv.wait(lock_guard, [&load]() { return load->done; });
+  return load->rc;
+}
+
+RC DiskBufferPool::load_frame(PageNum page_num, Frame **frame)
+{
+  Frame *allocated_frame = nullptr;
+  RC     rc              = allocate_detached_frame(&allocated_frame);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to alloc frame %s:%d, due to failed to alloc page.", file_name_.c_str(), page_num);
+    return rc;
+  }
+
+  // 加载期间页帧不在页帧表中，其它线程看不到它，所以不需要加锁
+  allocated_frame->set_file_desc(file_desc_);
+  allocated_frame->set_page_num(page_num);
+  rc = load_page(page_num, allocated_frame);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load page %s:%d", file_name_.c_str(), page_num);
+    frame_manager_.free_detached(allocated_frame);
+    return rc;
+  }
+
+  allocated_frame->clear_dirty();
+  if (!frame_manager_.attach(file_desc_, page_num, allocated_frame, true /*pin*/)) {
+    // 页面加载都需要先在 loading_pages_ 中登记，正常不会走到这里
+    allocated_frame = frame_manager_.get(file_desc_, page_num);
+    if (allocated_frame == nullptr) {
+      return RC::BUFFERPOOL_NOBUF;
+    }
+  }
+
+  allocated_frame->access();
+  *frame = allocated_frame;
+  return RC::SUCCESS;
 }
 
 RC DiskBufferPool::check_page_num(PageNum page_num)
@@ -573,53 +1165,765 @@ RC DiskBufferPool::check_page_num(PageNum page_num)
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
-  if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+  if (!page_allocated(page_num)) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::upgrade_file_header()
+{
+  // 老格式的文件头中直接存放位图，最多 (BP_PAGE_DATA_SIZE - 8) * 8 个页面，一个位图页就能放下。
+  // 位图页放在文件的最后，先写位图页，再写文件头
+  const int32_t old_page_count      = file_header_->page_count;
+  const int32_t old_allocated_pages = file_header_->allocated_pages;
+  const char   *old_bitmap          = reinterpret_cast<const char *>(&file_header_->magic);
+  if (old_page_count <= 0 || old_page_count >= BP_GROUP_PAGE_NUM || (old_bitmap[0] & 0x01) == 0) {
+    LOG_ERROR("invalid file header. file=%s, header=%s", file_name_.c_str(), file_header_->to_string().c_str());
+    return RC::INTERNAL;
+  }
+
+  const PageNum bitmap_page  = old_page_count;
+  Frame        *bitmap_frame = nullptr;
+  RC            rc           = allocate_frame(bitmap_page, &bitmap_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate frame for bitmap page. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  bitmap_frame->set_file_desc(file_desc_);
+  bitmap_frame->access();
+  bitmap_frame->clear_page();
+  bitmap_frame->set_page_num(bitmap_page);
+  memcpy(bitmap_frame->data(), old_bitmap, (old_page_count + 7) / 8);
+  Bitmap(bitmap_frame->data(), BP_GROUP_PAGE_NUM).set_bit(bitmap_page);
+
+  rc = flush_page_internal(*bitmap_frame);
+  bitmap_frame->unpin();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write bitmap page. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  memset(hdr_frame_->data(), 0, BP_PAGE_DATA_SIZE);
+  file_header_->page_count      = old_page_count + 1;
+  file_header_->allocated_pages = old_allocated_pages + 1;
+  file_header_->magic           = BP_FILE_MAGIC;
+  file_header_->group_count     = 1;
+  file_header_->bitmap_pages[0] = bitmap_page;
+  rc                            = flush_page_internal(*hdr_frame_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write file header. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("upgrade buffer pool file header. file=%s, header=%s", file_name_.c_str(), file_header_->to_string().c_str());
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::load_page_groups()
+{
+  if (file_header_->group_count <= 0 || file_header_->group_count > BPFileHeader::MAX_GROUP_NUM ||
+      file_header_->page_count > file_header_->group_count * BP_GROUP_PAGE_NUM) {
+    LOG_ERROR("invalid file header. file=%s, header=%s", file_name_.c_str(), file_header_->to_string().c_str());
+    return RC::INTERNAL;
+  }
+
+  free_groups_.assign((BPFileHeader::MAX_GROUP_NUM + 63) / 64, 0);
+  for (int i = 0; i < file_header_->group_count; i++) {
+    const PageNum bitmap_page = file_header_->bitmap_pages[i];
+
+    PageGroup group;
+    RC        rc = RC::SUCCESS;
+    if (mmap_base_ != nullptr) {
+      rc = get_mapped_page(bitmap_page, &group.bitmap_frame);
+    } else if (OB_SUCC(rc = allocate_frame(bitmap_page, &group.bitmap_frame))) {
+      group.bitmap_frame->set_file_desc(file_desc_);
+      group.bitmap_frame->access();
+      rc = load_page(bitmap_page, group.bitmap_frame);
+      if (OB_FAIL(rc)) {
+        purge_frame(bitmap_page, group.bitmap_frame);
+      }
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to load bitmap page. file=%s, group=%d, page=%d, rc=%s",
+               file_name_.c_str(), i, bitmap_page, strrc(rc));
+      return rc;
+    }
+
+    group.free_words.assign((GROUP_WORD_NUM + 63) / 64, 0);
+    page_groups_.push_back(std::move(group));
+    for (int word = 0; word < GROUP_WORD_NUM; word++) {
+      page_groups_[i].free_pages += refresh_free_word(i, word);
+    }
+    assign_bit(free_groups_, i, page_groups_[i].free_pages > 0);
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::add_page_group()
+{
+  // 位图页放在分组中第一个extent的最后一个页面，这样第一个分组中，文件头之后的第一个页面依然是
+  // 第一个分配出去的页面(比如B+树的文件头)
+  const int     group       = file_header_->group_count;
+  const PageNum first_page  = group * BP_GROUP_PAGE_NUM;
+  const PageNum bitmap_page = first_page + BP_EXTENT_PAGE_NUM - 1;
+  ASSERT(file_header_->page_count == first_page, "page count should be the first page of a group. page count=%d",
+         file_header_->page_count);
+  if (group >= BPFileHeader::MAX_GROUP_NUM) {
+    LOG_WARN("file buffer pool is full. page count %d, max page count %d",
+             file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
+    return RC::BUFFERPOOL_NOBUF;
+  }
+
+  Frame *bitmap_frame = nullptr;
+  RC     rc           = allocate_frame(bitmap_page, &bitmap_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate frame for bitmap page. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  bitmap_frame->set_file_desc(file_desc_);
+  bitmap_frame->access();
+  bitmap_frame->clear_page();
+  bitmap_frame->set_page_num(bitmap_page);
+  Bitmap(bitmap_frame->data(), BP_GROUP_PAGE_NUM).set_bit(bitmap_page - first_page);
+  bitmap_frame->mark_dirty();
+
+  PageGroup page_group;
+  page_group.bitmap_frame = bitmap_frame;
+  page_group.free_words.assign((GROUP_WORD_NUM + 63) / 64, 0);
+  page_groups_.push_back(std::move(page_group));
+
+  file_header_->bitmap_pages[group] = bitmap_page;
+  file_header_->group_count++;
+  file_header_->allocated_pages++;
+  hdr_frame_->mark_dirty();
+
+  LOG_INFO("add page group. file=%s, group=%d, bitmap page=%d", file_name_.c_str(), group, bitmap_page);
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::extend_file(PageNum page_count)
+{
+  // 先算出扩展之后的页面个数，把文件一次扩展到这个长度，失败时不修改文件头
+  PageNum target = file_header_->page_count;
+  while (target < page_count) {
+    const int group = target / BP_GROUP_PAGE_NUM;
+    target          = std::min(target + BP_EXTENT_PAGE_NUM, (group + 1) * BP_GROUP_PAGE_NUM);
+  }
+  if (target > file_header_->page_count) {
+    RC rc = grow_file(file_header_->page_count, target);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  while (file_header_->page_count < page_count) {
+    const int group = file_header_->page_count / BP_GROUP_PAGE_NUM;
+    if (group >= file_header_->group_count) {
+      RC rc = add_page_group();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    // 一次扩展一个extent，但是不超过当前分组
+    const PageNum start_page = file_header_->page_count;
+    const PageNum end_page   = std::min(start_page + BP_EXTENT_PAGE_NUM, (group + 1) * BP_GROUP_PAGE_NUM);
+
+    file_header_->page_count = end_page;
+    hdr_frame_->mark_dirty();
+
+    PageGroup &page_group = page_groups_[group];
+    Bitmap     bitmap(page_group.bitmap_frame->data(), BP_GROUP_PAGE_NUM);
+    for (PageNum page_num = start_page; page_num < end_page; page_num++) {
+      if (!bitmap.get_bit(page_num - group * BP_GROUP_PAGE_NUM)) {
+        page_group.free_pages++;
+      }
+    }
+
+    const int start_word = (start_page - group * BP_GROUP_PAGE_NUM) / 64;
+    const int end_word   = (end_page - 1 - group * BP_GROUP_PAGE_NUM) / 64;
+    for (int word = start_word; word <= end_word; word++) {
+      refresh_free_word(group, word);
+    }
+    assign_bit(free_groups_, group, page_group.free_pages > 0);
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::grow_file(PageNum start_page, PageNum end_page)
+{
+  const off_t start_offset = (off_t)start_page * BP_PAGE_SIZE;
+  const off_t end_offset   = (off_t)end_page * BP_PAGE_SIZE;
+
+  // 优先预先分配磁盘空间，让一个extent中的页面在磁盘上尽量连续，只分配空间，不会修改文件中已经存在的数据。
+  // 文件系统不支持时再修改文件长度，扩展出来的部分读出来都是0
+#ifdef __linux__
+  if (fallocate(file_desc_, 0, start_offset, end_offset - start_offset) == 0) {
+    return RC::SUCCESS;
+  }
+  LOG_TRACE("failed to fallocate file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+#endif
+
+  struct stat st;
+  if (fstat(file_desc_, &st) != 0) {
+    LOG_ERROR("failed to stat file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::IOERR_ACCESS;
+  }
+  if (st.st_size < end_offset && ftruncate(file_desc_, end_offset) != 0) {
+    LOG_ERROR("failed to extend file. file=%s, size=%ld, error=%s", file_name_.c_str(), (long)end_offset, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
+
+PageNum DiskBufferPool::find_free_page()
+{
+  const int group = find_first_bit(free_groups_);
+  if (group < 0) {
+    return BP_INVALID_PAGE_NUM;
+  }
+
+  const PageGroup &page_group = page_groups_[group];
+  const int        word_index = find_first_bit(page_group.free_words);
+  ASSERT(word_index >= 0, "group has free pages but no free word. group=%d", group);
+
+  const uint64_t word = load_bitmap_word(page_group.bitmap_frame->data(), word_index);
+  return group * BP_GROUP_PAGE_NUM + word_index * 64 + __builtin_ctzll(~word);
+}
+
+bool DiskBufferPool::page_allocated(PageNum page_num)
+{
+  if (page_num < 0 || page_num >= file_header_->page_count ||
+      page_num / BP_GROUP_PAGE_NUM >= static_cast<int>(page_groups_.size())) {
+    return false;
+  }
+  const PageGroup &page_group = page_groups_[page_num / BP_GROUP_PAGE_NUM];
+  return Bitmap(page_group.bitmap_frame->data(), BP_GROUP_PAGE_NUM).get_bit(page_num % BP_GROUP_PAGE_NUM);
+}
+
+void DiskBufferPool::set_page_allocated(PageNum page_num, bool allocated)
+{
+  const int  group      = page_num / BP_GROUP_PAGE_NUM;
+  const int  offset     = page_num % BP_GROUP_PAGE_NUM;
+  PageGroup &page_group = page_groups_[group];
+  Bitmap     bitmap(page_group.bitmap_frame->data(), BP_GROUP_PAGE_NUM);
+  if (bitmap.get_bit(offset) == allocated) {
+    return;
+  }
+
+  if (allocated) {
+    bitmap.set_bit(offset);
+    page_group.free_pages--;
+  } else {
+    bitmap.clear_bit(offset);
+    page_group.free_pages++;
+  }
+  page_group.bitmap_frame->mark_dirty();
+
+  refresh_free_word(group, offset / 64);
+  assign_bit(free_groups_, group, page_group.free_pages > 0);
+}
+
+int DiskBufferPool::refresh_free_word(int group, int word_index)
+{
+  // 只有文件范围内的页面才是空闲页面
+  const PageNum first_page = group * BP_GROUP_PAGE_NUM + word_index * 64;
+  const int     valid_bits = std::min(std::max(file_header_->page_count - first_page, 0), 64);
+  const uint64_t valid_mask = valid_bits == 64 ? ~0ULL : ((1ULL << valid_bits) - 1);
+
+  PageGroup     &page_group = page_groups_[group];
+  const uint64_t word       = load_bitmap_word(page_group.bitmap_frame->data(), word_index);
+  const uint64_t free_bits  = ~word & valid_mask;
+  assign_bit(page_group.free_words, word_index, free_bits != 0);
+  return __builtin_popcountll(free_bits);
+}
+
+PageNum DiskBufferPool::next_allocated_page(PageNum start_page)
+{
+  std::scoped_lock lock_guard(lock_);
+
+  PageNum page_num = std::max(start_page, 0);
+  while (page_num < file_header_->page_count) {
+    const int   group      = page_num / BP_GROUP_PAGE_NUM;
+    const char *bitmap     = page_groups_[group].bitmap_frame->data();
+    int         word_index = (page_num % BP_GROUP_PAGE_NUM) / 64;
+    uint64_t    word       = load_bitmap_word(bitmap, word_index) & (~0ULL << (page_num % 64));
+    while (word == 0 && ++word_index < GROUP_WORD_NUM) {
+      word = load_bitmap_word(bitmap, word_index);
+    }
+
+    if (word == 0) {
+      page_num = (group + 1) * BP_GROUP_PAGE_NUM;
+      continue;
+    }
+
+    page_num = group * BP_GROUP_PAGE_NUM + word_index * 64 + __builtin_ctzll(word);
+    if (page_num >= file_header_->page_count) {
+      break;
+    }
+
+    // 文件头和位图页不是给用户使用的页面
+    if (page_num == BP_HEADER_PAGE || page_num == file_header_->bitmap_pages[group]) {
+      page_num++;
+      continue;
+    }
+    return page_num;
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
 RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 {
   int64_t offset = ((int64_t)page_num) * BP_PAGE_SIZE;
-  if (lseek(file_desc_, offset, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to load page %s:%d, due to failed to lseek:%s.", file_name_.c_str(), page_num, strerror(errno));
+  Page   &page   = frame->page();
+  auto    start  = BufferPoolStats::Clock::now();
+  RC      rc     = bp_manager_.page_io().read(file_desc_, offset, &page, BP_PAGE_SIZE);
+  stats_.add_read(1, 1, start);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, rc=%s, page count=%d",
+              file_name_.c_str(), file_desc_, page_num, strrc(rc), file_header_->allocated_pages);
+    return rc;
+  }
+  return RC::SUCCESS;
+}
 
-    return RC::IOERR_SEEK;
+RC DiskBufferPool::load_pages(const std::vector<Frame *> &frames)
+{
+  std::vector<iovec> iovs(frames.size());
+  for (size_t i = 0; i < frames.size(); i++) {
+    iovs[i].iov_base = &frames[i]->page();
+    iovs[i].iov_len  = BP_PAGE_SIZE;
   }
 
-  Page &page = frame->page();
-  int   ret  = readn(file_desc_, &page, BP_PAGE_SIZE);
-  if (ret != 0) {
-    LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, due to failed to read data:%s, ret=%d, page count=%d",
-              file_name_.c_str(), file_desc_, page_num, strerror(errno), ret, file_header_->allocated_pages);
-    return RC::IOERR_READ;
+  std::vector<PageIORequest> requests;
+  for (size_t i = 0; i < frames.size(); i++) {
+    if (!requests.empty() && frames[i]->page_num() == frames[i - 1]->page_num() + 1) {
+      requests.back().iovcnt++;
+      continue;
+    }
+
+    PageIORequest request;
+    request.type   = PageIORequest::Type::READ;
+    request.fd     = file_desc_;
+    request.offset = ((int64_t)frames[i]->page_num()) * BP_PAGE_SIZE;
+    request.iov    = &iovs[i];
+    request.iovcnt = 1;
+    requests.push_back(request);
+  }
+
+  auto start = BufferPoolStats::Clock::now();
+  RC   rc    = bp_manager_.page_io().submit(requests.data(), static_cast<int>(requests.size()));
+  stats_.add_read(static_cast<int>(requests.size()), static_cast<int>(frames.size()), start);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to load pages %s, count=%d, rc=%s", file_name_.c_str(), (int)frames.size(), strrc(rc));
+  }
+  return rc;
+}
+
+void DiskBufferPool::read_ahead(PageNum start_page, int count)
+{
+  if (count <= 0) {
+    return;
+  }
+
+  {
+    // 检查和计数要在同一把锁下完成，否则 close_file 可能在两步之间看到计数为0并开始关闭文件
+    std::lock_guard<std::mutex> read_ahead_guard(read_ahead_lock_);
+    if (closing_) {
+      return;
+    }
+    if (pending_read_ahead_ >= MAX_PENDING_READ_AHEAD) {
+      LOG_TRACE("too many pending read ahead tasks. file=%s", file_name_.c_str());
+      return;
+    }
+    pending_read_ahead_++;
+  }
+
+  auto task = [this, start_page, count]() {
+    bool closing = false;
+    {
+      std::lock_guard<std::mutex> read_ahead_guard(read_ahead_lock_);
+      closing = closing_;
+    }
+    if (!closing) {
+      (void)read_ahead_internal(start_page, count);
+    }
+
+    // 在锁内通知，close_file 拿到锁之后当前对象才可能被删除，解锁之后不能再访问this
+    std::lock_guard<std::mutex> read_ahead_guard(read_ahead_lock_);
+    pending_read_ahead_--;
+    read_ahead_cv_.notify_all();
+  };
+
+  if (!bp_manager_.submit_read_ahead(task)) {
+    task();
+  }
+}
+
+RC DiskBufferPool::read_ahead_internal(PageNum start_page, int count)
+{
+  std::vector<PageNum> pages;
+  pages.reserve(count);
+  for (PageNum page_num = start_page; page_num < start_page + count; page_num++) {
+    pages.push_back(page_num);
+  }
+
+  int load_count = 0;
+  (void)prefetch_pages(pages, load_count);
+  LOG_DEBUG("read ahead done. file=%s, start=%d, count=%d, loaded=%d",
+            file_name_.c_str(), start_page, count, load_count);
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::prefetch_pages(const std::vector<PageNum> &pages, int &load_count)
+{
+  load_count = 0;
+
+  // 需要加载的页面一起提交，连续的页面会合并成一个IO请求
+  RC                   rc = RC::SUCCESS;
+  std::vector<Frame *> frames;
+  {
+    std::scoped_lock lock_guard(lock_);
+
+    for (PageNum page_num : pages) {
+      if (page_num >= file_header_->page_count || !page_allocated(page_num)) {
+        continue;
+      }
+
+      // 其它线程正在加载的页面不需要再加载
+      bool owner = false;
+      (void)begin_load(page_num, owner);
+      if (!owner) {
+        continue;
+      }
+
+      Frame *frame = frame_manager_.get(file_desc_, page_num);
+      if (frame != nullptr) {
+        frame->unpin();
+        end_load(page_num, RC::SUCCESS);
+        continue;
+      }
+
+      frame = frame_manager_.alloc_detached();
+      if (frame == nullptr) {
+        // 没有空闲的页帧了，不为了预加载去刷脏页
+        end_load(page_num, RC::SUCCESS);
+        rc = RC::BUFFERPOOL_NOBUF;
+        break;
+      }
+
+      frame->set_file_desc(file_desc_);
+      frame->set_page_num(page_num);
+      frames.push_back(frame);
+    }
+  }
+
+  // 加载页面时不持有缓冲池的锁，只有访问这些页面的线程需要等待
+  RC load_rc = frames.empty() ? RC::SUCCESS : load_pages(frames);
+  for (Frame *frame : frames) {
+    const PageNum page_num = frame->page_num();
+    if (OB_SUCC(load_rc)) {
+      frame->clear_dirty();
+      frame->access();
+      if (frame_manager_.attach(file_desc_, page_num, frame)) {
+        load_count++;
+      }
+    } else {
+      frame_manager_.free_detached(frame);
+    }
+    // 预加载失败不影响正常的访问，等待的线程会自己再加载一次
+    end_load(page_num, RC::SUCCESS);
+  }
+  stats_.add_prefetch(load_count);
+  return OB_FAIL(load_rc) ? load_rc : rc;
+}
+
+int DiskBufferPool::warm_up(std::vector<PageNum> pages)
+{
+  if (mmap_base_ != nullptr) {
+    return 0;
   }
+
+  std::sort(pages.begin(), pages.end());
+  pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+  int load_count = 0;
+  for (size_t start = 0; start < pages.size(); start += WARM_UP_BATCH_PAGES) {
+    const size_t         end = std::min(start + WARM_UP_BATCH_PAGES, pages.size());
+    std::vector<PageNum> batch(pages.begin() + start, pages.begin() + end);
+
+    int batch_count = 0;
+    RC  rc          = prefetch_pages(batch, batch_count);
+    load_count += batch_count;
+    if (rc == RC::BUFFERPOOL_NOBUF) {
+      LOG_INFO("no free frames to warm up. file=%s", file_name_.c_str());
+      break;
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to warm up pages. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+      break;
+    }
+  }
+
+  LOG_INFO("warm up done. file=%s, pages=%d, loaded=%d", file_name_.c_str(), (int)pages.size(), load_count);
+  return load_count;
+}
+
+void DiskBufferPool::hint_sequential(PageNum start_page)
+{
+  // 只读文件交给操作系统预读
+  if (mmap_base_ != nullptr) {
+    if (start_page >= 0 && start_page < mmap_page_count_) {
+      (void)madvise(mmap_base_ + (size_t)start_page * BP_PAGE_SIZE,
+                    (size_t)(mmap_page_count_ - start_page) * BP_PAGE_SIZE, MADV_SEQUENTIAL);
+    }
+    return;
+  }
+
+  const int max_pages = bp_manager_.read_ahead_param().max_pages;
+  if (max_pages <= 0) {
+    return;
+  }
+  start_read_ahead_window(start_page, std::min(READ_AHEAD_INIT_PAGES, max_pages));
+}
+
+void DiskBufferPool::check_read_ahead(PageNum page_num, bool hit)
+{
+  const int max_pages = bp_manager_.read_ahead_param().max_pages;
+  if (max_pages <= 0) {
+    return;
+  }
+
+  if (hit) {
+    // 访问到了预读窗口，接着预读下一个窗口
+    PageNum trigger = page_num;
+    if (page_num != read_ahead_trigger_.load() ||
+        !read_ahead_trigger_.compare_exchange_strong(trigger, BP_INVALID_PAGE_NUM)) {
+      return;
+    }
+    start_read_ahead_window(read_ahead_next_.load(), std::min(read_ahead_window_.load() * 2, max_pages));
+  } else {
+    PageNum last_miss_page = last_miss_page_.exchange(page_num);
+    if (page_num == last_miss_page + 1) {
+      start_read_ahead_window(page_num + 1, std::min(READ_AHEAD_INIT_PAGES, max_pages));
+    }
+  }
+}
+
+void DiskBufferPool::start_read_ahead_window(PageNum start_page, int window)
+{
+  read_ahead_window_  = window;
+  read_ahead_next_    = start_page + window;
+  read_ahead_trigger_ = start_page;
+  read_ahead(start_page, window);
+}
+
+RC DiskBufferPool::open_mapped_file(const char *file_name)
+{
+  // 只读的表可能放在没有写权限的存储上，这时只能以只读方式映射，不能回放日志修改页面
+  bool writable = true;
+  int  fd       = open(file_name, O_RDWR);
+  if (fd < 0 && (errno == EACCES || errno == EROFS || errno == EPERM)) {
+    LOG_INFO("no permission to write readonly file, map it readonly. file=%s, error=%s", file_name, strerror(errno));
+    writable = false;
+    fd       = open(file_name, O_RDONLY);
+  }
+  if (fd < 0) {
+    LOG_ERROR("Failed to open file %s, because %s.", file_name, strerror(errno));
+    return RC::IOERR_ACCESS;
+  }
+
+  // 先读文件头，映射的范围是文件头中记录的页面个数
+  Page header_page;
+  RC   rc = bp_manager_.page_io().read(fd, 0, &header_page, BP_PAGE_SIZE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load first page of %s. rc=%s", file_name, strrc(rc));
+    close(fd);
+    return rc;
+  }
+
+  const BPFileHeader *file_header = (const BPFileHeader *)header_page.data;
+  if (file_header->magic != BP_FILE_MAGIC) {
+    LOG_ERROR("readonly file should be upgraded first, open it without readonly once. file=%s", file_name);
+    close(fd);
+    return RC::BUFFERPOOL_READONLY;
+  }
+
+  // 文件可能比文件头中记录的短(比如老版本扩展文件时没有写最后一个extent)，映射超出文件大小的部分，访问时会收到SIGBUS。
+  // 只映射文件中实际存在的页面，不修改文件，访问后面的页面时返回错误
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_ERROR("Failed to stat file %s, because %s.", file_name, strerror(errno));
+    close(fd);
+    return RC::IOERR_ACCESS;
+  }
+  const PageNum page_count = std::min(file_header->page_count, static_cast<PageNum>(st.st_size / BP_PAGE_SIZE));
+  const size_t  map_size   = (size_t)page_count * BP_PAGE_SIZE;
+  if (page_count < file_header->page_count) {
+    LOG_WARN("file is shorter than its header, map the pages in file only. file=%s, page count=%d, mapped=%d",
+             file_name, file_header->page_count, page_count);
+  }
+
+  const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void     *base = mmap(nullptr, map_size, prot, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    LOG_ERROR("Failed to mmap file %s, because %s.", file_name, strerror(errno));
+    close(fd);
+    return RC::IOERR_ACCESS;
+  }
+
+  file_name_       = file_name;
+  file_desc_       = fd;
+  mmap_base_       = static_cast<char *>(base);
+  mmap_page_count_ = page_count;
+  mmap_writable_   = writable;
+  mmap_frames_.reset(new std::atomic<Frame *>[page_count]());
+
+  (void)get_mapped_page(BP_HEADER_PAGE, &hdr_frame_);
+  file_header_ = (BPFileHeader *)hdr_frame_->data();
+
+  rc = load_page_groups();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load page groups of %s. rc=%s", file_name, strrc(rc));
+    for (PageGroup &group : page_groups_) {
+      group.bitmap_frame->unpin();
+    }
+    page_groups_.clear();
+    hdr_frame_->unpin();
+    (void)unmap_file();
+    close(fd);
+    file_desc_ = -1;
+    return rc;
+  }
+
+  LOG_INFO("Successfully open readonly file %s. file_desc=%d, file header=%s",
+           file_name, file_desc_, file_header_->to_string().c_str());
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::get_mapped_page(PageNum page_num, Frame **frame)
+{
+  if (page_num < 0 || page_num >= mmap_page_count_) {
+    LOG_WARN("invalid page num. file=%s, page=%d, page count=%d", file_name_.c_str(), page_num, mmap_page_count_);
+    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
+  }
+
+  std::atomic<Frame *> &slot   = mmap_frames_[page_num];
+  Frame                *mapped = slot.load();
+  if (nullptr == mapped) {
+    Frame *created = new Frame(reinterpret_cast<Page *>(mmap_base_ + (size_t)page_num * BP_PAGE_SIZE));
+    created->set_file_desc(file_desc_);
+    if (slot.compare_exchange_strong(mapped, created)) {
+      mapped = created;
+    } else {
+      delete created;  // 其它线程已经创建了这个页面的页帧
+    }
+  }
+
+  mapped->pin();
+  mapped->access();
+  stats_.add_hit();
+  *frame = mapped;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::unmap_file()
+{
+  RC rc = RC::SUCCESS;
+  if (msync(mmap_base_, (size_t)mmap_page_count_ * BP_PAGE_SIZE, MS_SYNC) != 0) {
+    LOG_WARN("failed to sync mapped file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    rc = RC::IOERR_SYNC;
+  }
+  if (munmap(mmap_base_, (size_t)mmap_page_count_ * BP_PAGE_SIZE) != 0) {
+    LOG_WARN("failed to unmap file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+  }
+
+  for (PageNum page_num = 0; page_num < mmap_page_count_; page_num++) {
+    Frame *frame = mmap_frames_[page_num].load();
+    if (frame != nullptr && frame->pin_count() > 0) {
+      LOG_WARN("page of readonly file is still pinned while closing. file=%s, page=%d, pin count=%d",
+               file_name_.c_str(), page_num, frame->pin_count());
+    }
+    delete frame;
+  }
+  mmap_frames_.reset();
+  mmap_base_       = nullptr;
+  mmap_page_count_ = 0;
+  mmap_writable_   = false;
+  return rc;
+}
+
 int DiskBufferPool::file_desc() const { return file_desc_; }
+
+PageNum DiskBufferPool::page_count()
+{
+  std::scoped_lock lock_guard(lock_);
+  return file_header_->page_count;
+}
+
+int DiskBufferPool::allocated_pages()
+{
+  std::scoped_lock lock_guard(lock_);
+  return file_header_->allocated_pages;
+}
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+BufferPoolPartition::BufferPoolPartition(BufferPoolManager &bp_manager, const char *name)
+    : name_(name), frame_manager_(name), page_cleaner_(bp_manager, frame_manager_)
+{}
+
+RC BufferPoolPartition::init(int64_t memory_size, const char *frame_cache_name)
+{
+  const int64_t pool_size = static_cast<int64_t>(DEFAULT_ITEM_NUM_PER_POOL) * BP_PAGE_SIZE;
+  const int     pool_num  = static_cast<int>(std::max<int64_t>(memory_size / pool_size, 1));
+  RC            rc        = frame_manager_.init(pool_num, frame_cache_name);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init buffer pool partition. name=%s, rc=%s", name_.c_str(), strrc(rc));
+    return rc;
+  }
+  LOG_INFO("buffer pool partition init with memory size %ld, page num: %d, pool num: %d. name=%s",
+           memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num, name_.c_str());
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
+BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */, const char *frame_cache_name /* = nullptr */)
 {
   if (memory_size <= 0) {
     memory_size = MEM_POOL_ITEM_NUM * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE;
   }
-  const int pool_num = std::max(memory_size / BP_PAGE_SIZE / DEFAULT_ITEM_NUM_PER_POOL, 1);
-  frame_manager_.init(pool_num);
-  LOG_INFO("buffer pool manager init with memory size %d, page num: %d, pool num: %d",
-           memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num);
+  if (frame_cache_name != nullptr) {
+    frame_cache_name_ = frame_cache_name;
+  }
+
+  auto partition = std::make_unique<BufferPoolPartition>(*this, DEFAULT_PARTITION);
+  partition->init(memory_size, frame_cache_name);
+  default_partition_ = partition.get();
+  partitions_.emplace(DEFAULT_PARTITION, std::move(partition));
 }
 
 BufferPoolManager::~BufferPoolManager()
 {
+  for (auto &[name, partition] : partitions_) {
+    partition->page_cleaner().stop();
+  }
+
   std::unordered_map<std::string, DiskBufferPool *> tmp_bps;
   tmp_bps.swap(buffer_pools_);
 
   for (auto &iter : tmp_bps) {
     delete iter.second;
   }
+
+  if (read_ahead_running_.load()) {
+    read_ahead_running_ = false;
+    read_ahead_executor_.shutdown();
+    read_ahead_executor_.await_termination();
+  }
 }
 
 RC BufferPoolManager::create_file(const char *file_name)
@@ -641,25 +1945,35 @@ RC BufferPoolManager::create_file(const char *file_name)
     return RC::IOERR_ACCESS;
   }
 
-  Page page;
-  memset(&page, 0, BP_PAGE_SIZE);
+  // 新文件中有一个extent，第0个页面是文件头，extent的最后一个页面是第一个分组的位图页
+  const PageNum bitmap_page = BP_EXTENT_PAGE_NUM - 1;
 
-  BPFileHeader *file_header    = (BPFileHeader *)page.data;
-  file_header->allocated_pages = 1;
-  file_header->page_count      = 1;
+  Page header_page;
+  memset(&header_page, 0, BP_PAGE_SIZE);
 
-  char *bitmap = file_header->bitmap;
-  bitmap[0] |= 0x01;
-  if (lseek(fd, 0, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to seek file %s to position 0, due to %s .", file_name, strerror(errno));
-    close(fd);
-    return RC::IOERR_SEEK;
-  }
+  BPFileHeader *file_header    = (BPFileHeader *)header_page.data;
+  file_header->allocated_pages = 2;
+  file_header->page_count      = BP_EXTENT_PAGE_NUM;
+  file_header->magic           = BP_FILE_MAGIC;
+  file_header->group_count     = 1;
+
+  PageNum *bitmap_pages = file_header->bitmap_pages;
+  bitmap_pages[0]       = bitmap_page;
 
-  if (writen(fd, (char *)&page, BP_PAGE_SIZE) != 0) {
-    LOG_ERROR("Failed to write header to file %s, due to %s.", file_name, strerror(errno));
+  Page bitmap;
+  memset(&bitmap, 0, BP_PAGE_SIZE);
+  bitmap.page_num = bitmap_page;
+  Bitmap(bitmap.data, BP_GROUP_PAGE_NUM).set_bit(BP_HEADER_PAGE);
+  Bitmap(bitmap.data, BP_GROUP_PAGE_NUM).set_bit(bitmap_page);
+
+  RC rc = page_io_->write(fd, (int64_t)bitmap_page * BP_PAGE_SIZE, &bitmap, BP_PAGE_SIZE);
+  if (OB_SUCC(rc)) {
+    rc = page_io_->write(fd, 0, &header_page, BP_PAGE_SIZE);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to write header to file %s. rc=%s", file_name, strrc(rc));
     close(fd);
-    return RC::IOERR_WRITE;
+    return rc;
   }
 
   close(fd);
@@ -677,8 +1991,9 @@ RC BufferPoolManager::open_file(const char *_file_name, DiskBufferPool *&_bp)
     return RC::BUFFERPOOL_OPEN;
   }
 
-  DiskBufferPool *bp = new DiskBufferPool(*this, frame_manager_);
-  RC              rc = bp->open_file(_file_name);
+  const bool      readonly = readonly_tables_.count(table_name_of_file(file_name)) > 0;
+  DiskBufferPool *bp       = new DiskBufferPool(*this, partition_of_file(file_name));
+  RC              rc       = bp->open_file(_file_name, readonly);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to open file name");
     delete bp;
@@ -730,15 +2045,359 @@ RC BufferPoolManager::flush_page(Frame &frame)
 {
   int fd = frame.file_desc();
 
+  DiskBufferPool *bp = nullptr;
+  {
+    std::scoped_lock lock_guard(lock_);
+    auto             iter = fd_buffer_pools_.find(fd);
+    if (iter == fd_buffer_pools_.end()) {
+      LOG_WARN("unknown buffer pool of fd %d", fd);
+      return RC::INTERNAL;
+    }
+    bp = iter->second;
+  }
+
+  // 刷盘时不再持有manager的锁，否则持有某个buffer pool锁的线程再来刷其它文件的页面时，会相互等待。
+  // 调用者已经pin住了这个页帧，buffer pool关闭时会等待这个页帧释放，所以bp不会在这期间被删除
+  return bp->flush_page(frame);
+}
+
+RC BufferPoolManager::start_page_cleaner(const PageCleanerParam &param)
+{
   std::scoped_lock lock_guard(lock_);
-  auto             iter = fd_buffer_pools_.find(fd);
-  if (iter == fd_buffer_pools_.end()) {
-    LOG_WARN("unknown buffer pool of fd %d", fd);
+  for (auto &[name, partition] : partitions_) {
+    RC rc = partition->page_cleaner().start(param);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to start page cleaner. partition=%s, rc=%s", name.c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  cleaner_param_   = param;
+  cleaner_started_ = true;
+  return RC::SUCCESS;
+}
+
+RC BufferPoolManager::create_partition(const char *name, int64_t memory_size)
+{
+  if (nullptr == name || 0 == strlen(name) || memory_size <= 0) {
+    LOG_WARN("invalid partition. name=%s, memory size=%ld", name == nullptr ? "(null)" : name, memory_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  std::scoped_lock lock_guard(lock_);
+  if (partitions_.find(name) != partitions_.end()) {
+    LOG_WARN("partition already exists. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  auto partition = std::make_unique<BufferPoolPartition>(*this, name);
+  RC   rc        = partition->init(memory_size, frame_cache_name_.empty() ? nullptr : frame_cache_name_.c_str());
+  if (OB_SUCC(rc) && cleaner_started_) {
+    rc = partition->page_cleaner().start(cleaner_param_);
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  partitions_.emplace(name, std::move(partition));
+  return RC::SUCCESS;
+}
+
+RC BufferPoolManager::assign_table(const char *table_name, const char *partition)
+{
+  std::scoped_lock lock_guard(lock_);
+  if (partitions_.find(partition) == partitions_.end()) {
+    LOG_WARN("no such partition. table=%s, partition=%s", table_name, partition);
+    return RC::NOTFOUND;
+  }
+
+  table_partitions_[table_name] = partition;
+  LOG_INFO("assign table to buffer pool partition. table=%s, partition=%s", table_name, partition);
+  return RC::SUCCESS;
+}
+
+void BufferPoolManager::set_table_readonly(const char *table_name)
+{
+  std::scoped_lock lock_guard(lock_);
+  readonly_tables_.insert(table_name);
+  LOG_INFO("set table readonly. table=%s", table_name);
+}
+
+BufferPoolPartition *BufferPoolManager::find_partition(const char *name)
+{
+  std::scoped_lock lock_guard(lock_);
+  auto             iter = partitions_.find(name);
+  return iter == partitions_.end() ? nullptr : iter->second.get();
+}
+
+BufferPoolPartition &BufferPoolManager::partition_of_file(const std::string &file_name)
+{
+  if (table_partitions_.empty()) {
+    return *default_partition_;
+  }
+
+  auto iter = table_partitions_.find(table_name_of_file(file_name));
+  if (iter == table_partitions_.end()) {
+    return *default_partition_;
+  }
+  return *partitions_[iter->second];
+}
+
+RC BufferPoolManager::start_read_ahead(const ReadAheadParam &param)
+{
+  read_ahead_param_ = param;
+  if (param.max_pages <= 0 || param.thread_num <= 0) {
+    LOG_INFO("async read ahead is disabled. max pages=%d, thread num=%d", param.max_pages, param.thread_num);
+    return RC::SUCCESS;
+  }
+
+#ifdef CONCURRENCY
+  int ret = read_ahead_executor_.init("ReadAhead", param.thread_num, param.thread_num, 60 * 1000);
+  if (ret != 0) {
+    LOG_WARN("failed to init read ahead thread pool. ret=%d", ret);
     return RC::INTERNAL;
   }
+  read_ahead_running_ = true;
+  LOG_INFO("read ahead started. max pages=%d, thread num=%d", param.max_pages, param.thread_num);
+#else
+  LOG_INFO("async read ahead is disabled without CONCURRENCY. max pages=%d", param.max_pages);
+#endif
+  return RC::SUCCESS;
+}
+
+bool BufferPoolManager::submit_read_ahead(const std::function<void()> &task)
+{
+  if (!read_ahead_running_.load()) {
+    return false;
+  }
+  return read_ahead_executor_.execute(task) == 0;
+}
 
-  DiskBufferPool *bp = iter->second;
-  return bp->flush_page(frame);
+RC BufferPoolManager::set_page_io(const char *name)
+{
+  PageIO *page_io = PageIO::create(name);
+  if (nullptr == page_io) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  page_io_.reset(page_io);
+  LOG_INFO("buffer pool use page io %s", page_io_->name());
+  return RC::SUCCESS;
+}
+
+void BufferPoolManager::set_flush_rate_limit(int64_t mb_per_second)
+{
+  flush_rate_limit_ = std::max<int64_t>(mb_per_second, 0);
+  LOG_INFO("buffer pool flush rate limit %ld MB/s", flush_rate_limit_);
+}
+
+void BufferPoolManager::throttle_flush(int pages)
+{
+  if (flush_rate_limit_ <= 0 || pages <= 0) {
+    return;
+  }
+
+  using namespace std::chrono;
+  const int64_t bytes_per_second = flush_rate_limit_ * 1024 * 1024;
+  const auto    cost             = microseconds(static_cast<int64_t>(pages) * BP_PAGE_SIZE * 1000000 / bytes_per_second);
+
+  steady_clock::time_point wait_until;
+  {
+    std::scoped_lock lock_guard(flush_limit_lock_);
+    // 空闲了很久之后不累积额度，否则下一次checkpoint刚开始时会不受限速
+    auto now = steady_clock::now();
+    flush_next_time_ = std::max(flush_next_time_, now);
+    wait_until       = flush_next_time_;
+    flush_next_time_ += cost;
+  }
+  std::this_thread::sleep_until(wait_until);
+}
+
+RC BufferPoolManager::dump_hot_pages(const char *dump_file)
+{
+  std::map<std::string, std::vector<PageNum>> file_pages;
+  {
+    std::scoped_lock lock_guard(lock_);
+
+    std::unordered_map<int, const std::string *> fd_names;
+    for (const auto &[file_name, bp] : buffer_pools_) {
+      fd_names[bp->file_desc()] = &file_name;
+    }
+
+    for (auto &[name, partition] : partitions_) {
+      BPFrameManager &frame_manager = partition->frame_manager();
+      for (int i = 0; i < frame_manager.shard_num(); i++) {
+        frame_manager.foreach_frame_reverse(i, [&fd_names, &file_pages](Frame *frame) {
+          auto iter = fd_names.find(frame->file_desc());
+          if (iter != fd_names.end()) {
+            file_pages[*iter->second].push_back(frame->page_num());
+          }
+          return true;
+        });
+      }
+    }
+  }
+
+  // 先写临时文件再改名，避免中途失败留下一个不完整的文件
+  std::string tmp_file = std::string(dump_file) + ".tmp";
+  std::ofstream ofs(tmp_file, std::ios::trunc);
+  if (!ofs) {
+    LOG_WARN("failed to open hot page dump file. file=%s, errno=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int page_count = 0;
+  for (auto &[file_name, pages] : file_pages) {
+    std::sort(pages.begin(), pages.end());
+    for (PageNum page_num : pages) {
+      ofs << page_num << ' ' << file_name << '\n';
+    }
+    page_count += static_cast<int>(pages.size());
+  }
+
+  ofs.close();
+  if (!ofs) {
+    LOG_WARN("failed to write hot page dump file. file=%s", tmp_file.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  if (::rename(tmp_file.c_str(), dump_file) != 0) {
+    LOG_WARN("failed to rename hot page dump file. file=%s, errno=%s", dump_file, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  LOG_INFO("dump hot pages done. file=%s, files=%d, pages=%d", dump_file, (int)file_pages.size(), page_count);
+  return RC::SUCCESS;
+}
+
+RC BufferPoolManager::warm_up(const char *dump_file)
+{
+  std::ifstream ifs(dump_file);
+  if (!ifs) {
+    LOG_INFO("no hot page dump file, skip warm up. file=%s", dump_file);
+    return RC::SUCCESS;
+  }
+
+  std::map<std::string, std::vector<PageNum>> file_pages;
+  PageNum                                     page_num = BP_INVALID_PAGE_NUM;
+  std::string                                 file_name;
+  while (ifs >> page_num) {
+    ifs.get();  // 跳过页面编号后面的空格
+    if (!std::getline(ifs, file_name)) {
+      break;
+    }
+    file_pages[file_name].push_back(page_num);
+  }
+
+  int load_count = 0;
+  for (auto &[file_name, pages] : file_pages) {
+    DiskBufferPool *bp = nullptr;
+    {
+      std::scoped_lock lock_guard(lock_);
+      auto             iter = buffer_pools_.find(file_name);
+      if (iter != buffer_pools_.end()) {
+        bp = iter->second;
+      }
+    }
+
+    if (bp == nullptr) {
+      LOG_INFO("file is not opened, skip warm up. file=%s", file_name.c_str());
+      continue;
+    }
+    load_count += bp->warm_up(std::move(pages));
+  }
+
+  LOG_INFO("warm up done. dump file=%s, files=%d, loaded pages=%d", dump_file, (int)file_pages.size(), load_count);
+  return RC::SUCCESS;
+}
+
+void BufferPoolManager::collect_stats(std::vector<BufferPoolStatItem> &items)
+{
+  /// 页帧的使用情况，需要遍历页帧表
+  struct FrameUsage
+  {
+    int64_t resident = 0;
+    int64_t pinned   = 0;
+    int64_t dirty    = 0;
+  };
+
+  std::map<std::string, std::vector<BufferPoolStatItem>> file_items;
+  std::unordered_map<int, std::string>                   fd_names;
+  std::vector<BufferPoolPartition *>                     partitions;
+  {
+    std::scoped_lock lock_guard(lock_);
+    for (const auto &[file_name, bp] : buffer_pools_) {
+      fd_names[bp->file_desc()] = file_name;
+      bp->stats().to_items(file_name, file_items[file_name]);
+      file_items[file_name].push_back({file_name, "direct_io", bp->direct_io() ? "yes" : "no"});
+      file_items[file_name].push_back({file_name, "partition", bp->partition().name()});
+      file_items[file_name].push_back({file_name, "readonly(mmap)", bp->readonly() ? "yes" : "no"});
+    }
+    for (auto &[name, partition] : partitions_) {
+      partitions.push_back(partition.get());
+    }
+  }
+
+  // 遍历页帧表时不持有manager的锁，打开文件时会先加manager的锁再加分片的锁
+  FrameUsage                          total;
+  int64_t                             total_frames    = 0;
+  int64_t                             total_evictions = 0;
+  std::unordered_map<int, FrameUsage> fd_usages;
+  std::vector<BufferPoolStatItem>     partition_items;
+  for (BufferPoolPartition *partition : partitions) {
+    BPFrameManager &frame_manager = partition->frame_manager();
+    FrameUsage      partition_usage;
+    for (int i = 0; i < frame_manager.shard_num(); i++) {
+      frame_manager.foreach_frame_reverse(i, [&partition_usage, &fd_usages](Frame *frame) {
+        FrameUsage &usage  = fd_usages[frame->file_desc()];
+        const bool  pinned = !frame->can_purge();
+        const bool  dirty  = frame->dirty();
+        for (FrameUsage *u : {&usage, &partition_usage}) {
+          u->resident++;
+          u->pinned += pinned ? 1 : 0;
+          u->dirty += dirty ? 1 : 0;
+        }
+        return true;
+      });
+    }
+
+    const std::string scope     = "partition:" + partition->name();
+    const int64_t     frame_num = static_cast<int64_t>(frame_manager.total_frame_num());
+    partition_items.push_back({scope, "frames", std::to_string(frame_num)});
+    partition_items.push_back({scope, "free_frames", std::to_string(frame_num - partition_usage.resident)});
+    partition_items.push_back({scope, "resident_pages", std::to_string(partition_usage.resident)});
+    partition_items.push_back({scope, "dirty_frames", std::to_string(partition_usage.dirty)});
+    partition_items.push_back({scope, "evictions", std::to_string(frame_manager.evict_count())});
+
+    total.resident += partition_usage.resident;
+    total.pinned += partition_usage.pinned;
+    total.dirty += partition_usage.dirty;
+    total_frames += frame_num;
+    total_evictions += frame_manager.evict_count();
+  }
+
+  const std::string global_scope("global");
+  items.push_back({global_scope, "frames", std::to_string(total_frames)});
+  items.push_back({global_scope, "page_mode", FrameArena::page_mode_name(default_partition_->frame_manager().page_mode())});
+  items.push_back({global_scope, "partitions", std::to_string(partitions.size())});
+  items.push_back({global_scope, "free_frames", std::to_string(total_frames - total.resident)});
+  items.push_back({global_scope, "resident_pages", std::to_string(total.resident)});
+  items.push_back({global_scope, "pinned_frames", std::to_string(total.pinned)});
+  items.push_back({global_scope, "dirty_frames", std::to_string(total.dirty)});
+  items.push_back({global_scope, "evictions", std::to_string(total_evictions)});
+  stats_.to_items(global_scope, items);
+  items.insert(items.end(), partition_items.begin(), partition_items.end());
+
+  for (auto &[fd, file_name] : fd_names) {
+    FrameUsage                      &usage = fd_usages[fd];
+    std::vector<BufferPoolStatItem> &file  = file_items[file_name];
+    file.push_back({file_name, "resident_pages", std::to_string(usage.resident)});
+    file.push_back({file_name, "pinned_frames", std::to_string(usage.pinned)});
+    file.push_back({file_name, "dirty_frames", std::to_string(usage.dirty)});
+  }
+
+  for (auto &[file_name, file] : file_items) {
+    items.insert(items.end(), file.begin(), file.end());
+  }
 }
 
 static BufferPoolManager *default_bpm = nullptr;
@@ -13,8 +13,13 @@ See the Mulan PSL v2 for more details. */
 //
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fcntl.h>
 #include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
@@ -24,6 +29,8 @@ See the Mulan PSL v2 for more details. */
 #include <sys/types.h>
 #include <time.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/lang/bitmap.h"
 #include "common/lang/lru_cache.h"
@@ -31,8 +38,13 @@ See the Mulan PSL v2 for more details. */
 #include "common/mm/mem_pool.h"
 #include "common/rc.h"
 #include "common/types.h"
+#include "storage/buffer/buffer_pool_stats.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/frame_arena.h"
+#include "storage/buffer/frame_cache.h"
 #include "storage/buffer/page.h"
+#include "storage/buffer/page_cleaner.h"
+#include "storage/buffer/page_io.h"
 
 class BufferPoolManager;
 class DiskBufferPool;
@@ -42,29 +54,50 @@ class DiskBufferPool;
  * @defgroup BufferPool
  */
 
-#define BP_FILE_SUB_HDR_SIZE (sizeof(BPFileSubHeader))
+#define BP_FILE_SUB_HDR_SIZE (sizeof(BPFileHeader))
 
 /**
- * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了后面每页的分配信息。
+ * 文件格式的标识。老格式的文件头中，这个位置是页面位图的第一个字节，第0个页面总是已分配的，
+ * 所以最低位一定是1，而这个值的最低位是0，不会把老格式的文件当成新格式
+ */
+static constexpr int32_t BP_FILE_MAGIC = 0x4d504642;
+
+/**
+ * 一个位图页能够管理多少个页面。位图按照64位的字来访问，所以取64的整数倍
+ */
+static constexpr int BP_GROUP_PAGE_NUM = BP_PAGE_DATA_SIZE / sizeof(uint64_t) * 64;
+
+/**
+ * 文件没有空闲页面时，一次扩展多少个页面
+ */
+static constexpr int BP_EXTENT_PAGE_NUM = 64;
+
+/**
+ * @brief BufferPool的文件第一个页面，存放一些元数据信息
  * @ingroup BufferPool
- * @details
- * @code
- * TODO 1. 当前的做法，只能分配比较少的页面，你可以扩展一下，支持更多的页面或无限多的页面吗？
- *         可以参考Linux ext(n)和Windows NTFS等文件系统
- *      2. 当前使用bitmap存放页面分配情况，但是这种方法在页面非常多的时候，查找空闲页面的
- *         效率非常低，你有办法优化吗？
- * @endcode
+ * @details 页面的分配信息放在位图页中，是一个两层的结构：
+ * 文件按照 BP_GROUP_PAGE_NUM 个页面分成多个分组，每个分组有一个位图页，记录这个分组中每个页面
+ * 是否已经分配，文件头中记录每个分组的位图页的页号。位图页放在它管理的分组中，本身也是一个已分配的页面。
+ * 文件没有空闲页面时，一次扩展 BP_EXTENT_PAGE_NUM 个页面(一个extent)，而不是每次扩展一个页面。
+ * 打开老格式(文件头中直接存放位图)的文件时，会把位图搬到一个新的位图页中，升级成当前的格式。
  */
 struct BPFileHeader
 {
-  int32_t page_count;       //! 当前文件一共有多少个页面
-  int32_t allocated_pages;  //! 已经分配了多少个页面
-  char    bitmap[0];        //! 页面分配位图, 第0个页面(就是当前页面)，总是1
+  int32_t page_count;       //! 当前文件一共有多少个页面，包括还没有分配出去的页面
+  int32_t allocated_pages;  //! 已经分配了多少个页面，包括文件头和位图页
+  int32_t magic;            //! 文件格式的标识，BP_FILE_MAGIC
+  int32_t group_count;      //! 分组的个数，即位图页的个数
+  PageNum bitmap_pages[0];  //! 每个分组的位图页的页号
+
+  /**
+   * 最多能有多少个分组
+   */
+  static const int MAX_GROUP_NUM = (BP_PAGE_DATA_SIZE - sizeof(int32_t) * 4) / sizeof(PageNum);
 
   /**
-   * 能够分配的最大的页面个数，即bitmap的字节数 乘以8
+   * 能够分配的最大的页面个数
    */
-  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+  static const int MAX_PAGE_NUM = MAX_GROUP_NUM * BP_GROUP_PAGE_NUM;
 
   std::string to_string() const;
 };
@@ -74,15 +107,27 @@ struct BPFileHeader
  * @ingroup BufferPool
  * @details 管理内存中的页帧。内存是有限的，内存中能够存放的页帧个数也是有限的。
  * 当内存中的页帧不够用时，需要从内存中淘汰一些页帧，以便为新的页帧腾出空间。
- * 这个管理器负责为所有的BufferPool提供页帧管理服务，也就是所有的BufferPool磁盘文件
- * 在访问时都使用这个管理器映射到内存。
+ * 这个管理器负责为一个分区(BufferPoolPartition)中的所有BufferPool提供页帧管理服务，
+ * 也就是这个分区中的BufferPool磁盘文件在访问时都使用这个管理器映射到内存。
  */
 class BPFrameManager
 {
 public:
-  BPFrameManager(const char *tag);
+  /**
+   * 默认的分片个数。页帧表按照FrameId哈希到不同的分片上，每个分片单独加锁
+   */
+  static constexpr int DEFAULT_SHARD_NUM = 16;
+
+public:
+  BPFrameManager(const char *tag, int shard_num = DEFAULT_SHARD_NUM);
 
-  RC init(int pool_num);
+  /**
+   * @brief 初始化
+   *
+   * @param pool_num 申请多少个内存池的页帧
+   * @param cache_name 页面置换策略，参考 FrameCache::create
+   */
+  RC init(int pool_num, const char *cache_name = nullptr);
   RC cleanup();
 
   /**
@@ -117,6 +162,26 @@ public:
    */
   RC free(int file_desc, PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 拿一个空闲页帧，但是不放到页帧表中
+   * @details 从磁盘加载页面时使用。页面数据加载完成之前，其它线程不会在页帧表中看到这个页帧。
+   * 没有空闲页帧时会尝试淘汰一个干净的页帧，但不会刷脏页
+   * @return Frame* 没有可用的页帧时返回nullptr
+   */
+  Frame *alloc_detached();
+
+  /**
+   * @brief 把 alloc_detached 拿到的页帧放到页帧表中
+   * @param pin 是否同时pin住页帧。放到页帧表之后，页帧随时可能被淘汰，需要在分片的锁内pin
+   * @return false 页面已经在页帧表中了，frame会被放回空闲列表
+   */
+  bool attach(int file_desc, PageNum page_num, Frame *frame, bool pin = false);
+
+  /**
+   * @brief 归还 alloc_detached 拿到的页帧
+   */
+  void free_detached(Frame *frame);
+
   /**
    * 如果不能从空闲链表中分配新的页面，就使用这个接口，
    * 尝试从pin count=0的页面中淘汰一些
@@ -126,30 +191,132 @@ public:
    */
   int purge_frames(int count, std::function<RC(Frame *frame)> purger);
 
-  size_t frame_num() const { return frames_.count(); }
+  /**
+   * @brief 淘汰一些干净的页帧(pin count=0并且不是脏页)
+   * @details 与 purge_frames 不同，这里不会做任何磁盘IO，可以放心地在前台调用
+   * @param count 想要淘汰多少个页帧
+   * @return 返回本次淘汰了多少个页帧
+   */
+  int evict_clean_frames(int count);
+  int evict_clean_frames(int shard_index, int count);
+
+  /**
+   * @brief 从冷端到热端遍历某个分片中的页帧
+   * @details 遍历时会持有这个分片的锁，所以回调函数中不能做耗时的操作，也不能再访问frame manager。
+   * 回调函数返回false时停止遍历
+   */
+  void foreach_frame_reverse(int shard_index, std::function<bool(Frame *frame)> func);
+
+  /**
+   * @brief 文件关闭后清理页帧表中这个文件的访问历史，文件描述符可能会被其它文件复用
+   */
+  void forget_file(int file_desc);
+
+  /**
+   * 当前正在使用的页帧个数
+   */
+  size_t frame_num() const;
 
   /**
    * 测试使用。返回已经从内存申请的个数
    */
-  size_t total_frame_num() const { return allocator_.get_size(); }
+  size_t total_frame_num() const { return arena_.size(); }
 
-private:
-  Frame *get_internal(const FrameId &frame_id);
-  RC     free_internal(const FrameId &frame_id, Frame *frame);
+  /**
+   * 页面数据使用的内存页类型
+   */
+  FrameArena::PageMode page_mode() const { return arena_.page_mode(); }
+
+  int shard_num() const { return static_cast<int>(shards_.size()); }
+
+  /**
+   * 某个分片中正在使用的页帧个数和空闲页帧个数
+   */
+  size_t frame_num(int shard_index) const;
+  size_t free_frame_num(int shard_index) const;
+
+  /**
+   * 为了腾出空闲页帧而淘汰的页帧个数
+   */
+  int64_t evict_count() const { return evict_count_.load(); }
 
 private:
-  class BPFrameIdHasher
+  /**
+   * @brief 页帧表的一个分片
+   * @details 每个分片有自己的锁、页帧表和空闲页帧列表。页面命中时只需要加对应分片的锁，
+   * 不同分片上的访问不会相互阻塞。
+   */
+  struct FrameShard
   {
-  public:
-    size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
+    mutable std::mutex          lock_;
+    std::unique_ptr<FrameCache> frames_;
+    std::vector<Frame *>        free_frames_;
   };
 
-  using FrameLruCache  = common::LruCache<FrameId, Frame *, BPFrameIdHasher>;
-  using FrameAllocator = common::MemPoolSimple<Frame>;
+  FrameShard &shard_of(const FrameId &frame_id);
+
+  Frame *get_internal(FrameShard &shard, const FrameId &frame_id);
+  /**
+   * @param evict 是否是为了腾出页帧而淘汰，置换策略会记住被淘汰的页面
+   */
+  RC free_internal(FrameShard &shard, const FrameId &frame_id, Frame *frame, bool evict = false);
+
+  /**
+   * @brief 当前分片没有空闲页帧时，从其它分片拿一个空闲页帧过来
+   * @details 调用时不能持有任何分片的锁
+   */
+  Frame *steal_free_frame(const FrameShard &except);
+
+  /**
+   * @brief 在某个分片上淘汰页帧，调用时不需要持有该分片的锁
+   */
+  int purge_shard_frames(FrameShard &shard, int count, std::function<RC(Frame *frame)> &purger);
+  int evict_shard_clean_frames(FrameShard &shard, int count);
 
-  std::mutex     lock_;
-  FrameLruCache  frames_;
-  FrameAllocator allocator_;
+private:
+  std::string             tag_;
+  std::vector<FrameShard> shards_;
+  std::atomic<size_t>     purge_cursor_{0};  ///< 淘汰页帧时从哪个分片开始查找，轮流选择分片
+  std::atomic<int64_t>    evict_count_{0};
+  FrameArena              arena_;
+};
+
+/**
+ * @brief 缓冲池的一个分区
+ * @ingroup BufferPool
+ * @details 每个分区有自己的页帧和后台刷脏页线程，一个文件只会使用它所在分区的页帧，
+ * 所以不同分区的页面不会相互淘汰。可以把延迟敏感的表放在单独的分区中，批量导入的大表
+ * 再怎么扫描也不会把它们的页面挤出缓冲池。
+ */
+class BufferPoolPartition
+{
+public:
+  BufferPoolPartition(BufferPoolManager &bp_manager, const char *name);
+
+  /**
+   * @param memory_size 分区的内存大小，按照内存池的大小取整，至少一个内存池
+   * @param frame_cache_name 页面置换策略，参考 FrameCache::create
+   */
+  RC init(int64_t memory_size, const char *frame_cache_name);
+
+  const std::string &name() const { return name_; }
+  BPFrameManager    &frame_manager() { return frame_manager_; }
+  PageCleaner       &page_cleaner() { return page_cleaner_; }
+
+private:
+  std::string    name_;
+  BPFrameManager frame_manager_;
+  PageCleaner    page_cleaner_;
+};
+
+/**
+ * @brief 预读的参数
+ * @ingroup BufferPool
+ */
+struct ReadAheadParam
+{
+  int thread_num = 1;   ///< 异步预读的线程个数。只在CONCURRENCY编译模式下生效，否则同步预读
+  int max_pages  = 32;  ///< 预读窗口最大多少个页面。为0时关闭预读
 };
 
 /**
@@ -168,8 +335,8 @@ public:
   RC      reset();
 
 private:
-  common::Bitmap bitmap_;
-  PageNum        current_page_num_ = -1;
+  DiskBufferPool *bp_               = nullptr;
+  PageNum         current_page_num_ = -1;
 };
 
 /**
@@ -179,7 +346,7 @@ private:
 class DiskBufferPool
 {
 public:
-  DiskBufferPool(BufferPoolManager &bp_manager, BPFrameManager &frame_manager);
+  DiskBufferPool(BufferPoolManager &bp_manager, BufferPoolPartition &partition);
   ~DiskBufferPool();
 
   /**
@@ -189,8 +356,12 @@ public:
 
   /**
    * 根据文件名打开一个分页文件
+   * @param readonly 是否以只读方式打开。只读的文件直接使用mmap映射到内存中，get_this_page 返回的页帧
+   * 直接指向映射的内存，不需要占用缓冲池的页帧，也不需要从磁盘拷贝数据，访问冷数据时只依赖操作系统的页缓存。
+   * 只读文件不能分配和释放页面，修改页面的数据(比如回放日志)会由操作系统写回文件。
+   * 没有写权限时以只读方式映射，这时不能修改页面，参考 writable
    */
-  RC open_file(const char *file_name);
+  RC open_file(const char *file_name, bool readonly = false);
 
   /**
    * 关闭分页文件
@@ -209,6 +380,16 @@ public:
    */
   RC allocate_page(Frame **frame);
 
+  /**
+   * @brief 一次分配多个页面
+   * @details 批量导入数据时使用。只加一次锁，文件中的空闲页面不够时一次把文件扩展到足够大，而不是每个extent扩展一次。
+   * 返回的页面与 allocate_page 一样都是 pin 住的。失败时已经分配的页面会释放掉
+   *
+   * @param count  分配多少个页面
+   * @param frames 返回分配的页面
+   */
+  RC allocate_pages(int count, std::vector<Frame *> &frames);
+
   /**
    * @brief 释放某个页面，将此页面设置为未分配状态
    *
@@ -240,6 +421,16 @@ public:
 
   int file_desc() const;
 
+  /**
+   * @brief 文件中一共有多少个页面，包括还没有分配出去的页面，所有的页号都小于这个值
+   */
+  PageNum page_count();
+
+  /**
+   * @brief 已经分配了多少个页面，包括文件头和位图页
+   */
+  int allocated_pages();
+
   /**
    * 如果页面是脏的，就将数据刷新到磁盘
    */
@@ -247,6 +438,8 @@ public:
 
   /**
    * 刷新所有页面到磁盘，即使pin count不是0
+   * @details 脏页按照页面编号排序，连续的页面合并成一个IO请求(pwritev)。
+   * 每批页面下刷之前会经过 BufferPoolManager 的限速，避免做checkpoint时占满磁盘带宽
    */
   RC flush_all_pages();
 
@@ -255,15 +448,163 @@ public:
    */
   RC recover_page(PageNum page_num);
 
+  /**
+   * @brief 预读从start_page开始的count个页面
+   * @details 只会加载已经分配并且不在内存中的页面，并且只使用空闲的或干净的页帧，不会为了预读刷脏页。
+   * 如果启动了预读线程就异步执行，否则同步执行。
+   */
+  void read_ahead(PageNum start_page, int count);
+
+  /**
+   * @brief 告诉buffer pool接下来会从start_page开始顺序访问页面
+   * @details 会立即预读一个窗口的页面，之后访问到预读窗口时，会继续预读下一个窗口。
+   * 比如全表扫描时，页面不一定是连续分配的，没办法依赖顺序缺页来自动识别。
+   */
+  void hint_sequential(PageNum start_page);
+
+  /**
+   * @brief 预热，把指定的页面加载到内存中
+   * @details 页面排序后分批加载，连续的页面合并成一个IO请求。只使用空闲的或干净的页帧，没有可用的页帧时停止
+   * @return int 加载了多少个页面
+   */
+  int warm_up(std::vector<PageNum> pages);
+
+  BufferPoolStats &stats() { return stats_; }
+
+  /**
+   * @brief 文件是否使用 O_DIRECT 打开
+   */
+  bool direct_io() const { return direct_io_; }
+
+  /**
+   * @brief 文件是否以只读方式使用mmap打开
+   */
+  bool readonly() const { return mmap_base_ != nullptr; }
+
+  /**
+   * @brief 文件的页面能否修改
+   * @details 只读文件没有写权限时使用 PROT_READ 映射，修改页面(比如回放日志)会让进程崩溃，修改之前需要检查
+   */
+  bool writable() const { return mmap_base_ == nullptr || mmap_writable_; }
+
+  /**
+   * @brief 文件使用的缓冲池分区
+   */
+  BufferPoolPartition &partition() { return partition_; }
+
 protected:
   RC allocate_frame(PageNum page_num, Frame **buf);
 
+  /**
+   * @brief 分配一个页面，调用者需要持有 lock_
+   */
+  RC allocate_page_locked(Frame **frame);
+
+  /**
+   * @brief 申请一个不在页帧表中的页帧，没有空闲页帧时会淘汰一些页帧
+   */
+  RC allocate_detached_frame(Frame **buf);
+
+  /**
+   * @brief 没有空闲页帧时，淘汰一些页帧。优先淘汰干净的页帧，必要时刷脏页
+   */
+  void make_free_frame();
+
+  /**
+   * @brief 正在从磁盘加载的一个页面
+   */
+  struct PageLoad
+  {
+    bool                    done = false;
+    RC                      rc   = RC::SUCCESS;
+    std::condition_variable cv;
+  };
+
+  /**
+   * @brief 登记要加载一个页面
+   * @details 同一个页面同时只有一个线程加载，其它线程调用 wait_load 等待它加载完成。
+   * 不同页面的加载不会相互阻塞
+   * @param owner 返回true表示由当前线程加载，加载完成后要调用 end_load
+   */
+  std::shared_ptr<PageLoad> begin_load(PageNum page_num, bool &owner);
+  void                      end_load(PageNum page_num, RC rc);
+  RC                        wait_load(const std::shared_ptr<PageLoad> &load);
+
+  /**
+   * @brief 把页面加载到一个新的页帧中，加载完成后再放到页帧表中并pin住
+   * @details 调用者需要先通过 begin_load 拿到加载这个页面的权利
+   */
+  RC load_frame(PageNum page_num, Frame **frame);
+
   /**
    * 刷新指定页面到磁盘(flush)，并且释放关联的Frame
    */
   RC purge_frame(PageNum page_num, Frame *used_frame);
   RC check_page_num(PageNum page_num);
 
+  /**
+   * @brief 老格式的文件，把文件头中的位图搬到一个新的位图页中
+   */
+  RC upgrade_file_header();
+
+  /**
+   * @brief 打开文件时加载所有的位图页，位图页在文件关闭之前一直pin在内存中
+   */
+  RC load_page_groups();
+
+  /**
+   * @brief 只读方式打开文件，把整个文件映射到内存中
+   */
+  RC open_mapped_file(const char *file_name);
+
+  /**
+   * @brief 只读文件的页面，第一次访问时创建指向映射内存的页帧
+   */
+  RC get_mapped_page(PageNum page_num, Frame **frame);
+
+  /**
+   * @brief 解除只读文件的映射，修改过的数据会先写回文件
+   */
+  RC unmap_file();
+
+  /**
+   * @brief 在文件末尾增加一个分组，分组的第一个页面是位图页
+   */
+  RC add_page_group();
+
+  /**
+   * @brief 按照extent扩展文件，直到文件中至少有page_count个页面
+   * @details 先把文件的长度扩展好再修改文件头中的 page_count，扩展失败时返回错误，文件头不变
+   */
+  RC extend_file(PageNum page_count);
+
+  /**
+   * @brief 把文件扩展到能放下 [start_page, end_page) 这些页面
+   * @details 修改 page_count 之前调用，失败时 page_count 不能修改
+   */
+  RC grow_file(PageNum start_page, PageNum end_page);
+
+  /**
+   * @brief 查找一个空闲页面，没有时返回 BP_INVALID_PAGE_NUM
+   * @details 先在有空闲页面的分组的摘要位图中找到一个有空闲页面的分组，再在分组的摘要位图中找到一个
+   * 有空闲页面的字，最后在这个字中找到空闲的位，都是常数时间
+   */
+  PageNum find_free_page();
+
+  bool page_allocated(PageNum page_num);
+  void set_page_allocated(PageNum page_num, bool allocated);
+
+  /**
+   * @brief 重新计算位图中某个字是否有空闲页面
+   * @return int 这个字中有多少个空闲页面
+   */
+  int refresh_free_word(int group, int word_index);
+
+  /**
+   * @brief 从start_page开始(包括)，下一个已经分配的页面，会跳过文件头和位图页
+   */
+  PageNum next_allocated_page(PageNum start_page);
+
   /**
    * 加载指定页面的数据到内存中
    */
@@ -274,9 +615,36 @@ protected:
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 一次读取多个页面
+   * @details 页帧中需要设置好页面编号，连续的页面合并成一个IO请求，所有请求一起提交
+   */
+  RC load_pages(const std::vector<Frame *> &frames);
+
+  RC read_ahead_internal(PageNum start_page, int count);
+
+  /**
+   * @brief 加载一批不在内存中的页面，预读和预热使用
+   * @param pages 需要加载的页面，按照页面编号排序
+   * @param load_count 加载了多少个页面
+   * @return RC 没有可用的页帧时返回 BUFFERPOOL_NOBUF
+   */
+  RC prefetch_pages(const std::vector<PageNum> &pages, int &load_count);
+
+  /**
+   * @brief 访问页面时检查是否需要预读
+   * @details 连续两次缺页的页面相邻时，认为是顺序访问，开始预读。访问到预读窗口的第一个页面时，
+   * 预读下一个窗口，窗口大小每次翻倍，直到 ReadAheadParam::max_pages。
+   */
+  void check_read_ahead(PageNum page_num, bool hit);
+  void start_read_ahead_window(PageNum start_page, int window);
+
 private:
-  BufferPoolManager &bp_manager_;
-  BPFrameManager    &frame_manager_;
+  BufferPoolManager   &bp_manager_;
+  BufferPoolPartition &partition_;
+  BPFrameManager      &frame_manager_;
+  BufferPoolStats      stats_;
+  bool                 direct_io_ = false;
 
   std::string       file_name_;
   int               file_desc_   = -1;
@@ -284,8 +652,39 @@ private:
   BPFileHeader     *file_header_ = nullptr;
   std::set<PageNum> disposed_pages_;
 
+  /**
+   * @brief 一个分组在内存中的信息
+   */
+  struct PageGroup
+  {
+    Frame                *bitmap_frame = nullptr;  ///< 位图页，一直pin在内存中
+    int                   free_pages   = 0;        ///< 文件范围内有多少个空闲页面
+    std::vector<uint64_t> free_words;              ///< 第i位表示位图的第i个字中有空闲页面
+  };
+
+  std::vector<PageGroup> page_groups_;
+  std::vector<uint64_t>  free_groups_;  ///< 第i位表示第i个分组中有空闲页面
+
   common::Mutex lock_;
 
+  std::mutex                                              load_lock_;
+  std::unordered_map<PageNum, std::shared_ptr<PageLoad>> loading_pages_;  ///< 正在加载的页面
+
+  std::atomic<PageNum> last_miss_page_{BP_INVALID_PAGE_NUM};      ///< 上一次缺页的页面
+  std::atomic<PageNum> read_ahead_trigger_{BP_INVALID_PAGE_NUM};  ///< 访问到这个页面时预读下一个窗口
+  std::atomic<PageNum> read_ahead_next_{BP_INVALID_PAGE_NUM};     ///< 下一个预读窗口的起始页面
+  std::atomic<int>     read_ahead_window_{0};                      ///< 当前预读窗口的大小
+
+  std::mutex              read_ahead_lock_;         ///< 保护 pending_read_ahead_ 和 closing_
+  std::condition_variable read_ahead_cv_;           ///< 预读任务结束时通知 close_file
+  int                     pending_read_ahead_ = 0;  ///< 还没有执行完成的异步预读任务
+  bool                    closing_            = false;
+
+  char                                   *mmap_base_       = nullptr;  ///< 只读文件映射到内存的起始地址
+  PageNum                                 mmap_page_count_ = 0;        ///< 映射了多少个页面
+  bool                                    mmap_writable_   = false;    ///< 映射的内存是否可写
+  std::unique_ptr<std::atomic<Frame *>[]> mmap_frames_;                ///< 只读文件每个页面的页帧
+
 private:
   friend class BufferPoolIterator;
 };
@@ -297,21 +696,164 @@ private:
 class BufferPoolManager
 {
 public:
-  BufferPoolManager(int memory_size = 0);
+  /**
+   * 默认分区的名字，没有指定分区的文件都使用默认分区
+   */
+  static constexpr const char *DEFAULT_PARTITION = "default";
+
+public:
+  /**
+   * @param memory_size 默认分区的内存大小
+   */
+  BufferPoolManager(int memory_size = 0, const char *frame_cache_name = nullptr);
   ~BufferPoolManager();
 
   RC create_file(const char *file_name);
+
+  /**
+   * @brief 打开文件
+   * @details 文件属于哪个分区参考 assign_table，是否只读参考 set_table_readonly
+   */
   RC open_file(const char *file_name, DiskBufferPool *&bp);
   RC close_file(const char *file_name);
 
   RC flush_page(Frame &frame);
 
+  /**
+   * @brief 启动后台刷脏页的线程，每个分区都有自己的后台线程
+   */
+  RC start_page_cleaner(const PageCleanerParam &param);
+
+  /**
+   * @brief 创建一个有独立内存的分区
+   * @details 页面置换策略与默认分区相同。后台刷脏页的线程已经启动时，新分区也会启动
+   * @param name 分区的名字，不能与已有的分区重复
+   * @param memory_size 分区的内存大小
+   */
+  RC create_partition(const char *name, int64_t memory_size);
+
+  /**
+   * @brief 把表分配到某个分区，表的数据文件和索引文件都会使用这个分区
+   * @details 按照文件名识别文件属于哪个表(参考 table_name_of_file)，只对之后打开的文件生效
+   * @param partition 分区的名字，需要先创建
+   */
+  RC assign_table(const char *table_name, const char *partition);
+
+  /**
+   * @brief 把表设置为只读的，表的数据文件和索引文件会使用mmap映射到内存中，参考 DiskBufferPool::open_file
+   * @details 适用于归档之后不会再修改的表，只对之后打开的文件生效
+   */
+  void set_table_readonly(const char *table_name);
+
+  BufferPoolPartition &default_partition() { return *default_partition_; }
+
+  /**
+   * @brief 按照名字查找分区
+   * @return BufferPoolPartition* 不存在时返回nullptr
+   */
+  BufferPoolPartition *find_partition(const char *name);
+
+  /**
+   * @brief 设置预读参数，并启动异步预读的线程
+   */
+  RC start_read_ahead(const ReadAheadParam &param);
+
+  const ReadAheadParam &read_ahead_param() const { return read_ahead_param_; }
+
+  /**
+   * @brief 提交一个异步预读任务
+   * @return false 没有启动预读线程，调用者需要自己同步执行
+   */
+  bool submit_read_ahead(const std::function<void()> &task);
+
+  /**
+   * @brief 设置页面IO的实现，需要在打开文件之前设置
+   *
+   * @param name 参考 PageIO::create
+   */
+  RC set_page_io(const char *name);
+
+  PageIO &page_io() { return *page_io_; }
+
+  /**
+   * @brief 是否使用 O_DIRECT 打开文件，需要在打开文件之前设置
+   * @details 数据只缓存在缓冲池中，不再经过操作系统的页缓存，内存可以都给缓冲池使用。
+   * 页帧的内存是按照页面大小对齐的(参考 FrameArena)，满足 O_DIRECT 的要求。
+   * 文件系统不支持 O_DIRECT 时(比如tmpfs)，会退化成普通的读写
+   */
+  void set_direct_io(bool enable) { direct_io_ = enable; }
+  bool direct_io() const { return direct_io_; }
+
+  /**
+   * @brief 设置 flush_all_pages 下刷脏页的速度上限
+   * @param mb_per_second 每秒最多写多少MB，小于等于0表示不限速
+   */
+  void    set_flush_rate_limit(int64_t mb_per_second);
+  int64_t flush_rate_limit() const { return flush_rate_limit_; }
+
+  /**
+   * @brief 下刷一批页面之前调用，超过限速时会在这里等待
+   * @details 所有文件共享同一个限速，等待时不持有任何buffer pool的锁
+   */
+  void throttle_flush(int pages);
+
+  /**
+   * @brief 把在内存中的页面列表保存到文件中，重启后可以使用 warm_up 重新加载
+   * @details 每行记录一个页面：文件名 页面编号
+   */
+  RC dump_hot_pages(const char *dump_file);
+
+  /**
+   * @brief 加载 dump_hot_pages 保存的页面
+   * @details 只加载已经打开的文件中的页面，需要在打开数据库之后调用
+   */
+  RC warm_up(const char *dump_file);
+
+  /**
+   * @brief 全局的统计信息，所有文件的统计信息都会汇总到这里
+   */
+  BufferPoolStats &stats() { return stats_; }
+
+  /**
+   * @brief 收集全局和每个打开文件的统计信息
+   * @details 除了访问和IO的计数外，还包括页帧的使用情况，比如pin住的页帧和脏页的个数
+   */
+  void collect_stats(std::vector<BufferPoolStatItem> &items);
+
 public:
   static void               set_instance(BufferPoolManager *bpm);  // TODO 优化全局变量的表示方法
   static BufferPoolManager &instance();
 
 private:
-  BPFrameManager frame_manager_{"BufPool"};
+  /**
+   * @brief 文件应该使用哪个分区，调用时需要持有lock_
+   */
+  BufferPoolPartition &partition_of_file(const std::string &file_name);
+
+private:
+  std::string frame_cache_name_;
+
+  /// 分区只会增加，不会删除，所以可以在不持有锁的时候使用分区的引用
+  std::map<std::string, std::unique_ptr<BufferPoolPartition>> partitions_;
+  BufferPoolPartition                                        *default_partition_ = nullptr;
+  std::unordered_map<std::string, std::string>                table_partitions_;  ///< 表名 -> 分区名
+  std::unordered_set<std::string>                             readonly_tables_;
+
+  PageCleanerParam cleaner_param_;
+  bool             cleaner_started_ = false;
+
+  ReadAheadParam             read_ahead_param_;
+  common::ThreadPoolExecutor read_ahead_executor_;
+  std::atomic<bool>          read_ahead_running_{false};
+
+  std::unique_ptr<PageIO> page_io_{new SyncPageIO()};
+
+  BufferPoolStats stats_;
+  bool            direct_io_ = false;
+
+  int64_t                               flush_rate_limit_ = 0;  ///< 每秒最多下刷多少MB，0表示不限速
+  common::Mutex                         flush_limit_lock_;
+  std::chrono::steady_clock::time_point flush_next_time_;  ///< 按照限速，下一批页面最早什么时候可以下刷
 
   common::Mutex                                     lock_;
   std::unordered_map<std::string, DiskBufferPool *> buffer_pools_;
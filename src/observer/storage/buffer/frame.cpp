@@ -68,12 +68,12 @@ void Frame::write_latch(intptr_t xid)
     ASSERT(pin_count_.load() > 0,
         "frame lock. write lock failed while pin count is invalid. "
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
     ASSERT(read_lockers_.find(xid) == read_lockers_.end(),
         "frame lock write while holding the read lock."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
   }
 
   lock_.lock();
@@ -83,7 +83,7 @@ void Frame::write_latch(intptr_t xid)
   ++write_recursive_count_;
   TRACE("frame write lock success."
         "this=%p, pin=%d, pageNum=%d, write locker=%lx(recursive=%d), fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, write_locker_, write_recursive_count_, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, write_locker_, write_recursive_count_, file_desc_, xid, lbt());
 #endif
 }
 
@@ -97,15 +97,15 @@ void Frame::write_unlatch(intptr_t xid)
   ASSERT(pin_count_.load() > 0,
       "frame lock. write unlock failed while pin count is invalid."
       "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-      this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+      this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
   ASSERT(write_locker_ == xid,
       "frame unlock write while not the owner."
       "write_locker=%lx, this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-      write_locker_, this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+      write_locker_, this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
   TRACE("frame write unlock success. this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
   if (--write_recursive_count_ == 0) {
     write_locker_ = 0;
@@ -124,12 +124,12 @@ void Frame::read_latch(intptr_t xid)
     ASSERT(pin_count_ > 0,
         "frame lock. read lock failed while pin count is invalid."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
     ASSERT(xid != write_locker_,
         "frame lock read while holding the write lock."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
   }
 
   lock_.lock_shared();
@@ -140,7 +140,7 @@ void Frame::read_latch(intptr_t xid)
     ++read_lockers_[xid];
     TRACE("frame read lock success."
           "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, recursive=%d, lbt=%s",
-          this, pin_count_.load(), page_.page_num, file_desc_, xid, read_lockers_[xid], lbt());
+          this, pin_count_.load(), page_->page_num, file_desc_, xid, read_lockers_[xid], lbt());
 #endif
   }
 }
@@ -153,12 +153,12 @@ bool Frame::try_read_latch()
     ASSERT(pin_count_ > 0,
         "frame try lock. read lock failed while pin count is invalid."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
     ASSERT(xid != write_locker_,
         "frame try to lock read while holding the write lock."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
   }
 
   bool ret = lock_.try_lock_shared();
@@ -168,7 +168,7 @@ bool Frame::try_read_latch()
     ++read_lockers_[xid];
     TRACE("frame read lock success."
           "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, recursive=%d, lbt=%s",
-          this, pin_count_.load(), page_.page_num, file_desc_, xid, read_lockers_[xid], lbt());
+          this, pin_count_.load(), page_->page_num, file_desc_, xid, read_lockers_[xid], lbt());
     debug_lock_.unlock();
 #endif
   }
@@ -185,7 +185,7 @@ void Frame::read_unlatch(intptr_t xid)
     ASSERT(pin_count_.load() > 0,
         "frame lock. read unlock failed while pin count is invalid."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
 #ifdef DEBUG
     auto read_lock_iter  = read_lockers_.find(xid);
@@ -193,7 +193,7 @@ void Frame::read_unlatch(intptr_t xid)
     ASSERT(recursive_count > 0,
         "frame unlock while not holding read lock."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, recursive=%d, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, recursive_count, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, recursive_count, lbt());
 
     if (1 == recursive_count) {
       read_lockers_.erase(xid);
@@ -203,7 +203,7 @@ void Frame::read_unlatch(intptr_t xid)
 
   TRACE("frame read unlock success."
         "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-        this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+        this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
   lock_.unlock_shared();
 }
@@ -218,7 +218,7 @@ void Frame::pin()
   TRACE("after frame pin. "
         "this=%p, write locker=%lx, read locker has xid %d? pin=%d, fd=%d, pageNum=%d, xid=%lx, lbt=%s",
         this, write_locker_, read_lockers_.find(xid) != read_lockers_.end(), 
-        pin_count, file_desc_, page_.page_num, xid, lbt());
+        pin_count, file_desc_, page_->page_num, xid, lbt());
 }
 
 int Frame::unpin()
@@ -228,7 +228,7 @@ int Frame::unpin()
   ASSERT(pin_count_.load() > 0,
       "try to unpin a frame that pin count <= 0."
       "this=%p, pin=%d, pageNum=%d, fd=%d, xid=%lx, lbt=%s",
-      this, pin_count_.load(), page_.page_num, file_desc_, xid, lbt());
+      this, pin_count_.load(), page_->page_num, file_desc_, xid, lbt());
 
   std::scoped_lock debug_lock(debug_lock_);
 
@@ -236,15 +236,15 @@ int Frame::unpin()
   TRACE("after frame unpin. "
         "this=%p, write locker=%lx, read locker has xid? %d, pin=%d, fd=%d, pageNum=%d, xid=%lx, lbt=%s",
         this, write_locker_, read_lockers_.find(xid) != read_lockers_.end(), 
-        pin_count, file_desc_, page_.page_num, xid, lbt());
+        pin_count, file_desc_, page_->page_num, xid, lbt());
 
   if (0 == pin_count) {
     ASSERT(write_locker_ == 0,
            "frame unpin to 0 failed while someone hold the write lock. write locker=%lx, pageNum=%d, fd=%d, xid=%lx",
-           write_locker_, page_.page_num, file_desc_, xid);
+           write_locker_, page_->page_num, file_desc_, xid);
     ASSERT(read_lockers_.empty(),
            "frame unpin to 0 failed while someone hold the read locks. reader num=%d, pageNum=%d, fd=%d, xid=%lx",
-           read_lockers_.size(), page_.page_num, file_desc_, xid);
+           read_lockers_.size(), page_->page_num, file_desc_, xid);
   }
   return pin_count;
 }
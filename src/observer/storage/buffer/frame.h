@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <pthread.h>
 #include <set>
@@ -58,33 +59,38 @@ private:
  *
  * 为了防止在使用过程中页面被淘汰，这里使用了pin count，当页面被使用时，pin count会增加，
  * 当页面不再使用时，pin count会减少。当pin count为0时，页面可以被淘汰。
+ *
+ * 页帧的元数据和页面数据是分开存放的。缓冲池中所有页面的数据放在 FrameArena 的一段连续内存中，
+ * 页帧只记录页面的位置。
  */
 class Frame
 {
 public:
+  /**
+   * @brief 页面数据由页帧自己分配，测试或者临时使用
+   */
+  Frame() : own_page_(new Page()), page_(own_page_.get()) { memset(page_, 0, sizeof(Page)); }
+
+  /**
+   * @brief 使用外部的页面，页帧不负责释放
+   */
+  explicit Frame(Page *page) : page_(page) {}
+
   ~Frame()
   {
     // LOG_DEBUG("deallocate frame. this=%p, lbt=%s", this, common::lbt());
   }
 
-  /**
-   * @brief reinit 和 reset 在 MemPoolSimple 中使用
-   * @details 在 MemPoolSimple 分配和释放一个Frame对象时，不会调用构造函数和析构函数，
-   * 而是调用reinit和reset。
-   */
-  void reinit() {}
-  void reset() {}
-
-  void clear_page() { memset(&page_, 0, sizeof(page_)); }
+  void clear_page() { memset(page_, 0, sizeof(Page)); }
 
   int     file_desc() const { return file_desc_; }
   void    set_file_desc(int fd) { file_desc_ = fd; }
-  Page   &page() { return page_; }
-  PageNum page_num() const { return page_.page_num; }
-  void    set_page_num(PageNum page_num) { page_.page_num = page_num; }
-  FrameId frame_id() const { return FrameId(file_desc_, page_.page_num); }
-  LSN     lsn() const { return page_.lsn; }
-  void    set_lsn(LSN lsn) { page_.lsn = lsn; }
+  Page   &page() { return *page_; }
+  PageNum page_num() const { return page_->page_num; }
+  void    set_page_num(PageNum page_num) { page_->page_num = page_num; }
+  FrameId frame_id() const { return FrameId(file_desc_, page_->page_num); }
+  LSN     lsn() const { return page_->lsn; }
+  void    set_lsn(LSN lsn) { page_->lsn = lsn; }
 
   /// 刷新访问时间 TODO touch is better?
   void access();
@@ -97,7 +103,7 @@ public:
   void clear_dirty() { dirty_ = false; }
   bool dirty() const { return dirty_; }
 
-  char *data() { return page_.data; }
+  char *data() { return page_->data; }
 
   bool can_purge() { return pin_count_.load() == 0; }
 
@@ -136,7 +142,9 @@ private:
   std::atomic<int> pin_count_{0};
   unsigned long    acc_time_  = 0;
   int              file_desc_ = -1;
-  Page             page_;
+
+  std::unique_ptr<Page> own_page_;
+  Page                 *page_ = nullptr;
 
   /// 在非并发编译时，加锁解锁动作将什么都不做
   common::RecursiveSharedMutex lock_;
@@ -0,0 +1,101 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "common/log/log.h"
+#include "storage/buffer/frame_arena.h"
+
+/// 大页的大小。x86_64 和 aarch64 上默认都是2M
+static const size_t HUGE_PAGE_SIZE = 2UL * 1024 * 1024;
+
+static size_t align_up(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+
+FrameArena::~FrameArena() { destroy(); }
+
+RC FrameArena::init(int frame_num, bool use_huge_page /* = true */)
+{
+  if (memory_ != nullptr) {
+    LOG_WARN("frame arena has been initialized");
+    return RC::INTERNAL;
+  }
+  if (frame_num <= 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const size_t page_size = static_cast<size_t>(frame_num) * sizeof(Page);
+  memory_size_           = align_up(page_size, HUGE_PAGE_SIZE);
+  page_mode_             = PageMode::NORMAL;
+
+  void *memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (use_huge_page) {
+    memory = mmap(nullptr, memory_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) {
+      page_mode_ = PageMode::HUGETLB;
+    } else {
+      LOG_INFO("failed to alloc frame arena with MAP_HUGETLB, try transparent huge page. size=%ld, errno=%s",
+               memory_size_, strerror(errno));
+    }
+  }
+#endif
+
+  if (memory == MAP_FAILED) {
+    memory = mmap(nullptr, memory_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      LOG_ERROR("failed to alloc frame arena. size=%ld, errno=%s", memory_size_, strerror(errno));
+      memory_size_ = 0;
+      return RC::NOMEM;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (use_huge_page && madvise(memory, memory_size_, MADV_HUGEPAGE) == 0) {
+      page_mode_ = PageMode::THP;
+    }
+#endif
+  }
+
+  memory_ = memory;
+
+  Page *pages = static_cast<Page *>(memory_);
+  for (int i = 0; i < frame_num; i++) {
+    frames_.emplace_back(&pages[i]);
+  }
+
+  LOG_INFO("frame arena init done. frame num=%d, memory size=%ld, page mode=%s",
+           frame_num, memory_size_, page_mode_name(page_mode_));
+  return RC::SUCCESS;
+}
+
+void FrameArena::destroy()
+{
+  frames_.clear();
+  if (memory_ != nullptr) {
+    munmap(memory_, memory_size_);
+    memory_      = nullptr;
+    memory_size_ = 0;
+  }
+}
+
+const char *FrameArena::page_mode_name(PageMode mode)
+{
+  switch (mode) {
+    case PageMode::NORMAL: return "normal";
+    case PageMode::THP: return "thp";
+    case PageMode::HUGETLB: return "hugetlb";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <deque>
+#include <stddef.h>
+
+#include "common/rc.h"
+#include "storage/buffer/frame.h"
+
+/**
+ * @brief 缓冲池所有页帧使用的内存
+ * @ingroup BufferPool
+ * @details 所有页面的数据放在一段使用mmap申请的连续内存中，页帧的元数据(pin count、锁等)单独存放。
+ * 这样页面数据是连续并且按照页面大小对齐的，可以直接用于 O_DIRECT 读写。
+ * 缓冲池很大时，普通的4K页会带来大量的TLB miss，所以会尽量使用大页：
+ * 1. 先尝试 MAP_HUGETLB，需要系统预留了足够的大页(/proc/sys/vm/nr_hugepages)；
+ * 2. 再尝试透明大页，使用 madvise(MADV_HUGEPAGE) 告诉内核这段内存适合使用大页；
+ * 3. 都不支持时，就使用普通的内存页。
+ */
+class FrameArena
+{
+public:
+  enum class PageMode
+  {
+    NORMAL,   ///< 普通内存页
+    THP,      ///< 透明大页
+    HUGETLB,  ///< 预留的大页
+  };
+
+  FrameArena() = default;
+  ~FrameArena();
+
+  FrameArena(const FrameArena &)            = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  /**
+   * @brief 申请内存，创建 frame_num 个页帧
+   * @param use_huge_page 是否尝试使用大页
+   */
+  RC init(int frame_num, bool use_huge_page = true);
+
+  int    size() const { return static_cast<int>(frames_.size()); }
+  Frame *frame(int index) { return &frames_[index]; }
+
+  PageMode page_mode() const { return page_mode_; }
+
+  static const char *page_mode_name(PageMode mode);
+
+private:
+  void destroy();
+
+private:
+  void             *memory_      = nullptr;
+  size_t            memory_size_ = 0;
+  PageMode          page_mode_   = PageMode::NORMAL;
+  std::deque<Frame> frames_;  ///< deque 可以原地构造不能移动的对象
+};
@@ -0,0 +1,179 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <strings.h>
+
+#include "common/lang/string.h"
+#include "common/log/log.h"
+#include "storage/buffer/frame_cache.h"
+
+using namespace std;
+
+FrameCache *FrameCache::create(const char *name, size_t capacity)
+{
+  if (common::is_blank(name) || 0 == strcasecmp(name, "lru")) {
+    return new LruFrameCache();
+  }
+
+  if (0 == strcasecmp(name, "2q")) {
+    return new TwoQueueFrameCache(capacity);
+  }
+
+  LOG_ERROR("unknown frame cache name. name=%s", name);
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TwoQueueFrameCache::TwoQueueFrameCache(size_t capacity)
+    // 论文中建议的参数：in队列占总容量的1/4，ghost队列记录总容量1/2的页面
+    : in_capacity_(std::max(capacity / 4, (size_t)1)), ghost_capacity_(std::max(capacity / 2, (size_t)1))
+{}
+
+bool TwoQueueFrameCache::get(const FrameId &frame_id, Frame *&frame)
+{
+  auto iter = nodes_.find(frame_id);
+  if (iter == nodes_.end()) {
+    return false;
+  }
+
+  NodeList::iterator node = iter->second;
+  if (node->hot) {
+    hot_list_.splice(hot_list_.begin(), hot_list_, node);
+  }
+  frame = node->frame;
+  return true;
+}
+
+void TwoQueueFrameCache::put(const FrameId &frame_id, Frame *frame)
+{
+  auto iter = nodes_.find(frame_id);
+  if (iter != nodes_.end()) {
+    iter->second->frame = frame;
+    if (iter->second->hot) {
+      hot_list_.splice(hot_list_.begin(), hot_list_, iter->second);
+    }
+    return;
+  }
+
+  // 刚从in队列淘汰不久又被访问的页面，说明它不是只访问一次的页面，直接放到hot队列中
+  auto ghost_iter = ghosts_.find(frame_id);
+  if (ghost_iter != ghosts_.end()) {
+    ghost_list_.erase(ghost_iter->second);
+    ghosts_.erase(ghost_iter);
+
+    hot_list_.push_front(Node{frame_id, frame, true});
+    nodes_.emplace(frame_id, hot_list_.begin());
+  } else {
+    in_list_.push_front(Node{frame_id, frame, false});
+    nodes_.emplace(frame_id, in_list_.begin());
+  }
+}
+
+void TwoQueueFrameCache::remove(const FrameId &frame_id)
+{
+  auto iter = nodes_.find(frame_id);
+  if (iter == nodes_.end()) {
+    return;
+  }
+
+  NodeList::iterator node = iter->second;
+  nodes_.erase(iter);
+  if (node->hot) {
+    hot_list_.erase(node);
+  } else {
+    in_list_.erase(node);
+  }
+}
+
+void TwoQueueFrameCache::evict(const FrameId &frame_id)
+{
+  auto iter = nodes_.find(frame_id);
+  if (iter != nodes_.end() && !iter->second->hot) {
+    add_ghost(frame_id);
+  }
+  remove(frame_id);
+}
+
+void TwoQueueFrameCache::forget_file(int file_desc)
+{
+  for (auto iter = ghost_list_.begin(); iter != ghost_list_.end();) {
+    if (iter->file_desc() == file_desc) {
+      ghosts_.erase(*iter);
+      iter = ghost_list_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void TwoQueueFrameCache::add_ghost(const FrameId &frame_id)
+{
+  if (ghosts_.find(frame_id) != ghosts_.end()) {
+    return;
+  }
+
+  ghost_list_.push_front(frame_id);
+  ghosts_.emplace(frame_id, ghost_list_.begin());
+  if (ghost_list_.size() > ghost_capacity_) {
+    ghosts_.erase(ghost_list_.back());
+    ghost_list_.pop_back();
+  }
+}
+
+void TwoQueueFrameCache::destroy()
+{
+  nodes_.clear();
+  in_list_.clear();
+  hot_list_.clear();
+  ghosts_.clear();
+  ghost_list_.clear();
+}
+
+void TwoQueueFrameCache::foreach (Visitor visitor)
+{
+  for (Node &node : hot_list_) {
+    if (!visitor(node.frame_id, node.frame)) {
+      return;
+    }
+  }
+  for (Node &node : in_list_) {
+    if (!visitor(node.frame_id, node.frame)) {
+      return;
+    }
+  }
+}
+
+void TwoQueueFrameCache::foreach_reverse(Visitor visitor)
+{
+  auto visit_list = [&visitor](NodeList &list) {
+    for (auto iter = list.rbegin(); iter != list.rend(); ++iter) {
+      if (!visitor(iter->frame_id, iter->frame)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // in队列过长时优先淘汰in队列中的页面，否则优先淘汰hot队列中的页面
+  if (in_list_.size() > in_capacity_) {
+    if (visit_list(in_list_)) {
+      visit_list(hot_list_);
+    }
+  } else {
+    if (visit_list(hot_list_)) {
+      visit_list(in_list_);
+    }
+  }
+}
@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include "common/lang/lru_cache.h"
+#include "storage/buffer/frame.h"
+
+/**
+ * @brief FrameId 的哈希函数
+ * @ingroup BufferPool
+ */
+class FrameIdHasher
+{
+public:
+  size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
+};
+
+/**
+ * @brief 页帧表，同时决定了页帧的淘汰顺序(页面置换策略)
+ * @ingroup BufferPool
+ * @details BPFrameManager 的每个分片都有一个页帧表。页帧表不需要考虑并发，调用者会加锁。
+ * foreach_reverse 按照“最应该被淘汰”到“最不应该被淘汰”的顺序遍历页帧，淘汰页帧和后台刷脏页
+ * 时都按照这个顺序查找。
+ */
+class FrameCache
+{
+public:
+  using Visitor = std::function<bool(const FrameId &, Frame *const &)>;
+
+public:
+  virtual ~FrameCache() = default;
+
+  /**
+   * @brief 根据名字创建一个页帧表
+   *
+   * @param name 置换策略的名字，当前支持 lru 和 2q，为空时使用lru
+   * @param capacity 页帧表大概能容纳多少个页帧，有些置换策略会根据这个值划分不同的队列
+   * @return FrameCache* 名字不合法时返回nullptr
+   */
+  static FrameCache *create(const char *name, size_t capacity);
+
+  virtual const char *name() const = 0;
+
+  /**
+   * @brief 查找页帧，同时会记录一次访问
+   */
+  virtual bool get(const FrameId &frame_id, Frame *&frame) = 0;
+  virtual void put(const FrameId &frame_id, Frame *frame)  = 0;
+  virtual void remove(const FrameId &frame_id)             = 0;
+
+  /**
+   * @brief 为了腾出页帧而淘汰一个页帧
+   * @details 与 remove 不同，有些置换策略会记住被淘汰的页面，很快再访问时认为它是热点页面。
+   * 释放页面、关闭文件时删除页帧应该使用 remove
+   */
+  virtual void evict(const FrameId &frame_id) { remove(frame_id); }
+
+  /**
+   * @brief 文件关闭时忘掉这个文件的所有访问历史
+   * @details 文件描述符关闭后会被复用，新文件的页面不能继承老文件的访问历史
+   */
+  virtual void forget_file(int file_desc) {}
+
+  virtual size_t count() const = 0;
+  virtual void   destroy()     = 0;
+
+  /**
+   * @brief 遍历所有页帧，不会改变页帧的淘汰顺序。回调函数返回false时停止遍历
+   */
+  virtual void foreach (Visitor visitor) = 0;
+
+  /**
+   * @brief 按照淘汰顺序遍历所有页帧，最先遍历到的是最应该被淘汰的页帧
+   */
+  virtual void foreach_reverse(Visitor visitor) = 0;
+};
+
+/**
+ * @brief 使用LRU策略的页帧表
+ * @ingroup BufferPool
+ * @details 一次全表扫描会把整个缓冲池中的页面都换掉，比如B+树的热点页面。
+ */
+class LruFrameCache : public FrameCache
+{
+public:
+  const char *name() const override { return "lru"; }
+
+  bool get(const FrameId &frame_id, Frame *&frame) override { return cache_.get(frame_id, frame); }
+  void put(const FrameId &frame_id, Frame *frame) override { cache_.put(frame_id, frame); }
+  void remove(const FrameId &frame_id) override { cache_.remove(frame_id); }
+
+  size_t count() const override { return cache_.count(); }
+  void   destroy() override { cache_.destroy(); }
+
+  void foreach (Visitor visitor) override { cache_.foreach (visitor); }
+  void foreach_reverse(Visitor visitor) override { cache_.foreach_reverse(visitor); }
+
+private:
+  common::LruCache<FrameId, Frame *, FrameIdHasher> cache_;
+};
+
+/**
+ * @brief 使用2Q策略的页帧表，可以抵御全表扫描
+ * @ingroup BufferPool
+ * @details 参考 2Q: A Low Overhead High Performance Buffer Management Replacement Algorithm。
+ * 页帧分在两个队列中：
+ * - in队列：第一次加载的页面放在这里，按照FIFO的顺序淘汰，在队列中再次访问不会改变顺序；
+ * - hot队列：最近被淘汰过又很快被访问的页面放在这里，按照LRU的顺序淘汰。
+ * 另外使用一个ghost队列记录最近从in队列中淘汰的页面编号(不占用页帧)，只有淘汰的页面才会记录，
+ * 释放的页面和关闭的文件不会留下记录。
+ * 一次全表扫描的页面只会经过in队列，不会把hot队列中的页面挤出去。
+ */
+class TwoQueueFrameCache : public FrameCache
+{
+public:
+  TwoQueueFrameCache(size_t capacity);
+
+  const char *name() const override { return "2q"; }
+
+  bool get(const FrameId &frame_id, Frame *&frame) override;
+  void put(const FrameId &frame_id, Frame *frame) override;
+  void remove(const FrameId &frame_id) override;
+  void evict(const FrameId &frame_id) override;
+  void forget_file(int file_desc) override;
+
+  size_t count() const override { return nodes_.size(); }
+  void   destroy() override;
+
+  void foreach (Visitor visitor) override;
+  void foreach_reverse(Visitor visitor) override;
+
+  size_t in_count() const { return in_list_.size(); }
+  size_t hot_count() const { return hot_list_.size(); }
+
+private:
+  struct Node
+  {
+    FrameId frame_id;
+    Frame  *frame;
+    bool    hot;
+  };
+
+  using NodeList = std::list<Node>;
+
+  void add_ghost(const FrameId &frame_id);
+
+private:
+  size_t in_capacity_;     ///< in队列超过这个长度时，优先从in队列中淘汰
+  size_t ghost_capacity_;  ///< ghost队列最多记录多少个页面
+
+  NodeList                                                        in_list_;   ///< 头部是最新加入的页面
+  NodeList                                                        hot_list_;  ///< 头部是最近访问的页面
+  std::unordered_map<FrameId, NodeList::iterator, FrameIdHasher> nodes_;
+
+  std::list<FrameId>                                                        ghost_list_;
+  std::unordered_map<FrameId, std::list<FrameId>::iterator, FrameIdHasher> ghosts_;
+};
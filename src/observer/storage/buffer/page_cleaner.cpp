@@ -0,0 +1,219 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <chrono>
+#include <vector>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/page_cleaner.h"
+
+using namespace std;
+using namespace common;
+
+PageCleaner::PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager)
+    : bp_manager_(bp_manager), frame_manager_(frame_manager)
+{}
+
+PageCleaner::~PageCleaner() { stop(); }
+
+RC PageCleaner::start(const PageCleanerParam &param)
+{
+  if (running_.load()) {
+    LOG_WARN("page cleaner is already running");
+    return RC::INTERNAL;
+  }
+
+  if (param.thread_num <= 0) {
+    LOG_INFO("page cleaner is disabled");
+    return RC::SUCCESS;
+  }
+
+#ifndef CONCURRENCY
+  // 非并发编译模式下，页帧和buffer pool的锁什么都不做，后台线程刷盘会与前台访问冲突
+  LOG_INFO("page cleaner is disabled without CONCURRENCY");
+  return RC::SUCCESS;
+#endif
+
+  param_            = param;
+  param_.thread_num = std::min(param_.thread_num, frame_manager_.shard_num());
+  if (param_.interval_ms <= 0) {
+    param_.interval_ms = PageCleanerParam().interval_ms;
+  }
+  if (param_.dirty_low_watermark > param_.dirty_high_watermark) {
+    param_.dirty_low_watermark = param_.dirty_high_watermark;
+  }
+
+  int ret = executor_.init("PageCleaner", param_.thread_num, param_.thread_num, 60 * 1000);
+  if (ret != 0) {
+    LOG_WARN("failed to init page cleaner thread pool. ret=%d", ret);
+    return RC::INTERNAL;
+  }
+
+  running_ = true;
+  for (int i = 0; i < param_.thread_num; i++) {
+    executor_.execute([this, i]() { run(i); });
+  }
+
+  LOG_INFO("page cleaner started. thread num=%d, interval=%dms, free frame percent=%d, "
+           "dirty watermark high=%d, low=%d",
+           param_.thread_num, param_.interval_ms, param_.free_frame_percent,
+           param_.dirty_high_watermark, param_.dirty_low_watermark);
+  return RC::SUCCESS;
+}
+
+RC PageCleaner::stop()
+{
+  if (!running_.load()) {
+    return RC::SUCCESS;
+  }
+
+  {
+    lock_guard<mutex> guard(lock_);
+    running_ = false;
+  }
+  wakeup_cv_.notify_all();
+  free_frame_cv_.notify_all();
+
+  executor_.shutdown();
+  executor_.await_termination();
+  LOG_INFO("page cleaner stopped");
+  return RC::SUCCESS;
+}
+
+bool PageCleaner::wait_free_frames(int timeout_ms)
+{
+  if (!running_.load()) {
+    return false;
+  }
+
+  unique_lock<mutex> guard(lock_);
+  const int64_t      freed_seq = freed_seq_;
+  wakeup_seq_++;
+  wakeup_cv_.notify_all();
+  return free_frame_cv_.wait_for(guard, chrono::milliseconds(timeout_ms), [this, freed_seq]() {
+    return !running_.load() || freed_seq_ != freed_seq;
+  }) && running_.load();
+}
+
+bool PageCleaner::holding(Frame *frame)
+{
+  lock_guard<mutex> guard(holding_lock_);
+  return holding_frames_.count(frame) > 0;
+}
+
+void PageCleaner::run(int thread_index)
+{
+  LOG_INFO("page cleaner thread started. thread index=%d", thread_index);
+
+  int64_t wakeup_seq = 0;
+  while (running_.load()) {
+    int freed_count = 0;
+    for (int shard = thread_index; shard < frame_manager_.shard_num(); shard += param_.thread_num) {
+      freed_count += clean_shard(shard);
+    }
+
+    unique_lock<mutex> guard(lock_);
+    if (freed_count > 0) {
+      freed_seq_++;
+      free_frame_cv_.notify_all();
+    }
+
+    wakeup_cv_.wait_for(guard, chrono::milliseconds(param_.interval_ms), [this, &wakeup_seq]() {
+      return !running_.load() || wakeup_seq_ != wakeup_seq;
+    });
+    wakeup_seq = wakeup_seq_;
+  }
+
+  LOG_INFO("page cleaner thread exit. thread index=%d", thread_index);
+}
+
+int PageCleaner::clean_shard(int shard_index)
+{
+  const int capacity    = std::max(static_cast<int>(frame_manager_.total_frame_num() / frame_manager_.shard_num()), 1);
+  const int free_target = std::max(capacity * param_.free_frame_percent / 100, 1);
+  const int cold_depth  = free_target * 2;
+
+  // 先统计一下脏页比例，超过高水位时，冷端以外的脏页也要刷到低水位以下
+  int dirty_num = 0;
+  frame_manager_.foreach_frame_reverse(shard_index, [&dirty_num](Frame *frame) {
+    if (frame->dirty()) {
+      dirty_num++;
+    }
+    return true;
+  });
+
+  int extra_num = 0;
+  if (dirty_num * 100 > capacity * param_.dirty_high_watermark) {
+    extra_num = dirty_num - capacity * param_.dirty_low_watermark / 100;
+  }
+
+  // 在分片的锁内pin住要刷盘的页帧，真正刷盘时不持有分片的锁
+  vector<Frame *> dirty_frames;
+  int             depth = 0;
+  frame_manager_.foreach_frame_reverse(shard_index, [&](Frame *frame) {
+    const bool in_cold_region = depth++ < cold_depth;
+    if (!in_cold_region && extra_num <= 0) {
+      return false;
+    }
+
+    if (frame->can_purge() && frame->dirty()) {
+      if (!in_cold_region) {
+        extra_num--;
+      }
+
+      frame->pin();
+      dirty_frames.push_back(frame);
+
+      lock_guard<mutex> guard(holding_lock_);
+      holding_frames_.insert(frame);
+    }
+    return true;
+  });
+
+  for (Frame *frame : dirty_frames) {
+    flush_frame(frame);
+  }
+
+  int freed_count = 0;
+  int free_num    = static_cast<int>(frame_manager_.free_frame_num(shard_index));
+  if (free_num < free_target) {
+    freed_count = frame_manager_.evict_clean_frames(shard_index, free_target - free_num);
+  }
+
+  if (!dirty_frames.empty() || freed_count > 0) {
+    LOG_DEBUG("page cleaner clean shard done. shard=%d, dirty=%d, flushed=%d, freed=%d",
+              shard_index, dirty_num, (int)dirty_frames.size(), freed_count);
+  }
+  return freed_count;
+}
+
+void PageCleaner::flush_frame(Frame *frame)
+{
+  // 拿不到读锁说明有人正在修改这个页面，下次再刷
+  if (frame->try_read_latch()) {
+    if (frame->dirty()) {
+      RC rc = bp_manager_.flush_page(*frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("page cleaner failed to flush page. frame=%s, rc=%s", to_string(*frame).c_str(), strrc(rc));
+      }
+    }
+    frame->read_unlatch();
+  }
+
+  // 在锁内先删除再unpin。关闭文件时 holding 返回false，就说明后台线程已经不再使用这个页帧了
+  lock_guard<mutex> guard(holding_lock_);
+  holding_frames_.erase(frame);
+  frame->unpin();
+}
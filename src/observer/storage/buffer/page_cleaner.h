@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
+#include "common/rc.h"
+#include "common/thread/thread_pool_executor.h"
+
+class BufferPoolManager;
+class BPFrameManager;
+class Frame;
+
+/**
+ * @brief 后台刷脏页的参数
+ * @ingroup BufferPool
+ */
+struct PageCleanerParam
+{
+  int thread_num           = 1;    ///< 后台线程个数。为0时不启动后台线程
+  int interval_ms          = 100;  ///< 每隔多久检查一次
+  int free_frame_percent   = 5;    ///< 尽量保留多少比例的空闲页帧
+  int dirty_high_watermark = 50;   ///< 脏页比例(百分比)超过这个值时，不再仅限于冷端，要尽快刷脏页
+  int dirty_low_watermark  = 30;   ///< 脏页比例超过高水位时，一直刷到这个比例为止
+};
+
+/**
+ * @brief 后台刷脏页，并保留一定比例的空闲页帧
+ * @ingroup BufferPool
+ * @details 前台线程在缓冲池中找不到页面时，需要淘汰一个页帧。如果淘汰的是脏页，就需要先
+ * 把它写到磁盘上，这个前台请求就要为一个不相关的页面等待一次磁盘写。
+ * PageCleaner 在后台做这件事情：
+ * 1. 把LRU冷端的脏页刷到磁盘，这样前台淘汰时总能找到干净的页帧；
+ * 2. 脏页比例超过高水位时，继续刷脏页直到降到低水位；
+ * 3. 淘汰冷端的干净页帧，保持一定比例的空闲页帧，前台分配时可以直接拿到。
+ *
+ * 每个后台线程负责 BPFrameManager 中的一部分分片，线程之间不会争抢同一个分片。
+ */
+class PageCleaner
+{
+public:
+  PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager);
+  ~PageCleaner();
+
+  /**
+   * @brief 启动后台线程
+   */
+  RC start(const PageCleanerParam &param);
+
+  /**
+   * @brief 停止后台线程，会等待所有线程退出
+   */
+  RC stop();
+
+  bool running() const { return running_.load(); }
+
+  /**
+   * @brief 前台找不到干净的页帧时调用，唤醒后台线程并等待一段时间
+   *
+   * @param timeout_ms 最多等待多久
+   * @return true 后台线程在这段时间里释放了一些页帧
+   * @return false 后台线程没有运行或者超时
+   */
+  bool wait_free_frames(int timeout_ms);
+
+  /**
+   * @brief 后台线程是否正pin着这个页帧刷盘
+   * @details 关闭文件时，如果页帧是被后台线程pin住的，就等它刷完再释放。
+   * 后台线程在同一把锁内删除记录并unpin，这里返回false时后台线程一定已经unpin了
+   */
+  bool holding(Frame *frame);
+
+private:
+  void run(int thread_index);
+
+  /**
+   * @brief 处理一个分片：刷脏页并淘汰干净的页帧
+   * @return int 释放了多少个页帧
+   */
+  int clean_shard(int shard_index);
+
+  /**
+   * @brief 刷新一个页帧，调用前页帧已经被pin住
+   */
+  void flush_frame(Frame *frame);
+
+private:
+  BufferPoolManager &bp_manager_;
+  BPFrameManager    &frame_manager_;
+  PageCleanerParam   param_;
+
+  common::ThreadPoolExecutor executor_;
+  std::atomic<bool>          running_{false};
+
+  std::mutex              lock_;
+  std::condition_variable wakeup_cv_;      ///< 唤醒后台线程
+  std::condition_variable free_frame_cv_;  ///< 通知前台线程有空闲页帧了
+  int64_t                 wakeup_seq_ = 0;
+  int64_t                 freed_seq_  = 0;
+
+  std::mutex                 holding_lock_;
+  std::unordered_set<Frame *> holding_frames_;  ///< 正在刷盘的页帧
+};
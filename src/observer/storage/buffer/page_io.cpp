@@ -0,0 +1,427 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "common/lang/string.h"
+#include "common/log/log.h"
+#include "storage/buffer/page_io.h"
+
+using namespace std;
+
+int64_t PageIORequest::size() const
+{
+  int64_t total = 0;
+  for (int i = 0; i < iovcnt; i++) {
+    total += static_cast<int64_t>(iov[i].iov_len);
+  }
+  return total;
+}
+
+PageIO *PageIO::create(const char *name)
+{
+  if (common::is_blank(name) || 0 == strcasecmp(name, "sync")) {
+    return new SyncPageIO();
+  }
+
+  if (0 == strcasecmp(name, "io_uring")) {
+    if (!IoUringPageIO::supported()) {
+      LOG_WARN("io_uring is not supported, use sync page io instead");
+      return new SyncPageIO();
+    }
+    return new IoUringPageIO();
+  }
+
+  LOG_ERROR("unknown page io name. name=%s", name);
+  return nullptr;
+}
+
+RC PageIO::read(int fd, int64_t offset, void *buf, int size)
+{
+  struct iovec  iov = {buf, static_cast<size_t>(size)};
+  PageIORequest request;
+  request.type   = PageIORequest::Type::READ;
+  request.fd     = fd;
+  request.offset = offset;
+  request.iov    = &iov;
+  request.iovcnt = 1;
+  return submit(&request, 1);
+}
+
+RC PageIO::write(int fd, int64_t offset, const void *buf, int size)
+{
+  struct iovec  iov = {const_cast<void *>(buf), static_cast<size_t>(size)};
+  PageIORequest request;
+  request.type   = PageIORequest::Type::WRITE;
+  request.fd     = fd;
+  request.offset = offset;
+  request.iov    = &iov;
+  request.iovcnt = 1;
+  return submit(&request, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RC SyncPageIO::submit(PageIORequest *requests, int count)
+{
+  RC rc = RC::SUCCESS;
+  for (int i = 0; i < count; i++) {
+    requests[i].rc = execute(requests[i]);
+    if (OB_FAIL(requests[i].rc) && OB_SUCC(rc)) {
+      rc = requests[i].rc;
+    }
+  }
+  return rc;
+}
+
+RC SyncPageIO::execute(const PageIORequest &request, int64_t done)
+{
+  const bool is_read = request.type == PageIORequest::Type::READ;
+  const RC   fail_rc = is_read ? RC::IOERR_READ : RC::IOERR_WRITE;
+
+  // 跳过已经完成的部分。iovec可能会被修改，所以复制一份
+  vector<struct iovec> iovs(request.iov, request.iov + request.iovcnt);
+  size_t               index  = 0;
+  int64_t              offset = request.offset + done;
+  while (index < iovs.size() && done >= static_cast<int64_t>(iovs[index].iov_len)) {
+    done -= static_cast<int64_t>(iovs[index].iov_len);
+    index++;
+  }
+
+  while (index < iovs.size()) {
+    iovs[index].iov_base = static_cast<char *>(iovs[index].iov_base) + done;
+    iovs[index].iov_len -= done;
+
+    const int     iovcnt = static_cast<int>(iovs.size() - index);
+    const ssize_t ret    = is_read ? ::preadv(request.fd, &iovs[index], iovcnt, offset)
+                                   : ::pwritev(request.fd, &iovs[index], iovcnt, offset);
+    if (ret < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        done = 0;
+        continue;
+      }
+      LOG_WARN("failed to %s file. fd=%d, offset=%ld, error=%s",
+               is_read ? "read" : "write", request.fd, offset, strerror(errno));
+      return fail_rc;
+    }
+
+    if (ret == 0) {
+      LOG_WARN("failed to %s file: reach end of file. fd=%d, offset=%ld",
+               is_read ? "read" : "write", request.fd, offset);
+      return fail_rc;
+    }
+
+    offset += ret;
+    done = ret;
+    while (index < iovs.size() && done >= static_cast<int64_t>(iovs[index].iov_len)) {
+      done -= static_cast<int64_t>(iovs[index].iov_len);
+      index++;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_IO_URING
+
+namespace {
+
+/**
+ * @brief 一个io_uring实例，只能在一个线程中使用
+ */
+class IoUring
+{
+public:
+  static constexpr unsigned QUEUE_DEPTH = 64;
+
+public:
+  ~IoUring() { destroy(); }
+
+  bool init();
+  void destroy();
+  bool inited() const { return ring_fd_ >= 0; }
+
+  /**
+   * @brief 提交一批请求并等待完成
+   * @details 请求个数不能超过队列深度
+   * @return false io_uring出现了错误，没有完成的请求需要调用者自己处理，完成的请求记录在completed中
+   */
+  bool submit_and_wait(PageIORequest *requests, int count, vector<bool> &completed);
+
+private:
+  /**
+   * @brief 处理完成队列中所有已经完成的请求
+   * @return 这次处理了多少个请求
+   */
+  int reap(PageIORequest *requests, vector<bool> &completed);
+
+  /**
+   * @brief 出错之后等待已经被内核取走的请求全部完成，之后才能销毁io_uring或者同步重做没有完成的请求
+   * @details 如果等待也失败了，还在执行的请求不能再重做，否则会和内核同时读写同一块内存，只能标记为失败
+   */
+  void drain(PageIORequest *requests, int submitted, int done_num, vector<bool> &completed);
+
+private:
+  int ring_fd_ = -1;
+
+  void  *sq_ptr_      = nullptr;
+  size_t sq_ring_size_ = 0;
+  void  *cq_ptr_      = nullptr;
+  size_t cq_ring_size_ = 0;
+
+  struct io_uring_sqe *sqes_      = nullptr;
+  size_t               sqes_size_ = 0;
+
+  unsigned *sq_tail_  = nullptr;
+  unsigned *sq_mask_  = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned  sq_entries_ = 0;
+
+  unsigned            *cq_head_ = nullptr;
+  unsigned            *cq_tail_ = nullptr;
+  unsigned            *cq_mask_ = nullptr;
+  struct io_uring_cqe *cqes_    = nullptr;
+};
+
+bool IoUring::init()
+{
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params));
+  if (ring_fd_ < 0) {
+    LOG_WARN("failed to setup io_uring. error=%s", strerror(errno));
+    return false;
+  }
+
+  sq_entries_   = params.sq_entries;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ptr_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ptr_ == MAP_FAILED) {
+    sq_ptr_ = nullptr;
+    LOG_WARN("failed to mmap io_uring sq ring. error=%s", strerror(errno));
+    destroy();
+    return false;
+  }
+
+  if (single_mmap) {
+    cq_ptr_ = sq_ptr_;
+  } else {
+    cq_ptr_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ptr_ == MAP_FAILED) {
+      cq_ptr_ = nullptr;
+      LOG_WARN("failed to mmap io_uring cq ring. error=%s", strerror(errno));
+      destroy();
+      return false;
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    LOG_WARN("failed to mmap io_uring sqes. error=%s", strerror(errno));
+    destroy();
+    return false;
+  }
+  sqes_ = static_cast<struct io_uring_sqe *>(sqes);
+
+  char *sq_ptr = static_cast<char *>(sq_ptr_);
+  sq_tail_     = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.tail);
+  sq_mask_     = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.ring_mask);
+  sq_array_    = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.array);
+
+  char *cq_ptr = static_cast<char *>(cq_ptr_);
+  cq_head_     = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.head);
+  cq_tail_     = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.tail);
+  cq_mask_     = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.ring_mask);
+  cqes_        = reinterpret_cast<struct io_uring_cqe *>(cq_ptr + params.cq_off.cqes);
+  return true;
+}
+
+void IoUring::destroy()
+{
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+    munmap(cq_ptr_, cq_ring_size_);
+  }
+  cq_ptr_ = nullptr;
+  if (sq_ptr_ != nullptr) {
+    munmap(sq_ptr_, sq_ring_size_);
+    sq_ptr_ = nullptr;
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+bool IoUring::submit_and_wait(PageIORequest *requests, int count, vector<bool> &completed)
+{
+  ASSERT(static_cast<unsigned>(count) <= sq_entries_, "too many io requests. count=%d", count);
+
+  // 只有当前线程会修改提交队列的尾部，内核只会读取
+  unsigned tail = *sq_tail_;
+  for (int i = 0; i < count; i++) {
+    const PageIORequest &request = requests[i];
+    const unsigned       index   = tail & *sq_mask_;
+    struct io_uring_sqe *sqe     = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = request.type == PageIORequest::Type::READ ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd        = request.fd;
+    sqe->off       = static_cast<uint64_t>(request.offset);
+    sqe->addr      = reinterpret_cast<uint64_t>(request.iov);
+    sqe->len       = static_cast<uint32_t>(request.iovcnt);
+    sqe->user_data = static_cast<uint64_t>(i);
+    sq_array_[index] = index;
+    tail++;
+  }
+  __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+  int to_submit = count;
+  int done_num  = 0;
+  while (done_num < count) {
+    const int ret = static_cast<int>(
+        syscall(__NR_io_uring_enter, ring_fd_, to_submit, 1 /*min_complete*/, IORING_ENTER_GETEVENTS, nullptr, 0));
+    if (ret < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        continue;
+      }
+      // 出错的这次调用没有提交任何请求，但是之前提交的请求可能还在执行
+      LOG_WARN("failed to enter io_uring. error=%s", strerror(errno));
+      drain(requests, count - to_submit, done_num, completed);
+      return false;
+    }
+    to_submit -= ret;
+    done_num += reap(requests, completed);
+  }
+  return true;
+}
+
+int IoUring::reap(PageIORequest *requests, vector<bool> &completed)
+{
+  int      reaped = 0;
+  unsigned head   = *cq_head_;
+  while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+    const struct io_uring_cqe *cqe     = &cqes_[head & *cq_mask_];
+    PageIORequest             &request = requests[cqe->user_data];
+    if (cqe->res < 0) {
+      LOG_WARN("failed to %s file. fd=%d, offset=%ld, error=%s",
+               request.type == PageIORequest::Type::READ ? "read" : "write",
+               request.fd, request.offset, strerror(-cqe->res));
+      request.rc = request.type == PageIORequest::Type::READ ? RC::IOERR_READ : RC::IOERR_WRITE;
+    } else if (cqe->res < request.size()) {
+      request.rc = SyncPageIO::execute(request, cqe->res);
+    } else {
+      request.rc = RC::SUCCESS;
+    }
+    completed[cqe->user_data] = true;
+    reaped++;
+    head++;
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return reaped;
+}
+
+void IoUring::drain(PageIORequest *requests, int submitted, int done_num, vector<bool> &completed)
+{
+  // 没有被内核取走的请求留在提交队列中，io_uring销毁之后就不会再执行了，由调用者同步重做
+  while (done_num < submitted) {
+    const int ret =
+        static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, 0, 1 /*min_complete*/, IORING_ENTER_GETEVENTS, nullptr, 0));
+    if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      LOG_ERROR("failed to wait for submitted io requests. submitted=%d, done=%d, error=%s",
+                submitted, done_num, strerror(errno));
+      break;
+    }
+    done_num += reap(requests, completed);
+  }
+
+  if (done_num >= submitted) {
+    return;
+  }
+
+  // 提交队列是按顺序取走的，前 submitted 个请求中还没有完成的都还在内核中执行
+  for (int i = 0; i < submitted; i++) {
+    if (!completed[i]) {
+      PageIORequest &request = requests[i];
+      request.rc   = request.type == PageIORequest::Type::READ ? RC::IOERR_READ : RC::IOERR_WRITE;
+      completed[i] = true;
+    }
+  }
+}
+
+}  // namespace
+
+bool IoUringPageIO::supported()
+{
+  IoUring ring;
+  return ring.init();
+}
+
+RC IoUringPageIO::submit(PageIORequest *requests, int count)
+{
+  static thread_local IoUring ring;
+  if (!ring.inited() && !ring.init()) {
+    return SyncPageIO().submit(requests, count);
+  }
+
+  RC rc = RC::SUCCESS;
+  for (int start = 0; start < count; start += IoUring::QUEUE_DEPTH) {
+    const int    batch = std::min(count - start, static_cast<int>(IoUring::QUEUE_DEPTH));
+    vector<bool> completed(batch, false);
+    if (!ring.submit_and_wait(requests + start, batch, completed)) {
+      // io_uring 出错了，已经提交的请求都等到了完成，没有提交的请求改为同步执行，下次再重新创建io_uring
+      ring.destroy();
+      for (int i = 0; i < batch; i++) {
+        if (!completed[i]) {
+          requests[start + i].rc = SyncPageIO::execute(requests[start + i]);
+        }
+      }
+    }
+
+    for (int i = start; i < start + batch && OB_SUCC(rc); i++) {
+      rc = requests[i].rc;
+    }
+  }
+  return rc;
+}
+
+#else  // HAVE_IO_URING
+
+bool IoUringPageIO::supported() { return false; }
+
+RC IoUringPageIO::submit(PageIORequest *requests, int count) { return SyncPageIO().submit(requests, count); }
+
+#endif  // HAVE_IO_URING
@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include "common/rc.h"
+
+/**
+ * @brief 一个页面IO请求
+ * @ingroup BufferPool
+ * @details 从文件的offset位置开始，连续读写iov描述的所有内存。
+ */
+struct PageIORequest
+{
+  enum class Type
+  {
+    READ,
+    WRITE
+  };
+
+  Type                type   = Type::READ;
+  int                 fd     = -1;
+  int64_t             offset = 0;
+  const struct iovec *iov    = nullptr;
+  int                 iovcnt = 0;
+
+  RC rc = RC::SUCCESS;  ///< 请求的执行结果
+
+  int64_t size() const;
+};
+
+/**
+ * @brief 页面IO的实现
+ * @ingroup BufferPool
+ * @details 所有的读写都带有文件偏移(pread/pwrite)，不依赖文件描述符上的读写位置，
+ * 所以同一个文件上可以同时有多个IO请求。
+ * 当前支持两种实现：
+ * - sync: 使用 preadv/pwritev 逐个同步执行；
+ * - io_uring: 一批请求一次提交给内核，内核可以并行地执行这些请求。
+ * 可以在配置文件中切换，方便对比。
+ */
+class PageIO
+{
+public:
+  virtual ~PageIO() = default;
+
+  /**
+   * @brief 根据名字创建页面IO的实现
+   *
+   * @param name sync 或 io_uring，为空时使用sync。当前系统不支持io_uring时也会使用sync
+   * @return PageIO* 名字不合法时返回nullptr
+   */
+  static PageIO *create(const char *name);
+
+  virtual const char *name() const = 0;
+
+  /**
+   * @brief 执行一批IO请求，所有请求都完成后才返回
+   * @details 每个请求的结果记录在请求的rc中，请求之间的执行顺序是不确定的
+   * @return RC 第一个失败的请求的错误码，都成功时返回SUCCESS
+   */
+  virtual RC submit(PageIORequest *requests, int count) = 0;
+
+  RC read(int fd, int64_t offset, void *buf, int size);
+  RC write(int fd, int64_t offset, const void *buf, int size);
+};
+
+/**
+ * @brief 使用 preadv/pwritev 同步执行IO请求
+ * @ingroup BufferPool
+ */
+class SyncPageIO : public PageIO
+{
+public:
+  const char *name() const override { return "sync"; }
+
+  RC submit(PageIORequest *requests, int count) override;
+
+  /**
+   * @brief 同步执行一个请求
+   * @param done 请求已经完成了多少字节，会跳过这部分数据
+   */
+  static RC execute(const PageIORequest &request, int64_t done = 0);
+};
+
+/**
+ * @brief 使用io_uring批量提交IO请求
+ * @ingroup BufferPool
+ * @details 没有使用liburing，直接使用系统调用。每个线程有一个自己的io_uring实例，
+ * 线程之间不需要加锁，不同线程上的IO请求也可以同时执行。
+ * 内核返回部分完成的请求，会同步执行剩下的部分。
+ */
+class IoUringPageIO : public PageIO
+{
+public:
+  /**
+   * @brief 当前系统是否支持io_uring
+   */
+  static bool supported();
+
+  const char *name() const override { return "io_uring"; }
+
+  RC submit(PageIORequest *requests, int count) override;
+};
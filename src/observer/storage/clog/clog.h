@@ -48,14 +48,21 @@ class Db;
  * @details 除了事务操作相关的类型，比如MTR_BEGIN/MTR_COMMIT等，都是需要事务自己去处理的。
  * 也就是说，像INSERT、DELETE等是事务自己处理的，其实这种类型的日志不需要在这里定义，而是在各个
  * 事务模型中定义，由各个事务模型自行处理。
+ * VACUUM_DELETE/VACUUM_MOVE/VACUUM_RELEASE 是整理表时对记录和页面做的物理修改，不改变记录的可见性，
+ * 参考 Table::vacuum。
+ * OVERFLOW_PAGE 是插入长记录时写入的溢出页面的内容，写在对应的 INSERT 之前，恢复时按照原来的页号重写。
  */
-#define DEFINE_CLOG_TYPE_ENUM    \
-  DEFINE_CLOG_TYPE(ERROR)        \
-  DEFINE_CLOG_TYPE(MTR_BEGIN)    \
-  DEFINE_CLOG_TYPE(MTR_COMMIT)   \
-  DEFINE_CLOG_TYPE(MTR_ROLLBACK) \
-  DEFINE_CLOG_TYPE(INSERT)       \
-  DEFINE_CLOG_TYPE(DELETE)
+#define DEFINE_CLOG_TYPE_ENUM      \
+  DEFINE_CLOG_TYPE(ERROR)          \
+  DEFINE_CLOG_TYPE(MTR_BEGIN)      \
+  DEFINE_CLOG_TYPE(MTR_COMMIT)     \
+  DEFINE_CLOG_TYPE(MTR_ROLLBACK)   \
+  DEFINE_CLOG_TYPE(INSERT)         \
+  DEFINE_CLOG_TYPE(DELETE)         \
+  DEFINE_CLOG_TYPE(VACUUM_DELETE)  \
+  DEFINE_CLOG_TYPE(VACUUM_MOVE)    \
+  DEFINE_CLOG_TYPE(VACUUM_RELEASE) \
+  DEFINE_CLOG_TYPE(OVERFLOW_PAGE)
 
 enum class CLogType
 {
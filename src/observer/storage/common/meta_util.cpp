@@ -11,6 +11,8 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021/5/18.
 //
 
+#include <string.h>
+
 #include "storage/common/meta_util.h"
 #include "common/defs.h"
 
@@ -27,3 +29,36 @@ std::string table_index_file(const char *base_dir, const char *table_name, const
 {
   return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + "-" + index_name + TABLE_INDEX_SUFFIX;
 }
+
+std::string table_fsm_file(const char *base_dir, const char *table_name)
+{
+  return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + TABLE_FSM_SUFFIX;
+}
+
+static bool ends_with(const std::string &str, const char *suffix)
+{
+  const size_t suffix_len = strlen(suffix);
+  return str.size() > suffix_len && 0 == str.compare(str.size() - suffix_len, suffix_len, suffix);
+}
+
+std::string table_name_of_file(const std::string &file_name)
+{
+  const size_t      slash     = file_name.rfind(common::FILE_PATH_SPLIT_STR);
+  const std::string base_name = (slash == std::string::npos) ? file_name : file_name.substr(slash + 1);
+
+  if (ends_with(base_name, TABLE_DATA_SUFFIX)) {
+    return base_name.substr(0, base_name.size() - strlen(TABLE_DATA_SUFFIX));
+  }
+  if (ends_with(base_name, TABLE_FSM_SUFFIX)) {
+    return base_name.substr(0, base_name.size() - strlen(TABLE_FSM_SUFFIX));
+  }
+
+  // 表名中不会有'-'，索引文件中第一个'-'之前的部分就是表名
+  if (ends_with(base_name, TABLE_INDEX_SUFFIX)) {
+    const size_t dash = base_name.find('-');
+    if (dash != std::string::npos && dash > 0) {
+      return base_name.substr(0, dash);
+    }
+  }
+  return std::string();
+}
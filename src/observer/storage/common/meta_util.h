@@ -19,7 +19,19 @@ static constexpr const char *TABLE_META_SUFFIX       = ".table";
 static constexpr const char *TABLE_META_FILE_PATTERN = ".*\\.table$";
 static constexpr const char *TABLE_DATA_SUFFIX       = ".data";
 static constexpr const char *TABLE_INDEX_SUFFIX      = ".index";
+static constexpr const char *TABLE_FSM_SUFFIX        = ".fsm";
 
 std::string table_meta_file(const char *base_dir, const char *table_name);
 std::string table_data_file(const char *base_dir, const char *table_name);
 std::string table_index_file(const char *base_dir, const char *table_name, const char *index_name);
+
+/**
+ * @brief 表的空闲空间表文件，参考 FreeSpaceMap
+ */
+std::string table_fsm_file(const char *base_dir, const char *table_name);
+
+/**
+ * @brief 根据数据文件、空闲空间表文件或索引文件的文件名得到表名，是 table_data_file 等函数的逆过程
+ * @return std::string 不是表的数据文件、空闲空间表文件或索引文件时返回空字符串
+ */
+std::string table_name_of_file(const std::string &file_name);
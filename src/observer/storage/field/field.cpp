@@ -32,4 +32,15 @@ int Field::get_int(const Record &record)
   return value.get_int();
 }
 
-const char *Field::get_data(const Record &record) { return record.data() + field_->offset(); }
\ No newline at end of file
+const char *Field::get_data(const Record &record) { return record.data() + field_->offset(); }
+
+RC Field::get_value(const Record &record, Value &value) const
+{
+  if (field_->type() == AttrType::VARCHARS) {
+    return table_->read_varchar(record.data(), *field_, value);
+  }
+
+  value.set_type(field_->type());
+  value.set_data(const_cast<char *>(record.data() + field_->offset()), field_->len());
+  return RC::SUCCESS;
+}
\ No newline at end of file
@@ -48,6 +48,12 @@ public:
 
   const char *get_data(const Record &record);
 
+  /**
+   * @brief 读取记录中当前字段的值
+   * @details 变长字段(VARCHARS)的数据不在字段所在的位置，需要通过表来读取，参考 Table::read_varchar
+   */
+  RC get_value(const Record &record, Value &value) const;
+
 private:
   const Table     *table_ = nullptr;
   const FieldMeta *field_ = nullptr;
@@ -46,6 +46,11 @@ RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int at
     return RC::INVALID_ARGUMENT;
   }
 
+  if (AttrType::VARCHARS == attr_type && attr_len > VARCHAR_MAX_LENGTH) {
+    LOG_WARN("Varchar is too long. name=%s, attr_len=%d, max=%d", name, attr_len, VARCHAR_MAX_LENGTH);
+    return RC::INVALID_ARGUMENT;
+  }
+
   name_        = name;
   attr_type_   = attr_type;
   attr_len_    = attr_len;
@@ -64,6 +69,11 @@ int FieldMeta::offset() const { return attr_offset_; }
 
 int FieldMeta::len() const { return attr_len_; }
 
+int FieldMeta::storage_len() const
+{
+  return attr_type_ == AttrType::VARCHARS ? static_cast<int>(sizeof(VarcharRef)) : attr_len_;
+}
+
 bool FieldMeta::visible() const { return visible_; }
 
 void FieldMeta::desc(std::ostream &os) const
@@ -23,6 +23,23 @@ namespace Json {
 class Value;
 }  // namespace Json
 
+/**
+ * @brief varchar 字段在记录定长部分存放的内容
+ * @details 记录由定长部分和变长部分组成，所有字段按照 offset 放在定长部分，varchar 字段的数据放在记录的最后。
+ * 数据直接放在记录中时，location 是数据在记录中的偏移；记录太大时，比较长的数据会放到溢出页面中
+ * (参考 Table::insert_record)，location 是第一个溢出页面的页号，length 带有 OVERFLOW_FLAG 标记。
+ */
+struct VarcharRef
+{
+  static constexpr int32_t OVERFLOW_FLAG = 1 << 30;
+
+  int32_t location;
+  int32_t length;
+
+  bool overflow() const { return (length & OVERFLOW_FLAG) != 0; }
+  int  data_len() const { return length & ~OVERFLOW_FLAG; }
+};
+
 /**
  * @brief 字段元数据
  *
@@ -41,6 +58,12 @@ public:
   AttrType    type() const;
   int         offset() const;
   int         len() const;
+
+  /**
+   * @brief 字段在记录定长部分中占用的空间
+   * @details varchar 字段的 len 是定义的最大长度，在定长部分只存放一个 VarcharRef，其它类型与 len 相同
+   */
+  int storage_len() const;
   bool        visible() const;
 
 public:
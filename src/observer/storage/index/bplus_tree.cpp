@@ -12,6 +12,8 @@ See the Mulan PSL v2 for more details. */
 // Created by Xie Meiyi
 // Rewritten by Longda & Wangyunlai
 //
+#include <algorithm>
+
 #include "storage/index/bplus_tree.h"
 #include "common/lang/lower_bound.h"
 #include "common/log/log.h"
@@ -368,6 +370,13 @@ void InternalIndexNodeHandler::create_new_root(PageNum first_page_num, const cha
   increase_size(2);
 }
 
+void InternalIndexNodeHandler::append_child(const char *key, PageNum page_num)
+{
+  memcpy(__key_at(size()), key, key_size());
+  memcpy(__value_at(size()), &page_num, value_size());
+  increase_size(1);
+}
+
 /**
  * insert one entry
  * the entry to be inserted will never at the first slot.
@@ -1801,6 +1810,13 @@ RC BplusTreeScanner::next_entry(RID &rid)
   }
 
   latch_memo_.release_to(memo_point);
+
+  // 叶子节点在文件中不一定是连续的，没办法按照页号预读，这里提前加载下一个叶子节点
+  LeafIndexNodeHandler next_node(tree_handler_.file_header_, current_frame_);
+  if (BP_INVALID_PAGE_NUM != next_node.next_page()) {
+    tree_handler_.disk_buffer_pool_->read_ahead(next_node.next_page(), 1);
+  }
+
   iter_index_ = -1;  // `next` will add 1
   return next_entry(rid);
 }
@@ -1862,3 +1878,331 @@ RC BplusTreeScanner::fix_user_key(
   *fixed_key = key_buf;
   return RC::SUCCESS;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+static BplusTreeBuildParam bplus_tree_build_param;
+
+void BplusTreeBulkLoader::set_build_param(const BplusTreeBuildParam &param)
+{
+  bplus_tree_build_param              = param;
+  bplus_tree_build_param.fill_percent = std::clamp(param.fill_percent, 50, 100);
+  LOG_INFO("bplus tree build param: fill percent=%d, sort memory=%ld",
+           bplus_tree_build_param.fill_percent, bplus_tree_build_param.sort_memory);
+}
+
+const BplusTreeBuildParam &BplusTreeBulkLoader::build_param() { return bplus_tree_build_param; }
+
+BplusTreeBulkLoader::BplusTreeBulkLoader(BplusTreeHandler &tree_handler, const BplusTreeBuildParam &param)
+    : tree_handler_(tree_handler), param_(param), key_length_(tree_handler.file_header_.key_length)
+{
+  param_.fill_percent = std::clamp(param_.fill_percent, 50, 100);
+}
+
+BplusTreeBulkLoader::~BplusTreeBulkLoader()
+{
+  close_levels();
+  for (SortedRun &run : runs_) {
+    if (run.file != nullptr) {
+      fclose(run.file);
+    }
+  }
+}
+
+RC BplusTreeBulkLoader::add(const char *user_key, const RID &rid)
+{
+  const int attr_length = tree_handler_.file_header_.attr_length;
+
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + key_length_);
+  memcpy(buffer_.data() + offset, user_key, attr_length);
+  memcpy(buffer_.data() + offset + attr_length, &rid, sizeof(rid));
+  key_count_++;
+
+  if (static_cast<int64_t>(buffer_.size()) >= param_.sort_memory) {
+    return spill_run();
+  }
+  return RC::SUCCESS;
+}
+
+void BplusTreeBulkLoader::sort_buffer(vector<const char *> &sorted_keys)
+{
+  const size_t key_num = buffer_.size() / key_length_;
+  sorted_keys.resize(key_num);
+  for (size_t i = 0; i < key_num; i++) {
+    sorted_keys[i] = buffer_.data() + i * key_length_;
+  }
+
+  const KeyComparator &comparator = tree_handler_.key_comparator_;
+  std::sort(sorted_keys.begin(), sorted_keys.end(), [&comparator](const char *left, const char *right) {
+    return comparator(left, right) < 0;
+  });
+}
+
+RC BplusTreeBulkLoader::spill_run()
+{
+  if (buffer_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  SortedRun run;
+  run.file = tmpfile();
+  if (run.file == nullptr) {
+    LOG_WARN("failed to create temporary file for sorting index keys. error=%s", strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  runs_.push_back(run);
+
+  vector<const char *> sorted_keys;
+  sort_buffer(sorted_keys);
+  for (const char *key : sorted_keys) {
+    if (fwrite(key, key_length_, 1, run.file) != 1) {
+      LOG_WARN("failed to write index keys to temporary file. error=%s", strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+  }
+  if (fflush(run.file) != 0 || fseek(run.file, 0, SEEK_SET) != 0) {
+    LOG_WARN("failed to rewind temporary file of index keys. error=%s", strerror(errno));
+    return RC::IOERR_SEEK;
+  }
+
+  LOG_INFO("spill sorted index keys to temporary file. run=%d, keys=%d", static_cast<int>(runs_.size()) - 1,
+           static_cast<int>(sorted_keys.size()));
+  buffer_.clear();
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::fill_run(SortedRun &run)
+{
+  // 每个临时文件一次读一批键值，归并时的读也是顺序的
+  static constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+  const size_t key_num = std::max<size_t>(READ_BUFFER_SIZE / key_length_, 1);
+  run.buffer.resize(key_num * key_length_);
+  const size_t read_num = fread(run.buffer.data(), key_length_, key_num, run.file);
+  run.buffer.resize(read_num * key_length_);
+  run.offset = 0;
+  if (read_num > 0) {
+    return RC::SUCCESS;
+  }
+
+  // fread 出错时也返回0，不能当成读完了，否则这个临时文件中剩下的键值就丢了
+  if (ferror(run.file)) {
+    LOG_WARN("failed to read index keys from temporary file. error=%s", strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::RECORD_EOF;
+}
+
+RC BplusTreeBulkLoader::next_from_runs(const char *&key)
+{
+  const KeyComparator &comparator = tree_handler_.key_comparator_;
+  auto                 greater    = [this, &comparator](int left, int right) {
+    return comparator(runs_[left].buffer.data() + runs_[left].offset,
+                      runs_[right].buffer.data() + runs_[right].offset) > 0;
+  };
+
+  // key 不为空时表示上一次返回的是堆顶的键值，先让它所在的临时文件前进
+  if (key != nullptr && !run_heap_.empty()) {
+    std::pop_heap(run_heap_.begin(), run_heap_.end(), greater);
+    SortedRun &run = runs_[run_heap_.back()];
+    run.offset += key_length_;
+
+    RC rc = RC::SUCCESS;
+    if (run.offset >= run.buffer.size()) {
+      rc = fill_run(run);
+    }
+    if (rc == RC::RECORD_EOF) {
+      run_heap_.pop_back();
+    } else if (OB_FAIL(rc)) {
+      return rc;
+    } else {
+      std::push_heap(run_heap_.begin(), run_heap_.end(), greater);
+    }
+  }
+
+  if (run_heap_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  const SortedRun &run = runs_[run_heap_.front()];
+  key                  = run.buffer.data() + run.offset;
+  return RC::SUCCESS;
+}
+
+void BplusTreeBulkLoader::plan_levels()
+{
+  const IndexFileHeader &header = tree_handler_.file_header_;
+
+  // 节点按照填充比例放满，最后一个节点太小时与前一个节点合并或者平分
+  auto plan = [this](int64_t count, int max_size, vector<int> &sizes) {
+    const int     min_size = max_size - max_size / 2;
+    const int     target   = std::clamp(static_cast<int>(static_cast<int64_t>(max_size) * param_.fill_percent / 100),
+                                        std::max(min_size, 1), max_size);
+    const int64_t node_num = (count + target - 1) / target;
+    sizes.assign(node_num, target);
+    sizes.back() = static_cast<int>(count - (node_num - 1) * target);
+    if (node_num > 1 && sizes.back() < min_size) {
+      const int both = target + sizes.back();
+      sizes.pop_back();
+      if (both <= max_size) {
+        sizes.back() = both;
+      } else {
+        sizes.back() = both - both / 2;
+        sizes.push_back(both / 2);
+      }
+    }
+  };
+
+  levels_.clear();
+  int64_t count = key_count_;
+  do {
+    Level &level = levels_.emplace_back();
+    plan(count, levels_.size() == 1 ? header.leaf_max_size : header.internal_max_size, level.node_sizes);
+    count = level.node_sizes.size();
+  } while (count > 1);
+}
+
+RC BplusTreeBulkLoader::append(int level_index, const char *key, const char *value)
+{
+  const IndexFileHeader &header = tree_handler_.file_header_;
+  DiskBufferPool        *bp     = tree_handler_.disk_buffer_pool_;
+  Level                 &level  = levels_[level_index];
+  const bool             leaf   = level_index == 0;
+
+  if (level.frame == nullptr || level.filled == level.node_sizes[level.node_index]) {
+    Frame *frame = nullptr;
+    RC     rc    = bp->allocate_page(&frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate page while building bplus tree. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (leaf) {
+      LeafIndexNodeHandler node(header, frame);
+      node.init_empty();
+    } else {
+      InternalIndexNodeHandler node(header, frame);
+      node.init_empty();
+    }
+    frame->mark_dirty();
+
+    if (level.frame != nullptr) {
+      if (leaf) {
+        LeafIndexNodeHandler prev_node(header, level.frame);
+        prev_node.set_next_page(frame->page_num());
+      }
+      bp->unpin_page(level.frame);
+    }
+    level.frame  = frame;
+    level.filled = 0;
+    level.node_index++;
+
+    // 新节点中最小的键值就是这个键值，先把新节点挂到父节点上
+    const PageNum page_num = frame->page_num();
+    if (level_index + 1 < static_cast<int>(levels_.size())) {
+      rc = append(level_index + 1, key, reinterpret_cast<const char *>(&page_num));
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      IndexNodeHandler node(header, frame);
+      node.set_parent_page_num(levels_[level_index + 1].frame->page_num());
+    } else {
+      root_page_ = page_num;
+    }
+  }
+
+  if (leaf) {
+    LeafIndexNodeHandler node(header, level.frame);
+    node.insert(level.filled, key, value);
+  } else {
+    InternalIndexNodeHandler node(header, level.frame);
+    node.append_child(key, *reinterpret_cast<const PageNum *>(value));
+  }
+  level.filled++;
+  return RC::SUCCESS;
+}
+
+void BplusTreeBulkLoader::close_levels()
+{
+  for (Level &level : levels_) {
+    if (level.frame != nullptr) {
+      tree_handler_.disk_buffer_pool_->unpin_page(level.frame);
+      level.frame = nullptr;
+    }
+  }
+}
+
+RC BplusTreeBulkLoader::finish()
+{
+  if (!tree_handler_.is_empty()) {
+    LOG_WARN("cannot bulk load a bplus tree which is not empty. root page=%d", tree_handler_.file_header_.root_page);
+    return RC::INTERNAL;
+  }
+
+  if (key_count_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  plan_levels();
+
+  // 所有的键值都在内存中时直接排序，否则把最后一段也写到临时文件中再归并
+  RC                   rc = RC::SUCCESS;
+  vector<const char *> sorted_keys;
+  int64_t              appended = 0;
+  if (runs_.empty()) {
+    sort_buffer(sorted_keys);
+    for (const char *key : sorted_keys) {
+      rc = append(0, key, key + tree_handler_.file_header_.attr_length);
+      if (OB_FAIL(rc)) {
+        break;
+      }
+      appended++;
+    }
+  } else {
+    rc = spill_run();
+    for (int i = 0; OB_SUCC(rc) && i < static_cast<int>(runs_.size()); i++) {
+      rc = fill_run(runs_[i]);
+      if (OB_SUCC(rc)) {
+        run_heap_.push_back(i);
+      } else if (rc == RC::RECORD_EOF) {
+        rc = RC::SUCCESS;
+      }
+    }
+    const KeyComparator &comparator = tree_handler_.key_comparator_;
+    std::make_heap(run_heap_.begin(), run_heap_.end(), [this, &comparator](int left, int right) {
+      return comparator(runs_[left].buffer.data() + runs_[left].offset,
+                        runs_[right].buffer.data() + runs_[right].offset) > 0;
+    });
+
+    const char *key = nullptr;
+    while (OB_SUCC(rc) && OB_SUCC(rc = next_from_runs(key))) {
+      rc = append(0, key, key + tree_handler_.file_header_.attr_length);
+      if (OB_SUCC(rc)) {
+        appended++;
+      }
+    }
+    if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+    }
+  }
+  close_levels();
+  buffer_.clear();
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to build bplus tree. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (appended != key_count_) {
+    LOG_ERROR("keys are lost while building bplus tree. count=%ld, appended=%ld", key_count_, appended);
+    return RC::INTERNAL;
+  }
+
+  tree_handler_.root_lock_.lock();
+  tree_handler_.update_root_page_num_locked(root_page_);
+  tree_handler_.root_lock_.unlock();
+
+  LOG_INFO("bulk load bplus tree done. keys=%ld, levels=%d, leaves=%d, runs=%d, root page=%d",
+           key_count_, static_cast<int>(levels_.size()), static_cast<int>(levels_[0].node_sizes.size()),
+           static_cast<int>(runs_.size()), root_page_);
+  return RC::SUCCESS;
+}
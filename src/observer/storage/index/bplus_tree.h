@@ -388,6 +388,12 @@ public:
   void init_empty();
   void create_new_root(PageNum first_page_num, const char *key, PageNum page_num);
 
+  /**
+   * @brief 在最后追加一个子节点
+   * @details 批量构建时使用，子节点的键值都比已有的大。不会修改子节点中记录的父节点，参考 BplusTreeBulkLoader
+   */
+  void append_child(const char *key, PageNum page_num);
+
   void    insert(const char *key, PageNum page_num, const KeyComparator &comparator);
   RC      move_half_to(LeafIndexNodeHandler &other, DiskBufferPool *bp);
   char   *key_at(int index);
@@ -564,9 +570,129 @@ protected:
 
 private:
   friend class BplusTreeScanner;
+  friend class BplusTreeBulkLoader;
   friend class BplusTreeTester;
 };
 
+/**
+ * @brief 批量构建B+树的参数
+ * @ingroup BPlusTree
+ */
+struct BplusTreeBuildParam
+{
+  int     fill_percent = 90;                 ///< 每个节点填充的百分比，给之后的插入预留空间。范围是 [50, 100]
+  int64_t sort_memory  = 64 * 1024 * 1024;  ///< 排序使用的内存(字节)，超过之后把排好序的键值写到临时文件中
+};
+
+/**
+ * @brief 自底向上批量构建B+树
+ * @ingroup BPlusTree
+ * @details 在已有数据的表上创建索引时使用，树必须是空的。
+ * 先收集所有的键值(属性值和RID)并排序，内存放不下时把排好序的一段写到临时文件中，最后再多路归并。
+ * 然后按照顺序依次写满每个叶子节点，同时在每一层维护最右边的一个节点，子节点写满一个就追加到父节点中。
+ * 与逐条插入相比，没有从根节点查找叶子节点和节点分裂的开销，页面也是按照顺序分配和写入的。
+ *
+ * 每个节点按照 BplusTreeBuildParam::fill_percent 填充。键值的总数是知道的，
+ * 所以每一层的节点个数和每个节点的大小都可以提前算好，保证除了根节点之外的节点都不少于 min_size。
+ * 构建过程中不能有其它线程访问这棵树。
+ */
+class BplusTreeBulkLoader
+{
+public:
+  BplusTreeBulkLoader(BplusTreeHandler &tree_handler, const BplusTreeBuildParam &param = build_param());
+  ~BplusTreeBulkLoader();
+
+  /**
+   * @brief 添加一个键值，不要求有序
+   * @param user_key 属性值，长度与 attr_length 一致
+   */
+  RC add(const char *user_key, const RID &rid);
+
+  /**
+   * @brief 排序所有的键值并构建B+树
+   */
+  RC finish();
+
+  static void                       set_build_param(const BplusTreeBuildParam &param);
+  static const BplusTreeBuildParam &build_param();
+
+private:
+  /**
+   * @brief 对内存中的键值排序，返回按顺序排列的键值
+   */
+  void sort_buffer(std::vector<const char *> &sorted_keys);
+
+  /**
+   * @brief 把内存中的键值排好序写到一个临时文件中
+   */
+  RC spill_run();
+
+  /**
+   * @brief 提前算好每一层每个节点的大小
+   */
+  void plan_levels();
+
+  /**
+   * @brief 往某一层最右边的节点追加一项，节点满了就新建一个节点，并把新节点追加到上一层中
+   * @param level 0 表示叶子节点
+   * @param key   叶子节点中是键值，内部节点中是子节点中最小的键值
+   * @param value 叶子节点中是RID，内部节点中是子节点的页号
+   */
+  RC append(int level, const char *key, const char *value);
+
+  /**
+   * @brief 释放每一层最右边的节点
+   */
+  void close_levels();
+
+private:
+  /**
+   * @brief 一个排好序的临时文件
+   */
+  struct SortedRun
+  {
+    FILE             *file = nullptr;
+    std::vector<char> buffer;      ///< 从文件中读出来的一批键值
+    size_t            offset = 0;  ///< 当前键值在 buffer 中的位置
+  };
+
+  /**
+   * @brief 正在构建的一层
+   */
+  struct Level
+  {
+    std::vector<int> node_sizes;       ///< 这一层每个节点有多少项
+    int              node_index = -1;  ///< 当前节点是第几个
+    int              filled     = 0;   ///< 当前节点已经有多少项
+    Frame           *frame      = nullptr;
+  };
+
+  /**
+   * @brief 多路归并取下一个键值
+   * @param key 上一次返回的键值，第一次调用时为空。读完所有的临时文件时返回 RECORD_EOF
+   */
+  RC next_from_runs(const char *&key);
+
+  /**
+   * @brief 从临时文件中读下一批键值
+   * @return 文件读完时返回 RECORD_EOF，读文件出错时返回 IOERR_READ
+   */
+  RC fill_run(SortedRun &run);
+
+private:
+  BplusTreeHandler   &tree_handler_;
+  BplusTreeBuildParam param_;
+  const int           key_length_;
+
+  std::vector<char>      buffer_;  ///< 还在内存中没有排序的键值
+  std::vector<SortedRun> runs_;
+  std::vector<int>       run_heap_;  ///< 多路归并时按照当前键值排列的临时文件
+  int64_t                key_count_ = 0;
+
+  std::vector<Level> levels_;
+  PageNum            root_page_ = BP_INVALID_PAGE_NUM;
+};
+
 /**
  * @brief B+树的扫描器
  * @ingroup BPlusTree
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/index/bplus_tree_index.h"
 #include "common/log/log.h"
+#include "storage/record/record_manager.h"
 
 BplusTreeIndex::~BplusTreeIndex() noexcept { close(); }
 
@@ -79,6 +80,29 @@ RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
   return index_handler_.insert_entry(record + field_meta_.offset(), rid);
 }
 
+RC BplusTreeIndex::bulk_load(RecordFileScanner &scanner)
+{
+  BplusTreeBulkLoader loader(index_handler_);
+
+  RC     rc = RC::SUCCESS;
+  Record record;
+  while (scanner.has_next()) {
+    rc = scanner.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan records while loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+
+    rc = loader.add(record.data() + field_meta_.offset(), record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to add key into index loader. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+  }
+
+  return loader.finish();
+}
+
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
 {
   return index_handler_.delete_entry(record + field_meta_.offset(), rid);
@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/index/bplus_tree.h"
 #include "storage/index/index.h"
 
+class RecordFileScanner;
+
 /**
  * @brief B+树索引
  * @ingroup Index
@@ -34,6 +36,14 @@ public:
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
+  /**
+   * @brief 在空索引上批量构建B+树
+   * @details 扫描出所有记录的键值排序后，自底向上顺序写满叶子节点和各层内部节点。
+   * 用于在已有数据的表上创建索引，构建期间不能有其它线程访问这个索引。
+   * @param scanner 表的记录扫描器，读取其中的所有记录
+   */
+  RC bulk_load(RecordFileScanner &scanner);
+
   /**
    * 扫描指定范围的数据
    */
@@ -0,0 +1,241 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/record/free_space_map.h"
+
+using namespace common;
+
+static constexpr int BITS_PER_WORD = 64;
+
+FreeSpaceMap::~FreeSpaceMap() { close(); }
+
+RC FreeSpaceMap::open(DiskBufferPool *buffer_pool, bool &need_rebuild)
+{
+  close();
+
+  buffer_pool_ = buffer_pool;
+  need_rebuild = true;
+  std::fill(std::begin(cursors_), std::end(cursors_), BP_INVALID_PAGE_NUM);
+  if (buffer_pool_ == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  // 空闲空间表的页面不会释放，分配的页号是递增的，所以按照页号遍历就是空闲空间表的顺序
+  RC                 rc = RC::SUCCESS;
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*buffer_pool_);
+  bool valid = true;
+  while (bp_iterator.has_next()) {
+    PageNum page_num = bp_iterator.next();
+    Frame  *frame    = nullptr;
+    rc               = buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get free space map page. page_num=%d, rc=%s", page_num, strrc(rc));
+      close();
+      return rc;
+    }
+
+    auto *header = reinterpret_cast<FsmPageHeader *>(frame->data());
+    if (header->magic != FSM_PAGE_MAGIC || header->page_index != static_cast<int32_t>(frames_.size())) {
+      valid = false;
+    }
+    frames_.push_back(frame);
+  }
+
+  if (frames_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  if (!valid) {
+    // 空闲空间表只是一个提示，内容不对时清空重建就可以了
+    LOG_WARN("free space map is invalid, rebuild it. fd=%d", buffer_pool_->file_desc());
+    for (size_t i = 0; i < frames_.size(); i++) {
+      memset(frames_[i]->data(), 0, BP_PAGE_DATA_SIZE);
+      auto *header       = reinterpret_cast<FsmPageHeader *>(frames_[i]->data());
+      header->magic      = FSM_PAGE_MAGIC;
+      header->page_index = static_cast<int32_t>(i);
+      frames_[i]->mark_dirty();
+    }
+  }
+
+  const int64_t page_count = static_cast<int64_t>(frames_.size()) * FSM_PAGE_ENTRIES;
+  free_bits_.assign((page_count + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+  for (PageNum page_num = 0; page_num < page_count; page_num++) {
+    if (*entry(page_num) > 0) {
+      free_bits_[page_num / BITS_PER_WORD] |= 1ULL << (page_num % BITS_PER_WORD);
+      max_page_num_ = page_num;
+    }
+  }
+
+  need_rebuild = !valid;
+  LOG_INFO("open free space map done. fd=%d, fsm pages=%d", buffer_pool_->file_desc(), (int)frames_.size());
+  return RC::SUCCESS;
+}
+
+void FreeSpaceMap::close()
+{
+  if (buffer_pool_ != nullptr) {
+    for (Frame *frame : frames_) {
+      buffer_pool_->unpin_page(frame);
+    }
+    buffer_pool_ = nullptr;
+  }
+  frames_.clear();
+  own_frames_.clear();
+  free_bits_.clear();
+  max_page_num_ = BP_INVALID_PAGE_NUM;
+}
+
+RC FreeSpaceMap::update(PageNum page_num, int free_bytes)
+{
+  std::lock_guard<Mutex> guard(lock_);
+  return update_entry(page_num, free_bytes);
+}
+
+RC FreeSpaceMap::add_page(PageNum page_num, int free_bytes)
+{
+  std::lock_guard<Mutex> guard(lock_);
+  RC rc = update_entry(page_num, free_bytes);
+  if (OB_SUCC(rc)) {
+    cursors_[cursor_slot()] = page_num;
+  }
+  return rc;
+}
+
+RC FreeSpaceMap::update_entry(PageNum page_num, int free_bytes)
+{
+  if (page_num < 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = extend(page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const uint8_t units = static_cast<uint8_t>(std::clamp(free_bytes / FSM_UNIT_SIZE, 0, 255));
+  uint8_t      *value = entry(page_num);
+  if (*value != units) {
+    *value = units;
+    frames_[page_num / FSM_PAGE_ENTRIES]->mark_dirty();
+  }
+
+  uint64_t &word = free_bits_[page_num / BITS_PER_WORD];
+  if (units > 0) {
+    word |= 1ULL << (page_num % BITS_PER_WORD);
+  } else {
+    word &= ~(1ULL << (page_num % BITS_PER_WORD));
+  }
+  max_page_num_ = std::max(max_page_num_, page_num);
+  return RC::SUCCESS;
+}
+
+PageNum FreeSpaceMap::find(int need_bytes)
+{
+  const int need_units = std::max(1, (need_bytes + FSM_UNIT_SIZE - 1) / FSM_UNIT_SIZE);
+
+  std::lock_guard<Mutex> guard(lock_);
+  if (max_page_num_ < 0) {
+    return BP_INVALID_PAGE_NUM;
+  }
+
+  // 游标还没有用过时，不同的游标从不同的位置开始找，避免所有线程都挤在前面几个页面上
+  PageNum &cursor = cursors_[cursor_slot()];
+  PageNum  start  = cursor;
+  if (start < 0 || start > max_page_num_) {
+    start = static_cast<PageNum>(static_cast<int64_t>(max_page_num_ + 1) * cursor_slot() / CURSOR_NUM);
+  }
+
+  // 从游标所在的位置往后找，找到最后再从头找到游标的位置
+  const size_t word_num   = max_page_num_ / BITS_PER_WORD + 1;
+  const size_t start_word = start / BITS_PER_WORD;
+  const int    start_bit  = start % BITS_PER_WORD;
+  for (size_t i = 0; i <= word_num; i++) {
+    const size_t word_index = (start_word + i) % word_num;
+    uint64_t     bits       = free_bits_[word_index];
+    if (i == 0) {
+      bits &= ~0ULL << start_bit;
+    } else if (i == word_num) {
+      bits &= (1ULL << start_bit) - 1;
+    }
+
+    while (bits != 0) {
+      const PageNum page_num = static_cast<PageNum>(word_index * BITS_PER_WORD + __builtin_ctzll(bits));
+      bits &= bits - 1;
+      if (*entry(page_num) >= need_units) {
+        cursor = page_num;
+        return page_num;
+      }
+    }
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
+int FreeSpaceMap::free_space(PageNum page_num)
+{
+  std::lock_guard<Mutex> guard(lock_);
+  if (page_num < 0 || page_num >= static_cast<int64_t>(frames_.size()) * FSM_PAGE_ENTRIES) {
+    return 0;
+  }
+  return *entry(page_num) * FSM_UNIT_SIZE;
+}
+
+RC FreeSpaceMap::extend(PageNum page_num)
+{
+  while (static_cast<int64_t>(frames_.size()) * FSM_PAGE_ENTRIES <= page_num) {
+    Frame *frame = nullptr;
+    if (buffer_pool_ != nullptr) {
+      RC rc = buffer_pool_->allocate_page(&frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate free space map page. rc=%s", strrc(rc));
+        return rc;
+      }
+      memset(frame->data(), 0, BP_PAGE_DATA_SIZE);
+    } else {
+      own_frames_.emplace_back(new Frame());
+      frame = own_frames_.back().get();
+    }
+
+    auto *header       = reinterpret_cast<FsmPageHeader *>(frame->data());
+    header->magic      = FSM_PAGE_MAGIC;
+    header->page_index = static_cast<int32_t>(frames_.size());
+    frame->mark_dirty();
+    frames_.push_back(frame);
+
+    const int64_t page_count = static_cast<int64_t>(frames_.size()) * FSM_PAGE_ENTRIES;
+    free_bits_.resize((page_count + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+  }
+  return RC::SUCCESS;
+}
+
+uint8_t *FreeSpaceMap::entry(PageNum page_num)
+{
+  char *data = frames_[page_num / FSM_PAGE_ENTRIES]->data() + sizeof(FsmPageHeader);
+  return reinterpret_cast<uint8_t *>(data) + page_num % FSM_PAGE_ENTRIES;
+}
+
+int FreeSpaceMap::cursor_slot() const
+{
+  static thread_local const int slot =
+      static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % CURSOR_NUM);
+  return slot;
+}
@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "common/lang/mutex.h"
+#include "common/rc.h"
+#include "storage/buffer/frame.h"
+#include "storage/buffer/page.h"
+
+class DiskBufferPool;
+
+/**
+ * @brief 空闲空间表(Free Space Map)的页面头
+ * @ingroup RecordManager
+ */
+struct FsmPageHeader
+{
+  int32_t magic;       ///< 用来识别空闲空间表的页面
+  int32_t page_index;  ///< 当前是空闲空间表的第几个页面
+};
+
+/**
+ * @brief 记录数据文件中每个页面大概还有多少空闲空间
+ * @ingroup RecordManager
+ * @details 每个数据页面使用一个字节记录空闲空间的大小，单位是 FSM_UNIT_SIZE 字节，向下取整。
+ * 空闲空间表存放在单独的文件中(参考 table_fsm_file)，第k个页面记录数据页面
+ * [k * FSM_PAGE_ENTRIES, (k+1) * FSM_PAGE_ENTRIES) 的空闲空间，一个页面就可以覆盖几万个数据页面。
+ * 打开时把空闲空间表的所有页面加载进来并一直pin在内存中，同时在内存中维护一个位图，标记哪些数据页面还有空闲空间，
+ * 查找时一次跳过64个已经满了的页面。这样插入记录时不需要访问数据页面就能找到可用的页面，启动时也不需要扫描数据文件。
+ *
+ * 空闲空间表不记录日志，只是一个提示：插入记录时还会在数据页面上检查是否真的有空间，如果没有就修正空闲空间表。
+ * 异常退出之后空闲空间表可能与数据页面不一致，少记的空闲空间在删除记录时会重新记录下来。
+ *
+ * 多个线程同时插入时，如果都从第一个有空闲空间的页面开始找，就会争抢同一个页面的锁。
+ * 这里每个线程根据线程ID使用不同的游标，从上次插入的页面开始查找，不同线程会分散在不同的页面上。
+ */
+class FreeSpaceMap
+{
+public:
+  static constexpr int32_t FSM_PAGE_MAGIC   = 0x4653'4d50;
+  static constexpr int     FSM_PAGE_ENTRIES = BP_PAGE_DATA_SIZE - static_cast<int>(sizeof(FsmPageHeader));
+  static constexpr int     FSM_UNIT_SIZE    = BP_PAGE_SIZE / 256;
+  static constexpr int     CURSOR_NUM       = 16;  ///< 插入线程使用的游标个数
+
+public:
+  FreeSpaceMap() = default;
+  ~FreeSpaceMap();
+
+  /**
+   * @brief 打开空闲空间表
+   *
+   * @param buffer_pool  存放空闲空间表的文件。为空时只在内存中维护，每次打开都需要重建
+   * @param need_rebuild 返回文件中是否还没有空闲空间表(新文件或者老版本创建的表)，需要调用者扫描数据页面重建
+   */
+  RC open(DiskBufferPool *buffer_pool, bool &need_rebuild);
+
+  /**
+   * @brief 关闭空闲空间表，释放pin住的页面。修改过的页面由缓冲池负责写回
+   */
+  void close();
+
+  /**
+   * @brief 记录某个数据页面当前的空闲空间
+   *
+   * @param page_num   数据页面的页号
+   * @param free_bytes 页面上还可以存放记录的字节数
+   */
+  RC update(PageNum page_num, int free_bytes);
+
+  /**
+   * @brief 记录一个新分配的数据页面，当前线程之后会优先往这个页面插入记录
+   */
+  RC add_page(PageNum page_num, int free_bytes);
+
+  /**
+   * @brief 找一个至少有 need_bytes 空闲空间的数据页面
+   * @details 返回的页面只是一个提示，调用者需要在页面上再确认一下
+   * @return PageNum 没有合适的页面时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum find(int need_bytes);
+
+  /**
+   * @brief 空闲空间为 free_bytes 的页面还会不会被 find(need_bytes) 找到
+   * @details 空闲空间按照 FSM_UNIT_SIZE 向下取整，所以页面上剩下的一点空间可能不会再被用到
+   */
+  static bool fits(int free_bytes, int need_bytes)
+  {
+    return free_bytes / FSM_UNIT_SIZE >= std::max(1, (need_bytes + FSM_UNIT_SIZE - 1) / FSM_UNIT_SIZE);
+  }
+
+  /**
+   * @brief 空闲空间表中记录的某个页面的空闲空间，是 FSM_UNIT_SIZE 的整数倍
+   */
+  int free_space(PageNum page_num);
+
+private:
+  /**
+   * @brief 扩展空闲空间表，直到可以记录 page_num 的空闲空间
+   */
+  RC extend(PageNum page_num);
+
+  RC       update_entry(PageNum page_num, int free_bytes);
+  uint8_t *entry(PageNum page_num);
+  int      cursor_slot() const;
+
+private:
+  DiskBufferPool                     *buffer_pool_ = nullptr;
+  std::vector<Frame *>                frames_;      ///< 空闲空间表的所有页面，一直pin在内存中
+  std::vector<std::unique_ptr<Frame>> own_frames_;  ///< 只在内存中维护时，页面由自己管理
+  std::vector<uint64_t>               free_bits_;   ///< 每个数据页面一位，标记是否还有空闲空间
+  PageNum                             max_page_num_ = BP_INVALID_PAGE_NUM;  ///< 记录过的最大的数据页面
+  PageNum                             cursors_[CURSOR_NUM] = {};            ///< 每个游标记录上次插入的页面
+  common::Mutex                       lock_;
+};
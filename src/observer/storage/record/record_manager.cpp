@@ -11,6 +11,12 @@ See the Mulan PSL v2 for more details. */
 //
 // Created by Meiyi & Longda on 2021/4/13.
 //
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
 #include "storage/record/record_manager.h"
 #include "common/lang/bitmap.h"
 #include "common/log/log.h"
@@ -50,16 +56,228 @@ int page_record_capacity(int page_size, int record_size)
  */
 int page_bitmap_size(int record_capacity) { return (record_capacity + 7) / 8; }
 
+/**
+ * @brief PAX 页面上位图前面的元数据的大小，包括页头和列信息
+ */
+static int pax_meta_size(int column_num, bool compressed)
+{
+  int size = PAGE_HEADER_SIZE + sizeof(PaxPageHeader) + 2 * column_num * sizeof(int32_t);
+  if (compressed) {
+    size += column_num * sizeof(PaxColumnEncoding);
+  }
+  return size;
+}
+
+/**
+ * @brief 记录分配状态位图在页面中的位置，PAX 页面的位图放在列信息的后面
+ */
+static char *page_bitmap(char *data)
+{
+  auto *page_header = reinterpret_cast<PageHeader *>(data);
+  if (page_header->record_size != PAX_RECORD_SIZE && page_header->record_size != COMPRESSED_PAX_RECORD_SIZE) {
+    return data + PAGE_HEADER_SIZE;
+  }
+  auto *pax_header = reinterpret_cast<PaxPageHeader *>(data + PAGE_HEADER_SIZE);
+  return data + pax_meta_size(pax_header->column_num, page_header->record_size == COMPRESSED_PAX_RECORD_SIZE);
+}
+
+/**
+ * @brief 计算 PAX 页面的布局：位图、字典和每一列的minipage的位置
+ *
+ * @param lens      每一列的长度
+ * @param encodings 每一列的编码，为空表示不压缩的页面。会设置字典的位置
+ * @param offsets   返回每一列的minipage在页面中的偏移量
+ * @return int 页面可以存放的记录个数，放不下一条记录时返回0
+ */
+static int pax_page_layout(const std::vector<int> &lens, std::vector<PaxColumnEncoding> &encodings, std::vector<int32_t> &offsets)
+{
+  const int  column_num = static_cast<int>(lens.size());
+  const bool compressed = !encodings.empty();
+  const int  meta_size  = pax_meta_size(column_num, compressed);
+
+  int row_size   = 0;
+  int dict_bytes = 0;
+  for (int i = 0; i < column_num; i++) {
+    row_size += compressed ? encodings[i].width : lens[i];
+    if (compressed && encodings[i].encoding == PaxEncoding::DICT) {
+      dict_bytes += align8(encodings[i].dict_capacity * lens[i]);
+    }
+  }
+  if (row_size <= 0 || meta_size + dict_bytes >= BP_PAGE_DATA_SIZE) {
+    return 0;
+  }
+
+  // 每个minipage都按照8字节对齐，先按照没有对齐的情况估算容量，放不下再逐个减少
+  offsets.resize(column_num);
+  int capacity = (int)((BP_PAGE_DATA_SIZE - meta_size - dict_bytes - 1) / (row_size + 0.125));
+  for (; capacity > 0; capacity--) {
+    int offset = align8(meta_size + page_bitmap_size(capacity));
+    for (int i = 0; compressed && i < column_num; i++) {
+      if (encodings[i].encoding == PaxEncoding::DICT) {
+        encodings[i].dict_offset = offset;
+        offset                   = align8(offset + encodings[i].dict_capacity * lens[i]);
+      }
+    }
+    for (int i = 0; i < column_num; i++) {
+      offsets[i] = offset;
+      offset     = align8(offset + capacity * (compressed ? encodings[i].width : lens[i]));
+    }
+    if (offset <= BP_PAGE_DATA_SIZE) {
+      break;
+    }
+  }
+  return std::max(capacity, 0);
+}
+
+/**
+ * @brief 比较的结果是否满足条件，与 ComparisonExpr::compare_value 一致
+ */
+static bool compare_result(int cmp_result, CompOp comp)
+{
+  switch (comp) {
+    case EQUAL_TO: return cmp_result == 0;
+    case NOT_EQUAL: return cmp_result != 0;
+    case LESS_THAN: return cmp_result < 0;
+    case LESS_EQUAL: return cmp_result <= 0;
+    case GREAT_THAN: return cmp_result > 0;
+    case GREAT_EQUAL: return cmp_result >= 0;
+    default: return true;
+  }
+}
+
+/**
+ * @brief 读取 FOR 编码的一个值与基准值的差
+ */
+static int32_t read_delta(const char *data, int width)
+{
+  if (width == 1) {
+    return *reinterpret_cast<const uint8_t *>(data);
+  }
+  uint16_t delta;
+  memcpy(&delta, data, sizeof(delta));
+  return delta;
+}
+
+static void write_delta(char *data, int width, int32_t delta)
+{
+  if (width == 1) {
+    *reinterpret_cast<uint8_t *>(data) = static_cast<uint8_t>(delta);
+    return;
+  }
+  const uint16_t value = static_cast<uint16_t>(delta);
+  memcpy(data, &value, sizeof(value));
+}
+
+/**
+ * @brief FOR 编码的一列上的每个值与基准值的差最大是多少
+ */
+static int64_t max_delta(int width) { return (1LL << (8 * width)) - 1; }
+
+/**
+ * @brief 在一个minipage上比较一列的所有值，不满足条件的槽位清零
+ * @details 循环中没有分支，编译器可以向量化
+ */
+template <typename T, typename Compare>
+static void filter_column(const char *column_data, int count, T value, Compare compare, uint8_t *selected)
+{
+  const T *values = reinterpret_cast<const T *>(column_data);
+  for (int i = 0; i < count; i++) {
+    selected[i] &= static_cast<uint8_t>(compare(values[i], value));
+  }
+}
+
+template <typename T>
+static void filter_column(const char *column_data, int count, CompOp comp, T value, uint8_t *selected)
+{
+  switch (comp) {
+    case EQUAL_TO: filter_column(column_data, count, value, std::equal_to<T>(), selected); break;
+    case NOT_EQUAL: filter_column(column_data, count, value, std::not_equal_to<T>(), selected); break;
+    case LESS_THAN: filter_column(column_data, count, value, std::less<T>(), selected); break;
+    case LESS_EQUAL: filter_column(column_data, count, value, std::less_equal<T>(), selected); break;
+    case GREAT_THAN: filter_column(column_data, count, value, std::greater<T>(), selected); break;
+    case GREAT_EQUAL: filter_column(column_data, count, value, std::greater_equal<T>(), selected); break;
+    default: break;
+  }
+}
+
+/**
+ * @brief 在 FOR 编码的minipage上比较，常量也换算成与基准值的差，不需要解码
+ * @details 常量超出了页面上可以表示的范围时，页面上所有的值都在常量的同一侧，不需要逐个比较
+ */
+template <typename T>
+static void filter_delta_column(const char *column_data, int count, CompOp comp, int64_t delta, uint8_t *selected)
+{
+  if (delta >= 0 && delta <= std::numeric_limits<T>::max()) {
+    filter_column<T>(column_data, count, comp, static_cast<T>(delta), selected);
+    return;
+  }
+
+  const bool value_below = delta < 0;  // 常量比页面上所有的值都小
+  bool       all_match   = true;
+  switch (comp) {
+    case EQUAL_TO: all_match = false; break;
+    case NOT_EQUAL: all_match = true; break;
+    case LESS_THAN:
+    case LESS_EQUAL: all_match = !value_below; break;
+    case GREAT_THAN:
+    case GREAT_EQUAL: all_match = value_below; break;
+    default: break;
+  }
+  if (!all_match) {
+    memset(selected, 0, count);
+  }
+}
+
+/**
+ * @brief 在字典编码的minipage上过滤，match 是字典中每个值是否满足条件
+ */
+static void filter_dict_column(const char *column_data, int count, const uint8_t *match, uint8_t *selected)
+{
+  const uint8_t *codes = reinterpret_cast<const uint8_t *>(column_data);
+  for (int i = 0; i < count; i++) {
+    selected[i] &= match[codes[i]];
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 RecordPageIterator::RecordPageIterator() {}
 RecordPageIterator::~RecordPageIterator() {}
 
-void RecordPageIterator::init(RecordPageHandler &record_page_handler, SlotNum start_slot_num /*=0*/)
+void RecordPageIterator::init(
+    RecordPageHandler &record_page_handler, SlotNum start_slot_num /*=0*/, const ColumnScanSpec *column_spec /*=nullptr*/)
 {
   record_page_handler_ = &record_page_handler;
   page_num_            = record_page_handler.get_page_num();
-  bitmap_.init(record_page_handler.bitmap_, record_page_handler.page_header_->record_capacity);
-  next_slot_num_ = bitmap_.next_setted_bit(start_slot_num);
+  column_spec_         = nullptr;
+
+  if (record_page_handler.is_pax()) {
+    // 先在整个页面上按列计算出满足条件的槽位，遍历时只需要拼接这些记录
+    column_spec_ = column_spec;
+    static const std::vector<ColumnFilter> no_filters;
+    record_page_handler.pax_select(column_spec != nullptr ? column_spec->filters : no_filters, selected_);
+    next_slot_num_ = next_selected_slot(start_slot_num);
+    return;
+  }
+
+  // 定长记录页面按字遍历记录分配位图
+  use_bit_iterator_ = record_page_handler.page_header_->record_size > 0;
+  if (use_bit_iterator_) {
+    bit_iterator_.init(record_page_handler.bitmap_, record_page_handler.page_header_->record_capacity, start_slot_num);
+    next_slot_num_ = bit_iterator_.next();
+    return;
+  }
+  next_slot_num_ = record_page_handler.next_record_slot(start_slot_num);
+}
+
+SlotNum RecordPageIterator::next_selected_slot(SlotNum start_slot_num) const
+{
+  const SlotNum count = static_cast<SlotNum>(selected_.size());
+  for (SlotNum i = std::max(start_slot_num, 0); i < count; i++) {
+    if (selected_[i] != 0) {
+      return i;
+    }
+  }
+  return -1;
 }
 
 bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
@@ -67,12 +285,24 @@ bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
 RC RecordPageIterator::next(Record &record)
 {
   record.set_rid(page_num_, next_slot_num_);
-  record.set_data(record_page_handler_->get_record_data(record.rid().slot_num));
+  if (next_slot_num_ < 0) {
+    return RC::RECORD_EOF;
+  }
 
-  if (next_slot_num_ >= 0) {
-    next_slot_num_ = bitmap_.next_setted_bit(next_slot_num_ + 1);
+  if (record_page_handler_->is_pax()) {
+    std::vector<char> &buffer = row_buffers_[current_buffer_];
+    buffer.resize(record_page_handler_->page_header_->record_real_size);
+    record_page_handler_->pax_gather(
+        next_slot_num_, column_spec_ != nullptr ? &column_spec_->columns : nullptr, buffer.data());
+    record.set_data(buffer.data(), static_cast<int>(buffer.size()));
+    next_slot_num_ = next_selected_slot(next_slot_num_ + 1);
+    return RC::SUCCESS;
   }
-  return record.rid().slot_num != -1 ? RC::SUCCESS : RC::RECORD_EOF;
+
+  record.set_data(
+      record_page_handler_->get_record_data(next_slot_num_), record_page_handler_->get_record_len(next_slot_num_));
+  next_slot_num_ = use_bit_iterator_ ? bit_iterator_.next() : record_page_handler_->next_record_slot(next_slot_num_ + 1);
+  return RC::SUCCESS;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -106,7 +336,7 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, PageNum page_num, bool r
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = readonly;
   page_header_      = (PageHeader *)(data);
-  bitmap_           = data + PAGE_HEADER_SIZE;
+  bitmap_           = page_bitmap(data);
 
   LOG_TRACE("Successfully init page_num %d.", page_num);
   return ret;
@@ -131,9 +361,14 @@ RC RecordPageHandler::recover_init(DiskBufferPool &buffer_pool, PageNum page_num
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = false;
   page_header_      = (PageHeader *)(data);
-  bitmap_           = data + PAGE_HEADER_SIZE;
+  bitmap_           = page_bitmap(data);
 
-  buffer_pool.recover_page(page_num);
+  ret = buffer_pool.recover_page(page_num);
+  if (OB_FAIL(ret)) {
+    LOG_WARN("failed to recover page. page_num=%d, rc=%s", page_num, strrc(ret));
+    cleanup();
+    return ret;
+  }
 
   LOG_TRACE("Successfully init page_num %d.", page_num);
   return ret;
@@ -147,6 +382,18 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_
     return ret;
   }
 
+  format_empty_page(record_size);
+
+  if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
+    return ret;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::format_empty_page(int record_size)
+{
   page_header_->record_num          = 0;
   page_header_->record_real_size    = record_size;
   page_header_->record_size         = align8(record_size);
@@ -159,6 +406,53 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_
   bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
   memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
 
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::init_empty_variable_page(DiskBufferPool &buffer_pool, PageNum page_num)
+{
+  RC ret = init(buffer_pool, page_num, false /*readonly*/);
+  if (ret != RC::SUCCESS) {
+    LOG_ERROR("Failed to init empty variable page. page_num=%d", page_num);
+    return ret;
+  }
+
+  format_empty_variable_page();
+
+  if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
+    return ret;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::format_empty_variable_page()
+{
+  page_header_->record_num          = 0;
+  page_header_->record_real_size    = 0;
+  page_header_->record_size         = VARIABLE_RECORD_SIZE;
+  page_header_->record_capacity     = 0;
+  page_header_->first_record_offset = VARIABLE_PAGE_END;
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::init_empty_pax_page(
+    DiskBufferPool &buffer_pool, PageNum page_num, const std::vector<int> &column_lens)
+{
+  RC ret = init(buffer_pool, page_num, false /*readonly*/);
+  if (ret != RC::SUCCESS) {
+    LOG_ERROR("Failed to init empty pax page. page_num=%d", page_num);
+    return ret;
+  }
+
+  if ((ret = format_empty_pax_page(column_lens)) != RC::SUCCESS) {
+    return ret;
+  }
+
   if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
     return ret;
@@ -167,6 +461,40 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_
   return RC::SUCCESS;
 }
 
+RC RecordPageHandler::format_empty_pax_page(const std::vector<int> &column_lens)
+{
+  const int column_num = static_cast<int>(column_lens.size());
+  const int row_size   = std::accumulate(column_lens.begin(), column_lens.end(), 0);
+  if (column_num == 0 || row_size <= 0 || pax_meta_size(column_num, false) >= BP_PAGE_DATA_SIZE) {
+    LOG_ERROR("Invalid pax columns. column num=%d, row size=%d", column_num, row_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  std::vector<PaxColumnEncoding> no_encodings;
+  std::vector<int32_t>           column_offsets;
+  const int                      capacity = pax_page_layout(column_lens, no_encodings, column_offsets);
+  if (capacity <= 0) {
+    LOG_ERROR("Record is too large for pax page. row size=%d", row_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  page_header_->record_num       = 0;
+  page_header_->record_real_size = row_size;
+  page_header_->record_size      = PAX_RECORD_SIZE;
+  pax_header()->column_num       = column_num;
+  std::copy(column_lens.begin(), column_lens.end(), pax_column_lens());
+  std::copy(column_offsets.begin(), column_offsets.end(), pax_column_offsets());
+
+  page_header_->record_capacity     = capacity;
+  page_header_->first_record_offset = column_offsets[0];
+
+  bitmap_ = page_bitmap(frame_->data());
+  memset(bitmap_, 0, page_bitmap_size(capacity));
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
 RC RecordPageHandler::cleanup()
 {
   if (disk_buffer_pool_ != nullptr) {
@@ -183,23 +511,69 @@ RC RecordPageHandler::cleanup()
 }
 
 RC RecordPageHandler::insert_record(const char *data, RID *rid)
+{
+  return insert_record(data, page_header_->record_real_size, rid);
+}
+
+RC RecordPageHandler::insert_record(const char *data, int len, RID *rid)
 {
   ASSERT(readonly_ == false, "cannot insert record into page while the page is readonly");
 
-  if (page_header_->record_num == page_header_->record_capacity) {
-    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
-    return RC::RECORD_NOMEM;
-  }
+  int index = -1;
+  if (is_variable()) {
+    const int space = align8(len);
+    if (len <= 0 || space > MAX_VARIABLE_RECORD_SIZE) {
+      LOG_WARN("invalid variable record length. len=%d", len);
+      return RC::INVALID_ARGUMENT;
+    }
 
-  // 找到空闲位置
-  Bitmap bitmap(bitmap_, page_header_->record_capacity);
-  int    index = bitmap.next_unsetted_bit(0);
-  bitmap.set_bit(index);
-  page_header_->record_num++;
+    // 优先复用空闲的槽位，没有的话在槽位目录的末尾追加一个
+    RecordSlot *slot_dir = slots();
+    index                = 0;
+    while (index < page_header_->record_capacity && slot_dir[index].length != 0) {
+      index++;
+    }
+
+    const int slot_space = (index == page_header_->record_capacity) ? static_cast<int>(sizeof(RecordSlot)) : 0;
+    if (free_space() + static_cast<int>(sizeof(RecordSlot)) < space + slot_space) {
+      LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+      return RC::RECORD_NOMEM;
+    }
+
+    if (contiguous_free_space() < space + slot_space) {
+      compact();
+    }
+
+    if (slot_space > 0) {
+      slot_dir[index] = RecordSlot{0, 0};
+      page_header_->record_capacity++;
+    }
+    put_variable_record(index, data, len);
+  } else {
+    if (page_header_->record_num == page_header_->record_capacity) {
+      LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+      return RC::RECORD_NOMEM;
+    }
+
+    if (is_compressed() && !pax_encodable(data)) {
+      LOG_TRACE("Record cannot be encoded in page, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+      return RC::RECORD_NOMEM;
+    }
 
-  // assert index < page_header_->record_capacity
-  char *record_data = get_record_data(index);
-  memcpy(record_data, data, page_header_->record_real_size);
+    // 找到空闲位置
+    Bitmap bitmap(bitmap_, page_header_->record_capacity);
+    index = bitmap.next_unsetted_bit(0);
+    bitmap.set_bit(index);
+    page_header_->record_num++;
+
+    // assert index < page_header_->record_capacity
+    if (is_pax()) {
+      pax_scatter(index, data);
+    } else {
+      char *record_data = get_record_data(index);
+      memcpy(record_data, data, page_header_->record_real_size);
+    }
+  }
 
   frame_->mark_dirty();
 
@@ -212,13 +586,52 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid)
   return RC::SUCCESS;
 }
 
-RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+RC RecordPageHandler::recover_insert_record(const char *data, int len, const RID &rid)
 {
+  if (is_variable()) {
+    if (rid.slot_num < 0 || len <= 0 || align8(len) > MAX_VARIABLE_RECORD_SIZE) {
+      LOG_WARN("invalid variable record. rid=%s, len=%d", rid.to_string().c_str(), len);
+      return RC::RECORD_INVALID_RID;
+    }
+
+    // 恢复时槽位上可能已经有这条记录了(页面已经刷到磁盘上)，先把它删掉再重新放进去
+    RecordSlot *slot_dir = slots();
+    if (rid.slot_num < page_header_->record_capacity && slot_dir[rid.slot_num].length != 0) {
+      page_header_->record_real_size -= align8(slot_dir[rid.slot_num].length);
+      page_header_->record_num--;
+      slot_dir[rid.slot_num] = RecordSlot{0, 0};
+    }
+
+    const int slot_space =
+        std::max(0, rid.slot_num + 1 - page_header_->record_capacity) * static_cast<int>(sizeof(RecordSlot));
+    if (free_space() + static_cast<int>(sizeof(RecordSlot)) < align8(len) + slot_space) {
+      LOG_WARN("no space to recover record. rid=%s, len=%d", rid.to_string().c_str(), len);
+      return RC::RECORD_NOMEM;
+    }
+
+    if (contiguous_free_space() < align8(len) + slot_space) {
+      compact();
+    }
+
+    for (SlotNum i = page_header_->record_capacity; i <= rid.slot_num; i++) {
+      slot_dir[i] = RecordSlot{0, 0};
+    }
+    page_header_->record_capacity = std::max(page_header_->record_capacity, rid.slot_num + 1);
+    put_variable_record(rid.slot_num, data, len);
+    frame_->mark_dirty();
+    return RC::SUCCESS;
+  }
+
   if (rid.slot_num >= page_header_->record_capacity) {
     LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
     return RC::RECORD_INVALID_RID;
   }
 
+  if (is_compressed() && !pax_encodable(data)) {
+    LOG_WARN("record cannot be encoded in page. rid=%s", rid.to_string().c_str());
+    return RC::RECORD_NOMEM;
+  }
+
   // 更新位图
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
   if (!bitmap.get_bit(rid.slot_num)) {
@@ -227,8 +640,12 @@ RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
   }
 
   // 恢复数据
-  char *record_data = get_record_data(rid.slot_num);
-  memcpy(record_data, data, page_header_->record_real_size);
+  if (is_pax()) {
+    pax_scatter(rid.slot_num, data);
+  } else {
+    char *record_data = get_record_data(rid.slot_num);
+    memcpy(record_data, data, page_header_->record_real_size);
+  }
 
   frame_->mark_dirty();
 
@@ -244,16 +661,33 @@ RC RecordPageHandler::delete_record(const RID *rid)
     return RC::INVALID_ARGUMENT;
   }
 
+  if (is_variable()) {
+    RecordSlot *slot_dir = slots();
+    if (slot_dir[rid->slot_num].length == 0) {
+      LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+      return RC::RECORD_NOT_EXIST;
+    }
+
+    page_header_->record_real_size -= align8(slot_dir[rid->slot_num].length);
+    page_header_->record_num--;
+    slot_dir[rid->slot_num] = RecordSlot{0, 0};
+
+    // 末尾空闲的槽位可以直接去掉，页面空了之后记录区也从头开始
+    while (page_header_->record_capacity > 0 && slot_dir[page_header_->record_capacity - 1].length == 0) {
+      page_header_->record_capacity--;
+    }
+    if (page_header_->record_num == 0) {
+      page_header_->first_record_offset = VARIABLE_PAGE_END;
+    }
+    frame_->mark_dirty();
+    return RC::SUCCESS;
+  }
+
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
   if (bitmap.get_bit(rid->slot_num)) {
     bitmap.clear_bit(rid->slot_num);
     page_header_->record_num--;
     frame_->mark_dirty();
-
-    if (page_header_->record_num == 0) {
-      // PageNum page_num = get_page_num();
-      cleanup();
-    }
     return RC::SUCCESS;
   } else {
     LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
@@ -263,19 +697,61 @@ RC RecordPageHandler::delete_record(const RID *rid)
 
 RC RecordPageHandler::get_record(const RID *rid, Record *rec)
 {
+  if (is_overflow()) {
+    LOG_WARN("no record in overflow page. rid=%s", rid->to_string().c_str());
+    return RC::RECORD_NOT_EXIST;
+  }
+
   if (rid->slot_num >= page_header_->record_capacity) {
     LOG_ERROR("Invalid slot_num:%d, exceed page's record capacity, page_num %d.", rid->slot_num, frame_->page_num());
     return RC::RECORD_INVALID_RID;
   }
 
-  Bitmap bitmap(bitmap_, page_header_->record_capacity);
-  if (!bitmap.get_bit(rid->slot_num)) {
+  const bool exists = is_variable() ? slots()[rid->slot_num].length != 0
+                                    : Bitmap(bitmap_, page_header_->record_capacity).get_bit(rid->slot_num);
+  if (!exists) {
     LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
     return RC::RECORD_NOT_EXIST;
   }
 
   rec->set_rid(*rid);
-  rec->set_data(get_record_data(rid->slot_num), page_header_->record_real_size);
+  if (is_pax()) {
+    const int len  = page_header_->record_real_size;
+    char     *data = static_cast<char *>(malloc(len));
+    if (nullptr == data) {
+      LOG_WARN("failed to allocate memory for record. len=%d", len);
+      return RC::NOMEM;
+    }
+    pax_gather(rid->slot_num, nullptr, data);
+    rec->set_data_owner(data, len);
+    return RC::SUCCESS;
+  }
+
+  rec->set_data(get_record_data(rid->slot_num), get_record_len(rid->slot_num));
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(readonly_ == false, "cannot update record in page while the page is readonly");
+
+  Record record;
+  RC     rc = get_record(&rid, &record);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (is_compressed() && !pax_encodable(data)) {
+    LOG_WARN("record cannot be encoded in page. rid=%s", rid.to_string().c_str());
+    return RC::RECORD_NOMEM;
+  }
+
+  if (is_pax()) {
+    pax_scatter(rid.slot_num, data);
+  } else if (record.data() != data) {
+    memcpy(record.data(), data, record.len());
+  }
+  frame_->mark_dirty();
   return RC::SUCCESS;
 }
 
@@ -287,47 +763,507 @@ PageNum RecordPageHandler::get_page_num() const
   return frame_->page_num();
 }
 
-bool RecordPageHandler::is_full() const { return page_header_->record_num >= page_header_->record_capacity; }
+bool RecordPageHandler::is_full() const
+{
+  if (is_variable()) {
+    return free_space() <= 0;
+  }
+  return page_header_->record_num >= page_header_->record_capacity;
+}
 
-////////////////////////////////////////////////////////////////////////////////
+int RecordPageHandler::free_space() const
+{
+  if (page_header_->record_size == OVERFLOW_RECORD_SIZE) {
+    return 0;
+  }
 
-RecordFileHandler::~RecordFileHandler() { this->close(); }
+  if (is_variable()) {
+    // 插入记录时可能还需要一个新的槽位，这里把它先扣掉
+    const int used = PAGE_HEADER_SIZE + (page_header_->record_capacity + 1) * static_cast<int>(sizeof(RecordSlot)) +
+                     page_header_->record_real_size;
+    return std::max(0, VARIABLE_PAGE_END - used);
+  }
+  const int record_size = is_pax() ? align8(page_header_->record_real_size) : page_header_->record_size;
+  return (page_header_->record_capacity - page_header_->record_num) * record_size;
+}
 
-RC RecordFileHandler::init(DiskBufferPool *buffer_pool)
+int RecordPageHandler::used_space() const
 {
-  if (disk_buffer_pool_ != nullptr) {
-    LOG_ERROR("record file handler has been openned.");
-    return RC::RECORD_OPENNED;
+  if (page_header_->record_size == OVERFLOW_RECORD_SIZE) {
+    return 0;
   }
 
-  disk_buffer_pool_ = buffer_pool;
+  if (is_variable()) {
+    return page_header_->record_real_size + page_header_->record_num * static_cast<int>(sizeof(RecordSlot));
+  }
+  const int record_size = is_pax() ? align8(page_header_->record_real_size) : page_header_->record_size;
+  return page_header_->record_num * record_size;
+}
 
-  RC rc = init_free_pages();
+SlotNum RecordPageHandler::next_record_slot(SlotNum start_slot_num) const
+{
+  if (page_header_->record_size == OVERFLOW_RECORD_SIZE) {
+    return -1;
+  }
 
-  LOG_INFO("open record file handle done. rc=%s", strrc(rc));
-  return RC::SUCCESS;
+  if (is_variable()) {
+    const RecordSlot *slot_dir = slots();
+    for (SlotNum i = start_slot_num; i < page_header_->record_capacity; i++) {
+      if (slot_dir[i].length != 0) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  return bitmap.next_setted_bit(start_slot_num);
 }
 
-void RecordFileHandler::close()
+int RecordPageHandler::contiguous_free_space() const
 {
-  if (disk_buffer_pool_ != nullptr) {
-    free_pages_.clear();
-    disk_buffer_pool_ = nullptr;
-  }
+  return page_header_->first_record_offset - PAGE_HEADER_SIZE -
+         page_header_->record_capacity * static_cast<int>(sizeof(RecordSlot));
 }
 
-RC RecordFileHandler::init_free_pages()
+void RecordPageHandler::compact()
 {
-  // 遍历当前文件上所有页面，找到没有满的页面
-  // 这个效率很低，会降低启动速度
-  // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
+  RecordSlot          *slot_dir = slots();
+  std::vector<SlotNum> slot_nums;
+  for (SlotNum i = 0; i < page_header_->record_capacity; i++) {
+    if (slot_dir[i].length != 0) {
+      slot_nums.push_back(i);
+    }
+  }
 
-  RC rc = RC::SUCCESS;
+  // 按照记录在页面中的位置从后往前挪，记录只会往后移动，不会覆盖还没有挪动的记录
+  std::sort(slot_nums.begin(), slot_nums.end(), [slot_dir](SlotNum a, SlotNum b) {
+    return slot_dir[a].offset > slot_dir[b].offset;
+  });
+
+  char *data   = frame_->data();
+  int   offset = VARIABLE_PAGE_END;
+  for (SlotNum slot_num : slot_nums) {
+    RecordSlot &slot = slot_dir[slot_num];
+    offset -= align8(slot.length);
+    if (offset != slot.offset) {
+      memmove(data + offset, data + slot.offset, slot.length);
+      slot.offset = static_cast<uint16_t>(offset);
+    }
+  }
+  page_header_->first_record_offset = offset;
+  frame_->mark_dirty();
+}
+
+void RecordPageHandler::pax_scatter(SlotNum slot_num, const char *data)
+{
+  const int      column_num = pax_header()->column_num;
+  const int32_t *lens       = pax_column_lens();
+  const int32_t *offsets    = pax_column_offsets();
+  char          *page_data  = frame_->data();
+  if (!is_compressed()) {
+    for (int i = 0; i < column_num; i++) {
+      memcpy(page_data + offsets[i] + slot_num * lens[i], data, lens[i]);
+      data += lens[i];
+    }
+    return;
+  }
+
+  PaxColumnEncoding *encodings = pax_encodings();
+  for (int i = 0; i < column_num; i++) {
+    PaxColumnEncoding &encoding = encodings[i];
+    char              *target   = page_data + offsets[i] + slot_num * encoding.width;
+    switch (encoding.encoding) {
+      case PaxEncoding::DICT: {
+        // 不在字典中的值追加到字典的末尾
+        int code = pax_dict_find(i, data);
+        if (code < 0) {
+          code = encoding.dict_size++;
+          memcpy(page_data + encoding.dict_offset + code * lens[i], data, lens[i]);
+        }
+        *reinterpret_cast<uint8_t *>(target) = static_cast<uint8_t>(code);
+      } break;
+      case PaxEncoding::FOR: {
+        int32_t value;
+        memcpy(&value, data, sizeof(value));
+        write_delta(target, encoding.width, static_cast<int32_t>(static_cast<int64_t>(value) - encoding.base));
+      } break;
+      default: {
+        memcpy(target, data, lens[i]);
+      } break;
+    }
+    data += lens[i];
+  }
+}
+
+void RecordPageHandler::pax_gather(SlotNum slot_num, const std::vector<int> *columns, char *data) const
+{
+  const int      column_num = pax_header()->column_num;
+  const int32_t *lens       = pax_column_lens();
+  const int32_t *offsets    = pax_column_offsets();
+  const char    *page_data  = frame_->data();
+
+  // 解码一列，写到 target 中
+  auto decode = [this, lens, offsets, page_data, slot_num](int column, char *target) {
+    if (!is_compressed()) {
+      memcpy(target, page_data + offsets[column] + slot_num * lens[column], lens[column]);
+      return;
+    }
+
+    const PaxColumnEncoding &encoding = pax_encodings()[column];
+    const char              *source   = page_data + offsets[column] + slot_num * encoding.width;
+    switch (encoding.encoding) {
+      case PaxEncoding::DICT: {
+        const int code = *reinterpret_cast<const uint8_t *>(source);
+        memcpy(target, page_data + encoding.dict_offset + code * lens[column], lens[column]);
+      } break;
+      case PaxEncoding::FOR: {
+        const int32_t value = encoding.base + read_delta(source, encoding.width);
+        memcpy(target, &value, sizeof(value));
+      } break;
+      default: {
+        memcpy(target, source, lens[column]);
+      } break;
+    }
+  };
+
+  if (columns == nullptr || columns->empty()) {
+    for (int i = 0; i < column_num; i++) {
+      decode(i, data);
+      data += lens[i];
+    }
+    return;
+  }
+
+  // 记录中每一列的位置就是前面所有列的长度之和
+  for (int column : *columns) {
+    if (column < 0 || column >= column_num) {
+      continue;
+    }
+    int row_offset = 0;
+    for (int i = 0; i < column; i++) {
+      row_offset += lens[i];
+    }
+    decode(column, data + row_offset);
+  }
+}
+
+void RecordPageHandler::pax_select(const std::vector<ColumnFilter> &filters, std::vector<uint8_t> &selected) const
+{
+  const int capacity = page_header_->record_capacity;
+  selected.assign(capacity, 0);
+  SettedBitIterator bit_iterator(bitmap_, capacity);
+  for (int i = bit_iterator.next(); i >= 0; i = bit_iterator.next()) {
+    selected[i] = 1;
+  }
+
+  const int      column_num = pax_header()->column_num;
+  const int32_t *lens       = pax_column_lens();
+  const int32_t *offsets    = pax_column_offsets();
+  const char    *page_data  = frame_->data();
+  for (const ColumnFilter &filter : filters) {
+    if (filter.column < 0 || filter.column >= column_num) {
+      continue;
+    }
+
+    const char *column_data = page_data + offsets[filter.column];
+    const bool  is_integer  = (filter.type == INTS || filter.type == DATES) && lens[filter.column] == sizeof(int32_t);
+    const PaxEncoding encoding = is_compressed() ? pax_encodings()[filter.column].encoding : PaxEncoding::PLAIN;
+    if (encoding == PaxEncoding::PLAIN && is_integer) {
+      filter_column<int32_t>(column_data, capacity, filter.comp, filter.value, selected.data());
+    } else if (encoding == PaxEncoding::FOR && is_integer) {
+      // 常量换算成与基准值的差，直接在编码之后的值上比较
+      const PaxColumnEncoding &column_encoding = pax_encodings()[filter.column];
+      const int64_t            delta           = static_cast<int64_t>(filter.value) - column_encoding.base;
+      if (column_encoding.width == 1) {
+        filter_delta_column<uint8_t>(column_data, capacity, filter.comp, delta, selected.data());
+      } else {
+        filter_delta_column<uint16_t>(column_data, capacity, filter.comp, delta, selected.data());
+      }
+    } else if (encoding == PaxEncoding::DICT && filter.type == CHARS) {
+      // 字典中的每个值只比较一次，再按照每条记录的编码查表
+      const PaxColumnEncoding &column_encoding = pax_encodings()[filter.column];
+      const int                len             = lens[filter.column];
+      const Value              value(filter.chars_value.c_str());
+      uint8_t                  match[256]      = {0};
+      for (int code = 0; code < column_encoding.dict_size; code++) {
+        const Value entry(page_data + column_encoding.dict_offset + code * len, len);
+        match[code] = static_cast<uint8_t>(compare_result(entry.compare(value), filter.comp));
+      }
+      filter_dict_column(column_data, capacity, match, selected.data());
+    }
+  }
+}
+
+bool RecordPageHandler::pax_encodable(const char *data) const
+{
+  const int                column_num = pax_header()->column_num;
+  const int32_t           *lens       = pax_column_lens();
+  const PaxColumnEncoding *encodings  = pax_encodings();
+  for (int i = 0; i < column_num; data += lens[i], i++) {
+    const PaxColumnEncoding &encoding = encodings[i];
+    if (encoding.encoding == PaxEncoding::DICT) {
+      if (encoding.dict_size >= encoding.dict_capacity && pax_dict_find(i, data) < 0) {
+        return false;
+      }
+    } else if (encoding.encoding == PaxEncoding::FOR) {
+      int32_t value;
+      memcpy(&value, data, sizeof(value));
+      const int64_t delta = static_cast<int64_t>(value) - encoding.base;
+      if (delta < 0 || delta > max_delta(encoding.width)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int RecordPageHandler::pax_dict_find(int column, const char *value) const
+{
+  const PaxColumnEncoding &encoding = pax_encodings()[column];
+  const int                len      = pax_column_lens()[column];
+  const char              *dict     = frame_->data() + encoding.dict_offset;
+  for (int code = 0; code < encoding.dict_size; code++) {
+    if (0 == memcmp(dict + code * len, value, len)) {
+      return code;
+    }
+  }
+  return -1;
+}
+
+RC RecordPageHandler::compress(const std::vector<AttrType> &column_types)
+{
+  ASSERT(readonly_ == false, "cannot compress page while the page is readonly");
+  if (!is_pax()) {
+    return RC::INVALID_ARGUMENT;
+  }
+  return pax_reencode(column_types, page_header_->record_capacity + 1, -1, nullptr);
+}
+
+RC RecordPageHandler::compress_insert(
+    const std::vector<AttrType> &column_types, const char *data, SlotNum slot_num, RID *rid)
+{
+  ASSERT(readonly_ == false, "cannot insert record into page while the page is readonly");
+  if (!is_pax()) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 没有空闲的槽位时放到最后，重新编码之后页面的容量需要变大
+  if (slot_num < 0) {
+    Bitmap bitmap(bitmap_, page_header_->record_capacity);
+    slot_num = bitmap.next_unsetted_bit(0);
+    if (slot_num < 0) {
+      slot_num = page_header_->record_capacity;
+    }
+  }
+
+  RC rc = pax_reencode(column_types, slot_num + 1, slot_num, data);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (rid != nullptr) {
+    rid->page_num = get_page_num();
+    rid->slot_num = slot_num;
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::pax_reencode(
+    const std::vector<AttrType> &column_types, int min_capacity, SlotNum slot_num, const char *data)
+{
+  const int        column_num = pax_header()->column_num;
+  const int        row_size   = page_header_->record_real_size;
+  std::vector<int> lens(pax_column_lens(), pax_column_lens() + column_num);
+
+  // 先把页面上所有的记录解码出来，重新编码之后再放回原来的槽位
+  std::vector<SlotNum> slot_nums;
+  std::vector<char>    rows;
+  Bitmap               bitmap(bitmap_, page_header_->record_capacity);
+  for (SlotNum i = bitmap.next_setted_bit(0); i >= 0; i = bitmap.next_setted_bit(i + 1)) {
+    if (i == slot_num) {
+      continue;
+    }
+    slot_nums.push_back(i);
+    rows.resize(rows.size() + row_size);
+    pax_gather(i, nullptr, rows.data() + rows.size() - row_size);
+  }
+  if (slot_num >= 0) {
+    slot_nums.push_back(slot_num);
+    rows.insert(rows.end(), data, data + row_size);
+  }
+  for (SlotNum i : slot_nums) {
+    min_capacity = std::max(min_capacity, i + 1);
+  }
+
+  // 根据每一列的值挑选编码，编码之后没有变小的列不压缩
+  const int                      row_num    = static_cast<int>(slot_nums.size());
+  bool                           compressed = false;
+  std::vector<PaxColumnEncoding> encodings(column_num);
+  for (int i = 0, column_offset = 0; i < column_num; column_offset += lens[i], i++) {
+    PaxColumnEncoding &encoding = encodings[i];
+    encoding          = PaxColumnEncoding{PaxEncoding::PLAIN, lens[i], 0, 0, 0, 0};
+    const AttrType type = i < static_cast<int>(column_types.size()) ? column_types[i] : UNDEFINED;
+    if (row_num == 0) {
+      continue;
+    }
+
+    if (type == CHARS && lens[i] > 1) {
+      std::vector<std::string_view> values;
+      for (int r = 0; r < row_num; r++) {
+        values.emplace_back(rows.data() + r * row_size + column_offset, lens[i]);
+      }
+      std::sort(values.begin(), values.end());
+      const int distinct = static_cast<int>(std::unique(values.begin(), values.end()) - values.begin());
+
+      // 字典留出一些空间给之后插入的新值
+      const int dict_capacity = std::min(256, std::max(2 * distinct, 16));
+      if (distinct <= 256 && dict_capacity * lens[i] < page_header_->record_capacity * (lens[i] - 1)) {
+        encoding = PaxColumnEncoding{PaxEncoding::DICT, 1, 0, 0, dict_capacity, 0};
+      }
+    } else if ((type == INTS || type == DATES) && lens[i] == sizeof(int32_t)) {
+      int64_t min_value = std::numeric_limits<int32_t>::max();
+      int64_t max_value = std::numeric_limits<int32_t>::min();
+      for (int r = 0; r < row_num; r++) {
+        int32_t value;
+        memcpy(&value, rows.data() + r * row_size + column_offset, sizeof(value));
+        min_value = std::min<int64_t>(min_value, value);
+        max_value = std::max<int64_t>(max_value, value);
+      }
+
+      // 基准值放在范围的中间，之后插入的值比现有的值大一些或者小一些都可以放下
+      const int64_t range = max_value - min_value;
+      const int     width = range <= max_delta(1) / 2 ? 1 : (range <= max_delta(2) / 2 ? 2 : 0);
+      if (width > 0) {
+        int64_t base = min_value - (max_delta(width) - range) / 2;
+        base = std::clamp<int64_t>(base, std::numeric_limits<int32_t>::min(),
+            std::numeric_limits<int32_t>::max() - max_delta(width));
+        encoding = PaxColumnEncoding{PaxEncoding::FOR, width, static_cast<int32_t>(base), 0, 0, 0};
+      }
+    }
+    compressed = compressed || encoding.encoding != PaxEncoding::PLAIN;
+  }
+  if (!compressed) {
+    encodings.clear();
+  }
+
+  std::vector<int32_t> offsets;
+  const int            capacity = pax_page_layout(lens, encodings, offsets);
+  if (capacity < min_capacity) {
+    LOG_TRACE("cannot reencode page. page_num=%d, capacity=%d, min capacity=%d", get_page_num(), capacity, min_capacity);
+    return RC::RECORD_NOMEM;
+  }
+
+  // 重新写整个页面，位图、字典和minipage的位置都变了
+  char *page_data = frame_->data();
+  memset(page_data + PAGE_HEADER_SIZE, 0, BP_PAGE_DATA_SIZE - PAGE_HEADER_SIZE);
+  page_header_->record_num          = row_num;
+  page_header_->record_size         = compressed ? COMPRESSED_PAX_RECORD_SIZE : PAX_RECORD_SIZE;
+  page_header_->record_capacity     = capacity;
+  page_header_->first_record_offset = offsets[0];
+  pax_header()->column_num          = column_num;
+  std::copy(lens.begin(), lens.end(), pax_column_lens());
+  std::copy(offsets.begin(), offsets.end(), pax_column_offsets());
+  if (compressed) {
+    std::copy(encodings.begin(), encodings.end(), pax_encodings());
+  }
+
+  bitmap_ = page_bitmap(page_data);
+  Bitmap new_bitmap(bitmap_, capacity);
+  for (int r = 0; r < row_num; r++) {
+    new_bitmap.set_bit(slot_nums[r]);
+    pax_scatter(slot_nums[r], rows.data() + r * row_size);
+  }
+  frame_->mark_dirty();
+
+  LOG_TRACE("reencode pax page. page_num=%d, compressed=%d, capacity=%d, records=%d",
+      get_page_num(), compressed, capacity, row_num);
+  return RC::SUCCESS;
+}
+
+void RecordPageHandler::put_variable_record(SlotNum slot_num, const char *data, int len)
+{
+  page_header_->first_record_offset -= align8(len);
+  memcpy(frame_->data() + page_header_->first_record_offset, data, len);
+
+  slots()[slot_num] = RecordSlot{static_cast<uint16_t>(page_header_->first_record_offset), static_cast<uint16_t>(len)};
+  page_header_->record_real_size += align8(len);
+  page_header_->record_num++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecordFileHandler::~RecordFileHandler() { this->close(); }
+
+RC RecordFileHandler::init(DiskBufferPool *buffer_pool, DiskBufferPool *fsm_buffer_pool /*=nullptr*/,
+    RecordFormat format /*=FIXED*/, const std::vector<int> &column_lens /*={}*/,
+    const std::vector<AttrType> &column_types /*={}*/)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_ERROR("record file handler has been openned.");
+    return RC::RECORD_OPENNED;
+  }
+
+  if (format == RecordFormat::PAX && column_lens.empty()) {
+    LOG_ERROR("pax record file requires column lengths.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (!column_types.empty() && (format != RecordFormat::PAX || column_types.size() != column_lens.size())) {
+    LOG_ERROR("only pax record file with types of all columns can be compressed.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  disk_buffer_pool_ = buffer_pool;
+  format_           = format;
+  column_lens_      = column_lens;
+  column_types_     = column_types;
+
+  bool need_rebuild = false;
+  RC   rc           = free_space_map_.open(fsm_buffer_pool, need_rebuild);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open free space map. rc=%s", strrc(rc));
+    disk_buffer_pool_ = nullptr;
+    return rc;
+  }
+
+  if (need_rebuild) {
+    rc = rebuild_free_space_map();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to rebuild free space map. rc=%s", strrc(rc));
+      free_space_map_.close();
+      zone_map_.clear();
+      disk_buffer_pool_ = nullptr;
+      return rc;
+    }
+  }
+
+  LOG_INFO("open record file handle done. rc=%s", strrc(rc));
+  return RC::SUCCESS;
+}
+
+void RecordFileHandler::close()
+{
+  if (disk_buffer_pool_ != nullptr) {
+    free_space_map_.close();
+    zone_map_.clear();
+    disk_buffer_pool_ = nullptr;
+  }
+}
+
+RC RecordFileHandler::rebuild_free_space_map()
+{
+  // 遍历当前文件上所有页面，记录每个页面的空闲空间
+  // 这个效率很低，所以空闲空间表会持久化，只有第一次打开时才需要
+  // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
+
+  RC rc = RC::SUCCESS;
 
   BufferPoolIterator bp_iterator;
   bp_iterator.init(*disk_buffer_pool_);
   RecordPageHandler record_page_handler;
   PageNum           current_page_num = 0;
+  int               page_count       = 0;
 
   while (bp_iterator.has_next()) {
     current_page_num = bp_iterator.next();
@@ -338,78 +1274,368 @@ RC RecordFileHandler::init_free_pages()
       return rc;
     }
 
-    if (!record_page_handler.is_full()) {
-      free_pages_.insert(current_page_num);
+    rc = free_space_map_.update(current_page_num, record_page_handler.free_space());
+    record_page_handler.cleanup();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to update free space map. page num=%d, rc=%s", current_page_num, strrc(rc));
+      return rc;
+    }
+    page_count++;
+  }
+  LOG_INFO("record file handler rebuild free space map done. page num=%d, rc=%s", page_count, strrc(rc));
+  return rc;
+}
+
+RC RecordFileHandler::collect_page_usage(std::vector<RecordPageUsage> &usages)
+{
+  usages.clear();
+
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*disk_buffer_pool_);
+  RecordPageHandler record_page_handler;
+  while (bp_iterator.has_next()) {
+    const PageNum page_num = bp_iterator.next();
+
+    RC rc = record_page_handler.init(*disk_buffer_pool_, page_num, true /*readonly*/);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    if (!record_page_handler.is_overflow()) {
+      RecordPageUsage usage;
+      usage.page_num   = page_num;
+      usage.record_num = record_page_handler.record_num();
+      usage.used_bytes = record_page_handler.used_space();
+      usage.free_bytes = record_page_handler.free_space();
+      usages.push_back(usage);
     }
     record_page_handler.cleanup();
   }
-  LOG_INFO("record file handler init free pages done. free page num=%d, rc=%s", free_pages_.size(), strrc(rc));
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::release_empty_page(PageNum page_num, bool &released)
+{
+  released = false;
+
+  RecordPageHandler page_handler;
+  RC                rc = page_handler.init(*disk_buffer_pool_, page_num, false /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  if (page_handler.is_overflow() || page_handler.record_num() > 0) {
+    free_space_map_.update(page_num, page_handler.free_space());
+    page_handler.cleanup();
+    return RC::SUCCESS;
+  }
+
+  // 拿着页面锁从空闲空间表中去掉，插入时就不会再找到这个页面了
+  free_space_map_.update(page_num, 0);
+  zone_map_.reset(page_num);
+  page_handler.cleanup();
+
+  rc = disk_buffer_pool_->dispose_page(page_num);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to dispose empty page. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+  released = true;
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::recover_release_page(PageNum page_num, bool &released)
+{
+  released = false;
+
+  RC rc = disk_buffer_pool_->recover_page(page_num);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to recover page. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+  return release_empty_page(page_num, released);
+}
+
+RC RecordFileHandler::init_zone_map(const std::vector<ZoneMapColumn> &columns)
+{
+  zone_map_.init(columns);
+  if (!zone_map_.enabled()) {
+    return RC::SUCCESS;
+  }
+
+  // 区域映射只在内存中维护，每次打开都要遍历所有页面
+  RC rc = RC::SUCCESS;
+
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*disk_buffer_pool_);
+  RecordPageHandler record_page_handler;
+  int               page_count = 0;
+  while (bp_iterator.has_next()) {
+    const PageNum page_num = bp_iterator.next();
+
+    rc = record_page_handler.init(*disk_buffer_pool_, page_num, true /*readonly*/);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+      zone_map_.clear();
+      return rc;
+    }
+
+    rebuild_zone(record_page_handler);
+    record_page_handler.cleanup();
+    page_count++;
+  }
+  LOG_INFO("record file handler build zone map done. page num=%d, columns=%d", page_count, (int)columns.size());
   return rc;
 }
 
+void RecordFileHandler::rebuild_zone(RecordPageHandler &page_handler)
+{
+  const PageNum page_num = page_handler.get_page_num();
+  zone_map_.reset(page_num);
+
+  RecordPageIterator iterator;
+  iterator.init(page_handler);
+  Record record;
+  while (iterator.has_next()) {
+    if (OB_FAIL(iterator.next(record))) {
+      break;
+    }
+    zone_map_.add(page_num, record.data());
+  }
+}
+
 RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
 {
   RC ret = RC::SUCCESS;
 
   RecordPageHandler record_page_handler;
   bool              page_found       = false;
-  PageNum           current_page_num = 0;
-
-  // 当前要访问free_pages对象，所以需要加锁。在非并发编译模式下，不需要考虑这个锁
-  lock_.lock();
+  PageNum           current_page_num = BP_INVALID_PAGE_NUM;
+
+  // 从空闲空间表中找一个有足够空间的页面
+  // 空闲空间表只是一个提示，拿到页面写锁之后还要再确认一下，不对的话就修正空闲空间表再找
+  // 查找时只会短暂地加空闲空间表的锁，不会拿着这个锁再去加页面锁
+  const int need_bytes = align8(record_size);
+  if (format_ == RecordFormat::VARIABLE && (record_size <= 0 || need_bytes > MAX_VARIABLE_RECORD_SIZE)) {
+    LOG_WARN("variable record is too large. record size=%d, max=%d", record_size, MAX_VARIABLE_RECORD_SIZE);
+    return RC::INVALID_ARGUMENT;
+  }
 
-  // 找到没有填满的页面
-  while (!free_pages_.empty()) {
-    current_page_num = *free_pages_.begin();
+  while (true) {
+    page_found = false;
+    while ((current_page_num = free_space_map_.find(need_bytes)) != BP_INVALID_PAGE_NUM) {
+      ret = record_page_handler.init(*disk_buffer_pool_, current_page_num, false /*readonly*/);
+      if (ret != RC::SUCCESS) {
+        LOG_WARN("failed to init record page handler, skip it. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
+        free_space_map_.update(current_page_num, 0);
+        continue;
+      }
+
+      if (record_page_handler.free_space() >= need_bytes) {
+        page_found = true;
+        break;
+      }
+      free_space_map_.update(current_page_num, record_page_handler.free_space());
+      record_page_handler.cleanup();
+    }
 
-    ret = record_page_handler.init(*disk_buffer_pool_, current_page_num, false /*readonly*/);
-    if (ret != RC::SUCCESS) {
-      lock_.unlock();
-      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
-      return ret;
+    // 找不到就分配一个新的页面
+    if (!page_found) {
+      Frame *frame = nullptr;
+      if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
+        LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
+        return ret;
+      }
+
+      current_page_num = frame->page_num();
+
+      if (format_ == RecordFormat::VARIABLE) {
+        ret = record_page_handler.init_empty_variable_page(*disk_buffer_pool_, current_page_num);
+      } else if (format_ == RecordFormat::PAX) {
+        ret = record_page_handler.init_empty_pax_page(*disk_buffer_pool_, current_page_num, column_lens_);
+      } else {
+        ret = record_page_handler.init_empty_page(*disk_buffer_pool_, current_page_num, record_size);
+      }
+      if (ret != RC::SUCCESS) {
+        frame->unpin();
+        LOG_ERROR("Failed to init empty page. ret:%d", ret);
+        // this is for allocate_page
+        return ret;
+      }
+
+      // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
+      frame->unpin();
     }
 
-    if (!record_page_handler.is_full()) {
-      page_found = true;
-      break;
+    // 找到空闲位置
+    ret = record_page_handler.insert_record(data, record_size, rid);
+    if (ret == RC::RECORD_NOMEM && page_found && record_page_handler.is_compressed()) {
+      // 页面上有空闲的槽位，但是字典满了或者超出了基准值的范围，按照页面上的记录和这条记录重新编码
+      ret = record_page_handler.compress_insert(column_types_, data, -1 /*slot_num*/, rid);
+      if (ret == RC::RECORD_NOMEM) {
+        // 重新编码也放不下，之后不再往这个页面插入，删除记录时会重新记录页面的空闲空间
+        free_space_map_.update(current_page_num, 0);
+        record_page_handler.cleanup();
+        continue;
+      }
     }
-    record_page_handler.cleanup();
-    free_pages_.erase(free_pages_.begin());
+    break;
+  }
+  if (OB_FAIL(ret)) {
+    return ret;
   }
-  lock_.unlock();  // 如果找到了一个有效的页面，那么此时已经拿到了页面的写锁
+  zone_map_.add(current_page_num, data);
 
-  // 找不到就分配一个新的页面
-  if (!page_found) {
-    Frame *frame = nullptr;
-    if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
-      LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
-      return ret;
+  // 页面写满之后压缩，压缩腾出来的空间可以继续插入记录。压缩之后没有变小的页面保持原样
+  if (!column_types_.empty() && !record_page_handler.is_compressed() &&
+      !FreeSpaceMap::fits(record_page_handler.free_space(), need_bytes)) {
+    RC rc = record_page_handler.compress(column_types_);
+    LOG_TRACE("compress page. page num=%d, rc=%s", current_page_num, strrc(rc));
+  }
+
+  // 新分配的页面，当前线程之后会继续往这个页面插入，这样并发插入的线程会使用不同的页面
+  if (page_found) {
+    free_space_map_.update(current_page_num, record_page_handler.free_space());
+  } else {
+    free_space_map_.add_page(current_page_num, record_page_handler.free_space());
+  }
+  return ret;
+}
+
+RecordBulkLoader::~RecordBulkLoader() { finish(); }
+
+RC RecordBulkLoader::init(RecordFileHandler &file_handler)
+{
+  if (file_handler_ != nullptr) {
+    LOG_WARN("record bulk loader has been initialized");
+    return RC::RECORD_OPENNED;
+  }
+
+  file_handler_ = &file_handler;
+  return RC::SUCCESS;
+}
+
+RC RecordBulkLoader::append(const char *data, int record_size, RID *rid)
+{
+  ASSERT(file_handler_ != nullptr, "record bulk loader is not initialized");
+
+  const int need_bytes = align8(record_size);
+  if (file_handler_->format_ == RecordFormat::VARIABLE &&
+      (record_size <= 0 || need_bytes > MAX_VARIABLE_RECORD_SIZE)) {
+    LOG_WARN("variable record is too large. record size=%d, max=%d", record_size, MAX_VARIABLE_RECORD_SIZE);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (!page_open_) {
+      rc = open_page(record_size);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
     }
 
-    current_page_num = frame->page_num();
+    const bool empty_page = page_handler_.record_num() == 0;
+    if (!page_handler_.is_compressed() && page_handler_.free_space() < need_bytes) {
+      rc = RC::RECORD_NOMEM;
+    } else {
+      rc = page_handler_.insert_record(data, record_size, rid);
+      if (rc == RC::RECORD_NOMEM && page_handler_.is_compressed()) {
+        rc = page_handler_.compress_insert(file_handler_->column_types_, data, -1 /*slot_num*/, rid);
+      }
+    }
 
-    ret = record_page_handler.init_empty_page(*disk_buffer_pool_, current_page_num, record_size);
-    if (ret != RC::SUCCESS) {
-      frame->unpin();
-      LOG_ERROR("Failed to init empty page. ret:%d", ret);
-      // this is for allocate_page
-      return ret;
+    if (rc != RC::RECORD_NOMEM || empty_page) {
+      break;
     }
+    close_page();
+  }
 
-    // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to append record. record size=%d, rc=%s", record_size, strrc(rc));
+    return rc;
+  }
+
+  file_handler_->zone_map_.add(page_handler_.get_page_num(), data);
+
+  // 与普通插入一样，页面写满之后压缩，压缩腾出来的空间可以继续写
+  if (!file_handler_->column_types_.empty() && !page_handler_.is_compressed() &&
+      !FreeSpaceMap::fits(page_handler_.free_space(), need_bytes)) {
+    RC rc2 = page_handler_.compress(file_handler_->column_types_);
+    LOG_TRACE("compress page. page num=%d, rc=%s", page_handler_.get_page_num(), strrc(rc2));
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordBulkLoader::finish()
+{
+  if (file_handler_ == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  if (page_open_) {
+    close_page();
+  }
+
+  DiskBufferPool *buffer_pool = file_handler_->disk_buffer_pool_;
+  for (; next_frame_ < frames_.size(); next_frame_++) {
+    Frame        *frame    = frames_[next_frame_];
+    const PageNum page_num = frame->page_num();
     frame->unpin();
+    RC rc = buffer_pool->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose unused page. page num=%d, rc=%s", page_num, strrc(rc));
+    }
+  }
+  frames_.clear();
+  next_frame_   = 0;
+  file_handler_ = nullptr;
+  return RC::SUCCESS;
+}
+
+RC RecordBulkLoader::open_page(int record_size)
+{
+  DiskBufferPool *buffer_pool = file_handler_->disk_buffer_pool_;
+  if (next_frame_ >= frames_.size()) {
+    next_frame_ = 0;
+    RC rc       = buffer_pool->allocate_pages(PAGE_BATCH, frames_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate pages while bulk loading. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
 
-    // 这里的加锁顺序看起来与上面是相反的，但是不会出现死锁
-    // 上面的逻辑是先加lock锁，然后加页面写锁，这里是先加上
-    // 了页面写锁，然后加lock的锁，但是不会引起死锁。
-    // 为什么？
-    lock_.lock();
-    free_pages_.insert(current_page_num);
-    lock_.unlock();
+  Frame        *frame    = frames_[next_frame_++];
+  const PageNum page_num = frame->page_num();
+
+  // 新页面只在内存中格式化，标记为脏页之后跟着记录一起由正常的刷盘流程写出，不需要每个页面都同步写一次
+  RC rc = page_handler_.init(*buffer_pool, page_num, false /*readonly*/);
+  if (OB_SUCC(rc)) {
+    rc = file_handler_->format_empty_page(page_handler_, record_size);
+    if (OB_FAIL(rc)) {
+      page_handler_.cleanup();
+    }
   }
 
-  // 找到空闲位置
-  return record_page_handler.insert_record(data, rid);
+  // 分配页面时有一个pin，初始化页面时又会增加一个，这里释放分配时的pin
+  frame->unpin();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page. page num=%d, rc=%s", page_num, strrc(rc));
+    buffer_pool->dispose_page(page_num);
+    return rc;
+  }
+
+  page_open_ = true;
+  return RC::SUCCESS;
+}
+
+void RecordBulkLoader::close_page()
+{
+  file_handler_->free_space_map_.add_page(page_handler_.get_page_num(), page_handler_.free_space());
+  page_handler_.cleanup();
+  page_open_ = false;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -424,7 +1650,37 @@ RC RecordFileHandler::recover_insert_record(const char *data, int record_size, c
     return ret;
   }
 
-  return record_page_handler.recover_insert_record(data, rid);
+  if (record_page_handler.is_overflow()) {
+    LOG_INFO("page is still an overflow page on disk, format it as record page. rid=%s", rid.to_string().c_str());
+    ret = format_empty_page(record_page_handler, record_size);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("failed to format page while recovering. rid=%s, rc=%s", rid.to_string().c_str(), strrc(ret));
+      return ret;
+    }
+  }
+
+  ret = record_page_handler.recover_insert_record(data, record_size, rid);
+  if ((ret == RC::RECORD_NOMEM || ret == RC::RECORD_INVALID_RID) && !column_types_.empty() &&
+      record_page_handler.is_pax()) {
+    // 页面压缩不记录日志，磁盘上的页面可能还没有压缩，或者编码与插入时不同，重新编码之后再插入
+    ret = record_page_handler.compress_insert(column_types_, data, rid.slot_num, nullptr);
+  }
+  if (OB_SUCC(ret)) {
+    free_space_map_.update(rid.page_num, record_page_handler.free_space());
+    zone_map_.add(rid.page_num, data);
+  }
+  return ret;
+}
+
+RC RecordFileHandler::format_empty_page(RecordPageHandler &page_handler, int record_size)
+{
+  if (format_ == RecordFormat::VARIABLE) {
+    return page_handler.format_empty_variable_page();
+  }
+  if (format_ == RecordFormat::PAX) {
+    return page_handler.format_empty_pax_page(column_lens_);
+  }
+  return page_handler.format_empty_page(record_size);
 }
 
 RC RecordFileHandler::delete_record(const RID *rid)
@@ -437,19 +1693,28 @@ RC RecordFileHandler::delete_record(const RID *rid)
     return rc;
   }
 
+  // 删除的记录是页面上某一列的最小值或最大值时，删除之后需要重新计算页面的范围
+  bool zone_changed = false;
+  if (zone_map_.enabled()) {
+    Record record;
+    rc = page_handler.get_record(rid, &record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record before deleting. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc));
+      return rc;
+    }
+    zone_changed = zone_map_.on_bound(rid->page_num, record.data());
+  }
+
   rc = page_handler.delete_record(rid);
-  // 📢 这里注意要清理掉资源，否则会与insert_record中的加锁顺序冲突而可能出现死锁
-  // delete record的加锁逻辑是拿到页面锁，删除指定记录，然后加上和释放record manager锁
-  // insert record是加上 record manager锁，然后拿到指定页面锁再释放record manager锁
-  page_handler.cleanup();
   if (OB_SUCC(rc)) {
-    // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入 free_pages_
-    // 中。但是这里可以不关心，因为在查找空闲页面时，会自动过滤掉已经满的页面
-    lock_.lock();
-    free_pages_.insert(rid->page_num);
-    LOG_TRACE("add free page %d to free page list", rid->page_num);
-    lock_.unlock();
+    // 拿着页面锁更新空闲空间表，与插入时的加锁顺序是一致的
+    free_space_map_.update(rid->page_num, page_handler.free_space());
+    LOG_TRACE("update free space of page %d", rid->page_num);
+    if (zone_changed) {
+      rebuild_zone(page_handler);
+    }
   }
+  page_handler.cleanup();
   return rc;
 }
 
@@ -487,15 +1752,237 @@ RC RecordFileHandler::visit_record(const RID &rid, bool readonly, std::function<
   }
 
   visitor(record);
+
+  // PAX 页面上拿到的是记录的拷贝，修改之后要写回去
+  if (!readonly && page_handler.is_pax()) {
+    rc = page_handler.update_record(rid, record.data());
+    if (rc == RC::RECORD_NOMEM && page_handler.is_compressed()) {
+      // 新的值不能使用页面上的编码存放，按照新的值重新编码页面
+      rc = page_handler.compress_insert(column_types_, record.data(), rid.slot_num, nullptr);
+    }
+  }
+  if (!readonly && OB_SUCC(rc)) {
+    zone_map_.add(rid.page_num, record.data());
+  }
+  return rc;
+}
+
+RC RecordFileHandler::update_record(const RID &rid, const char *data)
+{
+  RecordPageHandler page_handler;
+
+  RC rc = page_handler.init(*disk_buffer_pool_, rid.page_num, false /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init record page handler.page number=%d", rid.page_num);
+    return rc;
+  }
+
+  rc = page_handler.update_record(rid, data);
+  if (rc == RC::RECORD_NOMEM && page_handler.is_compressed()) {
+    // 新的值不能使用页面上的编码存放，按照新的值重新编码页面
+    rc = page_handler.compress_insert(column_types_, data, rid.slot_num, nullptr);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to update record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+  zone_map_.add(rid.page_num, data);
   return rc;
 }
 
+/**
+ * @brief 一个溢出页面上最多可以存放的数据长度
+ */
+static constexpr int OVERFLOW_PAGE_CAPACITY =
+    BP_PAGE_DATA_SIZE - PAGE_HEADER_SIZE - static_cast<int>(sizeof(OverflowPageHeader));
+
+static void init_overflow_page_header(PageHeader *page_header)
+{
+  page_header->record_num          = 0;
+  page_header->record_real_size    = 0;
+  page_header->record_size         = OVERFLOW_RECORD_SIZE;
+  page_header->record_capacity     = 0;
+  page_header->first_record_offset = PAGE_HEADER_SIZE + sizeof(OverflowPageHeader);
+}
+
+RC RecordFileHandler::insert_overflow(const char *data, int len, PageNum &first_page)
+{
+  first_page = BP_INVALID_PAGE_NUM;
+  if (len <= 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 从最后一个页面开始写，这样写每个页面时都已经知道下一个页面的页号了
+  const int page_count = (len + OVERFLOW_PAGE_CAPACITY - 1) / OVERFLOW_PAGE_CAPACITY;
+  for (int i = page_count - 1; i >= 0; i--) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->allocate_page(&frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate overflow page. rc=%s", strrc(rc));
+      delete_overflow(first_page);
+      first_page = BP_INVALID_PAGE_NUM;
+      return rc;
+    }
+
+    frame->write_latch();
+    auto *page_header = reinterpret_cast<PageHeader *>(frame->data());
+    init_overflow_page_header(page_header);
+
+    auto *overflow_header      = reinterpret_cast<OverflowPageHeader *>(frame->data() + PAGE_HEADER_SIZE);
+    overflow_header->next_page = first_page;
+    overflow_header->data_len  = std::min(OVERFLOW_PAGE_CAPACITY, len - i * OVERFLOW_PAGE_CAPACITY);
+    memcpy(frame->data() + page_header->first_record_offset,
+        data + i * OVERFLOW_PAGE_CAPACITY,
+        overflow_header->data_len);
+
+    frame->mark_dirty();
+    frame->write_unlatch();
+    first_page = frame->page_num();
+    disk_buffer_pool_->unpin_page(frame);
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::read_overflow(PageNum first_page, int len, char *data)
+{
+  int     offset   = 0;
+  PageNum page_num = first_page;
+  while (offset < len && page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    frame->read_latch();
+    auto *page_header     = reinterpret_cast<PageHeader *>(frame->data());
+    auto *overflow_header = reinterpret_cast<OverflowPageHeader *>(frame->data() + PAGE_HEADER_SIZE);
+    if (page_header->record_size != OVERFLOW_RECORD_SIZE) {
+      LOG_WARN("page is not an overflow page. page_num=%d", page_num);
+      frame->read_unlatch();
+      disk_buffer_pool_->unpin_page(frame);
+      return RC::RECORD_NOT_EXIST;
+    }
+
+    const int copy_len = std::min(overflow_header->data_len, len - offset);
+    memcpy(data + offset, frame->data() + page_header->first_record_offset, copy_len);
+    offset += copy_len;
+    page_num = overflow_header->next_page;
+    frame->read_unlatch();
+    disk_buffer_pool_->unpin_page(frame);
+  }
+
+  if (offset != len) {
+    LOG_WARN("overflow data is incomplete. first page=%d, len=%d, read=%d", first_page, len, offset);
+    return RC::RECORD_NOT_EXIST;
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::delete_overflow(PageNum first_page)
+{
+  PageNum page_num = first_page;
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    auto   *page_header = reinterpret_cast<PageHeader *>(frame->data());
+    PageNum next_page   = reinterpret_cast<OverflowPageHeader *>(frame->data() + PAGE_HEADER_SIZE)->next_page;
+    bool    is_overflow = page_header->record_size == OVERFLOW_RECORD_SIZE;
+    disk_buffer_pool_->unpin_page(frame);
+    if (!is_overflow) {
+      LOG_WARN("page is not an overflow page. page_num=%d", page_num);
+      return RC::RECORD_NOT_EXIST;
+    }
+
+    rc = disk_buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+    page_num = next_page;
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::visit_overflow(PageNum first_page, const std::function<RC(PageNum, const char *, int)> &visitor)
+{
+  PageNum page_num = first_page;
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    frame->read_latch();
+    auto *page_header     = reinterpret_cast<PageHeader *>(frame->data());
+    auto *overflow_header = reinterpret_cast<OverflowPageHeader *>(frame->data() + PAGE_HEADER_SIZE);
+    if (page_header->record_size != OVERFLOW_RECORD_SIZE) {
+      LOG_WARN("page is not an overflow page. page_num=%d", page_num);
+      rc = RC::RECORD_NOT_EXIST;
+    } else {
+      rc = visitor(page_num,
+          frame->data() + PAGE_HEADER_SIZE,
+          static_cast<int>(sizeof(OverflowPageHeader)) + overflow_header->data_len);
+    }
+    const PageNum next_page = overflow_header->next_page;
+    frame->read_unlatch();
+    disk_buffer_pool_->unpin_page(frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    page_num = next_page;
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::recover_overflow_page(PageNum page_num, const char *data, int len)
+{
+  if (len < static_cast<int>(sizeof(OverflowPageHeader)) || len > BP_PAGE_DATA_SIZE - PAGE_HEADER_SIZE) {
+    LOG_WARN("invalid overflow page data. page_num=%d, len=%d", page_num, len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = disk_buffer_pool_->recover_page(page_num);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to recover page. page_num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  Frame *frame = nullptr;
+  rc           = disk_buffer_pool_->get_this_page(page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  // 磁盘上可能还是之前作为记录页面时的样子，插入时不能再选中这个页面
+  free_space_map_.update(page_num, 0);
+  zone_map_.reset(page_num);
+
+  frame->write_latch();
+  init_overflow_page_header(reinterpret_cast<PageHeader *>(frame->data()));
+  memcpy(frame->data() + PAGE_HEADER_SIZE, data, len);
+  frame->mark_dirty();
+  frame->write_unlatch();
+  disk_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileScanner::~RecordFileScanner() { close_scan(); }
 
-RC RecordFileScanner::open_scan(
-    Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter)
+RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly,
+    ConditionFilter *condition_filter, const ColumnScanSpec *column_spec /*=nullptr*/, ZoneMap *zone_map /*=nullptr*/,
+    PageNum start_page /*=0*/, PageNum end_page /*=BP_INVALID_PAGE_NUM*/)
 {
   close_scan();
 
@@ -503,14 +1990,30 @@ RC RecordFileScanner::open_scan(
   disk_buffer_pool_ = &buffer_pool;
   trx_              = trx;
   readonly_         = readonly;
-
-  RC rc = bp_iterator_.init(buffer_pool);
+  has_column_spec_  = column_spec != nullptr;
+  column_spec_      = has_column_spec_ ? *column_spec : ColumnScanSpec();
+  // 没有过滤条件时也可以跳过没有记录的页面
+  zone_map_      = zone_map != nullptr && zone_map->enabled() ? zone_map : nullptr;
+  skipped_pages_ = 0;
+
+  // 迭代器返回的第一个页面是初始化页号的下一个
+  start_page = std::max(start_page, BP_HEADER_PAGE + 1);
+  end_page_  = end_page;
+  RC rc      = bp_iterator_.init(buffer_pool, start_page - 1);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
   condition_filter_ = condition_filter;
 
+  if (end_page_ == BP_INVALID_PAGE_NUM) {
+    // 全表扫描会按照页号顺序访问所有的页面
+    buffer_pool.hint_sequential(start_page);
+  } else if (end_page_ > start_page) {
+    // 只扫描一部分页面时，范围是确定的，直接把这些页面都预读进来
+    buffer_pool.read_ahead(start_page, end_page_ - start_page);
+  }
+
   rc = fetch_next_record();
   if (rc == RC::RECORD_EOF) {
     rc = RC::SUCCESS;
@@ -539,16 +2042,27 @@ RC RecordFileScanner::fetch_next_record()
   }
 
   // 上个页面遍历完了，或者还没有开始遍历某个页面，那么就从一个新的页面开始遍历查找
+  // 已经返回的记录可能还在上个页面上，换一个页面处理器，上个页面继续保持pin住
+  current_handler_ ^= 1;
+  RecordPageHandler &record_page_handler = record_page_handlers_[current_handler_];
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
-    record_page_handler_.cleanup();
-    rc = record_page_handler_.init(*disk_buffer_pool_, page_num, readonly_);
+    if (end_page_ != BP_INVALID_PAGE_NUM && page_num >= end_page_) {
+      break;
+    }
+    if (zone_map_ != nullptr && !zone_map_->may_match(page_num, column_spec_.filters)) {
+      skipped_pages_++;
+      continue;
+    }
+
+    record_page_handler.cleanup();
+    rc = record_page_handler.init(*disk_buffer_pool_, page_num, readonly_);
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
 
-    record_page_iterator_.init(record_page_handler_);
+    record_page_iterator_.init(record_page_handler, 0, has_column_spec_ ? &column_spec_ : nullptr);
     rc = fetch_next_record_in_page();
     if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
       // 有有效记录：RC::SUCCESS
@@ -558,9 +2072,8 @@ RC RecordFileScanner::fetch_next_record()
     }
   }
 
-  // 所有的页面都遍历完了，没有数据了
+  // 所有的页面都遍历完了，没有数据了。最后一个页面在关闭扫描时再释放
   next_record_.rid().slot_num = -1;
-  record_page_handler_.cleanup();
   return RC::RECORD_EOF;
 }
 
@@ -573,7 +2086,7 @@ RC RecordFileScanner::fetch_next_record_in_page()
   while (record_page_iterator_.has_next()) {
     rc = record_page_iterator_.next(next_record_);
     if (rc != RC::SUCCESS) {
-      const auto page_num = record_page_handler_.get_page_num();
+      const auto page_num = record_page_handlers_[current_handler_].get_page_num();
       LOG_TRACE("failed to get next record from page. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
@@ -612,7 +2125,10 @@ RC RecordFileScanner::close_scan()
     condition_filter_ = nullptr;
   }
 
-  record_page_handler_.cleanup();
+  record_page_iterator_ = RecordPageIterator();
+  for (RecordPageHandler &record_page_handler : record_page_handlers_) {
+    record_page_handler.cleanup();
+  }
 
   return RC::SUCCESS;
 }
@@ -622,6 +2138,7 @@ bool RecordFileScanner::has_next() { return next_record_.rid().slot_num != -1; }
 RC RecordFileScanner::next(Record &record)
 {
   record = next_record_;
+  record_page_iterator_.switch_row_buffer();
 
   RC rc = fetch_next_record();
   if (rc == RC::RECORD_EOF) {
@@ -629,3 +2146,40 @@ RC RecordFileScanner::next(Record &record)
   }
   return rc;
 }
+
+RC RecordFileScanner::next_batch(std::vector<Record> &records, int max_count /*=0*/)
+{
+  records.clear();
+  batch_buffer_.clear();
+  if (!has_next()) {
+    return RC::RECORD_EOF;
+  }
+
+  // PAX 页面上的记录在迭代器中只有两个缓存，需要复制出来。缓存可能会扩容，最后再设置记录的数据指针
+  const bool    is_pax   = record_page_handlers_[current_handler_].is_pax();
+  const PageNum page_num = next_record_.rid().page_num;
+  RC            rc       = RC::SUCCESS;
+  while (has_next() && next_record_.rid().page_num == page_num &&
+         (max_count <= 0 || static_cast<int>(records.size()) < max_count)) {
+    records.push_back(next_record_);
+    if (is_pax) {
+      batch_buffer_.insert(batch_buffer_.end(), next_record_.data(), next_record_.data() + next_record_.len());
+    }
+    record_page_iterator_.switch_row_buffer();
+
+    rc = fetch_next_record();
+    if (OB_FAIL(rc) && rc != RC::RECORD_EOF) {
+      LOG_WARN("failed to fetch next record. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (is_pax) {
+    char *data = batch_buffer_.data();
+    for (Record &record : records) {
+      record.set_data(data, record.len());
+      data += record.len();
+    }
+  }
+  return RC::SUCCESS;
+}
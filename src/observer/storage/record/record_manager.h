@@ -16,10 +16,15 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/bitmap.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/record/free_space_map.h"
 #include "storage/record/record.h"
+#include "storage/record/zone_map.h"
 #include "storage/trx/latch_memo.h"
+#include "sql/parser/parse_defs.h"
 #include <limits>
 #include <sstream>
+#include <string>
+#include <vector>
 
 class ConditionFilter;
 class RecordPageHandler;
@@ -44,6 +49,8 @@ class Table;
  * 问题1：那么如果记录不是定长的，还能使用 slot num 吗？
  * 问题2：如何更有效地存放不定长数据呢？
  * 问题3：如果一个页面不能存放一个记录，那么怎么组织记录存放效果更好呢？
+ * 变长记录和超长字段的一种做法可以参考 RecordFormat::VARIABLE 和溢出页面(OverflowPageHeader)。
+ * 分析型的表可以按列存放页面内的数据，参考 RecordFormat::PAX。
  *
  * 按照上面的描述，这里提供了几个类，分别是：
  * - RecordFileHandler：管理整个文件/表的记录增删改查
@@ -53,12 +60,32 @@ class Table;
  * - PageHeader：每个页面上都会记录的页面头信息
  */
 
+/**
+ * @brief 记录在页面上的组织方式
+ * @ingroup RecordManager
+ */
+enum class RecordFormat
+{
+  FIXED,     ///< 定长记录，根据slot num可以直接计算出记录的位置
+  VARIABLE,  ///< 变长记录，页面上有一个槽位目录(slotted page)，记录在页面中的位置可以移动
+  PAX,       ///< 定长记录，页面内按列存放(Partition Attributes Across)，同一列的数据连续存放在一个minipage中
+};
+
 /**
  * @brief 数据文件，按照页面来组织，每一页都存放一些记录/数据行
  * @ingroup RecordManager
- * @details 每一页都有一个这样的页头，虽然看起来浪费，但是现在就简单的这么做
- * 从这个页头描述的信息来看，当前仅支持定长行/记录。如果要支持变长记录，
- * 或者超长（超出一页）的记录，这么做是不合适的。
+ * @details 每一页都有一个这样的页头，虽然看起来浪费，但是现在就简单的这么做。
+ * 同一个文件中可能有几种不同的页面，使用 record_size 区分：
+ * - record_size > 0：定长记录页面，字段的含义与字段后面的注释一致；
+ * - record_size == VARIABLE_RECORD_SIZE：变长记录页面，record_real_size 是记录已经使用的空间，
+ *   record_capacity 是槽位目录中槽位的个数，first_record_offset 是记录区的起始位置，记录区从页面尾部往前增长；
+ * - record_size == OVERFLOW_RECORD_SIZE：溢出页面，存放放不进记录中的长字段，没有记录，遍历记录时会跳过。
+ * - record_size == PAX_RECORD_SIZE：PAX页面，record_real_size 是一行数据的长度，record_capacity 是最大记录个数，
+ *   first_record_offset 是第一个minipage的起始位置，页头后面是 PaxPageHeader。
+ * - record_size == COMPRESSED_PAX_RECORD_SIZE：压缩的PAX页面，字段的含义与PAX页面一样，
+ *   列信息后面多了每一列的编码方式(参考 PaxColumnEncoding)。
+ * - record_size == 0：分配之后还没有初始化的页面(比如分配页面之后就宕机了)，页头全是0，
+ *   当作容量为0的定长记录页面，没有记录也没有空闲空间。所以其它类型的页面都不能使用0作为标识。
  */
 struct PageHeader
 {
@@ -69,6 +96,111 @@ struct PageHeader
   int32_t first_record_offset;  ///< 第一条记录的偏移量
 };
 
+static constexpr int32_t OVERFLOW_RECORD_SIZE = -1;  ///< 溢出页面的 PageHeader::record_size
+static constexpr int32_t PAX_RECORD_SIZE      = -2;  ///< PAX页面的 PageHeader::record_size
+
+static constexpr int32_t COMPRESSED_PAX_RECORD_SIZE = -3;  ///< 压缩的PAX页面的 PageHeader::record_size
+static constexpr int32_t VARIABLE_RECORD_SIZE       = -4;  ///< 变长记录页面的 PageHeader::record_size
+
+/**
+ * @brief 变长记录页面上的一个槽位，记录了一条记录在页面中的位置
+ * @ingroup RecordManager
+ */
+struct RecordSlot
+{
+  uint16_t offset;  ///< 记录在页面中的偏移量
+  uint16_t length;  ///< 记录的长度，0 表示这个槽位是空闲的
+};
+
+/**
+ * @brief 溢出页面上紧跟在 PageHeader 后面的信息
+ * @ingroup RecordManager
+ * @details 一个长字段可能会占用多个溢出页面，这些页面按照 next_page 串成一个链表
+ */
+struct OverflowPageHeader
+{
+  PageNum next_page;  ///< 下一个溢出页面，最后一个页面是 BP_INVALID_PAGE_NUM
+  int32_t data_len;   ///< 当前页面上存放的数据长度
+};
+
+/**
+ * @brief PAX 页面上紧跟在 PageHeader 后面的信息
+ * @ingroup RecordManager
+ * @details 后面是 column_num 个 int32_t 表示每一列的长度，再后面是 column_num 个 int32_t 表示每一列的
+ * minipage 在页面中的偏移量，然后是记录的分配状态位图
+ */
+struct PaxPageHeader
+{
+  int32_t column_num;  ///< 列的个数，与表中字段(包括系统字段)的个数一致
+};
+
+/**
+ * @brief 压缩的 PAX 页面上一列的编码方式
+ * @ingroup RecordManager
+ */
+enum class PaxEncoding : int32_t
+{
+  PLAIN,  ///< 不压缩，与普通的 PAX 页面一样
+  DICT,   ///< 字典编码，minipage 中存放每个值在页面字典中的下标(1个字节)，用于 CHARS 列
+  FOR,    ///< 基准值编码(frame of reference)，minipage 中存放每个值与基准值的差(1或2个字节)，用于 INTS 和 DATES 列
+};
+
+/**
+ * @brief 压缩的 PAX 页面上一列的编码信息，放在列的偏移量后面，每一列一个
+ * @ingroup RecordManager
+ * @details 页面写满之后才会根据页面上已有的数据给每一列挑选编码(参考 RecordPageHandler::compress)，
+ * 编码之后每条记录占用的空间变小，页面可以继续插入记录。字典和基准值是页面级别的，新插入的值不在字典中时
+ * 追加到字典的末尾，字典满了或者与基准值的差超出了范围时，需要重新编码页面或者换一个页面插入。
+ */
+struct PaxColumnEncoding
+{
+  PaxEncoding encoding;       ///< 编码方式
+  int32_t     width;          ///< 每个值编码之后占用的字节数，PLAIN 就是列的长度
+  int32_t     base;           ///< FOR 编码的基准值
+  int32_t     dict_size;      ///< DICT 编码的字典中已经有多少个值
+  int32_t     dict_capacity;  ///< DICT 编码的字典最多可以放多少个值
+  int32_t     dict_offset;    ///< DICT 编码的字典在页面中的位置，第k个值在 dict_offset + k * 列的长度
+};
+
+/**
+ * @brief 一个列上的简单过滤条件：列 comp 常量
+ * @ingroup RecordManager
+ * @details PAX 页面上同一列的数据是连续存放的，可以在整个minipage上批量比较，生成满足条件的槽位，
+ * 循环中没有分支，编译器可以做向量化。这里只是提前过滤，调用者仍然需要使用完整的条件再过滤一次。
+ */
+struct ColumnFilter
+{
+  int     column = -1;  ///< 第几列，与记录中字段的顺序一致
+  AttrType type  = UNDEFINED;  ///< 列的类型，只支持 INTS、DATES 和 CHARS
+  CompOp  comp   = NO_OP;
+  int32_t value  = 0;
+
+  /// CHARS 类型的常量。只在字典编码的列上使用，字典中的每个值比较一次，不需要解码每一条记录
+  std::string chars_value;
+};
+
+/**
+ * @brief 扫描 PAX 页面时需要读取的列和可以提前过滤的条件
+ * @ingroup RecordManager
+ * @details 只有 PAX 页面会使用，其它页面总是返回完整的记录。没有读取的列在返回的记录中是未定义的。
+ */
+struct ColumnScanSpec
+{
+  std::vector<int>          columns;  ///< 需要读取的列，为空表示读取所有的列
+  std::vector<ColumnFilter> filters;  ///< 所有的过滤条件都满足的记录才会返回
+};
+
+/**
+ * @brief 变长记录页面上记录区的结束位置，记录按照8字节对齐，从这里往前存放
+ */
+static constexpr int VARIABLE_PAGE_END = BP_PAGE_DATA_SIZE & ~7;
+
+/**
+ * @brief 变长记录页面上一条记录最大的长度
+ */
+static constexpr int MAX_VARIABLE_RECORD_SIZE =
+    (VARIABLE_PAGE_END - static_cast<int>(sizeof(PageHeader) + sizeof(RecordSlot))) & ~7;
+
 /**
  * @brief 遍历一个页面中每条记录的iterator
  * @ingroup RecordManager
@@ -84,8 +216,10 @@ public:
    *
    * @param record_page_handler 负责某个页面上记录增删改查的对象
    * @param start_slot_num      从哪个记录开始扫描，默认是0
+   * @param column_spec         PAX 页面上需要读取的列和过滤条件，为空表示读取完整的记录
    */
-  void init(RecordPageHandler &record_page_handler, SlotNum start_slot_num = 0);
+  void init(RecordPageHandler &record_page_handler, SlotNum start_slot_num = 0,
+      const ColumnScanSpec *column_spec = nullptr);
 
   /**
    * @brief 判断是否有下一个记录
@@ -104,22 +238,61 @@ public:
    */
   bool is_valid() const { return record_page_handler_ != nullptr; }
 
+  /**
+   * @brief 之后的记录放到另一个缓存中
+   * @details PAX 页面上返回的记录放在迭代器的缓存中。调用者把当前的记录交出去之后调用，
+   * 这样提前读取下一条记录(包括被过滤掉的记录)时不会覆盖已经交出去的记录
+   */
+  void switch_row_buffer() { current_buffer_ ^= 1; }
+
+private:
+  /**
+   * @brief PAX 页面上从 start_slot_num 开始找到下一个满足过滤条件的槽位，找不到返回-1
+   */
+  SlotNum next_selected_slot(SlotNum start_slot_num) const;
+
 private:
   RecordPageHandler *record_page_handler_ = nullptr;
   PageNum            page_num_            = BP_INVALID_PAGE_NUM;
-  common::Bitmap     bitmap_;             ///< bitmap 的相关信息可以参考 RecordPageHandler 的说明
-  SlotNum            next_slot_num_ = 0;  ///< 当前遍历到了哪一个slot
+  SlotNum            next_slot_num_       = 0;  ///< 当前遍历到了哪一个slot
+
+  bool                      use_bit_iterator_ = false;  ///< 定长记录页面使用位图迭代器查找下一条记录
+  common::SettedBitIterator bit_iterator_;
+
+  const ColumnScanSpec *column_spec_ = nullptr;
+  std::vector<uint8_t>  selected_;  ///< PAX 页面上每个槽位是否有记录并且满足过滤条件
+
+  /// PAX 页面上的记录需要拼成一行再返回。扫描时会提前取下一条记录，所以使用两个缓存轮流存放，参考 switch_row_buffer
+  std::vector<char> row_buffers_[2];
+  int               current_buffer_ = 0;
 };
 
 /**
  * @brief 负责处理一个页面中各种操作，比如插入记录、删除记录或者查找记录
  * @ingroup RecordManager
- * @details 当前定长记录模式下每个页面的组织大概是这样的：
+ * @details 定长记录模式下每个页面的组织大概是这样的：
  * @code
  * | PageHeader | record allocate bitmap |
  * |------------|------------------------|
  * | record1 | record2 | ..... | recordN |
  * @endcode
+ * 变长记录模式下，页头后面是槽位目录，记录从页面的尾部往前存放：
+ * @code
+ * | PageHeader | slot0 | slot1 | ... | slotN | --> free space <-- | recordN | ... | record0 |
+ * @endcode
+ * RID 中的 slot num 是槽位目录的下标，删除记录只清空槽位，不会移动其它槽位，所以 RID 是不变的。
+ * 空闲空间不连续时，插入记录前会把所有的记录挪到页面尾部，把空闲空间合并起来。
+ *
+ * PAX 模式下，记录仍然是定长的，但是页面内按列存放，每一列的数据连续存放在一个 minipage 中：
+ * @code
+ * | PageHeader | PaxPageHeader | column lens | column offsets | record allocate bitmap |
+ * | minipage0: col0 of record1..N | minipage1: col1 of record1..N | ... |
+ * @endcode
+ * 第 i 条记录的第 j 列在 column_offsets[j] + i * column_lens[j]。分析型查询只需要访问用到的列，
+ * 同一列的数据也更适合批量比较。读取完整的记录时需要把各列拼起来，所以 get_record 返回的是一份拷贝。
+ *
+ * 压缩的 PAX 页面上，列信息后面是每一列的编码方式(PaxColumnEncoding)，位图后面是字典编码的列的字典，
+ * minipage 中存放的是编码之后的值，第 i 条记录的第 j 列在 column_offsets[j] + i * encodings[j].width。
  */
 class RecordPageHandler
 {
@@ -153,11 +326,66 @@ public:
    */
   RC init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size);
 
+  /**
+   * @brief 把一个新的页面初始化成变长记录页面
+   *
+   * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
+   * @param page_num    当前处理哪个页面
+   */
+  RC init_empty_variable_page(DiskBufferPool &buffer_pool, PageNum page_num);
+
+  /**
+   * @brief 把一个新的页面初始化成PAX页面
+   *
+   * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
+   * @param page_num    当前处理哪个页面
+   * @param column_lens 每一列的长度，所有列的长度之和就是记录的长度
+   */
+  RC init_empty_pax_page(DiskBufferPool &buffer_pool, PageNum page_num, const std::vector<int> &column_lens);
+
+  /**
+   * @brief 把已经用 init 打开的页面格式化成定长记录页面
+   * @details 与 init_empty_page 不同，这里不会刷盘，只把页面标记为脏页
+   * @param record_size 每个记录的大小
+   */
+  RC format_empty_page(int record_size);
+
+  /**
+   * @brief 把已经用 init 打开的页面格式化成变长记录页面，不刷盘
+   */
+  RC format_empty_variable_page();
+
+  /**
+   * @brief 把已经用 init 打开的页面格式化成PAX页面，不刷盘
+   * @param column_lens 每一列的长度
+   */
+  RC format_empty_pax_page(const std::vector<int> &column_lens);
+
   /**
    * @brief 操作结束后做的清理工作，比如释放页面、解锁
    */
   RC cleanup();
 
+  /**
+   * @brief 压缩写满的 PAX 页面
+   * @details 根据页面上已有的记录给每一列挑选编码，重新存放所有的记录，记录的槽位不变。
+   * 只有压缩之后页面可以放下更多的记录时才会修改页面，否则返回 RECORD_NOMEM
+   *
+   * @param column_types 每一列的类型，UNDEFINED 表示这一列不压缩，比如会原地修改的系统字段
+   */
+  RC compress(const std::vector<AttrType> &column_types);
+
+  /**
+   * @brief 页面上的编码放不下一条记录时(比如字典满了)，按照页面上的记录和这条记录重新编码，再插入这条记录
+   * @details 重新编码之后页面放不下所有的记录时，不修改页面并返回 RECORD_NOMEM
+   *
+   * @param column_types 每一列的类型，参考 compress
+   * @param data         要插入的记录
+   * @param slot_num     插入的位置，小于0表示使用第一个空闲的槽位。恢复时使用日志中的位置，修改记录时使用记录原来的位置
+   * @param rid          如果插入成功，通过这个参数返回插入的位置，可以为空
+   */
+  RC compress_insert(const std::vector<AttrType> &column_types, const char *data, SlotNum slot_num, RID *rid);
+
   /**
    * @brief 插入一条记录
    *
@@ -166,13 +394,23 @@ public:
    */
   RC insert_record(const char *data, RID *rid);
 
+  /**
+   * @brief 插入一条指定长度的记录，定长记录页面会忽略这个长度
+   *
+   * @param data 要插入的记录
+   * @param len  记录的长度
+   * @param rid  如果插入成功，通过这个参数返回插入的位置
+   */
+  RC insert_record(const char *data, int len, RID *rid);
+
   /**
    * @brief 数据库恢复时，在指定位置插入数据
    *
    * @param data 要插入的数据行
+   * @param len  数据行的长度，定长记录页面会忽略这个长度
    * @param rid  插入的位置
    */
-  RC recover_insert_record(const char *data, const RID &rid);
+  RC recover_insert_record(const char *data, int len, const RID &rid);
 
   /**
    * @brief 删除指定的记录
@@ -185,10 +423,17 @@ public:
    * @brief 获取指定位置的记录数据
    *
    * @param rid 指定的位置
-   * @param rec 返回指定的数据。这里不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护
+   * @param rec 返回指定的数据。这里不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护。
+   *            PAX 页面上的记录需要把各列拼起来，返回的是一份拷贝，修改之后需要调用 update_record 写回
    */
   RC get_record(const RID *rid, Record *rec);
 
+  /**
+   * @brief 使用新的数据覆盖指定位置的记录，记录的长度不变
+   * @details 只用于原地修改记录，比如事务修改记录的版本号。变长记录页面不支持修改记录长度
+   */
+  RC update_record(const RID &rid, const char *data);
+
   /**
    * @brief 返回该记录页的页号
    */
@@ -199,6 +444,44 @@ public:
    */
   bool is_full() const;
 
+  /**
+   * @brief 当前页面上还可以存放记录的字节数，记录到空闲空间表中(参考 FreeSpaceMap)
+   */
+  int free_space() const;
+
+  /**
+   * @brief 当前页面上的记录占用的字节数，与 free_space 使用相同的计算方式
+   */
+  int used_space() const;
+
+  /**
+   * @brief 当前页面上的记录个数
+   */
+  int record_num() const { return page_header_->record_num; }
+
+  /**
+   * @brief 是否是溢出页面
+   */
+  bool is_overflow() const { return page_header_->record_size == OVERFLOW_RECORD_SIZE; }
+
+  /**
+   * @brief 是否是变长记录页面
+   */
+  bool is_variable() const { return page_header_->record_size == VARIABLE_RECORD_SIZE; }
+
+  /**
+   * @brief 是否是PAX页面，包括压缩的PAX页面
+   */
+  bool is_pax() const
+  {
+    return page_header_->record_size == PAX_RECORD_SIZE || page_header_->record_size == COMPRESSED_PAX_RECORD_SIZE;
+  }
+
+  /**
+   * @brief 是否是压缩的PAX页面
+   */
+  bool is_compressed() const { return page_header_->record_size == COMPRESSED_PAX_RECORD_SIZE; }
+
 protected:
   /**
    * @details
@@ -223,9 +506,94 @@ protected:
    */
   char *get_record_data(SlotNum slot_num)
   {
+    if (is_variable()) {
+      return frame_->data() + slots()[slot_num].offset;
+    }
     return frame_->data() + page_header_->first_record_offset + (page_header_->record_size * slot_num);
   }
 
+  /**
+   * @brief 获取指定槽位的记录长度
+   */
+  int get_record_len(SlotNum slot_num) const
+  {
+    return is_variable() ? slots()[slot_num].length : page_header_->record_real_size;
+  }
+
+  /**
+   * @brief 从 start_slot_num 开始找到下一个有记录的槽位，找不到返回-1
+   */
+  SlotNum next_record_slot(SlotNum start_slot_num) const;
+
+  /**
+   * @brief 变长记录页面的槽位目录
+   */
+  RecordSlot *slots() const { return reinterpret_cast<RecordSlot *>(frame_->data() + sizeof(PageHeader)); }
+
+  /**
+   * @brief 变长记录页面上槽位目录与记录区之间连续的空闲空间
+   */
+  int contiguous_free_space() const;
+
+  /**
+   * @brief 把变长记录页面上所有的记录挪到页面尾部，合并空闲空间
+   */
+  void compact();
+
+  /**
+   * @brief 在变长记录页面的记录区分配空间，并把记录放到指定的槽位上。调用者需要保证空间足够
+   */
+  void put_variable_record(SlotNum slot_num, const char *data, int len);
+
+  /**
+   * @brief PAX 页面的信息
+   */
+  PaxPageHeader *pax_header() const { return reinterpret_cast<PaxPageHeader *>(frame_->data() + sizeof(PageHeader)); }
+  int32_t *pax_column_lens() const { return reinterpret_cast<int32_t *>(pax_header() + 1); }
+  int32_t *pax_column_offsets() const { return pax_column_lens() + pax_header()->column_num; }
+  PaxColumnEncoding *pax_encodings() const
+  {
+    return reinterpret_cast<PaxColumnEncoding *>(pax_column_offsets() + pax_header()->column_num);
+  }
+
+  /**
+   * @brief 压缩的 PAX 页面上，一条记录的每一列是否都可以使用页面上的编码存放
+   */
+  bool pax_encodable(const char *data) const;
+
+  /**
+   * @brief 字典编码的列中查找一个值，找不到返回-1
+   */
+  int pax_dict_find(int column, const char *value) const;
+
+  /**
+   * @brief 按照页面上的记录重新挑选每一列的编码，重新存放页面
+   *
+   * @param column_types 每一列的类型，参考 compress
+   * @param min_capacity 重新编码之后至少要能放下这么多条记录，否则不修改页面并返回 RECORD_NOMEM
+   * @param slot_num     同时在这个槽位上放一条新的记录，小于0表示没有
+   * @param data         新的记录
+   */
+  RC pax_reencode(const std::vector<AttrType> &column_types, int min_capacity, SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 把一行数据按列拆开，写到 PAX 页面的各个minipage中
+   * @details 压缩的页面上写入的是编码之后的值，调用者需要先使用 pax_encodable 检查
+   */
+  void pax_scatter(SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 从 PAX 页面的各个minipage中读取指定的列，拼成一行数据
+   *
+   * @param columns 需要读取的列，为空表示所有的列。没有读取的列在 data 中保持原样
+   */
+  void pax_gather(SlotNum slot_num, const std::vector<int> *columns, char *data) const;
+
+  /**
+   * @brief 在 PAX 页面上计算每个槽位是否有记录并且满足所有的过滤条件
+   */
+  void pax_select(const std::vector<ColumnFilter> &filters, std::vector<uint8_t> &selected) const;
+
 protected:
   DiskBufferPool *disk_buffer_pool_ = nullptr;  ///< 当前操作的buffer pool(文件)
   Frame *frame_ = nullptr;  ///< 当前操作页面关联的frame(frame的更多概念可以参考buffer pool和frame)
@@ -237,6 +605,18 @@ private:
   friend class RecordPageIterator;
 };
 
+/**
+ * @brief 一个数据页面的使用情况，整理表时用来挑选稀疏的页面
+ * @ingroup RecordManager
+ */
+struct RecordPageUsage
+{
+  PageNum page_num   = BP_INVALID_PAGE_NUM;
+  int     record_num = 0;  ///< 页面上的记录个数
+  int     used_bytes = 0;  ///< 记录占用的空间，参考 RecordPageHandler::used_space
+  int     free_bytes = 0;  ///< 还可以存放记录的空间，参考 RecordPageHandler::free_space
+};
+
 /**
  * @brief 管理整个文件中记录的增删改查
  * @ingroup RecordManager
@@ -251,9 +631,15 @@ public:
   /**
    * @brief 初始化
    *
-   * @param buffer_pool 当前操作的是哪个文件
+   * @param buffer_pool     当前操作的是哪个文件
+   * @param fsm_buffer_pool 存放空闲空间表的文件，为空时空闲空间表只在内存中维护，需要扫描所有页面来构建
+   * @param format          新分配的页面使用哪种记录格式
+   * @param column_lens     PAX 格式下每一列的长度
+   * @param column_types    PAX 格式下每一列的类型，不为空时写满的页面会压缩，参考 RecordPageHandler::compress
    */
-  RC init(DiskBufferPool *buffer_pool);
+  RC init(DiskBufferPool *buffer_pool, DiskBufferPool *fsm_buffer_pool = nullptr,
+      RecordFormat format = RecordFormat::FIXED, const std::vector<int> &column_lens = {},
+      const std::vector<AttrType> &column_types = {});
 
   /**
    * @brief 关闭，做一些资源清理的工作
@@ -271,7 +657,7 @@ public:
    * @brief 插入一个新的记录到指定文件中，并返回该记录的标识符
    *
    * @param data        纪录内容
-   * @param record_size 记录大小
+   * @param record_size 记录大小，变长记录不能超过 MAX_VARIABLE_RECORD_SIZE
    * @param rid         返回该记录的标识符
    */
   RC insert_record(const char *data, int record_size, RID *rid);
@@ -282,6 +668,8 @@ public:
    * @param data        记录内容
    * @param record_size 记录大小
    * @param rid         要插入记录的指定标识符
+   * @details 页面被整理表释放之后可能又用作了溢出页面，磁盘上留下的是之后的样子。日志说明这个页面
+   * 在这里是记录页面，会按照当前的格式重新初始化之后再插入
    */
   RC recover_insert_record(const char *data, int record_size, const RID &rid);
 
@@ -306,16 +694,154 @@ public:
    */
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
 
+  /**
+   * @brief 使用新的数据覆盖指定的记录，记录的长度不变
+   * @details 用来把 get_record 或者遍历时拿到的记录拷贝上的修改写回到页面中，参考 RecordPageHandler::update_record
+   */
+  RC update_record(const RID &rid, const char *data);
+
+  /**
+   * @brief 把一个长字段的数据写到溢出页面中
+   * @details 溢出页面与记录放在同一个文件中，遍历记录时会跳过。数据写入之后不会修改，删除时整个链表一起释放。
+   * 页面的内容由事务通过 visit_overflow 写到日志中，恢复时使用 recover_overflow_page 按照原来的页号重写
+   *
+   * @param data       数据
+   * @param len        数据长度
+   * @param first_page 返回第一个溢出页面的页号
+   */
+  RC insert_overflow(const char *data, int len, PageNum &first_page);
+
+  /**
+   * @brief 读取溢出页面中的数据
+   *
+   * @param first_page 第一个溢出页面的页号
+   * @param len        数据长度
+   * @param data       存放数据的内存，至少 len 个字节
+   */
+  RC read_overflow(PageNum first_page, int len, char *data);
+
+  /**
+   * @brief 释放一个长字段占用的所有溢出页面
+   */
+  RC delete_overflow(PageNum first_page);
+
+  /**
+   * @brief 按照链表的顺序访问一个长字段占用的所有溢出页面
+   *
+   * @param first_page 第一个溢出页面的页号
+   * @param visitor    参数是页号，以及页面上 PageHeader 之后的内容(OverflowPageHeader 和数据)和它的长度
+   */
+  RC visit_overflow(PageNum first_page, const std::function<RC(PageNum, const char *, int)> &visitor);
+
+  /**
+   * @brief 数据库恢复时按照日志重写一个溢出页面
+   * @details 不管页面原来是什么样子，都直接覆盖，恢复时不会重新分配页面
+   *
+   * @param page_num 溢出页面的页号
+   * @param data     visit_overflow 访问到的页面内容
+   * @param len      内容的长度
+   */
+  RC recover_overflow_page(PageNum page_num, const char *data, int len);
+
+  /**
+   * @brief 开启区域映射，扫描所有页面构建每个页面上这些列的范围
+   * @details 之后插入和删除记录时都会维护区域映射，参考 ZoneMap
+   */
+  RC init_zone_map(const std::vector<ZoneMapColumn> &columns);
+
+  /**
+   * @brief 统计每个数据页面的使用情况，不包括溢出页面
+   */
+  RC collect_page_usage(std::vector<RecordPageUsage> &usages);
+
+  /**
+   * @brief 释放一个已经没有记录的数据页面，还给文件，之后分配页面时可以重新使用
+   * @details 整理表时把页面上的记录都搬走之后调用。页面上还有记录时(比如整理过程中又插入了记录)
+   * 不会释放，只是重新记录页面的空闲空间
+   *
+   * @param page_num 数据页面的页号
+   * @param released 返回页面是否被释放了
+   */
+  RC release_empty_page(PageNum page_num, bool &released);
+
+  /**
+   * @brief 数据库恢复时重做 release_empty_page
+   * @details 页面在磁盘上可能还没有分配，这里先确认页面是分配过的，避免重复释放
+   */
+  RC recover_release_page(PageNum page_num, bool &released);
+
+  FreeSpaceMap &free_space_map() { return free_space_map_; }
+  ZoneMap      &zone_map() { return zone_map_; }
+  RecordFormat  format() const { return format_; }
+
+private:
+  /**
+   * @brief 遍历所有页面，重建空闲空间表
+   * @details 只有空闲空间表还不存在时(比如内存中的空闲空间表或者老版本创建的表)才需要，正常启动时不会扫描数据文件
+   */
+  RC rebuild_free_space_map();
+
+  /**
+   * @brief 重新计算页面上的所有记录的范围
+   */
+  void rebuild_zone(RecordPageHandler &page_handler);
+
+  /**
+   * @brief 按照文件的记录格式把已经打开的页面格式化成空的记录页面，不刷盘
+   */
+  RC format_empty_page(RecordPageHandler &page_handler, int record_size);
+
 private:
+  DiskBufferPool *disk_buffer_pool_ = nullptr;
+  RecordFormat     format_           = RecordFormat::FIXED;
+  std::vector<int> column_lens_;     ///< PAX 格式下每一列的长度
+  std::vector<AttrType> column_types_;  ///< PAX 格式下每一列的类型，为空表示不压缩
+  FreeSpaceMap     free_space_map_;  ///< 记录每个页面的空闲空间，插入时用来挑选页面
+  ZoneMap          zone_map_;        ///< 记录每个页面上若干列的范围，扫描时用来跳过页面
+
+private:
+  friend class RecordBulkLoader;
+};
+
+/**
+ * @brief 批量导入记录
+ * @ingroup RecordManager
+ * @details 导入大量数据时使用。每次从文件中分配一批新页面，把记录依次写满一个页面再换下一个页面，
+ * 不需要每条记录都去空闲空间表中找页面、重新获取页面和加锁。写满的页面与普通插入一样会压缩，
+ * 也会维护区域映射，页面写完之后才放到空闲空间表中，之后的插入可以使用剩余的空间。
+ * 导入的记录不记录日志，与 RecordFileHandler::insert_record 一样由上层负责
+ */
+class RecordBulkLoader
+{
+public:
+  RecordBulkLoader() = default;
+  ~RecordBulkLoader();
+
+  RC init(RecordFileHandler &file_handler);
+
+  /**
+   * @brief 追加一条记录，放在当前页面中，当前页面满了就换一个新的页面
+   */
+  RC append(const char *data, int record_size, RID *rid);
+
   /**
-   * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
+   * @brief 结束导入，把最后一个页面放到空闲空间表中，释放没有用到的页面
    */
-  RC init_free_pages();
+  RC finish();
+
+private:
+  RC open_page(int record_size);
+  void close_page();
 
 private:
-  DiskBufferPool             *disk_buffer_pool_ = nullptr;
-  std::unordered_set<PageNum> free_pages_;  ///< 没有填充满的页面集合
-  common::Mutex               lock_;  ///< 当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+  /// 一次分配多少个页面。分配的页面在写之前都是 pin 住的，不能太多
+  static constexpr int PAGE_BATCH = 16;
+
+  RecordFileHandler   *file_handler_ = nullptr;
+  RecordPageHandler    page_handler_;           ///< 当前正在写的页面
+  bool                 page_open_  = false;
+  std::vector<Frame *> frames_;                 ///< 已经分配还没有开始写的页面
+  size_t               next_frame_ = 0;
 };
 
 /**
@@ -337,8 +863,15 @@ public:
    * @param readonly         当前是否只读操作。访问数据时，需要对页面加锁。比如
    *                         删除时也需要遍历找到数据，然后删除，这时就需要加写锁
    * @param condition_filter 做一些初步过滤操作
+   * @param column_spec      PAX 页面上需要读取的列和可以提前过滤的条件，为空表示读取完整的记录
+   * @param zone_map         记录每个页面范围的区域映射，不可能满足 column_spec 中过滤条件的页面会被跳过
+   * @param start_page       只遍历页号在 [start_page, end_page) 之间的页面，默认遍历所有的页面。
+   *                         并行扫描时每个线程使用一个扫描器遍历文件的一部分，参考 ParallelTableScanPhysicalOperator
+   * @param end_page         BP_INVALID_PAGE_NUM 表示一直遍历到文件的最后
    */
-  RC open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter);
+  RC open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter,
+      const ColumnScanSpec *column_spec = nullptr, ZoneMap *zone_map = nullptr, PageNum start_page = 0,
+      PageNum end_page = BP_INVALID_PAGE_NUM);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -360,6 +893,23 @@ public:
    */
   RC next(Record &record);
 
+  /**
+   * @brief 批量获取记录，一次返回同一个页面上的多条记录
+   * @details 返回的记录不会复制数据，而是直接指向页面(PAX 页面上指向扫描器中的缓存)。
+   * 扫描器在下一次调用 next 或 next_batch 之前会一直pin住这些记录所在的页面，
+   * 调用者可以在一个循环中处理这一批记录，不需要每条记录都调用一次 next。
+   *
+   * @param records   返回的记录，调用前的内容会被清空
+   * @param max_count 最多返回多少条记录，小于等于0表示返回当前页面上剩下的所有记录
+   * @return RC 没有记录时返回 RECORD_EOF
+   */
+  RC next_batch(std::vector<Record> &records, int max_count = 0);
+
+  /**
+   * @brief 根据区域映射跳过了多少个页面
+   */
+  int64_t skipped_pages() const { return skipped_pages_; }
+
 private:
   /**
    * @brief 获取该文件中的下一条记录
@@ -380,8 +930,18 @@ private:
   bool            readonly_         = false;    ///< 遍历出来的数据，是否可能对它做修改
 
   BufferPoolIterator bp_iterator_;                 ///< 遍历buffer pool的所有页面
+  PageNum            end_page_ = BP_INVALID_PAGE_NUM;  ///< 遍历到这个页面(不包括)为止，无效值表示遍历到最后
   ConditionFilter   *condition_filter_ = nullptr;  ///< 过滤record
-  RecordPageHandler  record_page_handler_;         ///< 处理文件某页面的记录
-  RecordPageIterator record_page_iterator_;        ///< 遍历某个页面上的所有record
+
+  /// 处理文件某页面的记录。提前获取下一条记录时可能会切换到下一个页面，上一个页面上的记录可能还在使用，
+  /// 所以两个页面处理器轮流使用，上一个页面会一直pin住直到再次切换页面
+  RecordPageHandler  record_page_handlers_[2];
+  int                current_handler_ = 0;
+  RecordPageIterator record_page_iterator_;  ///< 遍历某个页面上的所有record
+  bool               has_column_spec_ = false;
+  ColumnScanSpec     column_spec_;  ///< PAX 页面上需要读取的列和过滤条件
+  ZoneMap           *zone_map_ = nullptr;  ///< 用来跳过不可能有满足条件的记录的页面
+  int64_t            skipped_pages_ = 0;   ///< 根据区域映射跳过的页面数
+  std::vector<char>  batch_buffer_;  ///< next_batch 返回 PAX 页面上的记录时，记录的数据存放在这里
   Record             next_record_;                 ///< 获取的记录放在这里缓存起来
 };
\ No newline at end of file
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+
+#include "storage/record/record_manager.h"
+#include "storage/record/zone_map.h"
+
+using namespace common;
+
+/**
+ * @brief 页面上某一列的范围 [min_value, max_value] 中是否可能有满足 列 comp value 的值
+ */
+static bool range_may_match(int32_t min_value, int32_t max_value, CompOp comp, int32_t value)
+{
+  switch (comp) {
+    case EQUAL_TO: return min_value <= value && value <= max_value;
+    case NOT_EQUAL: return min_value != value || max_value != value;
+    case LESS_THAN: return min_value < value;
+    case LESS_EQUAL: return min_value <= value;
+    case GREAT_THAN: return max_value > value;
+    case GREAT_EQUAL: return max_value >= value;
+    default: return true;
+  }
+}
+
+void ZoneMap::init(const std::vector<ZoneMapColumn> &columns)
+{
+  std::lock_guard<Mutex> guard(lock_);
+  columns_ = columns;
+  states_.clear();
+  bounds_.clear();
+}
+
+void ZoneMap::clear()
+{
+  std::lock_guard<Mutex> guard(lock_);
+  columns_.clear();
+  states_.clear();
+  bounds_.clear();
+}
+
+void ZoneMap::reset(PageNum page_num)
+{
+  if (page_num < 0 || !enabled()) {
+    return;
+  }
+
+  std::lock_guard<Mutex> guard(lock_);
+  extend(page_num);
+  states_[page_num] = ZoneState::EMPTY;
+}
+
+void ZoneMap::add(PageNum page_num, const char *record)
+{
+  if (page_num < 0 || !enabled()) {
+    return;
+  }
+
+  std::lock_guard<Mutex> guard(lock_);
+  extend(page_num);
+  int32_t   *page_bounds = bounds(page_num);
+  const bool first       = states_[page_num] != ZoneState::VALID;
+  for (size_t i = 0; i < columns_.size(); i++) {
+    int32_t value;
+    memcpy(&value, record + columns_[i].offset, sizeof(value));
+    if (first) {
+      page_bounds[2 * i]     = value;
+      page_bounds[2 * i + 1] = value;
+    } else {
+      page_bounds[2 * i]     = std::min(page_bounds[2 * i], value);
+      page_bounds[2 * i + 1] = std::max(page_bounds[2 * i + 1], value);
+    }
+  }
+  states_[page_num] = ZoneState::VALID;
+}
+
+bool ZoneMap::on_bound(PageNum page_num, const char *record)
+{
+  if (page_num < 0 || !enabled()) {
+    return false;
+  }
+
+  std::lock_guard<Mutex> guard(lock_);
+  if (page_num >= static_cast<PageNum>(states_.size()) || states_[page_num] != ZoneState::VALID) {
+    return false;
+  }
+
+  const int32_t *page_bounds = bounds(page_num);
+  for (size_t i = 0; i < columns_.size(); i++) {
+    int32_t value;
+    memcpy(&value, record + columns_[i].offset, sizeof(value));
+    if (value == page_bounds[2 * i] || value == page_bounds[2 * i + 1]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ZoneMap::may_match(PageNum page_num, const std::vector<ColumnFilter> &filters)
+{
+  if (page_num < 0 || !enabled()) {
+    return true;
+  }
+
+  std::lock_guard<Mutex> guard(lock_);
+  if (page_num >= static_cast<PageNum>(states_.size()) || states_[page_num] == ZoneState::UNKNOWN) {
+    return true;
+  }
+  if (states_[page_num] == ZoneState::EMPTY) {
+    return false;
+  }
+
+  const int32_t *page_bounds = bounds(page_num);
+  for (const ColumnFilter &filter : filters) {
+    const int index = index_of(filter.column);
+    if (index < 0 || columns_[index].type != filter.type) {
+      continue;
+    }
+    if (!range_may_match(page_bounds[2 * index], page_bounds[2 * index + 1], filter.comp, filter.value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ZoneMap::range(PageNum page_num, int column, int32_t &min_value, int32_t &max_value)
+{
+  std::lock_guard<Mutex> guard(lock_);
+  const int index = index_of(column);
+  if (page_num < 0 || page_num >= static_cast<PageNum>(states_.size()) || states_[page_num] != ZoneState::VALID ||
+      index < 0) {
+    return false;
+  }
+
+  const int32_t *page_bounds = bounds(page_num);
+  min_value                  = page_bounds[2 * index];
+  max_value                  = page_bounds[2 * index + 1];
+  return true;
+}
+
+void ZoneMap::extend(PageNum page_num)
+{
+  if (page_num < static_cast<PageNum>(states_.size())) {
+    return;
+  }
+
+  // 按照倍数扩展，避免顺序插入时每个新页面都要重新分配内存
+  const size_t page_count = std::max(static_cast<size_t>(page_num) + 1, states_.size() * 2);
+  states_.resize(page_count, ZoneState::UNKNOWN);
+  bounds_.resize(page_count * columns_.size() * 2, 0);
+}
+
+int ZoneMap::index_of(int column) const
+{
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].column == column) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
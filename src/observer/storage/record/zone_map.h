@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "common/lang/mutex.h"
+#include "sql/parser/value.h"
+#include "storage/buffer/page.h"
+
+struct ColumnFilter;
+
+/**
+ * @brief 区域映射(Zone Map)中记录的一列
+ * @ingroup RecordManager
+ */
+struct ZoneMapColumn
+{
+  int      column = -1;         ///< 第几列，与 ColumnFilter::column 一致
+  int      offset = 0;          ///< 列在记录中的偏移
+  AttrType type   = UNDEFINED;  ///< 列的类型，只支持 INTS 和 DATES
+};
+
+/**
+ * @brief 记录每个数据页面上若干列的最小值和最大值
+ * @ingroup RecordManager
+ * @details 扫描时先用下推的过滤条件(参考 ColumnFilter)和页面的最小最大值比较，如果页面上不可能有满足条件的记录，
+ * 就不需要访问这个页面了。数据按照某一列大致有序插入时(比如时间、自增的ID)，范围查询可以跳过绝大部分页面。
+ *
+ * 区域映射只在内存中维护，打开表时扫描数据文件构建，所以只对指定的表开启(参考 TableMeta::zone_map)。
+ * 插入记录时扩大范围；删除的记录正好是某一列的最小值或最大值时，重新计算这个页面的范围，否则范围不变。
+ * 范围只会比页面上真实的数据大，不会漏掉记录，恢复时重放的插入和删除也会更新区域映射。
+ */
+class ZoneMap
+{
+public:
+  ZoneMap() = default;
+  ~ZoneMap() = default;
+
+  /**
+   * @brief 设置需要记录的列，清空已有的数据
+   */
+  void init(const std::vector<ZoneMapColumn> &columns);
+
+  /**
+   * @brief 清空所有的数据
+   */
+  void clear();
+
+  bool                              enabled() const { return !columns_.empty(); }
+  const std::vector<ZoneMapColumn> &columns() const { return columns_; }
+
+  /**
+   * @brief 把页面的范围设置为空，之后再逐条添加页面上的记录
+   */
+  void reset(PageNum page_num);
+
+  /**
+   * @brief 页面上插入了一条记录，扩大页面的范围
+   */
+  void add(PageNum page_num, const char *record);
+
+  /**
+   * @brief 页面上要删除一条记录，判断删除之后是否需要重新计算页面的范围
+   * @details 只有记录中某一列的值正好是页面上这一列的最小值或最大值时，页面的范围才可能变小
+   */
+  bool on_bound(PageNum page_num, const char *record);
+
+  /**
+   * @brief 页面上是否可能有满足所有过滤条件的记录
+   * @details 没有记录过的页面总是返回 true。不是记录中的列的过滤条件会被忽略
+   */
+  bool may_match(PageNum page_num, const std::vector<ColumnFilter> &filters);
+
+  /**
+   * @brief 获取某一列在页面上的范围
+   * @return 页面上没有记录或者没有记录过这个页面时返回 false
+   */
+  bool range(PageNum page_num, int column, int32_t &min_value, int32_t &max_value);
+
+private:
+  /**
+   * @brief 每个页面的状态
+   */
+  enum class ZoneState : uint8_t
+  {
+    UNKNOWN,  ///< 没有记录过，可能是溢出页面或者还没有构建
+    EMPTY,    ///< 页面上没有记录
+    VALID,    ///< 页面上有记录，范围是有效的
+  };
+
+  void     extend(PageNum page_num);
+  int32_t *bounds(PageNum page_num) { return bounds_.data() + static_cast<size_t>(page_num) * columns_.size() * 2; }
+  int      index_of(int column) const;
+
+private:
+  std::vector<ZoneMapColumn> columns_;
+  std::vector<ZoneState>     states_;  ///< 每个数据页面一个
+  std::vector<int32_t>       bounds_;  ///< 每个数据页面每一列的最小值和最大值
+  common::Mutex              lock_;
+};
@@ -14,7 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #include <algorithm>
 #include <limits.h>
+#include <mutex>
+#include <shared_mutex>
 #include <string.h>
+#include <unistd.h>
 
 #include "common/defs.h"
 #include "common/lang/string.h"
@@ -36,6 +39,11 @@ Table::~Table()
     record_handler_ = nullptr;
   }
 
+  if (fsm_buffer_pool_ != nullptr) {
+    fsm_buffer_pool_->close_file();
+    fsm_buffer_pool_ = nullptr;
+  }
+
   if (data_buffer_pool_ != nullptr) {
     data_buffer_pool_->close_file();
     data_buffer_pool_ = nullptr;
@@ -51,7 +59,7 @@ Table::~Table()
 }
 
 RC Table::create(int32_t table_id, const char *path, const char *name, const char *base_dir, int attribute_count,
-    const AttrInfoSqlNode attributes[])
+    const AttrInfoSqlNode attributes[], const TableOptions &options /*={}*/)
 {
   if (table_id < 0) {
     LOG_WARN("invalid table id. table_id=%d, table_name=%s", table_id, name);
@@ -86,7 +94,7 @@ RC Table::create(int32_t table_id, const char *path, const char *name, const cha
   close(fd);
 
   // 创建文件
-  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes)) != RC::SUCCESS) {
+  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes, options)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init table meta. name:%s, ret:%d", name, rc);
     return rc;  // delete table file
   }
@@ -110,6 +118,13 @@ RC Table::create(int32_t table_id, const char *path, const char *name, const cha
     return rc;
   }
 
+  std::string fsm_file = table_fsm_file(base_dir, name);
+  rc                   = bpm.create_file(fsm_file.c_str());
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to create disk buffer pool of free space map file. file name=%s", fsm_file.c_str());
+    return rc;
+  }
+
   rc = init_record_handler(base_dir);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to create table %s due to init record handler failed.", data_file.c_str());
@@ -179,12 +194,30 @@ RC Table::open(const char *meta_file, const char *base_dir)
   return rc;
 }
 
+/**
+ * @brief 变长记录超过这个长度时，把比较长的字段放到溢出页面中，保证一个页面可以放下多条记录
+ */
+static constexpr int MAX_INLINE_RECORD_SIZE = MAX_VARIABLE_RECORD_SIZE / 4;
+
 RC Table::insert_record(Record &record)
 {
-  RC rc = RC::SUCCESS;
-  rc    = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid());
+  std::shared_lock<common::RecursiveSharedMutex> guard(latch_);
+
+  // 实际存放的记录中长字段可能在溢出页面中，索引使用的还是传入的完整记录
+  Record stored;
+  RC     rc = make_stored_record(record, stored);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to make stored record. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  std::vector<PageNum> overflow_pages;
+  overflow_pages_of(stored.data(), overflow_pages);
+
+  rc = record_handler_->insert_record(stored.data(), stored.len(), &record.rid());
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+    delete_overflow_pages(overflow_pages);
     return rc;
   }
 
@@ -200,7 +233,74 @@ RC Table::insert_record(Record &record)
       LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%d:%s",
                 name(), rc2, strrc(rc2));
     }
+    delete_overflow_pages(overflow_pages);
+  }
+  return rc;
+}
+
+RC Table::insert_records(std::vector<Record> &records, int &inserted)
+{
+  std::shared_lock<common::RecursiveSharedMutex> guard(latch_);
+
+  inserted = 0;
+
+  // 先写数据页面，每条记录占用的溢出页面在回滚时使用
+  const int                         record_num = static_cast<int>(records.size());
+  std::vector<std::vector<PageNum>> overflow_pages(record_num);
+  int                               stored_num = 0;
+
+  RecordBulkLoader loader;
+  RC               rc = loader.init(*record_handler_);
+  for (; OB_SUCC(rc) && stored_num < record_num; stored_num++) {
+    Record &record = records[stored_num];
+    Record  stored;
+    rc = make_stored_record(record, stored);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to make stored record. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+      break;
+    }
+
+    overflow_pages_of(stored.data(), overflow_pages[stored_num]);
+    rc = loader.append(stored.data(), stored.len(), &record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to append record. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+      delete_overflow_pages(overflow_pages[stored_num]);
+      break;
+    }
   }
+  loader.finish();
+
+  // 数据都写完之后再建索引。某个索引插入失败时，这条记录和之后的记录在前面的索引中的数据都要删掉
+  int indexed_num = stored_num;
+  for (size_t i = 0; i < indexes_.size() && indexed_num > 0; i++) {
+    Index *index = indexes_[i];
+    for (int r = 0; r < indexed_num; r++) {
+      RC rc2 = index->insert_entry(records[r].data(), &records[r].rid());
+      if (OB_FAIL(rc2)) {
+        LOG_WARN("failed to insert index entry. table name=%s, index=%s, rc=%s",
+                 name(), index->index_meta().name(), strrc(rc2));
+        for (size_t j = 0; j < i; j++) {
+          for (int k = r; k < indexed_num; k++) {
+            indexes_[j]->delete_entry(records[k].data(), &records[k].rid());
+          }
+        }
+        indexed_num = r;
+        rc          = rc2;
+        break;
+      }
+    }
+  }
+
+  for (int r = indexed_num; r < stored_num; r++) {
+    RC rc2 = record_handler_->delete_record(&records[r].rid());
+    if (OB_FAIL(rc2)) {
+      LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%s",
+                name(), strrc(rc2));
+    }
+    delete_overflow_pages(overflow_pages[r]);
+  }
+
+  inserted = indexed_num;
   return rc;
 }
 
@@ -209,13 +309,24 @@ RC Table::visit_record(const RID &rid, bool readonly, std::function<void(Record
   return record_handler_->visit_record(rid, readonly, visitor);
 }
 
-RC Table::get_record(const RID &rid, Record &record)
+RC Table::write_back_record(const Record &record)
 {
-  const int record_size = table_meta_.record_size();
-  char     *record_data = (char *)malloc(record_size);
-  ASSERT(nullptr != record_data, "failed to malloc memory. record data size=%d", record_size);
+  if (table_meta_.storage_format() != StorageFormat::PAX) {
+    return RC::SUCCESS;
+  }
+  return record_handler_->update_record(record.rid(), record.data());
+}
 
-  auto copier = [&record, record_data, record_size](Record &record_src) {
+RC Table::get_record(const RID &rid, Record &record)
+{
+  char *record_data = nullptr;
+  int   record_size = 0;
+
+  // 变长记录的长度需要读到记录之后才知道
+  auto copier = [&record, &record_data, &record_size](Record &record_src) {
+    record_size = record_src.len();
+    record_data = (char *)malloc(record_size);
+    ASSERT(nullptr != record_data, "failed to malloc memory. record data size=%d", record_size);
     memcpy(record_data, record_src.data(), record_size);
     record.set_rid(record_src.rid());
   };
@@ -230,17 +341,55 @@ RC Table::get_record(const RID &rid, Record &record)
   return rc;
 }
 
+RC Table::get_stored_record(const Record &record, Record &stored)
+{
+  if (!table_meta_.variable_length() || record.len() <= MAX_INLINE_RECORD_SIZE) {
+    stored.set_data(const_cast<char *>(record.data()), record.len());
+    stored.set_rid(record.rid());
+    return RC::SUCCESS;
+  }
+  return get_record(record.rid(), stored);
+}
+
+RC Table::visit_overflow_pages(const Record &stored, const std::function<RC(PageNum, const char *, int)> &visitor)
+{
+  std::vector<PageNum> overflow_pages;
+  overflow_pages_of(stored.data(), overflow_pages);
+  for (PageNum first_page : overflow_pages) {
+    RC rc = record_handler_->visit_overflow(first_page, visitor);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to visit overflow pages. table=%s, first page=%d, rc=%s", name(), first_page, strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::recover_overflow_page(PageNum page_num, const char *data, int len)
+{
+  return record_handler_->recover_overflow_page(page_num, data, len);
+}
+
 RC Table::recover_insert_record(Record &record)
 {
-  RC rc = RC::SUCCESS;
-  rc    = record_handler_->recover_insert_record(record.data(), table_meta_.record_size(), record.rid());
+  // 溢出的字段不在索引中，索引项直接使用实际存放的记录
+  RC rc = record_handler_->recover_insert_record(record.data(), record.len(), record.rid());
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
 
-  rc = insert_entry_of_indexes(record.data(), record.rid());
-  if (rc != RC::SUCCESS) {  // 可能出现了键值重复
+  // 索引项中包含了记录的位置，重复说明索引页面已经刷到磁盘上了
+  for (Index *index : indexes_) {
+    rc = index->insert_entry(record.data(), &record.rid());
+    if (rc == RC::RECORD_DUPLICATE_KEY) {
+      rc = RC::SUCCESS;
+    }
+    if (OB_FAIL(rc)) {
+      break;
+    }
+  }
+  if (rc != RC::SUCCESS) {
     RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), false /*error_on_not_exists*/);
     if (rc2 != RC::SUCCESS) {
       LOG_ERROR("Failed to rollback index data when insert index entries failed. table name=%s, rc=%d:%s",
@@ -255,10 +404,428 @@ RC Table::recover_insert_record(Record &record)
   return rc;
 }
 
+RC Table::recover_delete_record(const RID &rid, bool delete_overflow)
+{
+  Record record;
+  RC     rc = get_record(rid, record);
+  if (rc == RC::RECORD_NOT_EXIST || rc == RC::RECORD_INVALID_RID) {
+    return RC::SUCCESS;
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = delete_entry_of_indexes(record.data(), rid, false /*error_on_not_exists*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to delete index entries while recovering. table=%s, rid=%s, rc=%s",
+        name(), rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 与 delete_record 一样，之后这些溢出页面可能会被其它记录重新使用
+  std::vector<PageNum> overflow_pages;
+  if (delete_overflow) {
+    overflow_pages_of(record.data(), overflow_pages);
+  }
+  rc = record_handler_->delete_record(&rid);
+  if (OB_SUCC(rc)) {
+    delete_overflow_pages(overflow_pages);
+  }
+  return rc;
+}
+
+RC Table::recover_release_page(PageNum page_num)
+{
+  bool released = false;
+  return record_handler_->recover_release_page(page_num, released);
+}
+
+/**
+ * @brief 整理表时只搬动使用率低于这个比例的页面
+ * @details 比较满的页面上记录多，搬空一个页面需要移动很多记录并修改很多索引项，得不偿失
+ */
+static constexpr double VACUUM_PAGE_FILL_RATIO = 0.5;
+
+RC Table::vacuum(Trx *trx, VacuumStat &stat)
+{
+  std::lock_guard<common::RecursiveSharedMutex> guard(latch_);
+
+  RC rc = trx->start_if_need();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = purge_dead_records(trx, stat);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to purge dead records. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  rc = compact_pages(trx, stat);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to compact pages. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  // 日志已经写到磁盘上了，这里把文件头中的页面位图也刷下去
+  rc = data_buffer_pool_->flush_all_pages();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush data pages after vacuum. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+  rc = sync();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("vacuum table done. table=%s, purged records=%ld, moved records=%ld, released pages=%d",
+      name(), stat.purged_records, stat.moved_records, stat.released_pages);
+  return RC::SUCCESS;
+}
+
+RC Table::purge_dead_records(Trx *trx, VacuumStat &stat)
+{
+  // 扫描时拿着页面锁，先把要删除的记录找出来，扫描结束之后再删除
+  std::vector<RID>  dead_rids;
+  RecordFileScanner scanner;
+  RC                rc = get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Record record;
+  while (scanner.has_next()) {
+    rc = scanner.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan records while purging. table=%s, rc=%s", name(), strrc(rc));
+      scanner.close_scan();
+      return rc;
+    }
+    if (trx->version_state(this, record) == RecordVersionState::DEAD) {
+      dead_rids.push_back(record.rid());
+    }
+  }
+  scanner.close_scan();
+
+  // 旧版本的索引项还在索引中，delete_record 会一起删除，溢出页面也一起释放
+  for (const RID &rid : dead_rids) {
+    rc = get_record(rid, record);
+    if (OB_SUCC(rc)) {
+      rc = delete_record(record);
+    }
+    if (OB_SUCC(rc)) {
+      rc = trx->log_purge(this, rid);
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to purge dead record. table=%s, rid=%s, rc=%s", name(), rid.to_string().c_str(), strrc(rc));
+      return rc;
+    }
+    stat.purged_records++;
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::compact_pages(Trx *trx, VacuumStat &stat)
+{
+  std::vector<RecordPageUsage> usages;
+  RC                           rc = record_handler_->collect_page_usage(usages);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 从最空的页面开始挑选要搬空的页面，搬走的记录要能放进剩下的页面的空闲空间中，否则只是换了一批页面存放
+  std::sort(usages.begin(), usages.end(), [](const RecordPageUsage &left, const RecordPageUsage &right) {
+    return left.used_bytes < right.used_bytes;
+  });
+  int64_t supply = 0;
+  for (const RecordPageUsage &usage : usages) {
+    supply += usage.free_bytes;
+  }
+
+  FreeSpaceMap        &free_space_map = record_handler_->free_space_map();
+  std::vector<PageNum> source_pages;
+  int64_t              demand = 0;
+  for (const RecordPageUsage &usage : usages) {
+    if (usage.used_bytes >= (usage.used_bytes + usage.free_bytes) * VACUUM_PAGE_FILL_RATIO && usage.record_num > 0) {
+      break;
+    }
+    if (demand + usage.used_bytes > supply - usage.free_bytes) {
+      break;
+    }
+    demand += usage.used_bytes;
+    supply -= usage.free_bytes;
+    source_pages.push_back(usage.page_num);
+
+    // 不要把记录搬到其它要搬空的页面上
+    free_space_map.update(usage.page_num, 0);
+  }
+
+  for (PageNum page_num : source_pages) {
+    // 先读出页面上所有记录的拷贝，搬动记录时需要修改这个页面
+    std::vector<Record> records;
+    RecordFileScanner   scanner;
+    rc = get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/, nullptr /*column_spec*/, page_num, page_num + 1);
+    if (OB_FAIL(rc)) {
+      break;
+    }
+
+    bool   movable = true;
+    Record record;
+    while (OB_SUCC(rc) && scanner.has_next()) {
+      rc = scanner.next(record);
+      if (OB_SUCC(rc)) {
+        movable = movable && trx->version_state(this, record) != RecordVersionState::ACTIVE;
+        char *data = (char *)malloc(record.len());
+        ASSERT(nullptr != data, "failed to malloc memory. record data size=%d", record.len());
+        memcpy(data, record.data(), record.len());
+        records.emplace_back();
+        records.back().set_data_owner(data, record.len());
+        records.back().set_rid(record.rid());
+      }
+    }
+    scanner.close_scan();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan page while compacting. table=%s, page=%d, rc=%s", name(), page_num, strrc(rc));
+      break;
+    }
+
+    // 有事务正在修改的记录不能搬动，这个页面就搬不空了
+    if (!movable) {
+      LOG_INFO("skip page with active records while compacting. table=%s, page=%d", name(), page_num);
+      continue;
+    }
+
+    for (const Record &page_record : records) {
+      if (trx->version_state(this, page_record) == RecordVersionState::DEAD) {
+        rc = delete_record(page_record);
+        if (OB_SUCC(rc)) {
+          rc = trx->log_purge(this, page_record.rid());
+        }
+        stat.purged_records += OB_SUCC(rc) ? 1 : 0;
+      } else {
+        RID new_rid;
+        rc = move_record(page_record, new_rid);
+        if (OB_SUCC(rc)) {
+          // 溢出页面没有变化，日志中只记录实际存放的记录
+          Record moved;
+          moved.set_data(const_cast<char *>(page_record.data()), page_record.len());
+          moved.set_rid(new_rid);
+          rc = trx->log_move(this, page_record.rid(), moved);
+        }
+        stat.moved_records += OB_SUCC(rc) ? 1 : 0;
+      }
+      if (OB_FAIL(rc)) {
+        break;
+      }
+    }
+    if (OB_FAIL(rc)) {
+      break;
+    }
+  }
+
+  // 释放页面时丢弃页面的内容，磁盘上留下的是最后一次刷下去的样子。先写日志再把页面刷下去，
+  // 恢复时重做这个页面上原来的插入日志，才能找到一个已经初始化过的记录页面
+  RC rc2 = trx->sync_log();
+  if (OB_SUCC(rc2)) {
+    rc2 = data_buffer_pool_->flush_all_pages();
+  }
+  if (OB_FAIL(rc2)) {
+    LOG_WARN("failed to flush log and data pages before releasing pages. table=%s, rc=%s", name(), strrc(rc2));
+    return OB_SUCC(rc) ? rc2 : rc;
+  }
+
+  // 搬空的页面还给文件，没有搬空的页面重新记录空闲空间
+  for (PageNum page_num : source_pages) {
+    bool released = false;
+    rc2           = record_handler_->release_empty_page(page_num, released);
+    if (OB_SUCC(rc2) && released) {
+      rc2 = trx->log_release_page(this, page_num);
+    }
+    if (OB_FAIL(rc2)) {
+      LOG_WARN("failed to release page. table=%s, page=%d, rc=%s", name(), page_num, strrc(rc2));
+      rc = OB_SUCC(rc) ? rc2 : rc;
+    }
+    stat.released_pages += released ? 1 : 0;
+  }
+
+  // 文件头中的页面位图在日志之后刷到磁盘上
+  rc2 = trx->sync_log();
+  return OB_SUCC(rc) ? rc2 : rc;
+}
+
+RC Table::move_record(const Record &record, RID &new_rid)
+{
+  RC rc = record_handler_->insert_record(record.data(), record.len(), &new_rid);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to insert moved record. table=%s, rid=%s, rc=%s", name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 先删除原来的索引项，唯一索引中同一个键不能同时出现两次
+  rc = delete_entry_of_indexes(record.data(), record.rid(), true /*error_on_not_exists*/);
+  if (OB_SUCC(rc)) {
+    rc = insert_entry_of_indexes(record.data(), new_rid);
+    if (OB_FAIL(rc)) {
+      (void)delete_entry_of_indexes(record.data(), new_rid, false /*error_on_not_exists*/);
+    }
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to update index entries of moved record. table=%s, rid=%s, rc=%s",
+        name(), record.rid().to_string().c_str(), strrc(rc));
+    RC rc2 = insert_entry_of_indexes(record.data(), record.rid());
+    if (OB_FAIL(rc2)) {
+      LOG_PANIC("failed to restore index entries of record. table=%s, rid=%s, rc=%s",
+          name(), record.rid().to_string().c_str(), strrc(rc2));
+    }
+    rc2 = record_handler_->delete_record(&new_rid);
+    if (OB_FAIL(rc2)) {
+      LOG_PANIC("failed to delete moved record. table=%s, rid=%s, rc=%s", name(), new_rid.to_string().c_str(), strrc(rc2));
+    }
+    return rc;
+  }
+
+  // 长字段的溢出页面已经被新的记录引用了，这里只删除记录本身
+  rc = record_handler_->delete_record(&record.rid());
+  if (OB_FAIL(rc)) {
+    LOG_PANIC("failed to delete record after moving it. table=%s, rid=%s, rc=%s",
+        name(), record.rid().to_string().c_str(), strrc(rc));
+  }
+  return rc;
+}
+
+RC Table::read_varchar(const char *record_data, const FieldMeta &field, Value &value) const
+{
+  VarcharRef ref;
+  memcpy(&ref, record_data + field.offset(), sizeof(ref));
+
+  const int len = ref.data_len();
+  if (len == 0) {
+    value.set_string("");
+    return RC::SUCCESS;
+  }
+
+  if (!ref.overflow()) {
+    value.set_string(record_data + ref.location, len);
+    return RC::SUCCESS;
+  }
+
+  std::string data(len, '\0');
+  RC          rc = record_handler_->read_overflow(ref.location, len, data.data());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read overflow data. table=%s, field=%s, first page=%d, len=%d, rc=%s",
+             name(), field.name(), ref.location, len, strrc(rc));
+    return rc;
+  }
+  value.set_string(data.data(), len);
+  return RC::SUCCESS;
+}
+
+RC Table::make_stored_record(const Record &record, Record &stored)
+{
+  if (!table_meta_.variable_length()) {
+    stored.set_data(const_cast<char *>(record.data()), table_meta_.record_size());
+    return RC::SUCCESS;
+  }
+
+  if (record.len() <= MAX_INLINE_RECORD_SIZE) {
+    stored.set_data(const_cast<char *>(record.data()), record.len());
+    return RC::SUCCESS;
+  }
+
+  const char                                           *data = record.data();
+  std::vector<std::pair<const FieldMeta *, VarcharRef>> refs;
+  for (const FieldMeta &field : *table_meta_.field_metas()) {
+    if (field.type() == VARCHARS) {
+      VarcharRef ref;
+      memcpy(&ref, data + field.offset(), sizeof(ref));
+      refs.emplace_back(&field, ref);
+    }
+  }
+  std::stable_sort(refs.begin(), refs.end(), [](const auto &left, const auto &right) {
+    return left.second.data_len() > right.second.data_len();
+  });
+
+  RC                   rc          = RC::SUCCESS;
+  int                  stored_len  = record.len();
+  std::vector<PageNum> spilled_pages;
+  for (auto &[field, ref] : refs) {
+    if (stored_len <= MAX_INLINE_RECORD_SIZE) {
+      break;
+    }
+    if (ref.overflow() || ref.data_len() == 0) {
+      continue;
+    }
+
+    PageNum first_page = BP_INVALID_PAGE_NUM;
+    rc                 = record_handler_->insert_overflow(data + ref.location, ref.data_len(), first_page);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert overflow data. table=%s, field=%s, rc=%s", name(), field->name(), strrc(rc));
+      delete_overflow_pages(spilled_pages);
+      return rc;
+    }
+
+    spilled_pages.push_back(first_page);
+    stored_len -= ref.data_len();
+    ref.length   = ref.data_len() | VarcharRef::OVERFLOW_FLAG;
+    ref.location = first_page;
+  }
+
+  // 重新拼装记录，留在记录中的字段依次放在定长部分的后面
+  char *stored_data = (char *)malloc(record.len());
+  ASSERT(nullptr != stored_data, "failed to malloc memory. record data size=%d", record.len());
+  memcpy(stored_data, data, table_meta_.record_size());
+
+  int offset = table_meta_.record_size();
+  for (auto &[field, ref] : refs) {
+    if (!ref.overflow()) {
+      memcpy(stored_data + offset, data + ref.location, ref.data_len());
+      ref.location = offset;
+      offset += ref.data_len();
+    }
+    memcpy(stored_data + field->offset(), &ref, sizeof(ref));
+  }
+
+  stored.set_data_owner(stored_data, offset);
+  return RC::SUCCESS;
+}
+
+void Table::overflow_pages_of(const char *record, std::vector<PageNum> &first_pages) const
+{
+  if (!table_meta_.variable_length()) {
+    return;
+  }
+
+  for (const FieldMeta &field : *table_meta_.field_metas()) {
+    if (field.type() != VARCHARS) {
+      continue;
+    }
+
+    VarcharRef ref;
+    memcpy(&ref, record + field.offset(), sizeof(ref));
+    if (ref.overflow()) {
+      first_pages.push_back(ref.location);
+    }
+  }
+}
+
+void Table::delete_overflow_pages(const std::vector<PageNum> &first_pages)
+{
+  for (PageNum first_page : first_pages) {
+    RC rc = record_handler_->delete_overflow(first_page);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to delete overflow pages. table=%s, first page=%d, rc=%s", name(), first_page, strrc(rc));
+    }
+  }
+}
+
 const char *Table::name() const { return table_meta_.name(); }
 
 const TableMeta &Table::table_meta() const { return table_meta_; }
 
+bool Table::readonly() const { return data_buffer_pool_ != nullptr && data_buffer_pool_->readonly(); }
+
+bool Table::writable() const { return data_buffer_pool_ != nullptr && data_buffer_pool_->writable(); }
+
 RC Table::make_record(int value_num, const Value *values, Record &record)
 {
   // 检查字段类型是否一致
@@ -271,21 +838,37 @@ RC Table::make_record(int value_num, const Value *values, Record &record)
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
     const Value     &value = values[i];
-    if (field->type() != value.attr_type()) {
+    if (field->type() != value.attr_type() && !(field->type() == VARCHARS && value.attr_type() == CHARS)) {
       LOG_ERROR("Invalid value type. table name =%s, field name=%s, type=%d, but given=%d",
                 table_meta_.name(), field->name(), field->type(), value.attr_type());
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
   }
 
-  // 复制所有字段的值
-  int   record_size = table_meta_.record_size();
+  // 复制所有字段的值，变长字段的数据依次放在定长部分的后面
+  int record_size = table_meta_.record_size();
+  for (int i = 0; i < value_num; i++) {
+    const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
+    if (field->type() == VARCHARS) {
+      record_size += std::min(values[i].length(), field->len());
+    }
+  }
   char *record_data = (char *)malloc(record_size);
 
+  int varchar_offset = table_meta_.record_size();
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field    = table_meta_.field(i + normal_field_start_index);
     const Value     &value    = values[i];
     size_t           copy_len = field->len();
+    if (field->type() == VARCHARS) {
+      VarcharRef ref;
+      ref.location = varchar_offset;
+      ref.length   = std::min(value.length(), field->len());
+      memcpy(record_data + varchar_offset, value.data(), ref.length);
+      memcpy(record_data + field->offset(), &ref, sizeof(ref));
+      varchar_offset += ref.length;
+      continue;
+    }
     if (field->type() == CHARS) {
       const size_t data_len = value.length();
       if (copy_len > data_len) {
@@ -309,11 +892,49 @@ RC Table::init_record_handler(const char *base_dir)
     return rc;
   }
 
+  // 只读的表不会插入记录，不需要空闲空间表。老版本创建的表没有空闲空间表文件，这里创建一个，打开时会扫描数据文件重建
+  if (!data_buffer_pool_->readonly()) {
+    std::string fsm_file = table_fsm_file(base_dir, table_meta_.name());
+    if (0 != access(fsm_file.c_str(), F_OK)) {
+      rc = BufferPoolManager::instance().create_file(fsm_file.c_str());
+    }
+    if (OB_SUCC(rc)) {
+      rc = BufferPoolManager::instance().open_file(fsm_file.c_str(), fsm_buffer_pool_);
+    }
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to open disk buffer pool for file:%s. rc=%s", fsm_file.c_str(), strrc(rc));
+      data_buffer_pool_->close_file();
+      data_buffer_pool_ = nullptr;
+      return rc;
+    }
+  }
+
   record_handler_ = new RecordFileHandler();
 
-  rc = record_handler_->init(data_buffer_pool_);
+  RecordFormat          format = table_meta_.variable_length() ? RecordFormat::VARIABLE : RecordFormat::FIXED;
+  std::vector<int>      column_lens;
+  std::vector<AttrType> column_types;
+  if (table_meta_.storage_format() == StorageFormat::PAX) {
+    format = RecordFormat::PAX;
+    for (const FieldMeta &field : *table_meta_.field_metas()) {
+      column_lens.push_back(field.storage_len());
+    }
+  }
+
+  // 系统字段(事务的版本号)会原地修改，不压缩
+  if (table_meta_.compression()) {
+    const std::vector<FieldMeta> &field_metas = *table_meta_.field_metas();
+    for (int i = 0; i < table_meta_.field_num(); i++) {
+      column_types.push_back(i < table_meta_.sys_field_num() ? UNDEFINED : field_metas[i].type());
+    }
+  }
+  rc = record_handler_->init(data_buffer_pool_, fsm_buffer_pool_, format, column_lens, column_types);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init record handler. rc=%s", strrc(rc));
+    if (fsm_buffer_pool_ != nullptr) {
+      fsm_buffer_pool_->close_file();
+      fsm_buffer_pool_ = nullptr;
+    }
     data_buffer_pool_->close_file();
     data_buffer_pool_ = nullptr;
     delete record_handler_;
@@ -321,12 +942,42 @@ RC Table::init_record_handler(const char *base_dir)
     return rc;
   }
 
+  // 区域映射只记录定长的整数类型的字段，与扫描时下推的过滤条件(参考 ColumnFilter)一致
+  if (table_meta_.zone_map()) {
+    const std::vector<FieldMeta> &field_metas = *table_meta_.field_metas();
+    std::vector<ZoneMapColumn>    columns;
+    for (int i = table_meta_.sys_field_num(); i < table_meta_.field_num(); i++) {
+      const FieldMeta &field = field_metas[i];
+      if (field.type() == INTS || field.type() == DATES) {
+        columns.push_back(ZoneMapColumn{i, field.offset(), field.type()});
+      }
+    }
+
+    rc = record_handler_->init_zone_map(columns);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init zone map, scan without it. table=%s, rc=%s", name(), strrc(rc));
+      rc = RC::SUCCESS;
+    }
+  }
+
   return rc;
 }
 
-RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly)
+RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly,
+    const ColumnScanSpec *column_spec /*=nullptr*/, PageNum start_page /*=0*/, PageNum end_page /*=BP_INVALID_PAGE_NUM*/)
 {
-  RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr);
+  ColumnScanSpec spec;
+  if (column_spec != nullptr && !column_spec->columns.empty()) {
+    // 事务需要读取系统字段判断记录的可见性
+    spec = *column_spec;
+    for (int i = 0; i < table_meta_.sys_field_num(); i++) {
+      spec.columns.push_back(i);
+    }
+    column_spec = &spec;
+  }
+
+  RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr, column_spec, &record_handler_->zone_map(),
+      start_page, end_page);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
   }
@@ -335,6 +986,8 @@ RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly
 
 RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name)
 {
+  std::shared_lock<common::RecursiveSharedMutex> guard(latch_);
+
   if (common::is_blank(index_name) || nullptr == field_meta) {
     LOG_INFO("Invalid input arguments, table name is %s, index_name is blank or attribute_name is blank", name());
     return RC::INVALID_ARGUMENT;
@@ -369,20 +1022,12 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
     return rc;
   }
 
-  Record record;
-  while (scanner.has_next()) {
-    rc = scanner.next(record);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to scan records while creating index. table=%s, index=%s, rc=%s",
-               name(), index_name, strrc(rc));
-      return rc;
-    }
-    rc = index->insert_entry(record.data(), &record.rid());
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to insert record into index while creating index. table=%s, index=%s, rc=%s",
-               name(), index_name, strrc(rc));
-      return rc;
-    }
+  // 表中已有的数据通过排序后自底向上批量构建索引，不再逐条插入
+  rc = index->bulk_load(scanner);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to load records into index while creating index. table=%s, index=%s, rc=%s",
+             name(), index_name, strrc(rc));
+    return rc;
   }
   scanner.close_scan();
   LOG_INFO("inserted all records into new index. table=%s, index=%s", name(), index_name);
@@ -439,7 +1084,14 @@ RC Table::delete_record(const Record &record)
            "failed to delete entry from index. table name=%s, index name=%s, rid=%s, rc=%s",
            name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
   }
+
+  // 删除之后页面上的数据可能会被覆盖，先把溢出页面记下来
+  std::vector<PageNum> overflow_pages;
+  overflow_pages_of(record.data(), overflow_pages);
   rc = record_handler_->delete_record(&record.rid());
+  if (OB_SUCC(rc)) {
+    delete_overflow_pages(overflow_pages);
+  }
   return rc;
 }
 
@@ -14,6 +14,9 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/mutex.h"
+#include "common/types.h"
+#include "storage/buffer/page.h"
 #include "storage/table/table_meta.h"
 #include <functional>
 
@@ -22,6 +25,7 @@ class Record;
 class DiskBufferPool;
 class RecordFileHandler;
 class RecordFileScanner;
+struct ColumnScanSpec;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
@@ -29,6 +33,16 @@ class IndexScanner;
 class RecordDeleter;
 class Trx;
 
+/**
+ * @brief 整理表的结果，参考 Table::vacuum
+ */
+struct VacuumStat
+{
+  int64_t purged_records = 0;  ///< 清理掉的已经删除的旧版本记录
+  int64_t moved_records  = 0;  ///< 从稀疏的页面搬到其它页面的记录
+  int     released_pages = 0;  ///< 还给文件的空页面
+};
+
 /**
  * @brief 表
  *
@@ -46,9 +60,10 @@ public:
    * @param base_dir 表数据存放的路径
    * @param attribute_count 字段个数
    * @param attributes 字段
+   * @param options 表的选项，比如数据的存储格式
    */
   RC create(int32_t table_id, const char *path, const char *name, const char *base_dir, int attribute_count,
-      const AttrInfoSqlNode attributes[]);
+      const AttrInfoSqlNode attributes[], const TableOptions &options = {});
 
   /**
    * 打开一个表
@@ -72,18 +87,99 @@ public:
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
    */
   RC insert_record(Record &record);
+
+  /**
+   * @brief 批量导入记录
+   * @details 导入大量数据时使用，参考 RecordBulkLoader。先把所有记录写到新的数据页面中，再依次插入每个索引的数据。
+   * 与逐条调用 insert_record 的效果一样：按照顺序插入，遇到第一个失败的记录(比如唯一索引键值重复)就停止，
+   * 这条记录和之后的记录都不会插入
+   * @param records[in/out] 要插入的记录，插入成功的记录通过 rid 返回位置
+   * @param inserted 返回成功插入了前面多少条记录
+   */
+  RC insert_records(std::vector<Record> &records, int &inserted);
   RC delete_record(const Record &record);
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 把记录上原地做的修改写回到数据文件中
+   * @details 行存的表扫描时拿到的记录直接指向页面，修改已经生效，不需要做任何事情。
+   * PAX 格式的表拿到的是记录的拷贝，需要写回去。记录的长度不能改变
+   */
+  RC write_back_record(const Record &record);
+
+  /**
+   * @brief 获取记录实际存放在数据文件中的样子
+   * @details 长字段放到溢出页面中的记录需要从数据文件中读出来，其它情况下 stored 直接引用 record 的数据
+   * @param record 已经插入的完整记录
+   */
+  RC get_stored_record(const Record &record, Record &stored);
+
+  /**
+   * @brief 按照链表的顺序访问记录中长字段占用的所有溢出页面，参考 RecordFileHandler::visit_overflow
+   * @param stored 实际存放的记录
+   */
+  RC visit_overflow_pages(const Record &stored, const std::function<RC(PageNum, const char *, int)> &visitor);
+
+  /**
+   * @brief 恢复时按照日志重写一个溢出页面，参考 RecordFileHandler::recover_overflow_page
+   */
+  RC recover_overflow_page(PageNum page_num, const char *data, int len);
+
+  /**
+   * @brief 恢复时重做插入记录
+   * @details record 是实际存放的记录，引用的溢出页面已经由前面的日志重写过了，恢复时不会分配新的页面。
+   * 页面和索引可能已经刷到磁盘上了，记录和索引项已经存在时不算错误
+   */
   RC recover_insert_record(Record &record);
 
+  /**
+   * @brief 恢复时重做整理表时的物理删除，记录已经不存在时不算错误
+   * @param delete_overflow 是否同时释放记录占用的溢出页面。搬动记录时新的记录还在引用这些页面
+   */
+  RC recover_delete_record(const RID &rid, bool delete_overflow);
+
+  /**
+   * @brief 恢复时重做整理表时释放页面，页面上还有记录时(已经被重新使用了)不释放
+   */
+  RC recover_release_page(PageNum page_num);
+
+  /**
+   * @brief 整理表，回收删除记录留下的空间
+   * @details 先物理删除所有事务都不会再访问的旧版本记录，再把稀疏页面上的记录搬到其它页面上并修改索引中记录的位置，
+   * 最后把搬空的页面还给文件。搬动记录会改变记录的位置(RID)，整理时拿着表的写锁，其它会话不能访问这张表，参考 latch。
+   * 删除、搬动记录和释放页面都通过 trx 记录日志，释放页面之前先把日志和数据页面写到磁盘上，
+   * 这样恢复时重做插入日志可以找到页面原来的样子
+   *
+   * @param trx  用来判断记录是否还会被其它事务访问，参考 Trx::version_state
+   * @param stat 返回整理的结果
+   */
+  RC vacuum(Trx *trx, VacuumStat &stat);
+
+  /**
+   * @brief 读取记录中一个变长字段(VARCHARS)的值
+   * @details 变长字段的数据可能放在记录中，也可能放在溢出页面中，参考 VarcharRef
+   * @param record_data 记录数据，可以是 make_record 生成的，也可以是从表中读出来的
+   * @param field       变长字段
+   * @param value       返回字段的值，是CHARS类型
+   */
+  RC read_varchar(const char *record_data, const FieldMeta &field, Value &value) const;
+
   // TODO refactor
   RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name);
 
-  RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly);
+  /**
+   * @brief 打开一个全表扫描
+   *
+   * @param column_spec 需要读取的列(字段在表中的下标)和可以提前过滤的条件，只对 PAX 格式的表有效。
+   *                    系统字段总是会读取
+   * @param start_page  只扫描页号在 [start_page, end_page) 之间的数据页面，默认扫描所有的页面
+   */
+  RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly, const ColumnScanSpec *column_spec = nullptr,
+      PageNum start_page = 0, PageNum end_page = BP_INVALID_PAGE_NUM);
 
   RecordFileHandler *record_handler() const { return record_handler_; }
+  DiskBufferPool    *data_buffer_pool() const { return data_buffer_pool_; }
 
 public:
   int32_t     table_id() const { return table_meta_.table_id(); }
@@ -91,9 +187,58 @@ public:
 
   const TableMeta &table_meta() const;
 
+  /**
+   * @brief 表是否是只读的，只读的表不能插入、删除和修改数据，也不能创建索引
+   * @details 参考 BufferPoolManager::set_table_readonly
+   */
+  bool readonly() const;
+
+  /**
+   * @brief 表的数据能否修改，回放日志之前检查
+   * @details 只读的表没有写权限时只能读，参考 DiskBufferPool::writable。索引文件与数据文件在同一个目录下，权限相同
+   */
+  bool writable() const;
+
   RC sync();
 
+  /**
+   * @brief 表级别的读写锁
+   * @details 扫描和插入记录时加读锁，整理表搬动记录时加写锁，避免扫描时记录的位置发生变化。
+   * 读锁可以递归加锁，同一个语句中可以多次扫描同一张表
+   */
+  common::RecursiveSharedMutex &latch() { return latch_; }
+
 private:
+  /**
+   * @brief 生成实际存放到数据文件中的记录
+   * @details 变长记录太长时，从最长的字段开始把数据放到溢出页面中，直到记录足够短。
+   * 不需要转换时 stored 直接引用 record 的数据
+   */
+  RC make_stored_record(const Record &record, Record &stored);
+
+  /**
+   * @brief 找出记录中的字段占用的溢出页面
+   */
+  void overflow_pages_of(const char *record, std::vector<PageNum> &first_pages) const;
+  void delete_overflow_pages(const std::vector<PageNum> &first_pages);
+
+  /**
+   * @brief 物理删除所有事务都不会再访问的旧版本记录
+   */
+  RC purge_dead_records(Trx *trx, VacuumStat &stat);
+
+  /**
+   * @brief 把稀疏页面上的记录搬到其它页面上，释放搬空的页面
+   */
+  RC compact_pages(Trx *trx, VacuumStat &stat);
+
+  /**
+   * @brief 把一条记录搬到其它页面上，同时修改索引中记录的位置
+   * @param record  从数据文件中读出来的记录的拷贝，长字段还在原来的溢出页面中，不需要搬动
+   * @param new_rid 返回记录新的位置
+   */
+  RC move_record(const Record &record, RID &new_rid);
+
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
 
@@ -108,6 +253,9 @@ private:
   std::string          base_dir_;
   TableMeta            table_meta_;
   DiskBufferPool      *data_buffer_pool_ = nullptr;  /// 数据文件关联的buffer pool
+  DiskBufferPool      *fsm_buffer_pool_  = nullptr;  /// 空闲空间表文件关联的buffer pool，只读的表没有
   RecordFileHandler   *record_handler_   = nullptr;  /// 记录操作
   std::vector<Index *> indexes_;
+
+  common::RecursiveSharedMutex latch_;  /// 参考 latch()
 };
@@ -26,12 +26,31 @@ static const Json::StaticString FIELD_TABLE_ID("table_id");
 static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
+static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
+static const Json::StaticString FIELD_ZONE_MAP("zone_map");
+static const Json::StaticString FIELD_COMPRESSION("compression");
+
+static const char *STORAGE_FORMAT_NAME[] = {"row", "pax"};
+
+const char *storage_format_to_string(StorageFormat format) { return STORAGE_FORMAT_NAME[static_cast<int>(format)]; }
+
+RC storage_format_from_string(const char *name, StorageFormat &format)
+{
+  for (size_t i = 0; i < sizeof(STORAGE_FORMAT_NAME) / sizeof(STORAGE_FORMAT_NAME[0]); i++) {
+    if (0 == strcasecmp(STORAGE_FORMAT_NAME[i], name)) {
+      format = static_cast<StorageFormat>(i);
+      return RC::SUCCESS;
+    }
+  }
+  return RC::INVALID_ARGUMENT;
+}
 
 TableMeta::TableMeta(const TableMeta &other)
     : table_id_(other.table_id_),
       name_(other.name_),
       fields_(other.fields_),
       indexes_(other.indexes_),
+      options_(other.options_),
       record_size_(other.record_size_)
 {}
 
@@ -40,10 +59,12 @@ void TableMeta::swap(TableMeta &other) noexcept
   name_.swap(other.name_);
   fields_.swap(other.fields_);
   indexes_.swap(other.indexes_);
+  std::swap(options_, other.options_);
   std::swap(record_size_, other.record_size_);
 }
 
-RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[])
+RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+    const TableOptions &options /*={}*/)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Name cannot be empty");
@@ -84,13 +105,20 @@ RC TableMeta::init(int32_t table_id, const char *name, int field_num, const Attr
       return rc;
     }
 
-    field_offset += attr_info.length;
+    field_offset += fields_[i + trx_field_num].storage_len();
   }
 
   record_size_ = field_offset;
 
+  // PAX 页面按照字段的长度划分每一列的空间，只支持定长的字段
+  if (options.storage_format == StorageFormat::PAX && variable_length()) {
+    LOG_ERROR("pax storage format does not support varchar fields. table name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+
   table_id_ = table_id;
   name_     = name;
+  options_  = options;
   LOG_INFO("Sussessfully initialized table meta. table id=%d, name=%s", table_id, name);
   return RC::SUCCESS;
 }
@@ -170,12 +198,21 @@ int TableMeta::index_num() const { return indexes_.size(); }
 
 int TableMeta::record_size() const { return record_size_; }
 
+bool TableMeta::variable_length() const
+{
+  return std::any_of(
+      fields_.begin(), fields_.end(), [](const FieldMeta &field) { return field.type() == AttrType::VARCHARS; });
+}
+
 int TableMeta::serialize(std::ostream &ss) const
 {
 
   Json::Value table_value;
-  table_value[FIELD_TABLE_ID]   = table_id_;
-  table_value[FIELD_TABLE_NAME] = name_;
+  table_value[FIELD_TABLE_ID]       = table_id_;
+  table_value[FIELD_TABLE_NAME]     = name_;
+  table_value[FIELD_STORAGE_FORMAT] = storage_format_to_string(options_.storage_format);
+  table_value[FIELD_ZONE_MAP]       = options_.zone_map;
+  table_value[FIELD_COMPRESSION]    = options_.compression;
 
   Json::Value fields_value;
   for (const FieldMeta &field : fields_) {
@@ -233,6 +270,35 @@ int TableMeta::deserialize(std::istream &is)
 
   std::string table_name = table_name_value.asString();
 
+  // 老版本的表没有记录存储格式，都是行存
+  TableOptions       options;
+  const Json::Value &storage_format_value = table_value[FIELD_STORAGE_FORMAT];
+  if (!storage_format_value.isNull()) {
+    if (!storage_format_value.isString() ||
+        OB_FAIL(storage_format_from_string(storage_format_value.asCString(), options.storage_format))) {
+      LOG_ERROR("Invalid storage format. json value=%s", storage_format_value.toStyledString().c_str());
+      return -1;
+    }
+  }
+
+  const Json::Value &zone_map_value = table_value[FIELD_ZONE_MAP];
+  if (!zone_map_value.isNull()) {
+    if (!zone_map_value.isBool()) {
+      LOG_ERROR("Invalid zone map option. json value=%s", zone_map_value.toStyledString().c_str());
+      return -1;
+    }
+    options.zone_map = zone_map_value.asBool();
+  }
+
+  const Json::Value &compression_value = table_value[FIELD_COMPRESSION];
+  if (!compression_value.isNull()) {
+    if (!compression_value.isBool()) {
+      LOG_ERROR("Invalid compression option. json value=%s", compression_value.toStyledString().c_str());
+      return -1;
+    }
+    options.compression = compression_value.asBool();
+  }
+
   const Json::Value &fields_value = table_value[FIELD_FIELDS];
   if (!fields_value.isArray() || fields_value.size() <= 0) {
     LOG_ERROR("Invalid table meta. fields is not array, json value=%s", fields_value.toStyledString().c_str());
@@ -258,9 +324,10 @@ int TableMeta::deserialize(std::istream &is)
   std::sort(fields.begin(), fields.end(), comparator);
 
   table_id_ = table_id;
+  options_  = options;
   name_.swap(table_name);
   fields_.swap(fields);
-  record_size_ = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
+  record_size_ = fields_.back().offset() + fields_.back().storage_len() - fields_.begin()->offset();
 
   const Json::Value &indexes_value = table_value[FIELD_INDEXES];
   if (!indexes_value.empty()) {
@@ -22,6 +22,32 @@ See the Mulan PSL v2 for more details. */
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 
+/**
+ * @brief 表数据的存储格式
+ */
+enum class StorageFormat
+{
+  ROW,  ///< 行存，一条记录的所有字段连续存放
+  PAX,  ///< PAX(Partition Attributes Across)，页面内同一列的数据连续存放，扫描时只需要读取用到的列
+};
+
+const char *storage_format_to_string(StorageFormat format);
+
+/**
+ * @brief 根据名字(row/pax，不区分大小写)找到存储格式
+ */
+RC storage_format_from_string(const char *name, StorageFormat &format);
+
+/**
+ * @brief 创建表时指定的选项，比如 WITH (format=pax, zone_map=true, compression=true)
+ */
+struct TableOptions
+{
+  StorageFormat storage_format = StorageFormat::ROW;  ///< 数据的存储格式
+  bool          zone_map       = false;               ///< 是否记录每个页面上各列的范围，参考 ZoneMap
+  bool          compression    = false;               ///< PAX 页面写满之后是否压缩，参考 PaxColumnEncoding
+};
+
 /**
  * @brief 表元数据
  *
@@ -36,7 +62,8 @@ public:
 
   void swap(TableMeta &other) noexcept;
 
-  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[]);
+  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+      const TableOptions &options = {});
 
   RC add_index(const IndexMeta &index);
 
@@ -58,8 +85,21 @@ public:
   const IndexMeta *index(int i) const;
   int              index_num() const;
 
+  /**
+   * @brief 记录定长部分的大小，没有varchar字段时就是记录的大小
+   */
   int record_size() const;
 
+  /**
+   * @brief 是否有varchar字段，有的话记录是变长的，数据文件使用变长记录的页面格式
+   */
+  bool variable_length() const;
+
+  const TableOptions &options() const { return options_; }
+  StorageFormat       storage_format() const { return options_.storage_format; }
+  bool                zone_map() const { return options_.zone_map; }
+  bool                compression() const { return options_.compression; }
+
 public:
   int  serialize(std::ostream &os) const override;
   int  deserialize(std::istream &is) override;
@@ -72,6 +112,7 @@ protected:
   std::string            name_;
   std::vector<FieldMeta> fields_;  // 包含sys_fields
   std::vector<IndexMeta> indexes_;
+  TableOptions           options_;
 
   int record_size_ = 0;
 };
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/clog/clog.h"
 #include "storage/db/db.h"
 #include "storage/field/field.h"
+#include <algorithm>
 #include <limits>
 
 using namespace std;
@@ -106,6 +107,22 @@ void MvccTrxKit::all_trxes(std::vector<Trx *> &trxes)
   lock_.unlock();
 }
 
+int32_t MvccTrxKit::min_active_trx_id()
+{
+  // 先取下一个事务号，之后开始的事务的事务号都比它大
+  int32_t min_trx_id = current_trx_id_.load() + 1;
+
+  lock_.lock();
+  for (Trx *trx : trxes_) {
+    auto *mvcc_trx = static_cast<MvccTrx *>(trx);
+    if (mvcc_trx->started()) {
+      min_trx_id = std::min(min_trx_id, mvcc_trx->id());
+    }
+  }
+  lock_.unlock();
+  return min_trx_id;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 MvccTrx::MvccTrx(MvccTrxKit &kit, CLogManager *log_manager) : trx_kit_(kit), log_manager_(log_manager) {}
@@ -133,8 +150,20 @@ RC MvccTrx::insert_record(Table *table, Record &record)
     return rc;
   }
 
-  rc = log_manager_->append_log(
-      CLogType::INSERT, trx_id_, table->table_id(), record.rid(), record.len(), 0 /*offset*/, record.data());
+  // 长字段放在溢出页面中时，先记录溢出页面的内容，插入日志中记录的是实际存放的记录，
+  // 恢复时按照日志中的页号重写这些页面，不会重新分配页面
+  Record stored;
+  rc = table->get_stored_record(record, stored);
+  if (OB_SUCC(rc)) {
+    rc = table->visit_overflow_pages(stored, [this, table](PageNum page_num, const char *data, int len) {
+      return log_manager_->append_log(
+          CLogType::OVERFLOW_PAGE, trx_id_, table->table_id(), RID(page_num, -1), len, 0 /*offset*/, data);
+    });
+  }
+  if (OB_SUCC(rc)) {
+    rc = log_manager_->append_log(
+        CLogType::INSERT, trx_id_, table->table_id(), record.rid(), stored.len(), 0 /*offset*/, stored.data());
+  }
   ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
 
@@ -163,7 +192,12 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   }
 
   end_field.set_int(record, -trx_id_);
-  RC rc = log_manager_->append_log(CLogType::DELETE, trx_id_, table->table_id(), record.rid(), 0, 0, nullptr);
+  RC rc = table->write_back_record(record);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write back record. table=%s, rid=%s, rc=%s", table->name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+  rc = log_manager_->append_log(CLogType::DELETE, trx_id_, table->table_id(), record.rid(), 0, 0, nullptr);
   ASSERT(rc == RC::SUCCESS, "failed to append delete record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
   if (begin_xid == -trx_id_) {
@@ -224,6 +258,51 @@ RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
   return rc;
 }
 
+RecordVersionState MvccTrx::version_state(Table *table, const Record &record)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  const int32_t begin_xid = begin_field.get_int(record);
+  const int32_t end_xid   = end_field.get_int(record);
+  if (begin_xid < 0 || end_xid < 0) {
+    return RecordVersionState::ACTIVE;
+  }
+  if (end_xid != trx_kit_.max_trx_id() && end_xid < trx_kit_.min_active_trx_id()) {
+    return RecordVersionState::DEAD;
+  }
+  return RecordVersionState::LIVE;
+}
+
+RC MvccTrx::log_purge(Table *table, const RID &rid)
+{
+  return log_manager_->append_log(CLogType::VACUUM_DELETE, trx_id_, table->table_id(), rid, 0, 0, nullptr);
+}
+
+RC MvccTrx::log_move(Table *table, const RID &old_rid, const Record &record)
+{
+  // 一条日志中记录搬动前后的位置，恢复时不会出现只搬了一半的情况
+  vector<char> data(sizeof(old_rid) + record.len());
+  memcpy(data.data(), &old_rid, sizeof(old_rid));
+  memcpy(data.data() + sizeof(old_rid), record.data(), record.len());
+  return log_manager_->append_log(CLogType::VACUUM_MOVE,
+      trx_id_,
+      table->table_id(),
+      record.rid(),
+      static_cast<int32_t>(data.size()),
+      0 /*offset*/,
+      data.data());
+}
+
+RC MvccTrx::log_release_page(Table *table, PageNum page_num)
+{
+  return log_manager_->append_log(
+      CLogType::VACUUM_RELEASE, trx_id_, table->table_id(), RID(page_num, -1), 0, 0, nullptr);
+}
+
+RC MvccTrx::sync_log() { return log_manager_->sync(); }
+
 /**
  * @brief 获取指定表上的事务使用的字段
  *
@@ -268,6 +347,14 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
   RC rc    = RC::SUCCESS;
   started_ = false;
 
+  // 先写提交日志再修改记录。记录修改之后整理表就可能搬动它，搬动的日志必须在提交日志的后面，
+  // 否则恢复时提交日志找不到原来位置上的记录
+  RC log_rc = RC::SUCCESS;
+  if (!recovering_) {
+    log_rc = log_manager_->commit_trx(trx_id_, commit_xid);
+  }
+  LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(log_rc));
+
   for (const Operation &operation : operations_) {
     switch (operation.type()) {
       case Operation::Type::INSERT: {
@@ -319,12 +406,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
   }
 
   operations_.clear();
-
-  if (!recovering_) {
-    rc = log_manager_->commit_trx(trx_id_, commit_xid);
-  }
-  LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
-  return rc;
+  return log_rc;
 }
 
 RC MvccTrx::rollback()
@@ -332,6 +414,13 @@ RC MvccTrx::rollback()
   RC rc    = RC::SUCCESS;
   started_ = false;
 
+  // 与提交一样，先写日志再修改记录
+  RC log_rc = RC::SUCCESS;
+  if (!recovering_) {
+    log_rc = log_manager_->rollback_trx(trx_id_);
+  }
+  LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(log_rc));
+
   for (const Operation &operation : operations_) {
     switch (operation.type()) {
       case Operation::Type::INSERT: {
@@ -379,19 +468,18 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
-
-  if (!recovering_) {
-    rc = log_manager_->rollback_trx(trx_id_);
-  }
-  LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(rc));
-  return rc;
+  return log_rc;
 }
 
 RC find_table(Db *db, const CLogRecord &log_record, Table *&table)
 {
   switch (clog_type_from_integer(log_record.header().type_)) {
     case CLogType::INSERT:
-    case CLogType::DELETE: {
+    case CLogType::DELETE:
+    case CLogType::VACUUM_DELETE:
+    case CLogType::VACUUM_MOVE:
+    case CLogType::VACUUM_RELEASE:
+    case CLogType::OVERFLOW_PAGE: {
       const CLogRecordData &data_record = log_record.data_record();
       table                             = db->find_table(data_record.table_id_);
       if (nullptr == table) {
@@ -399,6 +487,11 @@ RC find_table(Db *db, const CLogRecord &log_record, Table *&table)
                  data_record.table_id_, log_record.to_string().c_str());
         return RC::SCHEMA_TABLE_NOT_EXIST;
       }
+      if (!table->writable()) {
+        LOG_ERROR("table is mapped without write permission, cannot redo. table=%s, log record=%s",
+                  table->name(), log_record.to_string().c_str());
+        return RC::BUFFERPOOL_READONLY;
+      }
     } break;
     default: {
       // do nothing
@@ -445,13 +538,79 @@ RC MvccTrx::redo(Db *db, const CLogRecord &log_record)
         end_field.set_int(record, -trx_id_);
       };
 
-      RC rc = table->visit_record(data_record.rid_, false /*readonly*/, record_updater);
+      // 与 delete_record 一样，当前事务自己插入的记录直接删除。溢出页面也在这里释放，之后的日志可能会重新使用它们
+      Record record;
+      RC     rc = table->get_record(data_record.rid_, record);
+      ASSERT(rc == RC::SUCCESS, "failed to get record while recovering delete. rid=%s, rc=%s",
+             data_record.rid_.to_string().c_str(), strrc(rc));
+      if (begin_field.get_int(record) == -trx_id_) {
+        operations_.erase(Operation(Operation::Type::INSERT, table, data_record.rid_));
+        rc = table->delete_record(record);
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to recover delete. table=%s, log record=%s, rc=%s",
+                   table->name(), log_record.to_string().c_str(), strrc(rc));
+          return rc;
+        }
+        break;
+      }
+
+      rc = table->visit_record(data_record.rid_, false /*readonly*/, record_updater);
       ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
              data_record.rid_.to_string().c_str(), strrc(rc));
 
       operations_.insert(Operation(Operation::Type::DELETE, table, data_record.rid_));
     } break;
 
+    case CLogType::VACUUM_DELETE: {
+      RC rc = table->recover_delete_record(log_record.data_record().rid_, true /*delete_overflow*/);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to recover purge. table=%s, log record=%s, rc=%s",
+                 table->name(), log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
+    case CLogType::VACUUM_MOVE: {
+      // 日志数据的前面是搬动之前的位置，参考 log_move
+      const CLogRecordData &data_record = log_record.data_record();
+      RID                   old_rid;
+      memcpy(&old_rid, data_record.data_, sizeof(old_rid));
+
+      Record record;
+      record.set_data(data_record.data_ + sizeof(old_rid), data_record.data_len_ - static_cast<int>(sizeof(old_rid)));
+      record.set_rid(data_record.rid_);
+
+      RC rc = table->recover_delete_record(old_rid, false /*delete_overflow*/);
+      if (OB_SUCC(rc)) {
+        // 原来的记录已经删掉了，插入失败时不能当作成功，否则这条记录就丢了
+        rc = table->recover_insert_record(record);
+      }
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to recover move. table=%s, log record=%s, rc=%s",
+                 table->name(), log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
+    case CLogType::VACUUM_RELEASE: {
+      RC rc = table->recover_release_page(log_record.data_record().rid_.page_num);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to recover page release. table=%s, log record=%s, rc=%s",
+                 table->name(), log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
+    case CLogType::OVERFLOW_PAGE: {
+      const CLogRecordData &data_record = log_record.data_record();
+      RC rc = table->recover_overflow_page(data_record.rid_.page_num, data_record.data_, data_record.data_len_);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to recover overflow page. table=%s, log record=%s, rc=%s",
+                 table->name(), log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
     case CLogType::MTR_COMMIT: {
       const CLogRecordCommitData &commit_record = log_record.commit_record();
       commit_with_trx_id(commit_record.commit_xid_);
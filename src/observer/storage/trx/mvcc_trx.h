@@ -45,6 +45,12 @@ public:
 public:
   int32_t max_trx_id() const;
 
+  /**
+   * @brief 所有正在执行的事务中最小的事务号，没有正在执行的事务时返回下一个事务号
+   * @details 之后开始的事务的事务号都更大，所以在这个事务号之前提交的删除，已经没有事务能看到被删除的记录了
+   */
+  int32_t min_active_trx_id();
+
 private:
   std::vector<FieldMeta> fields_;  // 存储事务数据需要用到的字段元数据，所有表结构都需要带的
 
@@ -81,6 +87,22 @@ public:
    */
   RC visit_record(Table *table, Record &record, bool readonly) override;
 
+  /**
+   * @brief 整理表时判断一条记录的状态
+   * @details 还没有提交的插入和删除，事务中记录了它们的位置，不能移动。
+   * 删除已经提交，并且所有正在执行的事务都在删除之后开始的，记录就不会再被访问了
+   */
+  RecordVersionState version_state(Table *table, const Record &record) override;
+
+  /**
+   * @brief 整理表的日志
+   * @details 搬动记录的日志中放的是完整的记录，长字段不在溢出页面中，溢出页面没有日志
+   */
+  RC log_purge(Table *table, const RID &rid) override;
+  RC log_move(Table *table, const RID &old_rid, const Record &record) override;
+  RC log_release_page(Table *table, PageNum page_num) override;
+  RC sync_log() override;
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -89,6 +111,11 @@ public:
 
   int32_t id() const override { return trx_id_; }
 
+  /**
+   * @brief 事务是否已经开始，事务号只在开始之后才有效
+   */
+  bool started() const { return started_; }
+
 private:
   RC   commit_with_trx_id(int32_t commit_id);
   void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
@@ -90,6 +90,18 @@ public:
   }
 };
 
+/**
+ * @brief 整理表时一条记录的状态
+ * @ingroup Transaction
+ * @details 参考 Trx::version_state 和 Table::vacuum
+ */
+enum class RecordVersionState
+{
+  LIVE,    ///< 可以移动到其它位置，不影响任何事务
+  ACTIVE,  ///< 正在被还没有结束的事务修改，事务记录了它的位置，不能移动
+  DEAD,    ///< 已经删除，并且对所有的事务都不可见，可以直接清理掉
+};
+
 /**
  * @brief 事务管理器
  * @ingroup Transaction
@@ -141,6 +153,26 @@ public:
   virtual RC delete_record(Table *table, Record &record)               = 0;
   virtual RC visit_record(Table *table, Record &record, bool readonly) = 0;
 
+  /**
+   * @brief 整理表时判断一条记录的状态
+   * @details 与 visit_record 不同，这里不关心记录对当前事务是否可见，只关心还有没有事务会访问它
+   */
+  virtual RecordVersionState version_state(Table *table, const Record &record) = 0;
+
+  /**
+   * @brief 记录整理表时对数据做的物理修改
+   * @details 整理只改变记录存放的位置，不改变记录的内容和可见性，恢复时按照日志再做一遍。
+   * 不记录日志的事务模型不需要实现。参考 Table::vacuum
+   */
+  virtual RC log_purge(Table *table, const RID &rid);
+  virtual RC log_move(Table *table, const RID &old_rid, const Record &record);
+  virtual RC log_release_page(Table *table, PageNum page_num);
+
+  /**
+   * @brief 把已经记录的日志写到磁盘上
+   */
+  virtual RC sync_log();
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
@@ -44,6 +44,12 @@ public:
   RC insert_record(Table *table, Record &record) override;
   RC delete_record(Table *table, Record &record) override;
   RC visit_record(Table *table, Record &record, bool readonly) override;
+
+  /**
+   * @brief 没有事务时删除就是直接删除记录，页面上的记录都可以移动
+   */
+  RecordVersionState version_state(Table *table, const Record &record) override { return RecordVersionState::LIVE; }
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
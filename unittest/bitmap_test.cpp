@@ -16,7 +16,9 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/bitmap.h"
 #include "gtest/gtest.h"
+#include <random>
 #include <sstream>
+#include <vector>
 
 using namespace common;
 
@@ -67,6 +69,51 @@ TEST(test_bitmap, test_bitmap)
   ASSERT_EQ(16, bitmap3.next_setted_bit(8));
 }
 
+TEST(test_bitmap, test_find_next_bit)
+{
+  using FindNextBitFunc = int (*)(const char *, int, int, bool);
+  const FindNextBitFunc funcs[] = {find_next_bit, find_next_bit_wordwise, find_next_bit_avx2};
+
+  std::mt19937 random(20261017);
+  for (int size : {1, 7, 8, 9, 63, 64, 65, 255, 256, 257, 1000, 4096, 10000}) {
+    std::vector<char> buf((size + 7) / 8 + 64);
+    for (int density : {0, 1, 50, 99, 100}) {
+      // 位图后面的内存是随机的，不能影响查找结果
+      for (char &c : buf) {
+        c = static_cast<char>(random());
+      }
+      Bitmap bitmap(buf.data(), size);
+      for (int i = 0; i < size; i++) {
+        if (static_cast<int>(random() % 100) < density) {
+          bitmap.set_bit(i);
+        } else {
+          bitmap.clear_bit(i);
+        }
+      }
+
+      // 遍历所有为1的位
+      for (int start : {0, 1, size / 2}) {
+        SettedBitIterator iterator(buf.data(), size, start);
+        for (int expected = find_next_bit_bytewise(buf.data(), size, start, true); expected >= 0;
+             expected     = find_next_bit_bytewise(buf.data(), size, expected + 1, true)) {
+          ASSERT_EQ(expected, iterator.next()) << "size=" << size << ", density=" << density << ", start=" << start;
+        }
+        ASSERT_EQ(-1, iterator.next());
+      }
+
+      for (int start = 0; start <= size; start += (size < 300 ? 1 : 13)) {
+        for (bool setted : {true, false}) {
+          const int expected = find_next_bit_bytewise(buf.data(), size, start, setted);
+          for (FindNextBitFunc func : funcs) {
+            ASSERT_EQ(expected, func(buf.data(), size, start, setted))
+                << "size=" << size << ", density=" << density << ", start=" << start << ", setted=" << setted;
+          }
+        }
+      }
+    }
+  }
+}
+
 int main(int argc, char **argv)
 {
   // 分析gtest程序的命令行参数
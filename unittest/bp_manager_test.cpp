@@ -12,6 +12,15 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021
 //
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
 #include "storage/buffer/disk_buffer_pool.h"
 #include "gtest/gtest.h"
 
@@ -125,6 +134,846 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_frame_manager, test_frame_manager_simple_2q)
+{
+  BPFrameManager frame_manager("Test");
+  frame_manager.init(2, "2q");
+
+  test_get(frame_manager);
+
+  test_alloc(frame_manager);
+
+  frame_manager.cleanup();
+}
+
+TEST(test_frame_manager, test_frame_manager_evict_clean_frames)
+{
+  BPFrameManager frame_manager("Test");
+  frame_manager.init(2);
+
+  const int file_desc = 0;
+  const int frame_num = static_cast<int>(frame_manager.total_frame_num());
+  for (PageNum page_num = 0; page_num < frame_num; page_num++) {
+    Frame *frame = frame_manager.alloc(file_desc, page_num);
+    ASSERT_NE(frame, nullptr);
+    frame->set_file_desc(file_desc);
+    if (page_num % 2 == 0) {
+      frame->mark_dirty();
+    }
+    frame->unpin();
+  }
+  ASSERT_EQ(nullptr, frame_manager.alloc(file_desc, frame_num));
+
+  // 脏页和被pin住的页面都不会被淘汰
+  Frame *pinned_frame = frame_manager.get(file_desc, 1);
+  ASSERT_NE(pinned_frame, nullptr);
+
+  const int clean_num = frame_num / 2;
+  ASSERT_EQ(clean_num - 1, frame_manager.evict_clean_frames(frame_num));
+  ASSERT_EQ(0, frame_manager.evict_clean_frames(frame_num));
+  ASSERT_EQ(static_cast<size_t>(frame_num - clean_num + 1), frame_manager.frame_num());
+
+  for (PageNum page_num = 0; page_num < frame_num; page_num += 2) {
+    Frame *frame = frame_manager.get(file_desc, page_num);
+    ASSERT_NE(frame, nullptr);
+    ASSERT_TRUE(frame->dirty());
+    frame->clear_dirty();
+    frame->unpin();
+  }
+  pinned_frame->unpin();
+
+  ASSERT_EQ(frame_num - clean_num + 1, frame_manager.evict_clean_frames(frame_num));
+  ASSERT_EQ(0, static_cast<int>(frame_manager.frame_num()));
+  ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+}
+
+void test_read_ahead(const char *page_io_name)
+{
+  const char *file_name = "test_read_ahead.bp";
+  ::remove(file_name);
+
+  const int page_num = 100;
+  {
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.set_page_io(page_io_name));
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    PageNum last_page = BP_HEADER_PAGE;
+    for (int i = 1; i < page_num; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      ASSERT_GT(frame->page_num(), last_page);
+      last_page = frame->page_num();
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", last_page);
+      frame->mark_dirty();
+      bp->unpin_page(frame);
+    }
+
+    // 中间留一些空洞，预读时需要跳过
+    for (int i = 10; i < 20; i++) {
+      ASSERT_EQ(RC::SUCCESS, bp->dispose_page(i));
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  {
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.set_page_io(page_io_name));
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+
+    bp->read_ahead(5, 200);
+    bp->hint_sequential(1);
+    BufferPoolIterator iterator;
+    iterator.init(*bp);
+    int count = 0;
+    while (iterator.has_next()) {
+      PageNum page = iterator.next();
+      ASSERT_TRUE(page < 10 || page >= 20);
+
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+      ASSERT_EQ(page, frame->page_num());
+      ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+      bp->unpin_page(frame);
+      count++;
+    }
+    ASSERT_EQ(page_num - 1 - 10, count);
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_read_ahead)
+{
+  test_read_ahead("sync");
+  test_read_ahead("io_uring");
+}
+
+/**
+ * @brief 使用迭代器列出所有已经分配的页面
+ */
+std::vector<PageNum> list_pages(DiskBufferPool &bp)
+{
+  std::vector<PageNum> pages;
+  BufferPoolIterator   iterator;
+  iterator.init(bp);
+  while (iterator.has_next()) {
+    pages.push_back(iterator.next());
+  }
+  return pages;
+}
+
+TEST(test_buffer_pool, test_allocate_page)
+{
+  const char *file_name = "test_allocate_page.bp";
+  ::remove(file_name);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  const int            page_num = BP_EXTENT_PAGE_NUM * 3;
+  std::vector<PageNum> pages;
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (int i = 0; i < page_num; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+
+    // 文件头之后的第一个页面是第一个分配出去的页面
+    ASSERT_EQ(BP_HEADER_PAGE + 1, pages.front());
+    ASSERT_EQ(pages, list_pages(*bp));
+
+    // 释放的页面会优先分配出去
+    for (int i = 10; i < 20; i++) {
+      ASSERT_EQ(RC::SUCCESS, bp->dispose_page(pages[i]));
+    }
+    std::vector<PageNum> disposed(pages.begin() + 10, pages.begin() + 20);
+    pages.erase(pages.begin() + 10, pages.begin() + 20);
+    ASSERT_EQ(pages, list_pages(*bp));
+
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(disposed.front(), frame->page_num());
+    snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+    pages.insert(pages.begin() + 10, frame->page_num());
+    bp->unpin_page(frame);
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_EQ(pages, list_pages(*bp));
+    for (PageNum page : pages) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+      ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+      bp->unpin_page(frame);
+    }
+
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(pages.end(), std::find(pages.begin(), pages.end(), frame->page_num()));
+    bp->unpin_page(frame);
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_page_groups)
+{
+  const char *file_name = "test_page_groups.bp";
+  ::remove(file_name);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  // 回放日志时会直接恢复后面分组中的页面，中间的分组都会创建出来
+  const PageNum far_page = BP_GROUP_PAGE_NUM * 2 + 5;
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_EQ(RC::SUCCESS, bp->recover_page(far_page));
+    ASSERT_EQ(std::vector<PageNum>{far_page}, list_pages(*bp));
+
+    // 扩展之后文件的长度要能放下所有的页面，即使这些页面还没有写过
+    struct stat st;
+    ASSERT_EQ(0, ::stat(file_name, &st));
+    ASSERT_GE(st.st_size, (off_t)bp->page_count() * BP_PAGE_SIZE);
+
+    // 前面的分组中还有空闲页面
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(BP_HEADER_PAGE + 1, frame->page_num());
+    bp->unpin_page(frame);
+    ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_EQ((std::vector<PageNum>{BP_HEADER_PAGE + 1, far_page}), list_pages(*bp));
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_upgrade_file)
+{
+  const char *file_name = "test_upgrade_file.bp";
+  ::remove(file_name);
+
+  // 老格式的文件：文件头中直接存放页面位图，第5个页面是释放掉的
+  const int page_num = 10;
+  {
+    int fd = ::open(file_name, O_RDWR | O_CREAT, 0644);
+    ASSERT_GE(fd, 0);
+    for (PageNum i = 0; i < page_num; i++) {
+      Page page;
+      memset(&page, 0, sizeof(page));
+      page.page_num = i;
+      if (i == BP_HEADER_PAGE) {
+        int32_t *counts = reinterpret_cast<int32_t *>(page.data);
+        counts[0]       = page_num;
+        counts[1]       = page_num - 1;
+        char *bitmap    = page.data + sizeof(int32_t) * 2;
+        bitmap[0]       = static_cast<char>(0xDF);
+        bitmap[1]       = 0x03;
+      } else {
+        snprintf(page.data, BP_PAGE_DATA_SIZE, "page %d", i);
+      }
+      ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), ::write(fd, &page, sizeof(page)));
+    }
+    ::close(fd);
+  }
+
+  std::vector<PageNum> pages = {1, 2, 3, 4, 6, 7, 8, 9};
+  for (int round = 0; round < 2; round++) {
+    BufferPoolManager bpm;
+    DiskBufferPool   *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_EQ(pages, list_pages(*bp));
+    for (PageNum page : pages) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+      ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+      bp->unpin_page(frame);
+    }
+
+    if (round == 0) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      ASSERT_EQ(5, frame->page_num());
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      bp->unpin_page(frame);
+      pages.insert(pages.begin() + 4, 5);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_concurrent_get_page)
+{
+  const char *file_name = "test_concurrent_get_page.bp";
+  ::remove(file_name);
+
+  // 缓冲池只有一个内存池，页面数比页帧多，访问时会不断地淘汰和加载页面
+  BufferPoolManager bpm(1);
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  const int            page_num = 400;
+  std::vector<PageNum> pages;
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (int i = 0; i < page_num; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+
+  // 一半的线程访问相同的页面，一半的线程访问各自不同的页面
+  const int                thread_num = 8;
+  std::atomic<int>         error_num{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < page_num; i++) {
+          const int index = (t % 2 == 0) ? i : (i * 7 + t * 31) % page_num;
+          PageNum   page  = pages[index];
+          Frame    *frame = nullptr;
+          if (bp->get_this_page(page, &frame) != RC::SUCCESS) {
+            error_num++;
+            continue;
+          }
+          if (frame->page_num() != page || std::string("page ") + std::to_string(page) != frame->data()) {
+            error_num++;
+          }
+          bp->unpin_page(frame);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(0, error_num.load());
+  ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  ::remove(file_name);
+}
+
+/**
+ * @brief 读取 dump_hot_pages 生成的文件
+ */
+std::vector<std::string> read_lines(const char *file_name)
+{
+  std::vector<std::string> lines;
+  std::ifstream            ifs(file_name);
+  std::string              line;
+  while (std::getline(ifs, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+TEST(test_buffer_pool, test_warm_up)
+{
+  const char *file_name = "test_warm_up.bp";
+  const char *dump_file = "test_warm_up.dump";
+  ::remove(file_name);
+  ::remove(dump_file);
+
+  std::vector<PageNum> pages;
+  {
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (int i = 0; i < 100; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  std::vector<std::string> dumped;
+  {
+    BufferPoolManager bpm;
+    DiskBufferPool   *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (size_t i = 0; i < pages.size(); i += 3) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(pages[i], &frame));
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bpm.dump_hot_pages(dump_file));
+    dumped = read_lines(dump_file);
+    ASSERT_GE(dumped.size(), pages.size() / 3);
+    ASSERT_NE(dumped.end(), std::find(dumped.begin(), dumped.end(), std::to_string(pages[3]) + " " + file_name));
+    ASSERT_EQ(dumped.end(), std::find(dumped.begin(), dumped.end(), std::to_string(pages[1]) + " " + file_name));
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  {
+    BufferPoolManager bpm;
+    DiskBufferPool   *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_EQ(RC::SUCCESS, bpm.warm_up(dump_file));
+
+    // 预热之后，内存中的页面和上次保存的一样
+    ASSERT_EQ(RC::SUCCESS, bpm.dump_hot_pages(dump_file));
+    ASSERT_EQ(dumped, read_lines(dump_file));
+
+    for (size_t i = 0; i < pages.size(); i += 3) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(pages[i], &frame));
+      ASSERT_EQ(std::string("page ") + std::to_string(pages[i]), std::string(frame->data()));
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  // 没有预热文件时什么也不做
+  ::remove(dump_file);
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.warm_up(dump_file));
+  ::remove(file_name);
+}
+
+/**
+ * @brief 从统计信息中找到指定的一项
+ */
+std::string stat_value(const std::vector<BufferPoolStatItem> &items, const std::string &scope, const std::string &name)
+{
+  for (const BufferPoolStatItem &item : items) {
+    if (item.scope == scope && item.name == name) {
+      return item.value;
+    }
+  }
+  return "";
+}
+
+TEST(test_buffer_pool, test_stats)
+{
+  const char *file_name = "test_stats.bp";
+  ::remove(file_name);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  std::vector<PageNum> pages;
+  {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (int i = 0; i < 10; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+
+  // 跳着访问，避免触发预读。每个页面第一次访问缺页，第二次命中
+  Frame *pinned_frame = nullptr;
+  for (size_t i = 0; i < pages.size(); i += 2) {
+    for (int round = 0; round < 2; round++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(pages[i], &frame));
+      bp->unpin_page(frame);
+    }
+  }
+  ASSERT_EQ(RC::SUCCESS, bp->get_this_page(pages[0], &pinned_frame));
+  pinned_frame->mark_dirty();
+
+  std::vector<BufferPoolStatItem> items;
+  bpm.collect_stats(items);
+  ASSERT_EQ("6", stat_value(items, file_name, "hits"));
+  ASSERT_EQ("5", stat_value(items, file_name, "misses"));
+  // 打开文件时还读取了文件头和位图页
+  ASSERT_EQ("7", stat_value(items, file_name, "read_pages"));
+  ASSERT_EQ("1", stat_value(items, file_name, "dirty_frames"));
+  ASSERT_NE("-", stat_value(items, file_name, "read_latency_us(p50/p99/max)"));
+
+  // 全局的统计信息包含已经关闭的文件
+  ASSERT_EQ("6", stat_value(items, "global", "hits"));
+  ASSERT_LE(10, std::stol(stat_value(items, "global", "write_pages")));
+  ASSERT_EQ("0", stat_value(items, "global", "evictions"));
+
+  bp->unpin_page(pinned_frame);
+  ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_direct_io)
+{
+  const char *file_name = "test_direct_io.bp";
+  ::remove(file_name);
+
+  std::vector<PageNum> pages;
+  for (int round = 0; round < 2; round++) {
+    BufferPoolManager bpm;
+    bpm.set_direct_io(true);
+    if (round == 0) {
+      ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+    }
+
+    // 文件系统不支持 O_DIRECT 时，会使用普通的读写
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    if (round == 0) {
+      for (int i = 0; i < BP_EXTENT_PAGE_NUM * 2; i++) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+        snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+        frame->mark_dirty();
+        pages.push_back(frame->page_num());
+        bp->unpin_page(frame);
+      }
+      ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+    } else {
+      ASSERT_EQ(pages, list_pages(*bp));
+      for (PageNum page : pages) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+        ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+        bp->unpin_page(frame);
+      }
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_flush_all_pages)
+{
+  const char *file_name = "test_flush_all_pages.bp";
+  ::remove(file_name);
+
+  const int            page_count = 200;
+  std::vector<PageNum> pages;
+  for (int round = 0; round < 2; round++) {
+    BufferPoolManager bpm;
+    if (round == 0) {
+      ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+    }
+
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    if (round == 0) {
+      for (int i = 0; i < page_count; i++) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+        pages.push_back(frame->page_num());
+        bp->unpin_page(frame);
+      }
+
+      // 倒序弄脏页面，下刷时会按照页面编号排序并合并连续的页面
+      for (auto iter = pages.rbegin(); iter != pages.rend(); ++iter) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->get_this_page(*iter, &frame));
+        snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+        frame->mark_dirty();
+        bp->unpin_page(frame);
+      }
+
+      std::vector<BufferPoolStatItem> items;
+      bpm.collect_stats(items);
+      const long write_ios   = std::stol(stat_value(items, file_name, "write_ios"));
+      const long write_pages = std::stol(stat_value(items, file_name, "write_pages"));
+
+      ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+
+      items.clear();
+      bpm.collect_stats(items);
+      ASSERT_EQ("0", stat_value(items, file_name, "dirty_frames"));
+      // 页面中间只穿插了几个位图页，合并之后请求的个数远小于页面的个数
+      ASSERT_LE(write_pages + page_count, std::stol(stat_value(items, file_name, "write_pages")));
+      ASSERT_GT(write_ios + page_count / 10, std::stol(stat_value(items, file_name, "write_ios")));
+    } else {
+      for (PageNum page : pages) {
+        Frame *frame = nullptr;
+        ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+        ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+        bp->unpin_page(frame);
+      }
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+  ::remove(file_name);
+}
+
+#ifdef CONCURRENCY
+TEST(test_buffer_pool, test_close_file_with_page_cleaner)
+{
+  const char *file_name = "test_close_file_with_page_cleaner.bp";
+  ::remove(file_name);
+
+  // 后台线程不停地刷所有的脏页，关闭文件时经常会遇到后台线程正pin着页帧
+  BufferPoolManager bpm;
+  PageCleanerParam  param;
+  param.interval_ms          = 1;
+  param.dirty_high_watermark = 0;
+  param.dirty_low_watermark  = 0;
+  ASSERT_EQ(RC::SUCCESS, bpm.start_page_cleaner(param));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  const int            page_count = 100;
+  std::vector<PageNum> pages;
+  for (int round = 0; round < 30; round++) {
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    const int file_desc = bp->file_desc();
+
+    for (int i = 0; i < page_count; i++) {
+      Frame *frame = nullptr;
+      if (round == 0) {
+        ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+        pages.push_back(frame->page_num());
+      } else {
+        ASSERT_EQ(RC::SUCCESS, bp->get_this_page(pages[i], &frame));
+        ASSERT_EQ(std::to_string(round - 1), std::string(frame->data()));
+      }
+      frame->write_latch();
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "%d", round);
+      frame->mark_dirty();
+      frame->write_unlatch();
+      bp->unpin_page(frame);
+    }
+
+    // 文件关闭之后，页帧表中不能再有这个文件的页帧
+    ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+    ASSERT_TRUE(bpm.default_partition().frame_manager().find_list(file_desc).empty());
+  }
+  ::remove(file_name);
+}
+#endif
+
+TEST(test_buffer_pool, test_flush_rate_limit)
+{
+  BufferPoolManager bpm;
+  const int         pages_per_mb = 1024 * 1024 / BP_PAGE_SIZE;
+
+  // 不限速时不等待
+  auto start = std::chrono::steady_clock::now();
+  bpm.throttle_flush(pages_per_mb * 100);
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+  // 每秒8MB，第一批不需要等待，之后每MB需要等125毫秒
+  bpm.set_flush_rate_limit(8);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 3; i++) {
+    bpm.throttle_flush(pages_per_mb);
+  }
+  ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250));
+}
+
+TEST(test_buffer_pool, test_partition)
+{
+  const char *hot_file   = "hot_table.data";
+  const char *batch_file = "batch_table-index.index";
+  ::remove(hot_file);
+  ::remove(batch_file);
+
+  // 默认分区只有一个内存池
+  BufferPoolManager bpm(DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE);
+  ASSERT_EQ(RC::SUCCESS, bpm.create_partition("hot", DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE));
+  ASSERT_NE(RC::SUCCESS, bpm.create_partition("hot", DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE));
+  ASSERT_NE(RC::SUCCESS, bpm.assign_table("hot_table", "unknown"));
+  ASSERT_EQ(RC::SUCCESS, bpm.assign_table("hot_table", "hot"));
+
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(hot_file));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(batch_file));
+
+  DiskBufferPool *hot_bp   = nullptr;
+  DiskBufferPool *batch_bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(hot_file, hot_bp));
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(batch_file, batch_bp));
+  ASSERT_EQ("hot", hot_bp->partition().name());
+  ASSERT_EQ(BufferPoolManager::DEFAULT_PARTITION, batch_bp->partition().name());
+
+  std::vector<PageNum> hot_pages;
+  for (int i = 0; i < 10; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, hot_bp->allocate_page(&frame));
+    hot_pages.push_back(frame->page_num());
+    hot_bp->unpin_page(frame);
+  }
+
+  // 另一个文件使用的页面远多于默认分区的页帧，不会淘汰hot分区中的页面
+  for (int i = 0; i < DEFAULT_ITEM_NUM_PER_POOL * 4; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, batch_bp->allocate_page(&frame));
+    frame->mark_dirty();
+    batch_bp->unpin_page(frame);
+  }
+
+  std::vector<BufferPoolStatItem> items;
+  bpm.collect_stats(items);
+  ASSERT_EQ("2", stat_value(items, "global", "partitions"));
+  ASSERT_EQ("0", stat_value(items, "partition:hot", "evictions"));
+  ASSERT_NE("0", stat_value(items, "partition:default", "evictions"));
+  ASSERT_EQ("hot", stat_value(items, hot_file, "partition"));
+
+  const std::string misses = stat_value(items, hot_file, "misses");
+  for (PageNum page : hot_pages) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, hot_bp->get_this_page(page, &frame));
+    hot_bp->unpin_page(frame);
+  }
+  items.clear();
+  bpm.collect_stats(items);
+  ASSERT_EQ(misses, stat_value(items, hot_file, "misses"));
+
+  ASSERT_EQ(RC::SUCCESS, hot_bp->close_file());
+  ASSERT_EQ(RC::SUCCESS, batch_bp->close_file());
+  ::remove(hot_file);
+  ::remove(batch_file);
+}
+
+TEST(test_buffer_pool, test_readonly_file)
+{
+  const char *file_name = "archive_table.data";
+  ::remove(file_name);
+
+  std::vector<PageNum> pages;
+  {
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    ASSERT_FALSE(bp->readonly());
+    for (int i = 0; i < BP_EXTENT_PAGE_NUM * 2; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  BufferPoolManager bpm;
+  bpm.set_table_readonly("archive_table");
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  ASSERT_TRUE(bp->readonly());
+  ASSERT_EQ(pages, list_pages(*bp));
+
+  for (PageNum page : pages) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+    ASSERT_EQ(page, frame->page_num());
+    ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+
+    // 同一个页面总是同一个页帧
+    Frame *again = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &again));
+    ASSERT_EQ(frame, again);
+    bp->unpin_page(again);
+    bp->unpin_page(frame);
+  }
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::BUFFERPOOL_READONLY, bp->allocate_page(&frame));
+  ASSERT_EQ(RC::BUFFERPOOL_READONLY, bp->dispose_page(pages[0]));
+  ASSERT_NE(RC::SUCCESS, bp->get_this_page(BP_EXTENT_PAGE_NUM * 100, &frame));
+
+  // 只读文件不占用缓冲池的页帧
+  std::vector<BufferPoolStatItem> items;
+  bpm.collect_stats(items);
+  ASSERT_EQ("0", stat_value(items, "global", "resident_pages"));
+  ASSERT_EQ("yes", stat_value(items, file_name, "readonly(mmap)"));
+
+  ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  ::remove(file_name);
+}
+
+TEST(test_buffer_pool, test_readonly_short_file)
+{
+  const char *file_name = "archive_short_table.data";
+  ::remove(file_name);
+
+  std::vector<PageNum> pages;
+  {
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+    DiskBufferPool *bp = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    for (int i = 0; i < BP_EXTENT_PAGE_NUM * 2; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+      snprintf(frame->data(), BP_PAGE_DATA_SIZE, "page %d", frame->page_num());
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      bp->unpin_page(frame);
+    }
+    ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+    ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  }
+
+  // 文件比文件头中记录的页面个数短，打开时不能修改文件，只映射文件中的页面
+  const off_t file_size = (off_t)BP_EXTENT_PAGE_NUM * BP_PAGE_SIZE;
+  ASSERT_EQ(0, ::truncate(file_name, file_size));
+
+  BufferPoolManager bpm;
+  bpm.set_table_readonly("archive_short_table");
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  ASSERT_TRUE(bp->readonly());
+  ASSERT_TRUE(bp->writable());
+
+  struct stat st;
+  ASSERT_EQ(0, ::stat(file_name, &st));
+  ASSERT_EQ(file_size, st.st_size);
+
+  for (PageNum page : pages) {
+    Frame *frame = nullptr;
+    if (page < BP_EXTENT_PAGE_NUM) {
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page, &frame));
+      ASSERT_EQ(std::string("page ") + std::to_string(page), std::string(frame->data()));
+      bp->unpin_page(frame);
+    } else {
+      ASSERT_NE(RC::SUCCESS, bp->get_this_page(page, &frame));
+    }
+  }
+
+  ASSERT_EQ(RC::SUCCESS, bp->close_file());
+  ASSERT_EQ(0, ::stat(file_name, &st));
+  ASSERT_EQ(file_size, st.st_size);
+  ::remove(file_name);
+}
+
 int main(int argc, char **argv)
 {
 
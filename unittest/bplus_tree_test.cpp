@@ -728,6 +728,86 @@ TEST(test_bplus_tree, test_bplus_tree_insert)
   handler = nullptr;
 }
 
+TEST(test_bplus_tree, test_bulk_load)
+{
+  LoggerFactory::init_default("test.log");
+
+  const char *index_name = "bulk_load.btree";
+  const int   key_num    = 2000;  // validate_tree 会固定所有的页面，树不能超过缓冲池的大小
+  const int   dup_num    = 3;
+
+  // 排序内存很小时键值会分成多段写到临时文件中再归并
+  BplusTreeBuildParam params[] = {{90, 64 * 1024 * 1024}, {50, 1024}, {100, 4096}};
+  for (const BplusTreeBuildParam &param : params) {
+    ::remove(index_name);
+    handler = new BplusTreeHandler();
+    ASSERT_EQ(RC::SUCCESS, handler->create(index_name, INTS, sizeof(int), ORDER * 2, ORDER * 3));
+
+    // 乱序添加键值，每个键值重复几次
+    BplusTreeBulkLoader loader(*handler, param);
+    for (int i = 0; i < key_num * dup_num; i++) {
+      int key      = (i * 7919) % key_num;
+      rid.page_num = key;
+      rid.slot_num = i;
+      ASSERT_EQ(RC::SUCCESS, loader.add((const char *)&key, rid));
+    }
+    ASSERT_EQ(RC::SUCCESS, loader.finish());
+    ASSERT_EQ(true, handler->validate_tree());
+
+    // 扫描器析构时才会释放叶子页面上的读锁，需要在修改树之前销毁
+    {
+      BplusTreeScanner scanner(*handler);
+      ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+      int count = 0;
+      RID last_rid;
+      RC  rc = RC::SUCCESS;
+      while ((rc = scanner.next_entry(rid)) == RC::SUCCESS) {
+        ASSERT_EQ(count / dup_num, rid.page_num);
+        if (count % dup_num != 0) {
+          ASSERT_LT(last_rid.slot_num, rid.slot_num);
+        }
+        last_rid = rid;
+        count++;
+      }
+      ASSERT_EQ(RC::RECORD_EOF, rc);
+      ASSERT_EQ(key_num * dup_num, count);
+      scanner.close();
+    }
+
+    for (int key = 0; key < key_num; key += 97) {
+      std::list<RID> rids;
+      ASSERT_EQ(RC::SUCCESS, handler->get_entry((const char *)&key, sizeof(key), rids));
+      ASSERT_EQ(dup_num, static_cast<int>(rids.size()));
+    }
+
+    // 构建完的树可以继续插入和删除
+    for (int key = -100; key < key_num + 100; key += 3) {
+      rid.page_num = key;
+      rid.slot_num = -1;
+      ASSERT_EQ(RC::SUCCESS, handler->insert_entry((const char *)&key, &rid));
+    }
+    ASSERT_EQ(true, handler->validate_tree());
+    for (int i = 0; i < key_num * dup_num; i += 2) {
+      int key      = (i * 7919) % key_num;
+      rid.page_num = key;
+      rid.slot_num = i;
+      ASSERT_EQ(RC::SUCCESS, handler->delete_entry((const char *)&key, &rid));
+    }
+    ASSERT_EQ(true, handler->validate_tree());
+
+    // 已经有数据的树不能再批量构建
+    BplusTreeBulkLoader other_loader(*handler, param);
+    int key = 0;
+    ASSERT_EQ(RC::SUCCESS, other_loader.add((const char *)&key, rid));
+    ASSERT_NE(RC::SUCCESS, other_loader.finish());
+
+    handler->close();
+    delete handler;
+    handler = nullptr;
+  }
+  ::remove(index_name);
+}
+
 int main(int argc, char **argv)
 {
 
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include "storage/buffer/frame_arena.h"
+#include "gtest/gtest.h"
+
+void test_arena(bool use_huge_page)
+{
+  const int  frame_num = 300;
+  FrameArena arena;
+  ASSERT_EQ(RC::SUCCESS, arena.init(frame_num, use_huge_page));
+  ASSERT_EQ(frame_num, arena.size());
+  ASSERT_NE(RC::SUCCESS, arena.init(frame_num, use_huge_page));
+  if (!use_huge_page) {
+    ASSERT_EQ(FrameArena::PageMode::NORMAL, arena.page_mode());
+  }
+
+  // 页面数据是连续的，并且按照页面大小对齐，可以直接用于O_DIRECT
+  Page *first = &arena.frame(0)->page();
+  ASSERT_EQ(0UL, reinterpret_cast<uintptr_t>(first) % 4096);
+  for (int i = 0; i < frame_num; i++) {
+    Frame *frame = arena.frame(i);
+    ASSERT_EQ(first + i, &frame->page());
+    ASSERT_EQ(0, frame->pin_count());
+
+    frame->set_page_num(i);
+    memset(frame->data(), i & 0xFF, BP_PAGE_DATA_SIZE);
+  }
+
+  for (int i = 0; i < frame_num; i++) {
+    Frame *frame = arena.frame(i);
+    ASSERT_EQ(i, frame->page_num());
+    ASSERT_EQ(static_cast<char>(i & 0xFF), frame->data()[BP_PAGE_DATA_SIZE - 1]);
+  }
+}
+
+TEST(test_frame_arena, test_normal_page)
+{
+  test_arena(false);
+}
+
+TEST(test_frame_arena, test_huge_page)
+{
+  // 系统不支持大页时会退化成普通内存页
+  test_arena(true);
+}
+
+TEST(test_frame_arena, test_invalid)
+{
+  FrameArena arena;
+  ASSERT_NE(RC::SUCCESS, arena.init(0));
+  ASSERT_EQ(0, arena.size());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
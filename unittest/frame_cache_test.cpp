@@ -0,0 +1,194 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "storage/buffer/frame_cache.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 模拟缓冲池：缓存满了之后，按照淘汰顺序淘汰第一个页面
+ * @return true 命中
+ */
+bool access(FrameCache &cache, vector<Frame> &frames, set<Frame *> &free_frames, PageNum page_num)
+{
+  const int file_desc = 0;
+  FrameId   frame_id(file_desc, page_num);
+  Frame    *frame = nullptr;
+  if (cache.get(frame_id, frame)) {
+    return true;
+  }
+
+  if (free_frames.empty()) {
+    cache.foreach_reverse([&cache, &free_frames](const FrameId &victim_id, Frame *const victim) {
+      free_frames.insert(victim);
+      cache.evict(victim_id);
+      return false;
+    });
+  }
+
+  frame = *free_frames.begin();
+  free_frames.erase(free_frames.begin());
+  frame->set_page_num(page_num);
+  cache.put(frame_id, frame);
+  return false;
+}
+
+/**
+ * @brief 先反复访问一批热点页面，再做一次大范围的扫描，返回扫描之后热点页面的命中个数
+ */
+int hot_pages_hit_after_scan(const char *name)
+{
+  const int capacity  = 64;
+  const int hot_num   = 16;
+  const int scan_num  = 1000;
+  const int scan_base = 10000;
+
+  unique_ptr<FrameCache> cache(FrameCache::create(name, capacity));
+  EXPECT_NE(cache, nullptr);
+
+  vector<Frame> frames(capacity);
+  set<Frame *>  free_frames;
+  for (Frame &frame : frames) {
+    free_frames.insert(&frame);
+  }
+
+  // 热点页面需要先被淘汰一次再被访问，才能进入2Q的hot队列
+  for (int round = 0; round < 3; round++) {
+    for (PageNum page_num = 0; page_num < hot_num; page_num++) {
+      access(*cache, frames, free_frames, page_num);
+    }
+    for (PageNum page_num = 0; page_num < capacity; page_num++) {
+      access(*cache, frames, free_frames, scan_base + round * capacity + page_num);
+    }
+  }
+  for (PageNum page_num = 0; page_num < hot_num; page_num++) {
+    access(*cache, frames, free_frames, page_num);
+  }
+
+  for (PageNum page_num = 0; page_num < scan_num; page_num++) {
+    access(*cache, frames, free_frames, scan_base * 2 + page_num);
+  }
+
+  int hit_num = 0;
+  for (PageNum page_num = 0; page_num < hot_num; page_num++) {
+    if (access(*cache, frames, free_frames, page_num)) {
+      hit_num++;
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(capacity), cache->count());
+  return hit_num;
+}
+
+TEST(test_frame_cache, test_create)
+{
+  unique_ptr<FrameCache> cache(FrameCache::create(nullptr, 16));
+  ASSERT_NE(cache, nullptr);
+  ASSERT_STREQ("lru", cache->name());
+
+  cache.reset(FrameCache::create("2Q", 16));
+  ASSERT_NE(cache, nullptr);
+  ASSERT_STREQ("2q", cache->name());
+
+  cache.reset(FrameCache::create("unknown", 16));
+  ASSERT_EQ(cache, nullptr);
+}
+
+TEST(test_frame_cache, test_basic)
+{
+  for (const char *name : {"lru", "2q"}) {
+    unique_ptr<FrameCache> cache(FrameCache::create(name, 16));
+    vector<Frame>          frames(8);
+    for (int i = 0; i < static_cast<int>(frames.size()); i++) {
+      cache->put(FrameId(0, i), &frames[i]);
+    }
+    ASSERT_EQ(frames.size(), cache->count());
+
+    Frame *frame = nullptr;
+    ASSERT_TRUE(cache->get(FrameId(0, 3), frame));
+    ASSERT_EQ(&frames[3], frame);
+    ASSERT_FALSE(cache->get(FrameId(1, 3), frame));
+
+    cache->remove(FrameId(0, 3));
+    ASSERT_FALSE(cache->get(FrameId(0, 3), frame));
+    ASSERT_EQ(frames.size() - 1, cache->count());
+
+    int visit_num = 0;
+    cache->foreach ([&visit_num](const FrameId &, Frame *const) {
+      visit_num++;
+      return true;
+    });
+    ASSERT_EQ(static_cast<int>(frames.size()) - 1, visit_num);
+
+    // 没有再次访问过的页面，最早加入的最先被淘汰
+    FrameId victim(-1, -1);
+    cache->foreach_reverse([&victim](const FrameId &frame_id, Frame *const) {
+      victim = frame_id;
+      return false;
+    });
+    ASSERT_EQ(FrameId(0, 0), victim);
+
+    cache->destroy();
+    ASSERT_EQ(0, static_cast<int>(cache->count()));
+  }
+}
+
+TEST(test_frame_cache, test_scan_resistant)
+{
+  // LRU中，一次扫描就会把热点页面全部换出去
+  ASSERT_EQ(0, hot_pages_hit_after_scan("lru"));
+
+  // 2Q中，扫描的页面只会在in队列中，热点页面都还在hot队列中
+  ASSERT_EQ(16, hot_pages_hit_after_scan("2q"));
+}
+
+TEST(test_frame_cache, test_ghost_history)
+{
+  TwoQueueFrameCache cache(16);
+  vector<Frame>      frames(4);
+
+  // 淘汰的页面很快再访问会直接进入hot队列
+  cache.put(FrameId(0, 1), &frames[0]);
+  cache.evict(FrameId(0, 1));
+  cache.put(FrameId(0, 1), &frames[0]);
+  ASSERT_EQ(1, static_cast<int>(cache.hot_count()));
+
+  // 释放的页面不会留下访问历史
+  cache.put(FrameId(0, 2), &frames[1]);
+  cache.remove(FrameId(0, 2));
+  cache.put(FrameId(0, 2), &frames[1]);
+  ASSERT_EQ(1, static_cast<int>(cache.hot_count()));
+  ASSERT_EQ(1, static_cast<int>(cache.in_count()));
+
+  // 文件关闭之后，复用同一个文件描述符的新文件不会继承访问历史
+  cache.put(FrameId(1, 3), &frames[2]);
+  cache.evict(FrameId(1, 3));
+  cache.put(FrameId(2, 3), &frames[3]);
+  cache.evict(FrameId(2, 3));
+  cache.forget_file(1);
+  cache.put(FrameId(1, 3), &frames[2]);
+  cache.put(FrameId(2, 3), &frames[3]);
+  ASSERT_EQ(2, static_cast<int>(cache.hot_count()));
+  ASSERT_EQ(2, static_cast<int>(cache.in_count()));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
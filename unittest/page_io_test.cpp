@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <fcntl.h>
+#include <memory>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "storage/buffer/page.h"
+#include "storage/buffer/page_io.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+void test_page_io(PageIO &page_io)
+{
+  const char *file_name = "test_page_io.data";
+  ::remove(file_name);
+  int fd = ::open(file_name, O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+
+  const int             page_num = 100;
+  vector<Page>          pages(page_num);
+  vector<iovec>         iovs(page_num);
+  vector<PageIORequest> requests(page_num);
+  for (int i = 0; i < page_num; i++) {
+    memset(&pages[i], i, sizeof(Page));
+    iovs[i] = iovec{&pages[i], sizeof(Page)};
+
+    // 倒序写，每个页面一个请求
+    PageIORequest &request = requests[page_num - 1 - i];
+    request.type           = PageIORequest::Type::WRITE;
+    request.fd             = fd;
+    request.offset         = static_cast<int64_t>(i) * sizeof(Page);
+    request.iov            = &iovs[i];
+    request.iovcnt         = 1;
+  }
+  ASSERT_EQ(RC::SUCCESS, page_io.submit(requests.data(), page_num));
+  for (const PageIORequest &request : requests) {
+    ASSERT_EQ(RC::SUCCESS, request.rc);
+  }
+
+  // 单个页面读
+  Page page;
+  ASSERT_EQ(RC::SUCCESS, page_io.read(fd, 10 * sizeof(Page), &page, sizeof(Page)));
+  ASSERT_EQ(0, memcmp(&page, &pages[10], sizeof(Page)));
+
+  // 多个请求，每个请求读多个连续的页面
+  vector<Page> read_pages(page_num);
+  for (int i = 0; i < page_num; i++) {
+    iovs[i] = iovec{&read_pages[i], sizeof(Page)};
+  }
+  const int batch = 7;
+  requests.clear();
+  for (int i = 0; i < page_num; i += batch) {
+    PageIORequest request;
+    request.type   = PageIORequest::Type::READ;
+    request.fd     = fd;
+    request.offset = static_cast<int64_t>(i) * sizeof(Page);
+    request.iov    = &iovs[i];
+    request.iovcnt = std::min(batch, page_num - i);
+    requests.push_back(request);
+  }
+  ASSERT_EQ(RC::SUCCESS, page_io.submit(requests.data(), static_cast<int>(requests.size())));
+  for (int i = 0; i < page_num; i++) {
+    ASSERT_EQ(0, memcmp(&pages[i], &read_pages[i], sizeof(Page)));
+  }
+
+  // 读到文件尾之后
+  ASSERT_NE(RC::SUCCESS, page_io.read(fd, page_num * sizeof(Page), &page, sizeof(Page)));
+  ASSERT_NE(RC::SUCCESS, page_io.read(fd, (page_num - 1) * sizeof(Page) + 1, &page, sizeof(Page)));
+
+  ::close(fd);
+  ::remove(file_name);
+}
+
+TEST(test_page_io, test_create)
+{
+  unique_ptr<PageIO> page_io(PageIO::create(nullptr));
+  ASSERT_NE(page_io, nullptr);
+  ASSERT_STREQ("sync", page_io->name());
+
+  page_io.reset(PageIO::create("io_uring"));
+  ASSERT_NE(page_io, nullptr);
+  ASSERT_STREQ(IoUringPageIO::supported() ? "io_uring" : "sync", page_io->name());
+
+  page_io.reset(PageIO::create("unknown"));
+  ASSERT_EQ(page_io, nullptr);
+}
+
+TEST(test_page_io, test_sync)
+{
+  SyncPageIO page_io;
+  test_page_io(page_io);
+}
+
+TEST(test_page_io, test_io_uring)
+{
+  if (!IoUringPageIO::supported()) {
+    GTEST_SKIP() << "io_uring is not supported";
+  }
+
+  IoUringPageIO page_io;
+  test_page_io(page_io);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,8 +12,14 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2022
 //
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <string.h>
+#include <vector>
 
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/record/record_manager.h"
@@ -184,6 +190,890 @@ TEST(test_record_page_handler, test_record_file_iterator)
   delete bpm;
 }
 
+TEST(test_record_page_handler, test_record_file_batch)
+{
+  const char *record_manager_file = "record_batch.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  const int        record_insert_num = 2000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    int32_t record_data[4] = {i, i, i, i};
+    RID     rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<char *>(record_data), sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  for (int i = 0; i < record_insert_num; i += 3) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[i]));
+  }
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  for (int max_count : {0, 7}) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+
+    // 一批记录都在同一个页面上，处理这一批记录时页面一直是有效的
+    std::vector<Record> records;
+    std::set<int>       values;
+    int                 batch_count = 0;
+    RC                  rc          = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = file_scanner.next_batch(records, max_count))) {
+      ASSERT_FALSE(records.empty());
+      if (max_count > 0) {
+        ASSERT_LE(static_cast<int>(records.size()), max_count);
+      }
+      for (const Record &record : records) {
+        ASSERT_EQ(records.front().rid().page_num, record.rid().page_num);
+        const int32_t value = *reinterpret_cast<const int32_t *>(record.data());
+        ASSERT_EQ(rids[value], record.rid());
+        ASSERT_TRUE(values.insert(value).second);
+      }
+      batch_count++;
+    }
+    ASSERT_EQ(RC::RECORD_EOF, rc);
+    ASSERT_TRUE(records.empty());
+    ASSERT_EQ(record_insert_num - (record_insert_num + 2) / 3, static_cast<int>(values.size()));
+    ASSERT_GT(batch_count, 1);
+    file_scanner.close_scan();
+  }
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_free_space_map)
+{
+  const char *data_file = "free_space_map.data";
+  const char *fsm_file  = "free_space_map.fsm";
+  ::remove(data_file);
+  ::remove(fsm_file);
+
+  BufferPoolManager *bpm    = new BufferPoolManager();
+  DiskBufferPool    *bp     = nullptr;
+  DiskBufferPool    *fsm_bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(data_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(fsm_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(data_file, bp));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(fsm_file, fsm_bp));
+
+  auto file_handler = std::make_unique<RecordFileHandler>();
+  ASSERT_EQ(RC::SUCCESS, file_handler->init(bp, fsm_bp));
+
+  const int         record_insert_num = 3000;
+  char              record_data[20];
+  std::vector<RID>  rids;
+  std::set<PageNum> pages;
+  for (int i = 0; i < record_insert_num; i++) {
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler->insert_record(record_data, sizeof(record_data), &rid));
+    rids.push_back(rid);
+    pages.insert(rid.page_num);
+  }
+  ASSERT_GT(pages.size(), 2);
+
+  // 除了最后一个页面，其它页面都是满的
+  const PageNum first_page = *pages.begin();
+  const PageNum last_page  = *pages.rbegin();
+  ASSERT_EQ(0, file_handler->free_space_map().free_space(first_page));
+  ASSERT_GT(file_handler->free_space_map().free_space(last_page), 0);
+
+  // 删除第一个页面上一半的记录
+  int deleted = 0;
+  for (int i = 0; i < record_insert_num; i += 2) {
+    if (rids[i].page_num == first_page) {
+      ASSERT_EQ(RC::SUCCESS, file_handler->delete_record(&rids[i]));
+      deleted++;
+    }
+  }
+  const int first_page_free = file_handler->free_space_map().free_space(first_page);
+  ASSERT_GE(first_page_free, (deleted * 24 / FreeSpaceMap::FSM_UNIT_SIZE) * FreeSpaceMap::FSM_UNIT_SIZE);
+
+  // 重新打开之后空闲空间表不需要重建，删除记录留下的空间可以继续使用
+  file_handler.reset();
+  bpm->close_file(fsm_file);
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(fsm_file, fsm_bp));
+  file_handler = std::make_unique<RecordFileHandler>();
+  ASSERT_EQ(RC::SUCCESS, file_handler->init(bp, fsm_bp));
+  ASSERT_EQ(first_page_free, file_handler->free_space_map().free_space(first_page));
+
+  for (int i = 0; i < deleted; i++) {
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler->insert_record(record_data, sizeof(record_data), &rid));
+    ASSERT_EQ(1, pages.count(rid.page_num));
+  }
+
+  // 空闲空间表文件丢失时，扫描数据文件重建
+  const int first_free = file_handler->free_space_map().free_space(first_page);
+  const int last_free  = file_handler->free_space_map().free_space(last_page);
+  file_handler.reset();
+  bpm->close_file(fsm_file);
+  ::remove(fsm_file);
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(fsm_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(fsm_file, fsm_bp));
+  file_handler = std::make_unique<RecordFileHandler>();
+  ASSERT_EQ(RC::SUCCESS, file_handler->init(bp, fsm_bp));
+  ASSERT_EQ(first_free, file_handler->free_space_map().free_space(first_page));
+  ASSERT_EQ(last_free, file_handler->free_space_map().free_space(last_page));
+
+  file_handler.reset();
+  bpm->close_file(fsm_file);
+  bpm->close_file(data_file);
+  delete bpm;
+  ::remove(data_file);
+  ::remove(fsm_file);
+}
+
+TEST(test_record_page_handler, test_variable_record_page)
+{
+  const char *record_manager_file = "variable_record.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+
+  // 还没有初始化的页面全是0，不能被当成有空闲空间的变长记录页面
+  RecordPageHandler record_page_handle;
+  ASSERT_EQ(RC::SUCCESS, record_page_handle.init(*bp, frame->page_num(), true /*readonly*/));
+  ASSERT_FALSE(record_page_handle.is_variable());
+  ASSERT_EQ(0, record_page_handle.free_space());
+  ASSERT_EQ(0, record_page_handle.record_num());
+  RecordPageIterator empty_iterator;
+  empty_iterator.init(record_page_handle);
+  ASSERT_FALSE(empty_iterator.has_next());
+  record_page_handle.cleanup();
+
+  ASSERT_EQ(RC::SUCCESS, record_page_handle.init_empty_variable_page(*bp, frame->page_num()));
+  ASSERT_TRUE(record_page_handle.is_variable());
+
+  // 插入长度不同的记录，直到页面放不下
+  std::map<SlotNum, std::string> records;
+  for (int i = 0;; i++) {
+    std::string data(10 + (i * 37) % 300, 'a' + i % 26);
+    RID         rid;
+    RC          rc = record_page_handle.insert_record(data.data(), static_cast<int>(data.size()), &rid);
+    if (rc == RC::RECORD_NOMEM) {
+      break;
+    }
+    ASSERT_EQ(RC::SUCCESS, rc);
+    records[rid.slot_num] = data;
+  }
+  ASSERT_GT(records.size(), 10);
+
+  // 删除一半的记录，空闲空间分散在页面中，再插入比较长的记录需要整理页面
+  for (auto iter = records.begin(); iter != records.end();) {
+    if (iter->first % 2 == 0) {
+      RID rid(frame->page_num(), iter->first);
+      ASSERT_EQ(RC::SUCCESS, record_page_handle.delete_record(&rid));
+      iter = records.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  int inserted = 0;
+  while (record_page_handle.free_space() >= 500) {
+    std::string data(500, 'A' + inserted % 26);
+    RID         rid;
+    ASSERT_EQ(RC::SUCCESS, record_page_handle.insert_record(data.data(), static_cast<int>(data.size()), &rid));
+    ASSERT_EQ(0, records.count(rid.slot_num));
+    records[rid.slot_num] = data;
+    inserted++;
+  }
+  ASSERT_GT(inserted, 1);
+
+  // 恢复时可以在指定的槽位上重新放一条记录
+  const SlotNum recover_slot = records.rbegin()->first + 2;
+  std::string   recover_data(20, 'r');
+  ASSERT_EQ(RC::SUCCESS,
+      record_page_handle.recover_insert_record(
+          recover_data.data(), static_cast<int>(recover_data.size()), RID(frame->page_num(), recover_slot)));
+  records[recover_slot] = recover_data;
+
+  RecordPageIterator iterator;
+  iterator.init(record_page_handle);
+  size_t count = 0;
+  Record record;
+  while (iterator.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, iterator.next(record));
+    ASSERT_EQ(1, records.count(record.rid().slot_num));
+    const std::string &data = records[record.rid().slot_num];
+    ASSERT_EQ(static_cast<int>(data.size()), record.len());
+    ASSERT_EQ(0, memcmp(data.data(), record.data(), data.size()));
+    count++;
+  }
+  ASSERT_EQ(records.size(), count);
+
+  record_page_handle.cleanup();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_overflow_page)
+{
+  const char *record_manager_file = "overflow_record.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp, nullptr, RecordFormat::VARIABLE));
+
+  const int record_insert_num = 100;
+  for (int i = 0; i < record_insert_num; i++) {
+    std::string data(100 + i, 'x');
+    RID         rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(data.data(), static_cast<int>(data.size()), &rid));
+  }
+
+  // 超过一个页面的数据
+  std::string data(BP_PAGE_SIZE * 3 + 123, '\0');
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  PageNum first_page = BP_INVALID_PAGE_NUM;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_overflow(data.data(), static_cast<int>(data.size()), first_page));
+  ASSERT_NE(BP_INVALID_PAGE_NUM, first_page);
+
+  std::string read_data(data.size(), '\0');
+  ASSERT_EQ(RC::SUCCESS, file_handler.read_overflow(first_page, static_cast<int>(read_data.size()), read_data.data()));
+  ASSERT_EQ(data, read_data);
+
+  // 遍历记录时跳过溢出页面
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+  int    count = 0;
+  Record record;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    ASSERT_EQ(100 + count, record.len());
+    count++;
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(record_insert_num, count);
+
+  // 删除之后溢出页面都释放了
+  auto page_count = [bp]() {
+    BufferPoolIterator bp_iterator;
+    bp_iterator.init(*bp);
+    int count = 0;
+    for (; bp_iterator.has_next(); bp_iterator.next()) {
+      count++;
+    }
+    return count;
+  };
+  const int allocated_pages = page_count();
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_overflow(first_page));
+  ASSERT_EQ(allocated_pages - 4, page_count());
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_pax_record_file)
+{
+  const char *record_manager_file = "pax_record.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  // 三列：int a, int b, char(8) c
+  struct Row
+  {
+    int32_t a;
+    int32_t b;
+    char    c[8];
+  };
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp, nullptr, RecordFormat::PAX, {4, 4, 8}));
+
+  const int        record_insert_num = 3000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    Row row{i, i * 2, {}};
+    snprintf(row.c, sizeof(row.c), "r%d", i);
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &rid));
+    rids.push_back(rid);
+  }
+  ASSERT_NE(rids.front().page_num, rids.back().page_num);
+
+  // 读取完整的记录
+  for (int i = 0; i < record_insert_num; i += 101) {
+    RecordPageHandler page_handler;
+    Record            record;
+    ASSERT_EQ(RC::SUCCESS, file_handler.get_record(page_handler, &rids[i], true /*readonly*/, &record));
+    ASSERT_EQ(static_cast<int>(sizeof(Row)), record.len());
+    const Row *row = reinterpret_cast<const Row *>(record.data());
+    ASSERT_EQ(i, row->a);
+    ASSERT_EQ(i * 2, row->b);
+    ASSERT_STREQ(("r" + std::to_string(i)).c_str(), row->c);
+  }
+
+  // 修改之后写回页面
+  ASSERT_EQ(RC::SUCCESS, file_handler.visit_record(rids[10], false /*readonly*/, [](Record &record) {
+    reinterpret_cast<Row *>(record.data())->b = -1;
+  }));
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[20]));
+
+  // 只读取第二列，并且在页面上过滤 a >= 10 and a < 1010
+  ColumnScanSpec spec;
+  spec.columns = {1};
+  spec.filters.push_back(ColumnFilter{0, INTS, GREAT_EQUAL, 10});
+  spec.filters.push_back(ColumnFilter{0, INTS, LESS_THAN, 1010});
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, &spec));
+  std::set<int> values;
+  Record        record;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    values.insert(reinterpret_cast<const Row *>(record.data())->b);
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(999, values.size());
+  ASSERT_EQ(1, values.count(-1));
+  ASSERT_EQ(0, values.count(20 * 2));
+  ASSERT_EQ(1, values.count(1009 * 2));
+  ASSERT_EQ(0, values.count(1010 * 2));
+
+  // 不指定列时返回完整的记录
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+  int count = 0;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    const Row *row = reinterpret_cast<const Row *>(record.data());
+    ASSERT_STREQ(("r" + std::to_string(row->a)).c_str(), row->c);
+    count++;
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(record_insert_num - 1, count);
+
+  // 批量获取时 PAX 页面上的记录复制到扫描器的缓存中
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, &spec));
+  std::vector<Record> records;
+  count = 0;
+  while (RC::SUCCESS == file_scanner.next_batch(records)) {
+    for (const Record &record : records) {
+      ASSERT_EQ(1, values.count(reinterpret_cast<const Row *>(record.data())->b));
+      count++;
+    }
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(999, count);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_zone_map)
+{
+  const char *record_manager_file = "record_zone_map.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  // 第一列按照插入顺序递增，第二列在每个页面上都是随意的值
+  const std::vector<ZoneMapColumn> columns = {{0, 0, INTS}, {1, 4, DATES}};
+  RecordFileHandler                file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+  ASSERT_EQ(RC::SUCCESS, file_handler.init_zone_map(columns));
+
+  const int        record_insert_num = 3000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    int32_t record_data[4] = {i, (i * 7919) % 1000, 0, 0};
+    RID     rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<char *>(record_data), sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  const PageNum first_page = rids.front().page_num;
+  ASSERT_NE(first_page, rids.back().page_num);
+
+  ZoneMap &zone_map  = file_handler.zone_map();
+  int32_t  min_value = 0;
+  int32_t  max_value = 0;
+  ASSERT_TRUE(zone_map.range(first_page, 0, min_value, max_value));
+  ASSERT_EQ(0, min_value);
+  ASSERT_FALSE(zone_map.range(first_page, 2, min_value, max_value));
+
+  // 删除最小值之后页面的范围会变小，删除中间的值范围不变
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[0]));
+  ASSERT_TRUE(zone_map.range(first_page, 0, min_value, max_value));
+  ASSERT_EQ(1, min_value);
+  const int32_t first_max = max_value;
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[2]));
+  ASSERT_TRUE(zone_map.range(first_page, 0, min_value, max_value));
+  ASSERT_EQ(1, min_value);
+  ASSERT_EQ(first_max, max_value);
+
+  ASSERT_FALSE(zone_map.may_match(first_page, {ColumnFilter{0, INTS, LESS_THAN, 1}}));
+  ASSERT_TRUE(zone_map.may_match(first_page, {ColumnFilter{0, INTS, LESS_EQUAL, 1}}));
+  ASSERT_FALSE(zone_map.may_match(first_page, {ColumnFilter{0, INTS, GREAT_THAN, first_max}}));
+  ASSERT_TRUE(zone_map.may_match(first_page, {ColumnFilter{0, INTS, EQUAL_TO, first_max}}));
+  ASSERT_TRUE(zone_map.may_match(first_page, {ColumnFilter{0, INTS, NOT_EQUAL, 1}}));
+  // 类型不一致或者没有记录的列不能用来跳过页面
+  ASSERT_TRUE(zone_map.may_match(first_page, {ColumnFilter{0, DATES, LESS_THAN, 1}}));
+  ASSERT_TRUE(zone_map.may_match(first_page, {ColumnFilter{2, INTS, LESS_THAN, 0}}));
+
+  // 扫描时跳过不可能有满足条件的记录的页面，跳过的页面上确实没有满足条件的记录
+  auto scan = [&](const ColumnScanSpec &spec, int64_t &skipped_pages) {
+    VacuousTrx        trx;
+    RecordFileScanner file_scanner;
+    EXPECT_EQ(RC::SUCCESS,
+        file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, &spec, &zone_map));
+    int    count = 0;
+    Record record;
+    while (file_scanner.has_next()) {
+      EXPECT_EQ(RC::SUCCESS, file_scanner.next(record));
+      const int32_t value = *reinterpret_cast<const int32_t *>(record.data());
+      count += value >= 2900 ? 1 : 0;
+    }
+    skipped_pages = file_scanner.skipped_pages();
+    file_scanner.close_scan();
+    return count;
+  };
+
+  ColumnScanSpec spec;
+  spec.filters.push_back(ColumnFilter{0, INTS, GREAT_EQUAL, 2900});
+  int64_t skipped_pages = 0;
+  ASSERT_EQ(100, scan(spec, skipped_pages));
+  ASSERT_GT(skipped_pages, 0);
+
+  // 第二列的值分散在所有页面上，不能跳过任何页面
+  spec.filters.clear();
+  spec.filters.push_back(ColumnFilter{1, DATES, EQUAL_TO, 7});
+  scan(spec, skipped_pages);
+  ASSERT_EQ(0, skipped_pages);
+
+  // 页面上的记录都删除之后，没有条件也可以跳过这个页面
+  for (const RID &rid : rids) {
+    if (rid.page_num == first_page && rid.slot_num > 2) {
+      ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rid));
+    }
+  }
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[1]));
+  ASSERT_FALSE(zone_map.range(first_page, 0, min_value, max_value));
+  spec.filters.clear();
+  scan(spec, skipped_pages);
+  ASSERT_EQ(1, skipped_pages);
+
+  // 重新打开时扫描所有页面构建区域映射
+  const PageNum last_page = rids.back().page_num;
+  int32_t       last_min  = 0;
+  int32_t       last_max  = 0;
+  ASSERT_TRUE(zone_map.range(last_page, 1, last_min, last_max));
+  file_handler.close();
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+  ASSERT_TRUE(zone_map.may_match(first_page, {}));
+  ASSERT_EQ(RC::SUCCESS, file_handler.init_zone_map(columns));
+  ASSERT_FALSE(zone_map.may_match(first_page, {}));
+  ASSERT_TRUE(zone_map.range(last_page, 1, min_value, max_value));
+  ASSERT_EQ(last_min, min_value);
+  ASSERT_EQ(last_max, max_value);
+  file_handler.close();
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_record_file_page_range)
+{
+  const char *record_manager_file = "record_range.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  const int        record_insert_num = 5000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    int32_t record_data[4] = {i, i, i, i};
+    RID     rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<char *>(record_data), sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  for (int i = 0; i < record_insert_num; i += 5) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[i]));
+  }
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  std::vector<int>  all_values;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+  Record record;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    all_values.push_back(*reinterpret_cast<const int32_t *>(record.data()));
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(record_insert_num - record_insert_num / 5, static_cast<int>(all_values.size()));
+
+  // 按照页面范围分块扫描，每块只返回范围内的页面上的记录，所有块合起来与全表扫描相同
+  const PageNum page_count = bp->page_count();
+  ASSERT_GT(page_count, 4);
+  for (int morsel_pages : {1, 3, 8}) {
+    std::vector<int> values;
+    for (PageNum start_page = 0; start_page < page_count; start_page += morsel_pages) {
+      const PageNum end_page = std::min(start_page + morsel_pages, page_count);
+      ASSERT_EQ(RC::SUCCESS,
+          file_scanner.open_scan(
+              nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, nullptr, nullptr, start_page, end_page));
+      while (file_scanner.has_next()) {
+        ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+        ASSERT_GE(record.rid().page_num, start_page);
+        ASSERT_LT(record.rid().page_num, end_page);
+        values.push_back(*reinterpret_cast<const int32_t *>(record.data()));
+      }
+      file_scanner.close_scan();
+    }
+    ASSERT_EQ(all_values, values);
+  }
+
+  // 空的范围没有记录
+  ASSERT_EQ(RC::SUCCESS,
+      file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, nullptr, nullptr, 2, 2));
+  ASSERT_FALSE(file_scanner.has_next());
+  file_scanner.close_scan();
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_compressed_pax_record_file)
+{
+  const char *record_manager_file = "compressed_pax_record.bp";
+  const char *plain_record_file   = "plain_pax_record.bp";
+  ::remove(record_manager_file);
+  ::remove(plain_record_file);
+
+  BufferPoolManager *bpm      = new BufferPoolManager();
+  DiskBufferPool    *bp       = nullptr;
+  DiskBufferPool    *plain_bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(plain_record_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(plain_record_file, plain_bp));
+
+  // 四列：不压缩的版本号，int a, date d, char(8) c
+  struct Row
+  {
+    int32_t xid;
+    int32_t a;
+    int32_t d;
+    char    c[8];
+  };
+  const std::vector<int> column_lens = {4, 4, 4, 8};
+  RecordFileHandler      file_handler;
+  RecordFileHandler      plain_handler;
+  ASSERT_EQ(RC::SUCCESS,
+      file_handler.init(bp, nullptr, RecordFormat::PAX, column_lens, {UNDEFINED, INTS, DATES, CHARS}));
+  ASSERT_EQ(RC::SUCCESS, plain_handler.init(plain_bp, nullptr, RecordFormat::PAX, column_lens));
+
+  // c 只有几个不同的值，偶尔出现一个新值，字典满了之后需要重新编码或者换页面
+  auto make_row = [](int i) {
+    Row row{-i, i, 19000 + i / 100, {}};
+    if (i % 997 == 0) {
+      snprintf(row.c, sizeof(row.c), "u%d", i % 100000);
+    } else {
+      snprintf(row.c, sizeof(row.c), "k%d", i % 5);
+    }
+    return row;
+  };
+
+  const int        record_insert_num = 8000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    Row row = make_row(i);
+    RID rid;
+    RID plain_rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &rid));
+    ASSERT_EQ(RC::SUCCESS, plain_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &plain_rid));
+    rids.push_back(rid);
+  }
+  ASSERT_LT(bp->allocated_pages() * 3, plain_bp->allocated_pages() * 2);
+
+  {
+    RecordPageHandler page_handler;
+    ASSERT_EQ(RC::SUCCESS, page_handler.init(*bp, rids.front().page_num, true /*readonly*/));
+    ASSERT_TRUE(page_handler.is_compressed());
+  }
+
+  // 读取完整的记录
+  for (int i = 0; i < record_insert_num; i += 37) {
+    RecordPageHandler page_handler;
+    Record            record;
+    ASSERT_EQ(RC::SUCCESS, file_handler.get_record(page_handler, &rids[i], true /*readonly*/, &record));
+    const Row expected = make_row(i);
+    ASSERT_EQ(0, memcmp(record.data(), &expected, sizeof(Row)));
+  }
+
+  // 修改之后写回页面，删除一些记录之后插入超出基准值范围的记录
+  ASSERT_EQ(RC::SUCCESS, file_handler.visit_record(rids[9], false /*readonly*/, [](Record &record) {
+    reinterpret_cast<Row *>(record.data())->xid = 9;
+  }));
+  Row updated = make_row(12);
+  updated.d += 1;
+  snprintf(updated.c, sizeof(updated.c), "z9");
+  ASSERT_EQ(RC::SUCCESS, file_handler.update_record(rids[12], reinterpret_cast<const char *>(&updated)));
+  for (int i = 1; i < record_insert_num; i += 3) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[i]));
+  }
+  std::map<int, Row> rows;
+  for (int i = 0; i < record_insert_num; i++) {
+    if (i % 3 != 1) {
+      rows[i] = make_row(i);
+    }
+  }
+  rows[9].xid = 9;
+  rows[12]    = updated;
+  for (int i = 0; i < 100; i++) {
+    Row row{0, 1000000 + i * 1000, 0, {}};
+    snprintf(row.c, sizeof(row.c), "n%d", i);
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &rid));
+    rows[row.a] = row;
+  }
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  Record            record;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+  int count = 0;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    const Row *row = reinterpret_cast<const Row *>(record.data());
+    ASSERT_EQ(1, rows.count(row->a));
+    ASSERT_EQ(0, memcmp(row, &rows[row->a], sizeof(Row)));
+    count++;
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(static_cast<int>(rows.size()), count);
+
+  // 在编码之后的值上过滤，包括超出页面上范围的常量。
+  // 字符串只在字典编码的列上提前过滤，没有压缩的页面会返回所有的记录，调用者还需要再过滤一次
+  auto scan_count = [&](const std::vector<ColumnFilter> &filters, std::function<bool(const Row &)> expected) {
+    ColumnScanSpec spec;
+    spec.filters = filters;
+    EXPECT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr, &spec));
+    int returned = 0;
+    int matched  = 0;
+    while (file_scanner.has_next()) {
+      EXPECT_EQ(RC::SUCCESS, file_scanner.next(record));
+      matched += expected(*reinterpret_cast<const Row *>(record.data())) ? 1 : 0;
+      returned++;
+    }
+    file_scanner.close_scan();
+
+    int expected_count = 0;
+    for (const auto &[key, row] : rows) {
+      expected_count += expected(row) ? 1 : 0;
+    }
+    EXPECT_EQ(expected_count, matched);
+    return returned;
+  };
+
+  ColumnFilter c_equal{3, CHARS, EQUAL_TO, 0};
+  c_equal.chars_value = "k3";
+  ASSERT_LT(scan_count({c_equal}, [](const Row &row) { return strcmp(row.c, "k3") == 0; }),
+      static_cast<int>(rows.size()) / 2);
+  scan_count({c_equal, ColumnFilter{1, INTS, LESS_THAN, 5000}},
+      [](const Row &row) { return strcmp(row.c, "k3") == 0 && row.a < 5000; });
+
+  ColumnFilter c_greater{3, CHARS, GREAT_EQUAL, 0};
+  c_greater.chars_value = "n5";
+  scan_count({c_greater}, [](const Row &row) { return strcmp(row.c, "n5") >= 0; });
+
+  // 整数在所有的页面上都可以提前过滤
+  auto exact_count = [&](const ColumnFilter &filter, std::function<bool(const Row &)> expected) {
+    int expected_count = 0;
+    for (const auto &[key, row] : rows) {
+      expected_count += expected(row) ? 1 : 0;
+    }
+    ASSERT_EQ(expected_count, scan_count({filter}, expected));
+  };
+  exact_count(ColumnFilter{1, INTS, GREAT_THAN, 100000}, [](const Row &row) { return row.a > 100000; });
+  exact_count(ColumnFilter{1, INTS, GREAT_EQUAL, -5}, [](const Row &row) { return row.a >= -5; });
+  exact_count(ColumnFilter{1, INTS, NOT_EQUAL, 3000}, [](const Row &row) { return row.a != 3000; });
+  exact_count(ColumnFilter{1, INTS, LESS_EQUAL, 4000}, [](const Row &row) { return row.a <= 4000; });
+  exact_count(ColumnFilter{2, DATES, EQUAL_TO, 19042}, [](const Row &row) { return row.d == 19042; });
+
+  bpm->close_file(record_manager_file);
+  bpm->close_file(plain_record_file);
+  delete bpm;
+  ::remove(record_manager_file);
+  ::remove(plain_record_file);
+}
+
+TEST(test_record_page_handler, test_release_empty_page)
+{
+  const char *record_manager_file = "release_page_record.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  const int        record_insert_num = 5000;
+  char             record_data[100]  = {0};
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+
+  std::vector<RecordPageUsage> usages;
+  ASSERT_EQ(RC::SUCCESS, file_handler.collect_page_usage(usages));
+  ASSERT_GT(usages.size(), 2);
+  int total = 0;
+  for (const RecordPageUsage &usage : usages) {
+    total += usage.record_num;
+    ASSERT_LE(usage.record_num * static_cast<int>(sizeof(record_data)), usage.used_bytes);
+  }
+  ASSERT_EQ(record_insert_num, total);
+
+  // 只保留第一个页面上的记录
+  const PageNum kept_page = rids.front().page_num;
+  int           kept      = 0;
+  for (RID &rid : rids) {
+    if (rid.page_num == kept_page) {
+      kept++;
+    } else {
+      ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rid));
+    }
+  }
+
+  const int allocated_pages = bp->allocated_pages();
+  int       released_pages  = 0;
+  for (const RecordPageUsage &usage : usages) {
+    bool released = false;
+    ASSERT_EQ(RC::SUCCESS, file_handler.release_empty_page(usage.page_num, released));
+    ASSERT_EQ(usage.page_num != kept_page, released);
+    released_pages += released ? 1 : 0;
+  }
+  ASSERT_EQ(static_cast<int>(usages.size()) - 1, released_pages);
+  ASSERT_EQ(allocated_pages - released_pages, bp->allocated_pages());
+
+  ASSERT_EQ(RC::SUCCESS, file_handler.collect_page_usage(usages));
+  ASSERT_EQ(1, usages.size());
+  ASSERT_EQ(kept, usages.front().record_num);
+
+  // 释放的页面可以重新分配出来
+  for (int i = 0; i < record_insert_num - kept; i++) {
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+  }
+  ASSERT_EQ(allocated_pages, bp->allocated_pages());
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_record_bulk_loader)
+{
+  const char *record_manager_file = "bulk_load_record.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool    *bp  = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  const int        record_insert_num = 10000;
+  int              record_data[25]   = {0};
+  std::vector<RID> rids;
+  RecordBulkLoader loader;
+  ASSERT_EQ(RC::SUCCESS, loader.init(file_handler));
+  for (int i = 0; i < record_insert_num; i++) {
+    record_data[0] = i;
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, loader.append(reinterpret_cast<const char *>(record_data), sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  ASSERT_EQ(RC::SUCCESS, loader.finish());
+
+  // 页面都是写满的，没有用到的页面已经释放
+  std::vector<RecordPageUsage> usages;
+  ASSERT_EQ(RC::SUCCESS, file_handler.collect_page_usage(usages));
+  int not_full_pages = 0;
+  for (const RecordPageUsage &usage : usages) {
+    not_full_pages += FreeSpaceMap::fits(usage.free_bytes, sizeof(record_data)) ? 1 : 0;
+  }
+  ASSERT_EQ(1, not_full_pages);
+  ASSERT_EQ(static_cast<int>(usages.size()), bp->allocated_pages() - 2);
+
+  for (int i = 0; i < record_insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.visit_record(rids[i], true /*readonly*/, [i](Record &record) {
+      ASSERT_EQ(i, *reinterpret_cast<const int *>(record.data()));
+    }));
+  }
+
+  VacuousTrx        trx;
+  RecordFileScanner file_scanner;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr /*table*/, *bp, &trx, true /*readonly*/, nullptr));
+  int    count = 0;
+  Record record;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    ASSERT_EQ(count, *reinterpret_cast<const int *>(record.data()));
+    count++;
+  }
+  file_scanner.close_scan();
+  ASSERT_EQ(record_insert_num, count);
+
+  // 最后一个页面的剩余空间在空闲空间表中，普通插入可以继续使用
+  RID rid;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(reinterpret_cast<const char *>(record_data), sizeof(record_data), &rid));
+  ASSERT_EQ(rids.back().page_num, rid.page_num);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  ::remove(record_manager_file);
+}
+
 int main(int argc, char **argv)
 {
   // 分析gtest程序的命令行参数
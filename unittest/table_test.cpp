@@ -0,0 +1,493 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/global_context.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/index/index.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+static const char *TEST_DB_DIR    = "table_test_db";
+static const char *TEST_TABLE     = "t";
+static const char *TEST_INDEX     = "t_id";
+static const int   TEST_ROW_COUNT = 2000;
+
+/**
+ * @brief 打开测试使用的数据库，打开时会重做日志
+ */
+static unique_ptr<Db> open_db()
+{
+  unique_ptr<Db> db(new Db());
+  EXPECT_EQ(RC::SUCCESS, db->init("test", TEST_DB_DIR));
+  return db;
+}
+
+static Table *create_table(Db &db)
+{
+  AttrInfoSqlNode attrs[2] = {{INTS, "id", 4}, {CHARS, "name", 4}};
+  EXPECT_EQ(RC::SUCCESS, db.create_table(TEST_TABLE, 2, attrs));
+
+  Table *table = db.find_table(TEST_TABLE);
+  EXPECT_NE(nullptr, table);
+
+  Trx *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  EXPECT_EQ(RC::SUCCESS, table->create_index(trx, table->table_meta().field("id"), TEST_INDEX));
+  GCTX.trx_kit_->destroy_trx(trx);
+  return table;
+}
+
+static int id_of(Table *table, const Record &record)
+{
+  return *reinterpret_cast<const int *>(record.data() + table->table_meta().field("id")->offset());
+}
+
+static void insert_rows(Db &db, Table *table, int count)
+{
+  Trx *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  for (int i = 0; i < count; i++) {
+    Value  values[2] = {Value(i), Value("abcd")};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+}
+
+/**
+ * @brief 在 trx 中删除满足条件的记录，不提交
+ */
+static void delete_rows(Table *table, Trx *trx, function<bool(int)> predicate)
+{
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+
+  vector<RID>       rids;
+  RecordFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, trx, true /*readonly*/));
+  Record record;
+  while (scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, scanner.next(record));
+    if (predicate(id_of(table, record))) {
+      rids.push_back(record.rid());
+    }
+  }
+  scanner.close_scan();
+
+  for (const RID &rid : rids) {
+    RC rc = RC::SUCCESS;
+    ASSERT_EQ(RC::SUCCESS, table->visit_record(rid, false /*readonly*/, [&](Record &record) {
+      rc = trx->delete_record(table, record);
+    }));
+    ASSERT_EQ(RC::SUCCESS, rc);
+  }
+}
+
+static int count_rows(Db &db, Table *table)
+{
+  Trx *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  trx->start_if_need();
+
+  int               count = 0;
+  RecordFileScanner scanner;
+  EXPECT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, trx, true /*readonly*/));
+  Record record;
+  while (scanner.has_next()) {
+    EXPECT_EQ(RC::SUCCESS, scanner.next(record));
+    count++;
+  }
+  scanner.close_scan();
+
+  trx->commit();
+  GCTX.trx_kit_->destroy_trx(trx);
+  return count;
+}
+
+/**
+ * @brief 通过索引查找记录，返回找到的记录的位置
+ */
+static vector<RID> lookup(Table *table, int id)
+{
+  vector<RID>   rids;
+  Index        *index   = table->find_index(TEST_INDEX);
+  const char   *key     = reinterpret_cast<const char *>(&id);
+  IndexScanner *scanner = index->create_scanner(key, sizeof(id), true, key, sizeof(id), true);
+  RID           rid;
+  while (RC::SUCCESS == scanner->next_entry(&rid)) {
+    rids.push_back(rid);
+  }
+  scanner->destroy();
+  return rids;
+}
+
+/**
+ * @brief 每个索引项都指向 id 相同的记录，留下来的记录在索引中只有一项，删除的记录在索引中没有
+ */
+static void check_indexes(Table *table, function<bool(int)> kept)
+{
+  for (int id = 0; id < TEST_ROW_COUNT; id++) {
+    vector<RID> rids = lookup(table, id);
+    if (!kept(id)) {
+      ASSERT_TRUE(rids.empty()) << "id=" << id;
+      continue;
+    }
+
+    ASSERT_EQ(1, static_cast<int>(rids.size())) << "id=" << id;
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(rids[0], record));
+    ASSERT_EQ(id, id_of(table, record));
+  }
+}
+
+static VacuumStat vacuum(Db &db, Table *table)
+{
+  VacuumStat stat;
+  Trx       *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  EXPECT_EQ(RC::SUCCESS, table->vacuum(trx, stat));
+  EXPECT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+  return stat;
+}
+
+class TableTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    filesystem::remove_all(TEST_DB_DIR);
+    filesystem::create_directory(TEST_DB_DIR);
+  }
+
+  void TearDown() override { filesystem::remove_all(TEST_DB_DIR); }
+};
+
+TEST_F(TableTest, test_version_state)
+{
+  unique_ptr<Db> db    = open_db();
+  Table         *table = create_table(*db);
+  insert_rows(*db, table, 10);
+
+  auto state_of = [table](Trx *trx, int id) {
+    RecordVersionState state = RecordVersionState::LIVE;
+    EXPECT_EQ(RC::SUCCESS, table->visit_record(lookup(table, id)[0], true /*readonly*/, [&](Record &record) {
+      state = trx->version_state(table, record);
+    }));
+    return state;
+  };
+
+  Trx *observer = GCTX.trx_kit_->create_trx(db->clog_manager());
+  ASSERT_EQ(RecordVersionState::LIVE, state_of(observer, 0));
+
+  // 没有提交的删除还在事务中记录着位置
+  Trx *deleter = GCTX.trx_kit_->create_trx(db->clog_manager());
+  delete_rows(table, deleter, [](int id) { return id == 0; });
+  ASSERT_EQ(RecordVersionState::ACTIVE, state_of(observer, 0));
+  ASSERT_EQ(RecordVersionState::LIVE, state_of(observer, 1));
+
+  // 删除之前开始的事务还能看到这条记录
+  ASSERT_EQ(RC::SUCCESS, observer->start_if_need());
+  ASSERT_EQ(RC::SUCCESS, deleter->commit());
+  ASSERT_EQ(RecordVersionState::LIVE, state_of(observer, 0));
+
+  ASSERT_EQ(RC::SUCCESS, observer->commit());
+  ASSERT_EQ(RecordVersionState::DEAD, state_of(observer, 0));
+
+  GCTX.trx_kit_->destroy_trx(deleter);
+  GCTX.trx_kit_->destroy_trx(observer);
+}
+
+TEST_F(TableTest, test_vacuum_moves_records)
+{
+  auto kept = [](int id) { return id % 50 == 0; };
+
+  unique_ptr<Db> db    = open_db();
+  Table         *table = create_table(*db);
+  insert_rows(*db, table, TEST_ROW_COUNT);
+
+  Trx *trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+  delete_rows(table, trx, [&](int id) { return !kept(id); });
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+
+  const int page_count = table->data_buffer_pool()->allocated_pages();
+
+  VacuumStat stat = vacuum(*db, table);
+  ASSERT_EQ(TEST_ROW_COUNT - TEST_ROW_COUNT / 50, stat.purged_records);
+  ASSERT_GT(stat.moved_records, 0);
+  ASSERT_GT(stat.released_pages, 0);
+  ASSERT_EQ(page_count - stat.released_pages, table->data_buffer_pool()->allocated_pages());
+
+  ASSERT_EQ(TEST_ROW_COUNT / 50, count_rows(*db, table));
+  check_indexes(table, kept);
+
+  // 没有可以整理的了
+  stat = vacuum(*db, table);
+  ASSERT_EQ(0, stat.purged_records);
+  ASSERT_EQ(0, stat.moved_records);
+}
+
+TEST_F(TableTest, test_vacuum_skips_active_records)
+{
+  unique_ptr<Db> db    = open_db();
+  Table         *table = create_table(*db);
+  insert_rows(*db, table, TEST_ROW_COUNT);
+
+  // 删除没有提交，记录还不能清理，所在的页面也不能搬动
+  Trx *trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+  delete_rows(table, trx, [](int id) { return id % 50 != 0; });
+
+  VacuumStat stat = vacuum(*db, table);
+  ASSERT_EQ(0, stat.purged_records);
+  ASSERT_EQ(0, stat.moved_records);
+  ASSERT_EQ(0, stat.released_pages);
+
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+  ASSERT_EQ(TEST_ROW_COUNT / 50, count_rows(*db, table));
+}
+
+TEST_F(TableTest, test_vacuum_recover)
+{
+  auto kept = [](int id) { return id % 50 == 0 || id >= TEST_ROW_COUNT - 10; };
+
+  {
+    unique_ptr<Db> db    = open_db();
+    Table         *table = create_table(*db);
+    insert_rows(*db, table, TEST_ROW_COUNT - 10);
+
+    Trx *trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+    delete_rows(table, trx, [&](int id) { return !kept(id); });
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    GCTX.trx_kit_->destroy_trx(trx);
+
+    VacuumStat stat = vacuum(*db, table);
+    ASSERT_GT(stat.moved_records, 0);
+    ASSERT_GT(stat.released_pages, 0);
+
+    // 整理之后插入的记录可能用到释放的页面
+    Trx *inserter = GCTX.trx_kit_->create_trx(db->clog_manager());
+    ASSERT_EQ(RC::SUCCESS, inserter->start_if_need());
+    for (int id = TEST_ROW_COUNT - 10; id < TEST_ROW_COUNT; id++) {
+      Value  values[2] = {Value(id), Value("abcd")};
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+      ASSERT_EQ(RC::SUCCESS, inserter->insert_record(table, record));
+    }
+    ASSERT_EQ(RC::SUCCESS, inserter->commit());
+    GCTX.trx_kit_->destroy_trx(inserter);
+  }
+
+  // 重新打开时从头重做所有的日志，搬走的记录不能再出现一次。再打开一次，重做到已经恢复过的页面上
+  for (int i = 0; i < 2; i++) {
+    unique_ptr<Db> db    = open_db();
+    Table         *table = db->find_table(TEST_TABLE);
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ((TEST_ROW_COUNT - 10 + 49) / 50 + 10, count_rows(*db, table));
+    check_indexes(table, kept);
+  }
+}
+
+/**
+ * @brief 长字段放在溢出页面中的表，溢出页面和记录页面会互相重复使用同一个页面
+ */
+static const char *TEST_LONG_TABLE = "v";
+static const char *TEST_LONG_INDEX = "v_id";
+
+static string body_of(int id) { return id >= 1000 && id < 2000 ? string(10000 + id, 'a' + id % 26) : "x"; }
+
+static void insert_body_rows(Db &db, Table *table, const vector<int> &ids)
+{
+  Trx *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  for (int id : ids) {
+    const string body      = body_of(id);
+    Value        values[2] = {Value(id), Value(body.c_str(), static_cast<int>(body.size()))};
+    Record       record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+}
+
+static void delete_committed_rows(Db &db, Table *table, function<bool(int)> predicate)
+{
+  Trx *trx = GCTX.trx_kit_->create_trx(db.clog_manager());
+  delete_rows(table, trx, predicate);
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+}
+
+/**
+ * @brief 每条留下来的记录都能通过索引找到，长字段的内容与插入时一样
+ */
+static void check_long_rows(Table *table, const vector<int> &ids)
+{
+  const FieldMeta *body_field = table->table_meta().field("body");
+  Index           *index      = table->find_index(TEST_LONG_INDEX);
+  for (int id : ids) {
+    const char   *key     = reinterpret_cast<const char *>(&id);
+    IndexScanner *scanner = index->create_scanner(key, sizeof(id), true, key, sizeof(id), true);
+    RID           rid;
+    RC            rc = scanner->next_entry(&rid);
+    scanner->destroy();
+    ASSERT_EQ(RC::SUCCESS, rc) << "id=" << id;
+
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(rid, record)) << "id=" << id;
+    ASSERT_EQ(id, id_of(table, record));
+    Value body;
+    ASSERT_EQ(RC::SUCCESS, table->read_varchar(record.data(), *body_field, body)) << "id=" << id;
+    ASSERT_EQ(body_of(id), body.get_string()) << "id=" << id;
+  }
+}
+
+TEST_F(TableTest, test_overflow_recover)
+{
+  vector<int> ids;
+  {
+    unique_ptr<Db>  db       = open_db();
+    AttrInfoSqlNode attrs[2] = {{INTS, "id", 4}, {VARCHARS, "body", 20000}};
+    ASSERT_EQ(RC::SUCCESS, db->create_table(TEST_LONG_TABLE, 2, attrs));
+    Table *table = db->find_table(TEST_LONG_TABLE);
+    ASSERT_NE(nullptr, table);
+    Trx *trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+    ASSERT_EQ(RC::SUCCESS, table->create_index(trx, table->table_meta().field("id"), TEST_LONG_INDEX));
+    GCTX.trx_kit_->destroy_trx(trx);
+
+    // 整理之后释放的记录页面被长字段用作溢出页面
+    vector<int> short_ids;
+    for (int id = 0; id < 400; id++) {
+      short_ids.push_back(id);
+    }
+    insert_body_rows(*db, table, short_ids);
+    delete_committed_rows(*db, table, [](int id) { return id < 400 && id % 50 != 0; });
+    vacuum(*db, table);
+
+    vector<int> long_ids;
+    for (int id = 1000; id < 1020; id++) {
+      long_ids.push_back(id);
+    }
+    insert_body_rows(*db, table, long_ids);
+
+    // 清理长记录时释放的溢出页面又被用作记录页面
+    delete_committed_rows(*db, table, [](int id) { return id >= 1000 && id % 2 == 1; });
+    vacuum(*db, table);
+
+    vector<int> more_ids;
+    for (int id = 2000; id < 2200; id++) {
+      more_ids.push_back(id);
+    }
+    insert_body_rows(*db, table, more_ids);
+
+    // 同一个事务中插入又删除的长记录，溢出页面马上就释放了，之后的插入会用到
+    trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    const string body      = body_of(1500);
+    Value        values[2] = {Value(1500), Value(body.c_str(), static_cast<int>(body.size()))};
+    Record       record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+    Record inserted;
+    ASSERT_EQ(RC::SUCCESS, table->get_record(record.rid(), inserted));
+    ASSERT_EQ(RC::SUCCESS, trx->delete_record(table, inserted));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    GCTX.trx_kit_->destroy_trx(trx);
+    insert_body_rows(*db, table, {1501});
+
+    for (int id = 0; id < 400; id += 50) {
+      ids.push_back(id);
+    }
+    for (int id = 1000; id < 1020; id += 2) {
+      ids.push_back(id);
+    }
+    ids.insert(ids.end(), more_ids.begin(), more_ids.end());
+    ids.push_back(1501);
+    ASSERT_EQ(static_cast<int>(ids.size()), count_rows(*db, table));
+    check_long_rows(table, ids);
+  }
+
+  // 重做日志时溢出页面按照日志中的页号重写，不会分配新的页面，也不会丢掉插入到重复使用的页面上的记录
+  int page_count = 0;
+  for (int i = 0; i < 2; i++) {
+    unique_ptr<Db> db    = open_db();
+    Table         *table = db->find_table(TEST_LONG_TABLE);
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ(static_cast<int>(ids.size()), count_rows(*db, table));
+    check_long_rows(table, ids);
+
+    if (i == 0) {
+      page_count = table->data_buffer_pool()->allocated_pages();
+    } else {
+      ASSERT_EQ(page_count, table->data_buffer_pool()->allocated_pages());
+    }
+  }
+}
+
+#ifdef CONCURRENCY
+TEST_F(TableTest, test_vacuum_waits_for_scan)
+{
+  unique_ptr<Db> db    = open_db();
+  Table         *table = create_table(*db);
+  insert_rows(*db, table, TEST_ROW_COUNT);
+
+  Trx *trx = GCTX.trx_kit_->create_trx(db->clog_manager());
+  delete_rows(table, trx, [](int id) { return id % 50 != 0; });
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  GCTX.trx_kit_->destroy_trx(trx);
+
+  // 扫描算子打开时拿着表的读锁，整理要等扫描结束才能搬动记录
+  table->latch().lock_shared();
+  atomic<bool> done(false);
+  thread       vacuum_thread([&]() {
+    vacuum(*db, table);
+    done = true;
+  });
+
+  this_thread::sleep_for(chrono::milliseconds(200));
+  ASSERT_FALSE(done.load());
+  table->latch().unlock_shared();
+  vacuum_thread.join();
+  ASSERT_TRUE(done.load());
+
+  ASSERT_EQ(TEST_ROW_COUNT / 50, count_rows(*db, table));
+  check_indexes(table, [](int id) { return id % 50 == 0; });
+}
+#endif  // CONCURRENCY
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  LoggerFactory::init_default("table_test.log", LOG_LEVEL_INFO);
+
+  BufferPoolManager bpm;
+  BufferPoolManager::set_instance(&bpm);
+  TrxKit::init_global("mvcc");
+  GCTX.trx_kit_ = TrxKit::instance();
+
+  return RUN_ALL_TESTS();
+}